@@ -858,6 +858,10 @@ extern "C"
         SlangCompileRequest* request,
         ISlangBlob** outBlob);
 
+    /** Write the layout reflection as a binary reflection blob.
+    The format, and accessors to read it without Slang, are in `slang-reflection-blob.h`. */
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob);
+
     SLANG_API unsigned spReflection_GetParameterCount(SlangReflection* reflection);
     SLANG_API SlangReflectionParameter* spReflection_GetParameterByIndex(
         SlangReflection* reflection,
@@ -728,6 +728,17 @@ struct SubresourceRange
     GfxCount layerCount;     // For cube maps, this is a multiple of 6.
 };
 
+struct TextureResourceFlags
+{
+    enum Enum : uint32_t
+    {
+        None = 0,
+        /// Hint that the texture is mostly sampled with filtering, so it can be stored in a
+        /// layout that keeps neighboring texels close in memory. Only the CPU device uses it.
+        Tiled = 1,
+    };
+};
+
 class ITextureResource : public IResource
 {
 public:
@@ -767,6 +778,7 @@ public:
         Format format;             ///< The resources format
         SampleDesc sampleDesc;     ///< How the resource is sampled
         ClearValue* optimalClearValue = nullptr;
+        uint32_t flags = TextureResourceFlags::None; ///< Combination of TextureResourceFlags
     };
 
     /// Data for a single subresource of a texture.
@@ -0,0 +1,453 @@
+#ifndef SLANG_REFLECTION_BLOB_H
+#define SLANG_REFLECTION_BLOB_H
+
+/** \file slang-reflection-blob.h
+
+A compact binary form of the layout reflection of a program, together with zero-copy accessors.
+
+A reflection blob is produced by the compiler (see `spReflection_ToBinary` and the
+`-reflection-binary` option), and can be loaded by a runtime by just reading or memory mapping the
+file. Queries are answered directly from the bytes of the blob, so there is no need to keep a
+compiler session alive, or even to link against Slang. This header only depends on the C standard
+library.
+
+The blob is position independent. All references are either byte offsets from the start of the blob,
+or indices into one of the tables (sections) described by the header. Every section records the size
+of its records (the stride), so a reader can consume blobs produced by a newer minor version that
+has appended members to records, or appended sections.
+
+Values that are enums (type kind, scalar type, parameter category, binding type, stage and so on)
+hold the same values as the corresponding enums in `slang.h`.
+
+All values are stored little endian.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SLANG_REFLECTION_BLOB_MAGIC 0x4c465253u /* 'SRFL' */
+#define SLANG_REFLECTION_BLOB_MAJOR_VERSION 1
+#define SLANG_REFLECTION_BLOB_MINOR_VERSION 0
+
+/* The value of an index that doesn't reference anything */
+#define SLANG_REFLECTION_BLOB_NONE 0xffffffffu
+/* A size or count that is unbounded (for example an unsized array) */
+#define SLANG_REFLECTION_BLOB_UNBOUNDED 0xffffffffu
+/* A size that is too large to be represented */
+#define SLANG_REFLECTION_BLOB_UNKNOWN 0xfffffffeu
+
+#define SLANG_REFLECTION_BLOB_INLINE static inline
+
+    typedef enum SlangReflectionBlobSectionKind
+    {
+        /* Zero terminated UTF-8 strings. Strings are referenced by byte offset into the section.
+        Offset 0 is always the empty string. */
+        SLANG_REFLECTION_BLOB_SECTION_STRINGS,
+        SLANG_REFLECTION_BLOB_SECTION_TYPE_LAYOUTS,      /* SlangReflectionBlobTypeLayout */
+        SLANG_REFLECTION_BLOB_SECTION_VAR_LAYOUTS,       /* SlangReflectionBlobVarLayout */
+        SLANG_REFLECTION_BLOB_SECTION_SIZES,             /* SlangReflectionBlobSize */
+        SLANG_REFLECTION_BLOB_SECTION_OFFSETS,           /* SlangReflectionBlobOffset */
+        SLANG_REFLECTION_BLOB_SECTION_BINDING_RANGES,    /* SlangReflectionBlobBindingRange */
+        SLANG_REFLECTION_BLOB_SECTION_DESCRIPTOR_SETS,   /* SlangReflectionBlobDescriptorSet */
+        SLANG_REFLECTION_BLOB_SECTION_DESCRIPTOR_RANGES, /* SlangReflectionBlobDescriptorRange */
+        SLANG_REFLECTION_BLOB_SECTION_SUB_OBJECT_RANGES, /* SlangReflectionBlobSubObjectRange */
+        SLANG_REFLECTION_BLOB_SECTION_ENTRY_POINTS,      /* SlangReflectionBlobEntryPoint */
+        SLANG_REFLECTION_BLOB_SECTION_COUNT_V1,
+    } SlangReflectionBlobSectionKind;
+
+    typedef struct SlangReflectionBlobSection
+    {
+        uint32_t offset; /* Byte offset of the first record from the start of the blob */
+        uint32_t count;  /* Number of records. For the string section the number of bytes */
+        uint32_t stride; /* Size of a record in bytes */
+    } SlangReflectionBlobSection;
+
+    typedef struct SlangReflectionBlobHeader
+    {
+        uint32_t magic; /* SLANG_REFLECTION_BLOB_MAGIC */
+        uint16_t majorVersion;
+        uint16_t minorVersion;
+        uint32_t totalSize;    /* Size of the whole blob in bytes */
+        uint32_t sectionCount; /* Number of SlangReflectionBlobSection that follow the header */
+
+        uint32_t globalParamsVarLayout; /* Var layout of the global scope */
+        uint32_t firstParameter;        /* Global parameters are contiguous var layouts */
+        uint32_t parameterCount;
+    } SlangReflectionBlobHeader;
+
+    typedef struct SlangReflectionBlobTypeLayout
+    {
+        uint32_t name; /* String */
+        uint32_t kind; /* SlangTypeKind */
+        uint32_t scalarType;
+        uint32_t resourceShape;
+        uint32_t resourceAccess;
+        uint32_t rowCount;
+        uint32_t columnCount;
+        uint32_t elementCount; /* For arrays, may be SLANG_REFLECTION_BLOB_UNBOUNDED */
+        uint32_t parameterCategory;
+        uint32_t matrixLayoutMode;
+
+        uint32_t elementTypeLayout;  /* Arrays, vectors, buffers and parameter groups */
+        uint32_t elementVarLayout;   /* Parameter groups only */
+        uint32_t containerVarLayout; /* Parameter groups only */
+
+        uint32_t firstField; /* Fields are contiguous var layouts */
+        uint32_t fieldCount;
+        uint32_t firstSize; /* One size per resource category consumed */
+        uint32_t sizeCount;
+        uint32_t firstBindingRange;
+        uint32_t bindingRangeCount;
+        uint32_t firstDescriptorSet;
+        uint32_t descriptorSetCount;
+        uint32_t firstSubObjectRange;
+        uint32_t subObjectRangeCount;
+    } SlangReflectionBlobTypeLayout;
+
+    typedef struct SlangReflectionBlobVarLayout
+    {
+        uint32_t name; /* String */
+        uint32_t typeLayout;
+        uint32_t firstOffset; /* One offset per resource category consumed */
+        uint32_t offsetCount;
+        uint32_t semanticName; /* String */
+        uint32_t semanticIndex;
+        uint32_t stage; /* SlangStage */
+    } SlangReflectionBlobVarLayout;
+
+    typedef struct SlangReflectionBlobSize
+    {
+        uint32_t category; /* SlangParameterCategory */
+        uint32_t size;
+        uint32_t alignment;
+        uint32_t stride;
+    } SlangReflectionBlobSize;
+
+    typedef struct SlangReflectionBlobOffset
+    {
+        uint32_t category; /* SlangParameterCategory */
+        uint32_t offset;
+        uint32_t space;
+    } SlangReflectionBlobOffset;
+
+    typedef struct SlangReflectionBlobBindingRange
+    {
+        uint32_t bindingType; /* SlangBindingType */
+        uint32_t bindingCount;
+        uint32_t leafTypeLayout;
+        uint32_t imageFormat; /* SlangImageFormat */
+        uint32_t descriptorSetIndex; /* Relative to the type layouts descriptor sets */
+        uint32_t firstDescriptorRange; /* Relative to the descriptor set */
+        uint32_t descriptorRangeCount;
+    } SlangReflectionBlobBindingRange;
+
+    typedef struct SlangReflectionBlobDescriptorSet
+    {
+        uint32_t spaceOffset;
+        uint32_t firstDescriptorRange;
+        uint32_t descriptorRangeCount;
+    } SlangReflectionBlobDescriptorSet;
+
+    typedef struct SlangReflectionBlobDescriptorRange
+    {
+        uint32_t indexOffset;
+        uint32_t descriptorCount;
+        uint32_t bindingType; /* SlangBindingType */
+        uint32_t category;    /* SlangParameterCategory */
+    } SlangReflectionBlobDescriptorRange;
+
+    typedef struct SlangReflectionBlobSubObjectRange
+    {
+        uint32_t bindingRangeIndex; /* Relative to the type layouts binding ranges */
+        uint32_t spaceOffset;
+        uint32_t offsetVarLayout;
+    } SlangReflectionBlobSubObjectRange;
+
+    typedef struct SlangReflectionBlobEntryPoint
+    {
+        uint32_t name;       /* String */
+        uint32_t nameOverride; /* String */
+        uint32_t stage;      /* SlangStage */
+        uint32_t varLayout;
+        uint32_t resultVarLayout;
+        uint32_t firstParameter; /* Parameters are contiguous var layouts */
+        uint32_t parameterCount;
+        uint32_t threadGroupSize[3];
+    } SlangReflectionBlobEntryPoint;
+
+    /* Returns the header if data/size holds a reflection blob that can be read by this version of
+    the accessors, otherwise returns NULL. All sections are bounds checked, so the other accessors
+    only need to check indices. data must be at least 4 byte aligned. */
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobHeader* slangReflectionBlob_getHeader(
+        const void* data,
+        size_t size)
+    {
+        static const uint32_t minStrides[SLANG_REFLECTION_BLOB_SECTION_COUNT_V1] = {
+            1,
+            sizeof(SlangReflectionBlobTypeLayout),
+            sizeof(SlangReflectionBlobVarLayout),
+            sizeof(SlangReflectionBlobSize),
+            sizeof(SlangReflectionBlobOffset),
+            sizeof(SlangReflectionBlobBindingRange),
+            sizeof(SlangReflectionBlobDescriptorSet),
+            sizeof(SlangReflectionBlobDescriptorRange),
+            sizeof(SlangReflectionBlobSubObjectRange),
+            sizeof(SlangReflectionBlobEntryPoint),
+        };
+
+        const SlangReflectionBlobHeader* header = (const SlangReflectionBlobHeader*)data;
+        const SlangReflectionBlobSection* sections;
+        uint32_t i;
+
+        if (!data || size < sizeof(SlangReflectionBlobHeader) || (((uintptr_t)data) & 3) != 0)
+            return NULL;
+        if (header->magic != SLANG_REFLECTION_BLOB_MAGIC ||
+            header->majorVersion != SLANG_REFLECTION_BLOB_MAJOR_VERSION ||
+            header->totalSize > size || header->totalSize < sizeof(SlangReflectionBlobHeader) ||
+            header->sectionCount < SLANG_REFLECTION_BLOB_SECTION_COUNT_V1 ||
+            header->sectionCount >
+                (header->totalSize - sizeof(SlangReflectionBlobHeader)) /
+                    sizeof(SlangReflectionBlobSection))
+            return NULL;
+
+        sections = (const SlangReflectionBlobSection*)(header + 1);
+        for (i = 0; i < SLANG_REFLECTION_BLOB_SECTION_COUNT_V1; ++i)
+        {
+            const SlangReflectionBlobSection* section = &sections[i];
+            if (section->stride < minStrides[i] || (i != 0 && (section->stride & 3) != 0) ||
+                (section->offset & 3) != 0 || section->offset > header->totalSize ||
+                (uint64_t)section->count * section->stride > header->totalSize - section->offset)
+                return NULL;
+        }
+
+        /* The string section must be zero terminated, so any offset into it is a valid string */
+        if (sections[SLANG_REFLECTION_BLOB_SECTION_STRINGS].count == 0 ||
+            ((const char*)data)[sections[SLANG_REFLECTION_BLOB_SECTION_STRINGS].offset +
+                                sections[SLANG_REFLECTION_BLOB_SECTION_STRINGS].count - 1] != 0)
+            return NULL;
+
+        return header;
+    }
+
+    /* Returns a pointer to record index of the section kind, or NULL if out of range */
+    SLANG_REFLECTION_BLOB_INLINE const void* slangReflectionBlob_getRecord(
+        const SlangReflectionBlobHeader* header,
+        SlangReflectionBlobSectionKind kind,
+        uint32_t index)
+    {
+        const SlangReflectionBlobSection* section =
+            &((const SlangReflectionBlobSection*)(header + 1))[kind];
+        if (index >= section->count)
+            return NULL;
+        return (const char*)header + section->offset + (size_t)index * section->stride;
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE uint32_t slangReflectionBlob_getRecordCount(
+        const SlangReflectionBlobHeader* header,
+        SlangReflectionBlobSectionKind kind)
+    {
+        return ((const SlangReflectionBlobSection*)(header + 1))[kind].count;
+    }
+
+    /* Returns the string at offset. Never returns NULL, an invalid offset returns "" */
+    SLANG_REFLECTION_BLOB_INLINE const char* slangReflectionBlob_getString(
+        const SlangReflectionBlobHeader* header,
+        uint32_t offset)
+    {
+        const char* strings = (const char*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_STRINGS,
+            offset);
+        return strings ? strings
+                       : (const char*)slangReflectionBlob_getRecord(
+                             header,
+                             SLANG_REFLECTION_BLOB_SECTION_STRINGS,
+                             0);
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobTypeLayout*
+    slangReflectionBlob_getTypeLayout(
+        const SlangReflectionBlobHeader* header,
+        uint32_t index)
+    {
+        return (const SlangReflectionBlobTypeLayout*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_TYPE_LAYOUTS,
+            index);
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobVarLayout*
+    slangReflectionBlob_getVarLayout(
+        const SlangReflectionBlobHeader* header,
+        uint32_t index)
+    {
+        return (const SlangReflectionBlobVarLayout*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_VAR_LAYOUTS,
+            index);
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobEntryPoint*
+    slangReflectionBlob_getEntryPoint(
+        const SlangReflectionBlobHeader* header,
+        uint32_t index)
+    {
+        return (const SlangReflectionBlobEntryPoint*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_ENTRY_POINTS,
+            index);
+    }
+
+    /* Get the global parameter at index */
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobVarLayout*
+    slangReflectionBlob_getParameter(
+        const SlangReflectionBlobHeader* header,
+        uint32_t index)
+    {
+        if (index >= header->parameterCount)
+            return NULL;
+        return slangReflectionBlob_getVarLayout(header, header->firstParameter + index);
+    }
+
+    /* Find a global parameter by name. Returns NULL if not found */
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobVarLayout*
+    slangReflectionBlob_findParameter(
+        const SlangReflectionBlobHeader* header,
+        const char* name)
+    {
+        uint32_t i;
+        for (i = 0; i < header->parameterCount; ++i)
+        {
+            const SlangReflectionBlobVarLayout* param = slangReflectionBlob_getParameter(header, i);
+            if (param && strcmp(slangReflectionBlob_getString(header, param->name), name) == 0)
+                return param;
+        }
+        return NULL;
+    }
+
+    /* Get the field at index of the type layout */
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobVarLayout* slangReflectionBlob_getField(
+        const SlangReflectionBlobHeader* header,
+        const SlangReflectionBlobTypeLayout* typeLayout,
+        uint32_t index)
+    {
+        if (index >= typeLayout->fieldCount)
+            return NULL;
+        return slangReflectionBlob_getVarLayout(header, typeLayout->firstField + index);
+    }
+
+    /* Get the size of the type layout for a category. Returns 0 if the category isn't consumed */
+    SLANG_REFLECTION_BLOB_INLINE uint32_t slangReflectionBlob_getTypeLayoutSize(
+        const SlangReflectionBlobHeader* header,
+        const SlangReflectionBlobTypeLayout* typeLayout,
+        uint32_t category)
+    {
+        uint32_t i;
+        for (i = 0; i < typeLayout->sizeCount; ++i)
+        {
+            const SlangReflectionBlobSize* size = (const SlangReflectionBlobSize*)
+                slangReflectionBlob_getRecord(
+                    header,
+                    SLANG_REFLECTION_BLOB_SECTION_SIZES,
+                    typeLayout->firstSize + i);
+            if (size && size->category == category)
+                return size->size;
+        }
+        return 0;
+    }
+
+    /* Get the offset of the var layout for a category, and optionally its space. Returns 0 if the
+    category isn't consumed */
+    SLANG_REFLECTION_BLOB_INLINE uint32_t slangReflectionBlob_getVarLayoutOffset(
+        const SlangReflectionBlobHeader* header,
+        const SlangReflectionBlobVarLayout* varLayout,
+        uint32_t category,
+        uint32_t* outSpace)
+    {
+        uint32_t i;
+        for (i = 0; i < varLayout->offsetCount; ++i)
+        {
+            const SlangReflectionBlobOffset* offset = (const SlangReflectionBlobOffset*)
+                slangReflectionBlob_getRecord(
+                    header,
+                    SLANG_REFLECTION_BLOB_SECTION_OFFSETS,
+                    varLayout->firstOffset + i);
+            if (offset && offset->category == category)
+            {
+                if (outSpace)
+                    *outSpace = offset->space;
+                return offset->offset;
+            }
+        }
+        if (outSpace)
+            *outSpace = 0;
+        return 0;
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobBindingRange*
+    slangReflectionBlob_getBindingRange(
+        const SlangReflectionBlobHeader* header,
+        const SlangReflectionBlobTypeLayout* typeLayout,
+        uint32_t index)
+    {
+        if (index >= typeLayout->bindingRangeCount)
+            return NULL;
+        return (const SlangReflectionBlobBindingRange*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_BINDING_RANGES,
+            typeLayout->firstBindingRange + index);
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobDescriptorSet*
+    slangReflectionBlob_getDescriptorSet(
+        const SlangReflectionBlobHeader* header,
+        const SlangReflectionBlobTypeLayout* typeLayout,
+        uint32_t index)
+    {
+        if (index >= typeLayout->descriptorSetCount)
+            return NULL;
+        return (const SlangReflectionBlobDescriptorSet*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_DESCRIPTOR_SETS,
+            typeLayout->firstDescriptorSet + index);
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobDescriptorRange*
+    slangReflectionBlob_getDescriptorRange(
+        const SlangReflectionBlobHeader* header,
+        const SlangReflectionBlobDescriptorSet* descriptorSet,
+        uint32_t index)
+    {
+        if (index >= descriptorSet->descriptorRangeCount)
+            return NULL;
+        return (const SlangReflectionBlobDescriptorRange*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_DESCRIPTOR_RANGES,
+            descriptorSet->firstDescriptorRange + index);
+    }
+
+    SLANG_REFLECTION_BLOB_INLINE const SlangReflectionBlobSubObjectRange*
+    slangReflectionBlob_getSubObjectRange(
+        const SlangReflectionBlobHeader* header,
+        const SlangReflectionBlobTypeLayout* typeLayout,
+        uint32_t index)
+    {
+        if (index >= typeLayout->subObjectRangeCount)
+            return NULL;
+        return (const SlangReflectionBlobSubObjectRange*)slangReflectionBlob_getRecord(
+            header,
+            SLANG_REFLECTION_BLOB_SECTION_SUB_OBJECT_RANGES,
+            typeLayout->firstSubObjectRange + index);
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
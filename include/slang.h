@@ -1008,6 +1008,24 @@ typedef uint32_t SlangSizeT;
 
         EmitReflectionJSON, // bool
         SaveGLSLModuleBinSource,
+        EmitReflectionBinary,   // string
+        CPUSIMDWidth,           // int, thread-group lanes run per iteration in CPU compute kernels
+        CheckpointBudget,       // int, bytes of primal values stored per function for reverse-mode
+                                // autodiff
+        ModuleCompression,      // int, compression of the chunks of serialized modules
+        SerialIRViaData,        // bool, serialize IR through the intermediate IRSerialData arrays
+        InlineThreshold,        // int, size below which the cost model inliner inlines a call
+        ReportInlining,         // bool
+        ReportDynamicDispatch,  // bool
+        TightAnyValuePacking,   // bool
+        ReportAnyValuePacking,  // bool
+        LoopUnrollBudget,       // int, unrolled size below which constant trip count loops unroll
+        ReportLoopUnrolling,    // bool
+        ReportRegisterPressure, // bool
+        SpecializeConstant,     // stringValue0: constant name or constant_id; stringValue1: value
+        DisableTypeLayoutCache, // bool
+        ModuleLoadThreadCount,  // int, threads used to read the precompiled modules imported by a
+                                // precompiled module
         CountOf,
     };
 
@@ -3377,6 +3395,12 @@ struct ShaderReflection
     {
         return spReflection_ToJson((SlangReflection*)this, nullptr, outBlob);
     }
+
+    /// Get the layout reflection as a binary reflection blob (see `slang-reflection-blob.h`)
+    SlangResult toBinary(ISlangBlob** outBlob)
+    {
+        return spReflection_ToBinary((SlangReflection*)this, outBlob);
+    }
 };
 
 
@@ -3520,6 +3544,8 @@ struct IModule;
 struct SessionDesc;
 struct SpecializationArg;
 struct TargetDesc;
+struct BatchCompileRequest;
+struct BatchCompileResult;
 
 enum class BuiltinModuleName
 {
@@ -3834,7 +3860,13 @@ struct TargetDesc
 typedef uint32_t SessionFlags;
 enum
 {
-    kSessionFlags_None = 0
+    kSessionFlags_None = 0,
+
+    /** Load files through a file cache that is owned by the global session, and shared by all
+    sessions created with this flag. Cached contents are revalidated against the file size and
+    modification time on each access. Ignored if `SessionDesc::fileSystem` is set.
+    */
+    kSessionFlags_UseSharedFileCache = 1 << 0,
 };
 
 struct PreprocessorMacroDesc
@@ -4083,6 +4115,29 @@ struct ISession : public ISlangUnknown
         const char* path,
         const char* string,
         slang::IBlob** outDiagnostics = nullptr) = 0;
+
+    /** Compile many entry points, each with its own specialization arguments and target.
+
+    This is equivalent to calling `findAndCheckEntryPoint`, `createCompositeComponentType`,
+    `specialize`, `link` and `getEntryPointCode` for each request in turn, except that the
+    work that requests have in common is only done once. Requests for the same entry point
+    share the checked entry point, requests that also have the same specialization arguments
+    share the linked program, and requests that also have the same target share the code.
+
+    Where the code for a target is compiled by a downstream compiler, such as a C++ compiler or
+    glslang, the downstream compiles of different requests are run on multiple threads. DXC and
+    FXC compiles are run one at a time, as they read `#include`d files through the session.
+
+    `outResults` must have room for `requestCount` results. The result for each request holds
+    references to its code and diagnostics blobs (either can be null), that the caller must
+    release.
+
+    Returns SLANG_OK if every request succeeded, and SLANG_FAIL if any failed.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compileBatch(
+        BatchCompileRequest const* requests,
+        SlangInt requestCount,
+        BatchCompileResult* outResults) = 0;
 };
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
@@ -4460,6 +4515,43 @@ struct SpecializationArg
         return rs;
     }
 };
+
+/** A request to compile one entry point with `ISession::compileBatch`.
+ */
+struct BatchCompileRequest
+{
+    /** The module that defines the entry point. */
+    IModule* module = nullptr;
+
+    /** The name of the entry point function. */
+    const char* entryPointName = nullptr;
+
+    /** The stage to compile the entry point for, or `SLANG_STAGE_NONE` to use the stage given
+     * by its `[shader(...)]` attribute. */
+    SlangStage stage = SLANG_STAGE_NONE;
+
+    /** Arguments for the specialization parameters of the module and the entry point, in that
+     * order. */
+    SpecializationArg const* specializationArgs = nullptr;
+    SlangInt specializationArgCount = 0;
+
+    /** The index of the session target to generate code for. */
+    SlangInt targetIndex = 0;
+};
+
+/** The result of one request to `ISession::compileBatch`.
+ */
+struct BatchCompileResult
+{
+    /** The result of compiling the request. */
+    SlangResult result = SLANG_OK;
+
+    /** The code for the entry point, or null if it failed. */
+    IBlob* code = nullptr;
+
+    /** Any diagnostics produced for the request, or null if there were none. */
+    IBlob* diagnostics = nullptr;
+};
 } // namespace slang
 
     // Passed into functions to create globalSession to identify the API version client code is
@@ -319,4 +319,26 @@ public:
 #define SLANG_UNROLL
 #endif
 
+// Precedes the loop over a block of lanes of a compute thread group (see `-cpu-simd-width`).
+// It is only a hint to vectorize the loop. It makes no claim that the iterations are independent,
+// so the compiler still has to prove that before it runs them as SIMD lanes.
+#ifndef SLANG_VECTORIZE_LANES
+#if SLANG_CLANG
+#define SLANG_VECTORIZE_LANES _Pragma("clang loop vectorize(enable)")
+#else
+#define SLANG_VECTORIZE_LANES
+#endif
+#endif
+
+// Used on the entry point workhorse function, so that it is inlined into the loop over lanes
+#ifndef SLANG_LANE_INLINE
+#if SLANG_GCC_FAMILY
+#define SLANG_LANE_INLINE inline __attribute__((always_inline))
+#elif SLANG_VC
+#define SLANG_LANE_INLINE __forceinline
+#else
+#define SLANG_LANE_INLINE inline
+#endif
+#endif
+
 #endif
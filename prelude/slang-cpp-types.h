@@ -1339,6 +1339,16 @@ struct ComputeThreadVaryingInput
     uint3 groupThreadID;
 };
 
+/* Used in place of ComputeThreadVaryingInput inside the generated code of a module that
+synchronizes the threads of a group with barriers. It is never passed across the host interface,
+which only ever takes ComputeThreadVaryingInput. */
+struct ComputeGroupThreadVaryingInput
+{
+    uint3 groupID;
+    uint3 groupThreadID;
+    void* group; ///< The thread group being run, used by barriers. Can be nullptr.
+};
+
 struct ComputeVaryingInput
 {
     uint3 startGroupID; ///< start groupID
@@ -1357,6 +1367,358 @@ typedef void (*ComputeFunc)(
     void* uniformEntryPointParams,
     void* uniformState);
 
+/* Thread groups with barriers
+
+If a kernel synchronizes the threads of a group with barriers, each thread of the group runs on
+its own fiber (a stack the thread can be suspended on) on the calling OS thread. A barrier
+suspends the thread, and resumes the next thread of the group that hasn't finished. So all of
+the threads reach a barrier before any of them continues past it.
+
+Each fiber has a stack of SLANG_PRELUDE_FIBER_STACK_SIZE bytes, which can be overridden by defining
+it before including the prelude. Where the stacks can be mapped, each one is preceded by an
+inaccessible guard page, so a thread that overflows its stack faults rather than overwriting the
+stack of another thread. The pages of a mapped stack are only committed once they are used, so a
+large group only costs the stack it actually uses. Otherwise a marker at the bottom of each stack
+is checked whenever its thread is suspended.
+
+Fibers are only implemented for x86-64, with the Win32 fiber API on Windows and with a small
+assembly context switch for GCC compatible compilers (including slang-llvm) elsewhere. On any
+other platform a kernel with barriers fails to compile. */
+
+#ifndef SLANG_PRELUDE_FIBER_STACK_SIZE
+#define SLANG_PRELUDE_FIBER_STACK_SIZE (64 * 1024)
+#endif
+
+#if defined(_WIN32) && (defined(_M_X64) || defined(__x86_64__))
+#define SLANG_PRELUDE_FIBERS_WIN32 1
+#elif defined(__x86_64__) && defined(__GNUC__) && !defined(_WIN32)
+#define SLANG_PRELUDE_FIBERS_ASM 1
+#endif
+
+struct ComputeGroupFiber
+{
+    void* context; ///< The saved stack pointer, or the fiber on Windows
+    ComputeGroupThreadVaryingInput input;
+    bool isFinished;
+};
+
+struct ComputeGroupFibers
+{
+    ComputeGroupFiber* fibers;
+    uint32_t fiberCount;
+    uint32_t current;      ///< Index of the fiber that is running
+    void* mainContext;     ///< The context of the caller of `_slang_runGroupFibers`
+    void* stacks;          ///< Memory for the stacks of the fibers, if allocated by the prelude
+    size_t stackStride;    ///< Distance between the bottoms of consecutive stacks
+    bool isMainConverted;  ///< True if the calling thread was converted to a fiber (Windows)
+    void (*threadFunc)(void* threadContext, ComputeGroupThreadVaryingInput* input);
+    void* threadContext;
+};
+
+#if SLANG_PRELUDE_FIBERS_WIN32
+
+#ifndef _WINDOWS_
+extern "C"
+{
+    __declspec(dllimport) void* __stdcall ConvertThreadToFiber(void* parameter);
+    __declspec(dllimport) int __stdcall ConvertFiberToThread();
+    __declspec(dllimport) int __stdcall IsThreadAFiber();
+    __declspec(dllimport) void* __stdcall CreateFiber(
+        size_t stackSize,
+        void(__stdcall* startAddress)(void*),
+        void* parameter);
+    __declspec(dllimport) void __stdcall DeleteFiber(void* fiber);
+    __declspec(dllimport) void __stdcall SwitchToFiber(void* fiber);
+    unsigned __int64 __readgsqword(unsigned long offset);
+}
+#endif
+
+inline void _slang_switchFiber(void** outContext, void* context)
+{
+    (void)outContext;
+    SwitchToFiber(context);
+}
+
+#elif SLANG_PRELUDE_FIBERS_ASM
+
+#ifdef SLANG_LLVM
+extern "C" void* malloc(size_t size);
+extern "C" void free(void* ptr);
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#define SLANG_PRELUDE_FIBER_GUARD_PAGES 1
+#endif
+
+// Written at the bottom of each stack that doesn't have a guard page
+#define SLANG_PRELUDE_FIBER_STACK_MARKER 0x5354434B534C4E47ull
+
+// Saves the callee-saved registers of the running fiber on its stack, stores its stack pointer
+// in `*outSp`, and resumes the fiber with the stack pointer `sp`.
+extern "C" void slang_prelude_fiberSwitch(void** outSp, void* sp);
+// The first code run on the stack of a new fiber. Calls the function in the saved register that
+// holds the function, with the parameter in the saved register that holds the parameter.
+extern "C" void slang_prelude_fiberStart();
+
+#ifdef __APPLE__
+#define SLANG_PRELUDE_FIBER_SYMBOL(NAME) "_" #NAME
+#else
+#define SLANG_PRELUDE_FIBER_SYMBOL(NAME) #NAME
+#endif
+
+// Also saves the SSE control/status and x87 control words, which are callee-saved
+__asm__(".text\n"
+        ".p2align 4\n" SLANG_PRELUDE_FIBER_SYMBOL(slang_prelude_fiberSwitch) ":\n"
+        "    pushq %rbp\n"
+        "    pushq %rbx\n"
+        "    pushq %r12\n"
+        "    pushq %r13\n"
+        "    pushq %r14\n"
+        "    pushq %r15\n"
+        "    subq $8, %rsp\n"
+        "    stmxcsr (%rsp)\n"
+        "    fnstcw 4(%rsp)\n"
+        "    movq %rsp, (%rdi)\n"
+        "    movq %rsi, %rsp\n"
+        "    ldmxcsr (%rsp)\n"
+        "    fldcw 4(%rsp)\n"
+        "    addq $8, %rsp\n"
+        "    popq %r15\n"
+        "    popq %r14\n"
+        "    popq %r13\n"
+        "    popq %r12\n"
+        "    popq %rbx\n"
+        "    popq %rbp\n"
+        "    ret\n"
+        ".p2align 4\n" SLANG_PRELUDE_FIBER_SYMBOL(slang_prelude_fiberStart) ":\n"
+        "    movq %r12, %rdi\n"
+        "    callq *%r13\n"
+        "    ud2\n");
+
+inline void* _slang_initFiberStack(unsigned char* top, void (*func)(void*), void* param)
+{
+    // The frame popped by `slang_prelude_fiberSwitch`, that 'returns' to the start code
+    uint64_t* frame = (uint64_t*)(top - 64);
+    frame[0] = 0x1F80 | (uint64_t(0x037F) << 32); // Default MXCSR and x87 control word
+    frame[1] = 0;                                  // r15
+    frame[2] = 0;                                  // r14
+    frame[3] = uint64_t(func);                     // r13
+    frame[4] = uint64_t(param);                    // r12
+    frame[5] = 0;                                  // rbx
+    frame[6] = 0;                                  // rbp
+    frame[7] = uint64_t(&slang_prelude_fiberStart);
+    return frame;
+}
+
+inline void _slang_switchFiber(void** outContext, void* context)
+{
+    slang_prelude_fiberSwitch(outContext, context);
+}
+
+#endif // SLANG_PRELUDE_FIBERS_ASM
+
+#if SLANG_PRELUDE_FIBERS_WIN32 || SLANG_PRELUDE_FIBERS_ASM
+
+// Switches from the running fiber to the next one that hasn't finished, or back to the caller of
+// `_slang_runGroupFibers` when all of them have.
+inline void _slang_switchToNextFiber(ComputeGroupFibers* group)
+{
+    const uint32_t from = group->current;
+#if SLANG_PRELUDE_FIBERS_ASM && !SLANG_PRELUDE_FIBER_GUARD_PAGES
+    // The thread overflowed its stack
+    const unsigned char* bottom = (const unsigned char*)group->stacks + group->stackStride * from;
+    if (*(const uint64_t*)bottom != SLANG_PRELUDE_FIBER_STACK_MARKER)
+    {
+        __builtin_trap();
+    }
+#endif
+    for (uint32_t i = 1; i <= group->fiberCount; ++i)
+    {
+        const uint32_t next = (from + i) % group->fiberCount;
+        if (!group->fibers[next].isFinished)
+        {
+            // If it's the only thread left, there is nothing to wait for
+            if (next != from)
+            {
+                group->current = next;
+                _slang_switchFiber(&group->fibers[from].context, group->fibers[next].context);
+            }
+            return;
+        }
+    }
+    _slang_switchFiber(&group->fibers[from].context, group->mainContext);
+}
+
+inline void _slang_runFiber(void* param)
+{
+    ComputeGroupFibers* group = (ComputeGroupFibers*)param;
+    ComputeGroupFiber* fiber = &group->fibers[group->current];
+    group->threadFunc(group->threadContext, &fiber->input);
+    fiber->isFinished = true;
+    _slang_switchToNextFiber(group);
+}
+
+#if SLANG_PRELUDE_FIBERS_WIN32
+inline void __stdcall _slang_runFiberWin32(void* param)
+{
+    _slang_runFiber(param);
+}
+#endif
+
+inline void _slang_createGroupFibers(ComputeGroupFibers* group)
+{
+    const size_t stackSize = SLANG_PRELUDE_FIBER_STACK_SIZE;
+#if SLANG_PRELUDE_FIBERS_WIN32
+    // The caller has to be a fiber to switch to the fibers of the group
+    group->isMainConverted = !IsThreadAFiber();
+    group->mainContext = group->isMainConverted ? ConvertThreadToFiber(nullptr)
+                                                : (void*)__readgsqword(0x20);
+    group->stacks = nullptr;
+    for (uint32_t i = 0; i < group->fiberCount; ++i)
+    {
+        group->fibers[i].context = CreateFiber(stackSize, &_slang_runFiberWin32, group);
+    }
+#else
+    group->isMainConverted = false;
+    group->mainContext = nullptr;
+#if SLANG_PRELUDE_FIBER_GUARD_PAGES
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    group->stackStride = pageSize + (stackSize + pageSize - 1) / pageSize * pageSize;
+    group->stacks = mmap(
+        nullptr,
+        group->stackStride * group->fiberCount,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (group->stacks == MAP_FAILED)
+    {
+        __builtin_trap();
+    }
+    for (uint32_t i = 0; i < group->fiberCount; ++i)
+    {
+        unsigned char* bottom = (unsigned char*)group->stacks + group->stackStride * i;
+        mprotect(bottom, pageSize, PROT_NONE);
+        group->fibers[i].context =
+            _slang_initFiberStack(bottom + group->stackStride, &_slang_runFiber, group);
+    }
+#else
+    group->stackStride = stackSize;
+    group->stacks = malloc(stackSize * group->fiberCount);
+    if (!group->stacks)
+    {
+        __builtin_trap();
+    }
+    for (uint32_t i = 0; i < group->fiberCount; ++i)
+    {
+        unsigned char* bottom = (unsigned char*)group->stacks + stackSize * i;
+        *(uint64_t*)bottom = SLANG_PRELUDE_FIBER_STACK_MARKER;
+        group->fibers[i].context =
+            _slang_initFiberStack(bottom + stackSize, &_slang_runFiber, group);
+    }
+#endif
+#endif
+}
+
+inline void _slang_destroyGroupFibers(ComputeGroupFibers* group)
+{
+#if SLANG_PRELUDE_FIBERS_WIN32
+    for (uint32_t i = 0; i < group->fiberCount; ++i)
+    {
+        DeleteFiber(group->fibers[i].context);
+    }
+    if (group->isMainConverted)
+    {
+        ConvertFiberToThread();
+    }
+#elif SLANG_PRELUDE_FIBER_GUARD_PAGES
+    munmap(group->stacks, group->stackStride * group->fiberCount);
+#else
+    free(group->stacks);
+#endif
+}
+
+/* Called by barriers. Waits until all of the threads of the group have called it. */
+inline void _slang_groupSync(void* group)
+{
+    // Threads run on their own have nothing to wait for
+    if (group)
+    {
+        _slang_switchToNextFiber((ComputeGroupFibers*)group);
+    }
+}
+
+/* Runs all of the threads of the group `groupInput.groupID`, calling `func` with the varying input
+of each thread. */
+template<typename F>
+void _slang_runGroupFibers(
+    const ComputeGroupThreadVaryingInput& groupInput,
+    uint32_t sizeX,
+    uint32_t sizeY,
+    uint32_t sizeZ,
+    const F& func)
+{
+    struct Thunk
+    {
+        static void call(void* threadContext, ComputeGroupThreadVaryingInput* input)
+        {
+            (*(const F*)threadContext)(input);
+        }
+    };
+
+    ComputeGroupFibers group;
+    group.fiberCount = sizeX * sizeY * sizeZ;
+    group.fibers = (ComputeGroupFiber*)malloc(sizeof(ComputeGroupFiber) * group.fiberCount);
+    group.current = 0;
+    group.threadFunc = &Thunk::call;
+    group.threadContext = (void*)&func;
+
+    uint32_t index = 0;
+    for (uint32_t z = 0; z < sizeZ; ++z)
+    {
+        for (uint32_t y = 0; y < sizeY; ++y)
+        {
+            for (uint32_t x = 0; x < sizeX; ++x)
+            {
+                ComputeGroupFiber& fiber = group.fibers[index++];
+                fiber.input = groupInput;
+                fiber.input.groupThreadID.x = x;
+                fiber.input.groupThreadID.y = y;
+                fiber.input.groupThreadID.z = z;
+                fiber.input.group = &group;
+                fiber.isFinished = false;
+            }
+        }
+    }
+
+    _slang_createGroupFibers(&group);
+    // Returns when all of the threads have finished
+    _slang_switchFiber(&group.mainContext, group.fibers[0].context);
+    _slang_destroyGroupFibers(&group);
+
+    free(group.fibers);
+}
+
+#else // SLANG_PRELUDE_FIBERS_WIN32 || SLANG_PRELUDE_FIBERS_ASM
+
+inline void _slang_groupSync(void* group)
+{
+    (void)group;
+}
+
+template<typename F>
+void _slang_runGroupFibers(
+    const ComputeGroupThreadVaryingInput& groupInput,
+    uint32_t sizeX,
+    uint32_t sizeY,
+    uint32_t sizeZ,
+    const F& func)
+{
+    static_assert(sizeof(F) == 0, "Barriers in CPU kernels are not supported on this platform");
+}
+
+#endif // SLANG_PRELUDE_FIBERS_WIN32 || SLANG_PRELUDE_FIBERS_ASM
+
 #ifdef SLANG_PRELUDE_NAMESPACE
 }
 #endif
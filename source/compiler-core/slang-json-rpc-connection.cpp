@@ -12,7 +12,7 @@ namespace Slang
 
 /// Ctor
 JSONRPCConnection::JSONRPCConnection()
-    : m_container(nullptr), m_typeMap(JSONNativeUtil::getTypeFuncsMap())
+    : m_container(nullptr), m_builder(&m_container), m_typeMap(JSONNativeUtil::getTypeFuncsMap())
 {
 }
 
@@ -291,17 +291,23 @@ SlangResult JSONRPCConnection::tryReadMessage()
         return SLANG_OK;
     }
 
-    auto content = m_connection->getContent();
-    UnownedStringSlice slice((const char*)content.begin(), content.getCount());
-
     clearBuffers();
 
     {
-        const SlangResult res =
-            JSONRPCUtil::parseJSON(slice, &m_container, &m_diagnosticSink, m_jsonRoot);
+        // Copy the content out of the read stream, so the packet can be consumed. The copy is zero
+        // terminated as the lexer requires, and is parsed in place.
+        auto content = m_connection->getContent();
+        const Index contentCount = content.getCount();
+
+        m_messageBuffer.setCount(contentCount + 1);
+        ::memcpy(m_messageBuffer.getBuffer(), content.begin(), contentCount);
+        m_messageBuffer[contentCount] = 0;
 
         // Consume that content/packet
         m_connection->consumeContent();
+
+        const SlangResult res =
+            _parseMessage(UnownedStringSlice(m_messageBuffer.getBuffer(), contentCount));
         if (SLANG_FAILED(res))
         {
             // if we can't parse JSON, we return with id of 'null' as per the standard
@@ -312,6 +318,41 @@ SlangResult JSONRPCConnection::tryReadMessage()
     return SLANG_OK;
 }
 
+SlangResult JSONRPCConnection::_parseMessage(const UnownedStringSlice& text)
+{
+    // JSON-RPC content is UTF-8, so normally the text can be used without decoding.
+    // If it looks like some other encoding (it has a 0 byte, or a UTF-16 byte order mark),
+    // use the general path which will decode it.
+    UnownedStringSlice utf8Text = text;
+    if (utf8Text.startsWith(UnownedStringSlice::fromLiteral("\xef\xbb\xbf")))
+    {
+        utf8Text = utf8Text.tail(3);
+    }
+    if (::memchr(utf8Text.begin(), 0, utf8Text.getLength()) ||
+        (utf8Text.getLength() >= 2 && (Byte(utf8Text[0]) == 0xfe || Byte(utf8Text[0]) == 0xff)))
+    {
+        return JSONRPCUtil::parseJSON(text, &m_container, &m_diagnosticSink, m_jsonRoot);
+    }
+
+    SourceFile* sourceFile =
+        m_sourceManager.createSourceFileWithSize(PathInfo::makeUnknown(), utf8Text.getLength());
+    sourceFile->setUnownedContents(utf8Text);
+    SourceView* sourceView = m_sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONLexer lexer;
+    lexer.init(sourceView, &m_diagnosticSink);
+
+    // String values are held as lexemes referencing the text, and are only unescaped when they
+    // are converted
+    m_builder.reset();
+
+    JSONParser parser;
+    SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &m_builder, &m_diagnosticSink));
+
+    m_jsonRoot = m_builder.getRootValue();
+    return SLANG_OK;
+}
+
 JSONRPCMessageType JSONRPCConnection::getMessageType()
 {
     return JSONRPCUtil::getMessageType(&m_container, m_jsonRoot);
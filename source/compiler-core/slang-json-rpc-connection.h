@@ -227,6 +227,9 @@ public:
     JSONRPCConnection();
 
 protected:
+    /// Parse the message held in m_messageBuffer into m_jsonRoot
+    SlangResult _parseMessage(const UnownedStringSlice& text);
+
     CallStyle _getCallStyle(CallStyle callStyle) const
     {
         return (callStyle == CallStyle::Default) ? m_defaultCallStyle : callStyle;
@@ -244,6 +247,10 @@ protected:
     JSONContainer m_container; ///< Holds the backing memory for jsonMemory, and used when
                                ///< converting input into output JSON
 
+    JSONBuilder m_builder; ///< Builds m_jsonRoot. Kept to reuse its buffers between messages.
+    List<char> m_messageBuffer; ///< The text of the current message. Lexemes in m_jsonRoot point
+                                ///< into it, so it's only changed when the next message is read.
+
     JSONValue m_jsonRoot; ///< The root JSON value for the currently read message.
 
     CallStyle m_defaultCallStyle = CallStyle::Array; ///< The default calling style
@@ -1495,10 +1495,19 @@ void JSONBuilder::endArray(SourceLoc loc)
 
 void JSONBuilder::addQuotedKey(const UnownedStringSlice& key, SourceLoc loc)
 {
+    StringEscapeHandler* handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+    const UnownedStringSlice unquoted = StringEscapeUtil::unquote(handler, key);
+
+    // Keys rarely contain escapes, in which case the text can be used as is
+    if (!handler->isUnescapingNeeeded(unquoted))
+    {
+        addUnquotedKey(unquoted, loc);
+        return;
+    }
+
     // We need to decode
     m_work.clear();
-    StringEscapeHandler* handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
-    StringEscapeUtil::appendUnquoted(handler, key, m_work);
+    handler->appendUnescaped(unquoted, m_work);
     addUnquotedKey(m_work.getUnownedSlice(), loc);
 }
 
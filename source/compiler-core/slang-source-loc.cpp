@@ -645,6 +645,15 @@ void SourceFile::setContents(const String& content)
     setContents(contentBlob);
 }
 
+void SourceFile::setUnownedContents(const UnownedStringSlice& content)
+{
+    SLANG_ASSERT(size_t(content.getLength()) == m_contentSize);
+    SLANG_ASSERT(*content.end() == 0);
+
+    m_contentBlob = UnownedRawBlob::create(content.begin(), content.getLength());
+    m_content = content;
+}
+
 SourceFile::SourceFile(SourceManager* sourceManager, const PathInfo& pathInfo, size_t contentSize)
     : m_sourceManager(sourceManager), m_pathInfo(pathInfo), m_contentSize(contentSize)
 {
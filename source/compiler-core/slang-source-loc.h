@@ -307,6 +307,10 @@ public:
     void setContents(ISlangBlob* blob);
     /// Set the content as a string
     void setContents(const String& content);
+    /// Set the content to text that is held elsewhere, without copying or decoding it.
+    /// The text must be UTF-8, be followed by a 0 byte, and stay unchanged for the lifetime of the
+    /// file.
+    void setUnownedContents(const UnownedStringSlice& content);
 
     /// Calculate a display path -> can canonicalize if necessary
     String calcVerbosePath() const;
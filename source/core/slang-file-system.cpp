@@ -113,7 +113,7 @@ void* OSFileSystem::getObject(const Guid& guid)
     return nullptr;
 }
 
-static String _fixPathDelimiters(const char* pathIn)
+/* static */ String OSFileSystem::fixPathDelimiters(const char* pathIn)
 {
 #if SLANG_WINDOWS_FAMILY
     return pathIn;
@@ -152,7 +152,7 @@ SlangResult OSFileSystem::getPath(PathKind pathKind, const char* path, ISlangBlo
     case PathKind::Canonical:
         {
             String canonicalPath;
-            SLANG_RETURN_ON_FAIL(Path::getCanonical(_fixPathDelimiters(path), canonicalPath));
+            SLANG_RETURN_ON_FAIL(Path::getCanonical(fixPathDelimiters(path), canonicalPath));
             *outPath = StringUtil::createStringBlob(canonicalPath).detach();
             return SLANG_OK;
         }
@@ -183,7 +183,7 @@ SlangResult SLANG_MCALL OSFileSystem::getPathType(const char* pathIn, SlangPathT
 {
     SLANG_RETURN_ON_FAIL(_checkExt(m_style));
 
-    return Path::getPathType(_fixPathDelimiters(pathIn), pathTypeOut);
+    return Path::getPathType(fixPathDelimiters(pathIn), pathTypeOut);
 }
 
 
@@ -196,7 +196,7 @@ SlangResult OSFileSystem::loadFile(char const* pathIn, ISlangBlob** outBlob)
     // a user could create a build of Slang that doesn't include any OS
     // filesystem calls.
 
-    const String path = _fixPathDelimiters(pathIn);
+    const String path = fixPathDelimiters(pathIn);
     if (!File::exists(path))
     {
         return SLANG_E_NOT_FOUND;
@@ -256,7 +256,7 @@ SlangResult OSFileSystem::enumeratePathContents(
 SlangResult OSFileSystem::saveFile(const char* pathIn, const void* data, size_t size)
 {
     SLANG_RETURN_ON_FAIL(_checkMutable(m_style));
-    const String path = _fixPathDelimiters(pathIn);
+    const String path = fixPathDelimiters(pathIn);
     FileStream stream;
     SLANG_RETURN_ON_FAIL(
         stream.init(pathIn, FileMode::Create, FileAccess::Write, FileShare::ReadWrite));
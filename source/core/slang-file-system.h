@@ -70,6 +70,9 @@ public:
     static ISlangFileSystemExt* getExtSingleton() { return &g_ext; }
     static ISlangMutableFileSystem* getMutableSingleton() { return &g_mutable; }
 
+    /// Converts windows style \ delimiters in path to the standard delimiter on other platforms
+    static String fixPathDelimiters(const char* path);
+
 private:
     /// Make so not constructible
     OSFileSystem(FileSystemStyle style)
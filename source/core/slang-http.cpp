@@ -255,7 +255,16 @@ SlangResult HTTPPacketConnection::update()
         break;
     }
 
-    SLANG_RETURN_ON_FAIL(_updateReadResult(m_readStream->update()));
+    // If we know how large the content is, read the rest of it in one go
+    size_t readSize = 0;
+    if (m_readState == ReadState::Content)
+    {
+        const size_t contentLength = m_readHeader.m_contentLength;
+        const size_t count = m_readStream->getCount();
+        readSize = (contentLength > count) ? contentLength - count : 0;
+    }
+
+    SLANG_RETURN_ON_FAIL(_updateReadResult(m_readStream->update(readSize)));
 
     // Note will only indicate end if the buffer *and* backing stream are end/empty
     if (m_readStream->isEnd())
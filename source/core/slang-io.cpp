@@ -194,6 +194,53 @@ bool File::exists(const String& fileName)
 #endif
 }
 
+/* static */ SlangResult File::getInfo(const String& fileName, Info& outInfo)
+{
+#ifdef _WIN32
+    // `_stat64` only gives the modification time in whole seconds, so an edit made in the same
+    // second as an earlier read couldn't be told apart. The attributes have 100ns resolution.
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!::GetFileAttributesExW(fileName.toWString(), GetFileExInfoStandard, &data))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        outInfo.pathType = SLANG_PATH_TYPE_DIRECTORY;
+    else if (data.dwFileAttributes & FILE_ATTRIBUTE_DEVICE)
+        return SLANG_FAIL;
+    else
+        outInfo.pathType = SLANG_PATH_TYPE_FILE;
+    outInfo.size = (uint64_t(data.nFileSizeHigh) << 32) | uint64_t(data.nFileSizeLow);
+    const uint64_t writeTime = (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                               uint64_t(data.ftLastWriteTime.dwLowDateTime);
+    outInfo.modificationTime = writeTime * 100;
+    return SLANG_OK;
+#else
+    struct stat statVar;
+    if (::stat(fileName.getBuffer(), &statVar) != 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    if (S_ISDIR(statVar.st_mode))
+        outInfo.pathType = SLANG_PATH_TYPE_DIRECTORY;
+    else if (S_ISREG(statVar.st_mode))
+        outInfo.pathType = SLANG_PATH_TYPE_FILE;
+    else
+        return SLANG_FAIL;
+    outInfo.size = uint64_t(statVar.st_size);
+#if SLANG_APPLE_FAMILY
+    outInfo.modificationTime = uint64_t(statVar.st_mtimespec.tv_sec) * 1000000000 +
+                               uint64_t(statVar.st_mtimespec.tv_nsec);
+#elif defined(__linux__) || defined(__CYGWIN__)
+    outInfo.modificationTime =
+        uint64_t(statVar.st_mtim.tv_sec) * 1000000000 + uint64_t(statVar.st_mtim.tv_nsec);
+#else
+    outInfo.modificationTime = uint64_t(statVar.st_mtime) * 1000000000;
+#endif
+    return SLANG_OK;
+#endif
+}
+
 String Path::replaceExt(const String& path, const char* newExt)
 {
     StringBuilder sb(path.getLength() + 10);
@@ -12,8 +12,27 @@ namespace Slang
 class File
 {
 public:
+    /// Describes the state of a file on disk, such that a change to the file can be detected.
+    struct Info
+    {
+        SlangPathType pathType = SLANG_PATH_TYPE_FILE;
+        uint64_t size = 0;             ///< Size in bytes
+        uint64_t modificationTime = 0; ///< Last modification time (in nanoseconds if available)
+
+        bool operator==(const Info& rhs) const
+        {
+            return pathType == rhs.pathType && size == rhs.size &&
+                   modificationTime == rhs.modificationTime;
+        }
+        bool operator!=(const Info& rhs) const { return !(*this == rhs); }
+    };
+
     static bool exists(const String& fileName);
 
+    /// Get the type, size and modification time of the item at fileName.
+    /// Returns SLANG_E_NOT_FOUND if there is nothing at the path.
+    static SlangResult getInfo(const String& fileName, Info& outInfo);
+
     static SlangResult readAllText(const String& fileName, String& outString);
 
     static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
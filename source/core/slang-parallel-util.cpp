@@ -0,0 +1,133 @@
+// slang-parallel-util.cpp
+
+#include "slang-parallel-util.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+// A fixed set of worker threads that run tasks in the order they were submitted
+class SharedThreadPool
+{
+public:
+    // The pool is deliberately leaked, so that its threads never see it destroyed while the
+    // process exits
+    static SharedThreadPool& get()
+    {
+        static SharedThreadPool* pool = new SharedThreadPool;
+        return *pool;
+    }
+
+    Index getThreadCount() const { return m_threadCount; }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.add(std::move(task));
+        }
+        m_condition.notify_one();
+    }
+
+private:
+    SharedThreadPool()
+    {
+        // The thread that submits the tasks is one of the threads doing the work
+        m_threadCount = Math::Max(Index(1), Index(std::thread::hardware_concurrency()) - 1);
+        for (Index i = 0; i < m_threadCount; ++i)
+        {
+            std::thread(&SharedThreadPool::_runTasks, this).detach();
+        }
+    }
+
+    void _runTasks()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [&]() { return m_tasks.getCount() != 0; });
+                task = std::move(m_tasks[0]);
+                m_tasks.removeAt(0);
+            }
+            task();
+        }
+    }
+
+    Index m_threadCount = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    List<std::function<void()>> m_tasks;
+};
+
+// What a call to runWithHelpers shares with the pool threads helping it. It is held by each
+// of the tasks submitted, which may only start after the call has returned.
+struct HelperState
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    const std::function<void()>* task = nullptr;
+    Index activeCount = 0;
+    bool isFinished = false;
+};
+
+} // namespace
+
+/* static */ Index ParallelUtil::calcThreadCount(Index jobCount, Index threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = Index(std::thread::hardware_concurrency());
+    }
+    return Math::Max(Index(1), Math::Min(threadCount, jobCount));
+}
+
+/* static */ void ParallelUtil::runWithHelpers(
+    Index helperCount,
+    const std::function<void()>& task)
+{
+    SharedThreadPool& pool = SharedThreadPool::get();
+    helperCount = Math::Min(helperCount, pool.getThreadCount());
+
+    auto state = std::make_shared<HelperState>();
+    state->task = &task;
+
+    for (Index i = 0; i < helperCount; ++i)
+    {
+        pool.submit(
+            [state]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (state->isFinished)
+                        return;
+                    state->activeCount++;
+                }
+
+                (*state->task)();
+
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->activeCount--;
+                }
+                state->condition.notify_all();
+            });
+    }
+
+    task();
+
+    // Wait for the helpers that started, and stop any others from starting
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->isFinished = true;
+    state->condition.wait(lock, [&]() { return state->activeCount == 0; });
+}
+
+} // namespace Slang
@@ -0,0 +1,52 @@
+#ifndef SLANG_PARALLEL_UTIL_H
+#define SLANG_PARALLEL_UTIL_H
+
+#include "slang-basic.h"
+
+#include <atomic>
+#include <functional>
+
+namespace Slang
+{
+
+struct ParallelUtil
+{
+    /// Get the number of threads to use for jobCount jobs, when up to threadCount threads were
+    /// asked for. If threadCount is <= 0, a thread is used for each hardware thread.
+    static Index calcThreadCount(Index jobCount, Index threadCount);
+
+    /// Runs job(i) for each i in [0, jobCount) on up to threadCount threads, including the
+    /// calling thread. Each thread takes the next index that hasn't been started, until there are
+    /// none left. If threadCount is <= 0, a thread is used for each hardware thread.
+    ///
+    /// The other threads come from a pool that is shared by the process, so no threads are
+    /// started for each call, and the number of threads in use is bounded however many calls
+    /// are made at the same time.
+    template<typename F>
+    static void forEach(Index jobCount, Index threadCount, F const& job)
+    {
+        std::atomic<Index> nextJob(0);
+        auto runJobs = [&]()
+        {
+            for (Index i = nextJob++; i < jobCount; i = nextJob++)
+                job(i);
+        };
+
+        const Index usedThreadCount = calcThreadCount(jobCount, threadCount);
+        if (usedThreadCount <= 1)
+        {
+            runJobs();
+            return;
+        }
+        runWithHelpers(usedThreadCount - 1, runJobs);
+    }
+
+    /// Runs task on the calling thread, and on up to helperCount threads of the shared pool.
+    /// Returns when all of the runs of task have finished. Pool threads that are only free
+    /// after the calling thread has finished don't run task.
+    static void runWithHelpers(Index helperCount, const std::function<void()>& task);
+};
+
+} // namespace Slang
+
+#endif
@@ -1,7 +1,11 @@
 #include "slang-riff.h"
 
 #include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang-deflate-compression-system.h"
 #include "slang-hex-dump-util.h"
+#include "slang-lz4-compression-system.h"
+#include "slang-parallel-util.h"
 
 namespace Slang
 {
@@ -168,7 +172,8 @@ struct DumpVisitor : public RiffContainer::Visitor
         _dumpRiffType(data->m_fourCC);
         m_writer.put(" ");
 
-        const RiffHashCode hash = data->calcHash();
+        RiffHashCode hash;
+        SLANG_RETURN_ON_FAIL(data->calcHash(hash));
 
         // We don't know in general what the contents is or means... but we can display a hash
         HexDumpUtil::dump(uint32_t(hash), m_writer.getWriter());
@@ -222,6 +227,24 @@ struct DumpVisitor : public RiffContainer::Visitor
     chunk->visit(&visitor);
 }
 
+// The size of the payload of a chunk when written, where data chunks with a frame are written as
+// the frame.
+static size_t _calcWrittenPayloadSize(RiffContainer::Chunk* chunk)
+{
+    if (auto dataChunk = as<RiffContainer::DataChunk>(chunk))
+    {
+        return dataChunk->m_frame ? dataChunk->m_frame->getSize() : dataChunk->m_payloadSize;
+    }
+
+    auto list = static_cast<RiffContainer::ListChunk*>(chunk);
+    size_t size = sizeof(RiffListHeader) - sizeof(RiffHeader);
+    for (auto child = list->m_containedChunks; child; child = child->m_next)
+    {
+        size += RiffUtil::getPadSize(_calcWrittenPayloadSize(child) + sizeof(RiffHeader));
+    }
+    return size;
+}
+
 /* static */ SlangResult RiffUtil::write(
     RiffContainer::ListChunk* list,
     bool isRoot,
@@ -230,7 +253,7 @@ struct DumpVisitor : public RiffContainer::Visitor
     RiffListHeader listHeader;
 
     listHeader.chunk.type = isRoot ? RiffFourCC::kRiff : RiffFourCC::kList;
-    listHeader.chunk.size = uint32_t(list->m_payloadSize);
+    listHeader.chunk.size = uint32_t(_calcWrittenPayloadSize(list));
     listHeader.subType = list->getSubType();
 
     // Write the header
@@ -253,14 +276,18 @@ struct DumpVisitor : public RiffContainer::Visitor
             {
                 auto dataChunk = static_cast<DataChunk*>(chunk);
 
+                // If there is a frame, it's written in place of the payload
+                RiffContainer::Data* frame = dataChunk->m_frame;
+                const size_t payloadSize = frame ? frame->getSize() : dataChunk->m_payloadSize;
+
                 // Must be a regular chunk with data
                 RiffHeader chunkHeader;
-                chunkHeader.type = dataChunk->m_fourCC;
-                chunkHeader.size = uint32_t(dataChunk->m_payloadSize);
+                chunkHeader.type = frame ? RiffFourCC::kFrame : dataChunk->m_fourCC;
+                chunkHeader.size = uint32_t(payloadSize);
 
                 SLANG_RETURN_ON_FAIL(stream->write(&chunkHeader, sizeof(chunkHeader)));
 
-                RiffContainer::Data* data = dataChunk->m_dataList;
+                RiffContainer::Data* data = frame ? frame : dataChunk->m_dataList;
                 while (data)
                 {
                     SLANG_RETURN_ON_FAIL(stream->write(data->getPayload(), data->getSize()));
@@ -270,8 +297,7 @@ struct DumpVisitor : public RiffContainer::Visitor
                 }
 
                 // Need to write for alignment
-                const size_t remainingSize =
-                    getPadSize(dataChunk->m_payloadSize) - dataChunk->m_payloadSize;
+                const size_t remainingSize = getPadSize(payloadSize) - payloadSize;
 
                 if (remainingSize)
                 {
@@ -295,6 +321,50 @@ struct DumpVisitor : public RiffContainer::Visitor
     return write(container->getRoot(), true, stream);
 }
 
+// Reads a frame chunk as a data chunk of the type it was made from. Space is allocated for the
+// payload, but it's only decompressed from the frame when it's accessed.
+static SlangResult _readFrame(Stream* stream, size_t frameSize, RiffContainer& ioContainer)
+{
+    if (frameSize < sizeof(RiffFrameHeader))
+    {
+        return SLANG_FAIL;
+    }
+
+    MemoryArena& arena = ioContainer.getMemoryArena();
+    void* framePayload = arena.allocateAligned(frameSize, RiffContainer::kPayloadMinAlignment);
+
+    size_t readSize;
+    SLANG_RETURN_ON_FAIL(RiffUtil::readPayload(stream, frameSize, framePayload, readSize));
+
+    RiffFrameHeader frameHeader;
+    ::memcpy(&frameHeader, framePayload, sizeof(frameHeader));
+    if (RiffUtil::isListType(frameHeader.fourCC) ||
+        !RiffContainer::getCompressionSystem(
+            CompressionSystemType(frameHeader.compressionSystemType)))
+    {
+        return SLANG_FAIL;
+    }
+
+    RiffContainer::ScopeChunk scopeChunk(
+        &ioContainer,
+        RiffContainer::Chunk::Kind::Data,
+        frameHeader.fourCC);
+
+    RiffContainer::Data* data = ioContainer.addData();
+    ioContainer.setPayload(data, nullptr, frameHeader.uncompressedSize);
+
+    RiffContainer::Data* frame = (RiffContainer::Data*)arena.allocate(sizeof(RiffContainer::Data));
+    frame->init();
+    frame->m_ownership = RiffContainer::Ownership::Arena;
+    frame->m_payload = framePayload;
+    frame->m_size = frameSize;
+
+    auto dataChunk = static_cast<RiffContainer::DataChunk*>(ioContainer.getCurrentChunk());
+    dataChunk->m_frame = frame;
+    dataChunk->m_hasPendingFrame = true;
+    return SLANG_OK;
+}
+
 /* static */ SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
 {
     typedef RiffContainer::ScopeChunk ScopeChunk;
@@ -363,6 +433,13 @@ struct DumpVisitor : public RiffContainer::Visitor
                 // Start a container
                 outContainer.startChunk(Chunk::Kind::List, header.subType);
             }
+            else if (header.chunk.type == RiffFourCC::kFrame)
+            {
+                SLANG_RETURN_ON_FAIL(_readFrame(stream, header.chunk.size, outContainer));
+
+                // Correct remaining
+                remaining -= sizeof(RiffHeader) + getPadSize(header.chunk.size);
+            }
             else
             {
                 ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
@@ -570,12 +647,7 @@ RiffContainer::Data* RiffContainer::ListChunk::findContainedData(FourCC type) co
     {
         DataChunk* dataChunk = static_cast<DataChunk*>(found);
         // Assumes that there is a single data chunk
-
-        Data* data = dataChunk->m_dataList;
-        if (data && data->m_next == nullptr)
-        {
-            return data;
-        }
+        return dataChunk->getSingleData();
     }
     return nullptr;
 }
@@ -618,6 +690,10 @@ static RiffContainer::ListChunk* _findListRec(RiffContainer::ListChunk* list, Fo
 
 RiffContainer::Data* RiffContainer::DataChunk::getSingleData() const
 {
+    if (SLANG_FAILED(decompressFrame()))
+    {
+        return nullptr;
+    }
     Data* data = m_dataList;
     return (data && data->m_next == nullptr) ? data : nullptr;
 }
@@ -632,8 +708,44 @@ RiffReadHelper RiffContainer::DataChunk::asReadHelper() const
     return RiffReadHelper(nullptr, 0);
 }
 
-RiffHashCode RiffContainer::DataChunk::calcHash() const
+SlangResult RiffContainer::DataChunk::decompressFrame() const
+{
+    if (!m_hasPendingFrame)
+    {
+        return SLANG_OK;
+    }
+
+    // The space for the payload is allocated when the frame is read, as a single block
+    Data* data = m_dataList;
+    if (!data || data->m_next || m_frame->getSize() < sizeof(RiffFrameHeader))
+    {
+        return SLANG_FAIL;
+    }
+
+    RiffFrameHeader frameHeader;
+    ::memcpy(&frameHeader, m_frame->getPayload(), sizeof(frameHeader));
+
+    auto compressionSystem =
+        getCompressionSystem(CompressionSystemType(frameHeader.compressionSystemType));
+    if (!compressionSystem || frameHeader.uncompressedSize != data->getSize())
+    {
+        return SLANG_FAIL;
+    }
+
+    SLANG_RETURN_ON_FAIL(compressionSystem->decompress(
+        (const uint8_t*)m_frame->getPayload() + sizeof(RiffFrameHeader),
+        m_frame->getSize() - sizeof(RiffFrameHeader),
+        data->getSize(),
+        data->getPayload()));
+
+    m_hasPendingFrame = false;
+    return SLANG_OK;
+}
+
+SlangResult RiffContainer::DataChunk::calcHash(RiffHashCode& outHash) const
 {
+    SLANG_RETURN_ON_FAIL(decompressFrame());
+
     RiffHashCode hash = 0;
 
     Data* data = m_dataList;
@@ -652,7 +764,8 @@ RiffHashCode RiffContainer::DataChunk::calcHash() const
         data = data->m_next;
     }
 
-    return hash;
+    outHash = hash;
+    return SLANG_OK;
 }
 
 size_t RiffContainer::DataChunk::calcPayloadSize() const
@@ -667,10 +780,12 @@ size_t RiffContainer::DataChunk::calcPayloadSize() const
     return size;
 }
 
-void RiffContainer::DataChunk::getPayload(void* inDst) const
+SlangResult RiffContainer::DataChunk::getPayload(void* inDst) const
 {
     uint8_t* dst = (uint8_t*)inDst;
 
+    SLANG_RETURN_ON_FAIL(decompressFrame());
+
     Data* data = m_dataList;
     while (data)
     {
@@ -680,12 +795,18 @@ void RiffContainer::DataChunk::getPayload(void* inDst) const
         dst += size;
         data = data->m_next;
     }
+    return SLANG_OK;
 }
 
 bool RiffContainer::DataChunk::isEqual(const void* inData, size_t count) const
 {
     const uint8_t* src = (const uint8_t*)inData;
 
+    if (SLANG_FAILED(decompressFrame()))
+    {
+        return false;
+    }
+
     Data* data = m_dataList;
     while (data)
     {
@@ -935,7 +1056,10 @@ RiffContainer::Data* RiffContainer::makeSingleData(DataChunk* dataChunk)
         const size_t payloadSize = dataChunk->calcPayloadSize();
 
         void* dst = m_arena.allocateAligned(payloadSize, kPayloadMinAlignment);
-        dataChunk->getPayload(dst);
+        if (SLANG_FAILED(dataChunk->getPayload(dst)))
+        {
+            return nullptr;
+        }
 
         // Remove other datas
         data->m_next = nullptr;
@@ -999,5 +1123,141 @@ static SlangResult _calcAndSetSize(RiffContainer::Chunk* chunk, void* data)
     chunk->visitPostOrder(&_calcAndSetSize, nullptr);
 }
 
+/* static */ ICompressionSystem* RiffContainer::getCompressionSystem(CompressionSystemType type)
+{
+    switch (type)
+    {
+    case CompressionSystemType::Deflate:
+        return DeflateCompressionSystem::getSingleton();
+    case CompressionSystemType::LZ4:
+        return LZ4CompressionSystem::getSingleton();
+    default:
+        return nullptr;
+    }
+}
+
+static SlangResult _addFrameCandidate(RiffContainer::Chunk* chunk, void* data)
+{
+    auto dataChunk = as<RiffContainer::DataChunk>(chunk);
+    if (dataChunk && !dataChunk->m_frame &&
+        dataChunk->m_payloadSize >= RiffContainer::kMinFramePayloadSize)
+    {
+        ((List<RiffContainer::DataChunk*>*)data)->add(dataChunk);
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _addPendingFrame(RiffContainer::Chunk* chunk, void* data)
+{
+    auto dataChunk = as<RiffContainer::DataChunk>(chunk);
+    if (dataChunk && dataChunk->hasPendingFrame())
+    {
+        ((List<RiffContainer::DataChunk*>*)data)->add(dataChunk);
+    }
+    return SLANG_OK;
+}
+
+// Runs job(index) for each index in [0, jobCount), on up to threadCount threads. Returns the
+// first failure.
+template<typename Job>
+static SlangResult _runFrameJobs(Index jobCount, Index threadCount, const Job& job)
+{
+    std::atomic<SlangResult> result(SLANG_OK);
+    ParallelUtil::forEach(
+        jobCount,
+        threadCount,
+        [&](Index i)
+        {
+            const SlangResult jobResult = job(i);
+            if (SLANG_FAILED(jobResult))
+            {
+                SlangResult expected = SLANG_OK;
+                result.compare_exchange_strong(expected, jobResult);
+            }
+        });
+    return result.load();
+}
+
+SlangResult RiffContainer::compressFrames(
+    Chunk* chunk,
+    ICompressionSystem* compressionSystem,
+    Index threadCount)
+{
+    List<DataChunk*> dataChunks;
+    chunk->visitPreOrder(&_addFrameCandidate, &dataChunks);
+
+    // Compression needs each payload to be contiguous. This allocates from the arena, so is
+    // done before any threads are started.
+    for (auto dataChunk : dataChunks)
+    {
+        makeSingleData(dataChunk);
+    }
+
+    const Index count = dataChunks.getCount();
+    List<ComPtr<ISlangBlob>> compressedBlobs;
+    compressedBlobs.setCount(count);
+
+    CompressionStyle style;
+    SLANG_RETURN_ON_FAIL(_runFrameJobs(
+        count,
+        threadCount,
+        [&](Index i) -> SlangResult
+        {
+            Data* data = dataChunks[i]->m_dataList;
+            return compressionSystem->compress(
+                &style,
+                data->getPayload(),
+                data->getSize(),
+                compressedBlobs[i].writeRef());
+        }));
+
+    for (Index i = 0; i < count; ++i)
+    {
+        DataChunk* dataChunk = dataChunks[i];
+        ISlangBlob* compressedBlob = compressedBlobs[i];
+
+        // If it doesn't get smaller, the payload is written as it is
+        const size_t frameSize = sizeof(RiffFrameHeader) + compressedBlob->getBufferSize();
+        if (frameSize >= dataChunk->m_payloadSize)
+        {
+            continue;
+        }
+
+        RiffFrameHeader frameHeader;
+        frameHeader.fourCC = dataChunk->m_fourCC;
+        frameHeader.compressionSystemType = uint32_t(compressionSystem->getSystemType());
+        frameHeader.uncompressedSize = uint32_t(dataChunk->m_payloadSize);
+
+        uint8_t* framePayload = (uint8_t*)m_arena.allocateAligned(frameSize, kPayloadMinAlignment);
+        ::memcpy(framePayload, &frameHeader, sizeof(frameHeader));
+        ::memcpy(
+            framePayload + sizeof(frameHeader),
+            compressedBlob->getBufferPointer(),
+            compressedBlob->getBufferSize());
+
+        Data* frame = (Data*)m_arena.allocate(sizeof(Data));
+        frame->init();
+        frame->m_ownership = Ownership::Arena;
+        frame->m_payload = framePayload;
+        frame->m_size = frameSize;
+
+        dataChunk->m_frame = frame;
+    }
+    return SLANG_OK;
+}
+
+/* static */ SlangResult RiffContainer::decompressFrames(Chunk* chunk, Index threadCount)
+{
+    List<DataChunk*> dataChunks;
+    chunk->visitPreOrder(&_addPendingFrame, &dataChunks);
+
+    // Each frame decompresses into space that was allocated when it was read, so they can all be
+    // decompressed at the same time
+    return _runFrameJobs(
+        dataChunks.getCount(),
+        threadCount,
+        [&](Index i) -> SlangResult { return dataChunks[i]->decompressFrame(); });
+}
+
 
 } // namespace Slang
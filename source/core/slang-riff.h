@@ -2,6 +2,7 @@
 #define SLANG_RIFF_H
 
 #include "slang-basic.h"
+#include "slang-compression-system.h"
 #include "slang-memory-arena.h"
 #include "slang-semantic-version.h"
 #include "slang-stream.h"
@@ -68,10 +69,22 @@ struct RiffFourCC
     /// A list is the same as a 'riff' except can be placed anywhere in hierarchy.
     static const FourCC kList = SLANG_FOUR_CC('L', 'I', 'S', 'T');
 
+    /// A data chunk whose payload is an independently compressed frame. The payload starts with
+    /// a RiffFrameHeader, which holds the type of the chunk it was made from.
+    static const FourCC kFrame = SLANG_FOUR_CC('F', 'R', 'M', 'E');
+
 private:
     RiffFourCC() = delete;
 };
 
+struct RiffFrameHeader
+{
+    FourCC fourCC;                  ///< The type of the data chunk that was compressed
+    uint32_t compressionSystemType; ///< The CompressionSystemType used to compress the payload
+    uint32_t uncompressedSize;      ///< The size of the payload when decompressed
+    // Followed by the compressed payload
+};
+
 // Follows semantic version rules
 // https://semver.org/
 //
@@ -343,13 +356,15 @@ public:
             return chunk->m_kind == Kind::Data;
         }
 
-        /// Calculate a hash (not necessarily very fast)
-        RiffHashCode calcHash() const;
+        /// Calculate a hash (not necessarily very fast). Fails if the payload is in a frame
+        /// that can't be decompressed.
+        SlangResult calcHash(RiffHashCode& outHash) const;
         /// Calculate the payload size
         size_t calcPayloadSize() const;
 
-        /// Copy the payload to dst. Dst must be at least the payload size.
-        void getPayload(void* dst) const;
+        /// Copy the payload to dst. Dst must be at least the payload size. Fails if the payload
+        /// is in a frame that can't be decompressed.
+        SlangResult getPayload(void* dst) const;
 
         /// True if payloads contents is equal to data
         bool isEqual(const void* data, size_t count) const;
@@ -360,15 +375,31 @@ public:
         /// Return as read helper
         RiffReadHelper asReadHelper() const;
 
+        /// True if the payload is still only held in the compressed frame
+        bool hasPendingFrame() const { return m_hasPendingFrame; }
+        /// Decompress the payload from the frame, if that hasn't happened yet. Accessing the
+        /// payload through the methods above does this implicitly.
+        /// NOTE! Not thread safe for the same chunk.
+        SlangResult decompressFrame() const;
+
         void init(FourCC fourCC)
         {
             Super::init(Kind::Data, fourCC);
             m_dataList = nullptr;
             m_endData = nullptr;
+            m_frame = nullptr;
+            m_hasPendingFrame = false;
         }
 
         Data* m_dataList; ///< List of 0 or more data items
         Data* m_endData;  ///< The last data point
+
+        /// If set, the payload compressed as an independent frame (starting with a
+        /// RiffFrameHeader). This is what is written to a stream.
+        Data* m_frame;
+        /// True if m_dataList holds the space for the payload, but it's not been decompressed from
+        /// m_frame yet
+        mutable bool m_hasPendingFrame;
     };
 
     class ScopeChunk
@@ -448,6 +479,24 @@ public:
     /// Traverses over chunk hierarchy and sets the sizes
     static void calcAndSetSize(Chunk* chunk);
 
+    /// Compress the payloads of data chunks in the hierarchy that are at least
+    /// kMinFramePayloadSize into independent frames, that are written in place of the payload.
+    /// Frames are compressed on up to threadCount threads. If threadCount is <= 0, a thread is
+    /// used for each hardware thread.
+    SlangResult compressFrames(
+        Chunk* chunk,
+        ICompressionSystem* compressionSystem,
+        Index threadCount);
+
+    /// Decompress all of the pending frames in the hierarchy, on up to threadCount threads.
+    static SlangResult decompressFrames(Chunk* chunk, Index threadCount);
+
+    /// Get the compression system for a type. Returns nullptr for None or an unknown type.
+    static ICompressionSystem* getCompressionSystem(CompressionSystemType type);
+
+    /// Payloads smaller than this are not worth compressing as a frame
+    static const size_t kMinFramePayloadSize = 256;
+
     /// Ctor
     RiffContainer();
 
@@ -519,12 +568,14 @@ struct RiffUtil
     /// Get the size taking into account padding
     static size_t getPadSize(size_t in) { return (in + kRiffPadMask) & ~size_t(kRiffPadMask); }
 
-    /// Write a chunk list and contents to a stream
+    /// Write a chunk list and contents to a stream. Data chunks with a frame are written as a
+    /// 'FRME' chunk containing the frame.
     static SlangResult write(ListChunk* listChunk, bool isRoot, Stream* stream);
     /// Write a container to the stream
     static SlangResult write(RiffContainer* container, Stream* stream);
 
-    /// Read the stream into the container
+    /// Read the stream into the container. Frames are not decompressed until the payload is
+    /// first accessed (or RiffContainer::decompressFrames is used).
     static SlangResult read(Stream* stream, RiffContainer& outContainer);
 };
 
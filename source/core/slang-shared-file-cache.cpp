@@ -0,0 +1,219 @@
+#include "slang-shared-file-cache.h"
+
+#include "../core/slang-file-system.h"
+
+namespace Slang
+{
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SharedFileCache !!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+SharedFileCache::SharedFileCache() {}
+
+void* SharedFileCache::castAs(const Guid& guid)
+{
+    if (auto ptr = getInterface(guid))
+    {
+        return ptr;
+    }
+    return getObject(guid);
+}
+
+void* SharedFileCache::getInterface(const Guid& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangCastable::getTypeGuid() ||
+        guid == ISlangFileSystem::getTypeGuid() || guid == ISlangFileSystemExt::getTypeGuid())
+    {
+        return static_cast<ISlangFileSystemExt*>(this);
+    }
+    return nullptr;
+}
+
+void* SharedFileCache::getObject(const Guid& guid)
+{
+    if (guid == SharedFileCache::getTypeGuid())
+    {
+        return this;
+    }
+    return nullptr;
+}
+
+SlangResult SharedFileCache::loadFile(char const* pathIn, ISlangBlob** outBlob)
+{
+    *outBlob = nullptr;
+
+    const String path = OSFileSystem::fixPathDelimiters(pathIn);
+
+    // We always have to go to the OS to find out if the file has changed. This is a single 'stat'
+    // and much cheaper than reading the contents again.
+    File::Info info;
+    if (SLANG_FAILED(File::getInfo(path, info)))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        _removeEntry(path);
+        return SLANG_E_NOT_FOUND;
+    }
+
+    if (info.pathType != SLANG_PATH_TYPE_FILE)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto entry = m_entries.tryGetValue(path))
+        {
+            if (entry->info == info)
+            {
+                m_stats.hitCount++;
+                entry->lastUse = ++m_useCount;
+                *outBlob = ComPtr<ISlangBlob>(entry->contents).detach();
+                return SLANG_OK;
+            }
+            m_stats.invalidationCount++;
+        }
+        else
+        {
+            m_stats.missCount++;
+        }
+    }
+
+    // Read without holding the lock, so loads of different files can proceed in parallel.
+    // If two threads race to load the same file they will both read it, and the last one
+    // to finish wins, which is benign.
+    //
+    // The contents are read into memory rather than mapped, so a blob that has been handed out
+    // is a snapshot that isn't affected by the file being edited or truncated in place.
+    ScopedAllocation alloc;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(path, alloc));
+    ComPtr<ISlangBlob> contents = RawBlob::moveCreate(alloc);
+
+    // If the file changed while it was being read, the contents may not match the info, so they
+    // are returned but not cached.
+    File::Info infoAfterRead;
+    if (SLANG_SUCCEEDED(File::getInfo(path, infoAfterRead)) && infoAfterRead == info)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        _removeEntry(path);
+        if (contents->getBufferSize() <= m_maxByteCount)
+        {
+            Entry entry;
+            entry.info = info;
+            entry.contents = contents;
+            entry.lastUse = ++m_useCount;
+            m_entries.set(path, entry);
+            m_byteCount += contents->getBufferSize();
+            _evictToFit();
+        }
+    }
+
+    *outBlob = contents.detach();
+    return SLANG_OK;
+}
+
+SlangResult SharedFileCache::getFileUniqueIdentity(const char* path, ISlangBlob** outUniqueIdentity)
+{
+    return OSFileSystem::getExtSingleton()->getFileUniqueIdentity(path, outUniqueIdentity);
+}
+
+SlangResult SharedFileCache::calcCombinedPath(
+    SlangPathType fromPathType,
+    const char* fromPath,
+    const char* path,
+    ISlangBlob** pathOut)
+{
+    return OSFileSystem::getExtSingleton()->calcCombinedPath(fromPathType, fromPath, path, pathOut);
+}
+
+SlangResult SharedFileCache::getPathType(const char* path, SlangPathType* outPathType)
+{
+    return OSFileSystem::getExtSingleton()->getPathType(path, outPathType);
+}
+
+SlangResult SharedFileCache::getPath(PathKind kind, const char* path, ISlangBlob** outPath)
+{
+    return OSFileSystem::getExtSingleton()->getPath(kind, path, outPath);
+}
+
+SlangResult SharedFileCache::enumeratePathContents(
+    const char* path,
+    FileSystemContentsCallBack callback,
+    void* userData)
+{
+    return OSFileSystem::getExtSingleton()->enumeratePathContents(path, callback, userData);
+}
+
+void SharedFileCache::_removeEntry(const String& path)
+{
+    if (auto entry = m_entries.tryGetValue(path))
+    {
+        m_byteCount -= entry->contents->getBufferSize();
+        m_entries.remove(path);
+    }
+}
+
+void SharedFileCache::_evictToFit()
+{
+    while (m_byteCount > m_maxByteCount && m_entries.getCount())
+    {
+        // Entries are few enough that a scan for the oldest is cheaper than keeping them ordered
+        const String* oldestPath = nullptr;
+        uint64_t oldestUse = 0;
+        for (const auto& [path, entry] : m_entries)
+        {
+            if (!oldestPath || entry.lastUse < oldestUse)
+            {
+                oldestPath = &path;
+                oldestUse = entry.lastUse;
+            }
+        }
+        const String evictedPath = *oldestPath;
+        _removeEntry(evictedPath);
+        m_stats.evictionCount++;
+    }
+}
+
+void SharedFileCache::clearCache()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_byteCount = 0;
+}
+
+void SharedFileCache::setMaxByteCount(size_t maxByteCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxByteCount = maxByteCount;
+    _evictToFit();
+}
+
+size_t SharedFileCache::getMaxByteCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxByteCount;
+}
+
+size_t SharedFileCache::getByteCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_byteCount;
+}
+
+SharedFileCache::Stats SharedFileCache::getStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void SharedFileCache::resetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = Stats();
+}
+
+Count SharedFileCache::getEntryCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return Count(m_entries.getCount());
+}
+
+} // namespace Slang
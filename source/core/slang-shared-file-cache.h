@@ -0,0 +1,125 @@
+#ifndef SLANG_CORE_SHARED_FILE_CACHE_H
+#define SLANG_CORE_SHARED_FILE_CACHE_H
+
+#include "../core/slang-blob.h"
+#include "../core/slang-dictionary.h"
+#include "../core/slang-io.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+#include <mutex>
+
+namespace Slang
+{
+
+/* A file system on top of the OS file system that keeps file contents alive across many sessions.
+
+CacheFileSystem assumes files don't change for the lifetime of the Linkage that owns it, so its
+cache cannot be shared between sessions. SharedFileCache is designed to be long lived (typically
+owned by the global session), so every access validates the cached entry against the size and
+modification time reported by the OS, and reloads the contents if either has changed.
+
+The contents of a header that is included by many sessions is only held once by the process.
+Contents are read into memory, so a blob that has been handed out never changes, even if the file
+is later edited or truncated in place.
+
+The total size of the cached contents is bounded by a byte budget. When it is exceeded the least
+recently used entries are evicted, so a long running process doesn't keep every file it has read.
+
+All methods can be called concurrently from multiple threads.
+*/
+class SharedFileCache : public ISlangFileSystemExt, public ComBaseObject
+{
+public:
+    SLANG_CLASS_GUID(0x6f1a6c3e, 0x2b8d, 0x4d1f, {0x9a, 0x43, 0x5c, 0x17, 0xe2, 0x0b, 0x88, 0x41})
+
+    struct Stats
+    {
+        Count hitCount = 0;          ///< Loads that were satisfied from the cache
+        Count missCount = 0;         ///< Loads of files that were not in the cache
+        Count invalidationCount = 0; ///< Loads where a cached entry was stale and had to be reloaded
+        Count evictionCount = 0;     ///< Entries removed to keep within the byte budget
+    };
+
+    /// The default budget for the total size of the cached contents
+    static const size_t kDefaultMaxByteCount = 64 * 1024 * 1024;
+
+    // ISlangUnknown
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    // ISlangCastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE;
+
+    // ISlangFileSystem
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(char const* path, ISlangBlob** outBlob)
+        SLANG_OVERRIDE;
+
+    // ISlangFileSystemExt
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getFileUniqueIdentity(const char* path, ISlangBlob** outUniqueIdentity) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL calcCombinedPath(
+        SlangPathType fromPathType,
+        const char* fromPath,
+        const char* path,
+        ISlangBlob** pathOut) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPathType(const char* path, SlangPathType* outPathType) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getPath(PathKind kind, const char* path, ISlangBlob** outPath) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW void SLANG_MCALL clearCache() SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL enumeratePathContents(
+        const char* path,
+        FileSystemContentsCallBack callback,
+        void* userData) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW OSPathKind SLANG_MCALL getOSPathKind() SLANG_OVERRIDE
+    {
+        return OSPathKind::Direct;
+    }
+
+    /// Get a snapshot of the stats
+    Stats getStats();
+    /// Reset the stats
+    void resetStats();
+
+    /// Get the amount of entries in the cache
+    Count getEntryCount();
+    /// Get the total size of the cached contents in bytes
+    size_t getByteCount();
+
+    /// Set the budget for the total size of the cached contents. Entries are evicted, least
+    /// recently used first, until the contents fit. A file larger than the budget isn't cached.
+    void setMaxByteCount(size_t maxByteCount);
+    size_t getMaxByteCount();
+
+    /// Ctor
+    SharedFileCache();
+
+protected:
+    struct Entry
+    {
+        File::Info info;
+        ComPtr<ISlangBlob> contents;
+        uint64_t lastUse = 0; ///< The value of m_useCount when the entry was last used
+    };
+
+    void* getInterface(const Guid& guid);
+    void* getObject(const Guid& guid);
+
+    /// Remove the entry at path if there is one. Must be called with m_mutex held.
+    void _removeEntry(const String& path);
+    /// Evict the least recently used entries until the contents fit in the budget. Must be
+    /// called with m_mutex held.
+    void _evictToFit();
+
+    std::mutex m_mutex;                 ///< Guards all members below
+    Dictionary<String, Entry> m_entries; ///< Maps a path to the cached state of the file
+    size_t m_byteCount = 0;             ///< The total size of the contents of m_entries
+    size_t m_maxByteCount = kDefaultMaxByteCount;
+    uint64_t m_useCount = 0;
+    Stats m_stats;
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_SHARED_FILE_CACHE_H
@@ -514,7 +514,7 @@ SlangResult BufferedReadStream::flush()
     return SLANG_E_NOT_AVAILABLE;
 }
 
-SlangResult BufferedReadStream::update()
+SlangResult BufferedReadStream::update(size_t readSize)
 {
     if (m_stream == nullptr)
     {
@@ -522,13 +522,15 @@ SlangResult BufferedReadStream::update()
         return SLANG_OK;
     }
 
+    readSize = (readSize > m_defaultReadSize) ? readSize : m_defaultReadSize;
+
     // Repeat until we have enough space
     for (;;)
     {
-        // How much buffer space do we have. We need at least m_defaultReadSize
+        // How much buffer space do we have. We need at least readSize
         const size_t remainingCount = size_t(m_buffer.getCapacity() - m_buffer.getCount());
 
-        if (remainingCount >= m_defaultReadSize)
+        if (remainingCount >= readSize)
         {
             break;
         }
@@ -550,19 +552,19 @@ SlangResult BufferedReadStream::update()
         {
             // Make sure we have the space
             const Index prevCount = m_buffer.getCount();
-            m_buffer.setCount(prevCount + m_defaultReadSize);
+            m_buffer.setCount(prevCount + Index(readSize));
             m_buffer.setCount(prevCount);
         }
     }
 
     {
         const Index prevCount = m_buffer.getCount();
-        m_buffer.setCount(prevCount + m_defaultReadSize);
+        m_buffer.setCount(prevCount + Index(readSize));
 
         size_t readBytes = 0;
 
         const SlangResult res =
-            m_stream->read(m_buffer.getBuffer() + prevCount, m_defaultReadSize, readBytes);
+            m_stream->read(m_buffer.getBuffer() + prevCount, readSize, readBytes);
 
         m_buffer.setCount(prevCount + Index(readBytes));
 
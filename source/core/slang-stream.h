@@ -245,7 +245,9 @@ public:
     virtual SlangResult flush() SLANG_OVERRIDE;
 
     /// Will read assuming backing stream is
-    SlangResult update();
+    /// readSize is how many bytes to try to read, if it's less than the default read size, the
+    /// default read size is used.
+    SlangResult update(size_t readSize = 0);
 
     /// Consume bytes in the buffer.
     void consume(Index byteCount);
@@ -0,0 +1,453 @@
+#include "async-output-stream.h"
+
+#include "../../core/slang-lz4-compression-system.h"
+#include "../util/record-format.h"
+#include "../util/record-utility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <string.h>
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+namespace SlangRecord
+{
+// The amount of data to collect before writing it to the file
+static const Slang::Index kStagingSize = 64 * 1024;
+
+static std::atomic<uint64_t> g_nextStreamId{1};
+
+namespace
+{
+struct LiveStreams
+{
+    std::mutex mutex;
+    Slang::List<AsyncFileOutputStream*> streams;
+};
+} // namespace
+
+// The live streams are deliberately leaked, so that they are still there for the exit and crash
+// handlers however late those run.
+static LiveStreams& _getLiveStreams()
+{
+    static LiveStreams* liveStreams = new LiveStreams;
+    return *liveStreams;
+}
+
+static const int kCrashSignals[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL};
+#ifdef _WIN32
+static void (*g_previousSignalHandlers[SLANG_COUNT_OF(kCrashSignals)])(int);
+#else
+// The whole action is kept, so that a handler installed with SA_SIGINFO, and its flags and mask,
+// are put back as they were
+static struct sigaction g_previousSignalActions[SLANG_COUNT_OF(kCrashSignals)];
+#endif
+static std::terminate_handler g_previousTerminateHandler = nullptr;
+
+static void _handleCrashSignal(int signal)
+{
+    AsyncFileOutputStream::drainAllStreams();
+
+    // Put back the handler that was there before, and raise the signal again, so that the
+    // signal is handled as it would have been without recording.
+    for (Slang::Index i = 0; i < SLANG_COUNT_OF(kCrashSignals); ++i)
+    {
+        if (kCrashSignals[i] == signal)
+        {
+#ifdef _WIN32
+            auto previousHandler = g_previousSignalHandlers[i];
+            std::signal(signal, previousHandler == SIG_ERR ? SIG_DFL : previousHandler);
+#else
+            sigaction(signal, &g_previousSignalActions[i], nullptr);
+#endif
+        }
+    }
+    std::raise(signal);
+}
+
+static void _handleTerminate()
+{
+    AsyncFileOutputStream::drainAllStreams();
+    if (g_previousTerminateHandler)
+    {
+        g_previousTerminateHandler();
+    }
+    std::abort();
+}
+
+static void _handleExit()
+{
+    AsyncFileOutputStream::drainAllStreams();
+}
+
+static void _installExitHandlers()
+{
+    static std::once_flag onceFlag;
+    std::call_once(
+        onceFlag,
+        []()
+        {
+            // Create the live streams before registering the exit handler, so that they are
+            // there when it runs
+            _getLiveStreams();
+            std::atexit(_handleExit);
+            for (Slang::Index i = 0; i < SLANG_COUNT_OF(kCrashSignals); ++i)
+            {
+#ifdef _WIN32
+                g_previousSignalHandlers[i] = std::signal(kCrashSignals[i], _handleCrashSignal);
+#else
+                struct sigaction action;
+                memset(&action, 0, sizeof(action));
+                action.sa_handler = _handleCrashSignal;
+                sigemptyset(&action.sa_mask);
+                sigaction(kCrashSignals[i], &action, &g_previousSignalActions[i]);
+#endif
+            }
+            g_previousTerminateHandler = std::set_terminate(_handleTerminate);
+        });
+}
+
+AsyncFileOutputStream::RingBuffer::RingBuffer(std::thread::id inThreadId)
+    : threadId(inThreadId)
+{
+    data.setCount(kCapacity);
+}
+
+void AsyncFileOutputStream::RingBuffer::copyIn(uint64_t pos, const void* src, size_t size)
+{
+    const size_t offset = size_t(pos & (kCapacity - 1));
+    const size_t firstSize = std::min(size, kCapacity - offset);
+    memcpy(data.getBuffer() + offset, src, firstSize);
+    memcpy(data.getBuffer(), (const uint8_t*)src + firstSize, size - firstSize);
+}
+
+void AsyncFileOutputStream::RingBuffer::copyOut(uint64_t pos, void* dst, size_t size) const
+{
+    const size_t offset = size_t(pos & (kCapacity - 1));
+    const size_t firstSize = std::min(size, kCapacity - offset);
+    memcpy(dst, data.getBuffer() + offset, firstSize);
+    memcpy((uint8_t*)dst + firstSize, data.getBuffer(), size - firstSize);
+}
+
+AsyncFileOutputStream::AsyncFileOutputStream(const Slang::String& fileName, bool useLZ4)
+    : m_streamId(g_nextStreamId++), m_useLZ4(useLZ4)
+{
+    Slang::FileMode fileMode = Slang::FileMode::Create;
+    Slang::FileAccess fileAccess = Slang::FileAccess::Write;
+    Slang::FileShare fileShare = Slang::FileShare::None;
+
+    SlangResult res = m_fileStream.init(fileName, fileMode, fileAccess, fileShare);
+
+    if (res != SLANG_OK)
+    {
+        SlangRecord::slangRecordLog(
+            SlangRecord::LogLevel::Error,
+            "Failed to open file %s\n",
+            fileName.getBuffer());
+        std::abort();
+    }
+
+    m_staging.reserve(kStagingSize);
+
+    _installExitHandlers();
+    {
+        auto& liveStreams = _getLiveStreams();
+        std::lock_guard<std::mutex> lock(liveStreams.mutex);
+        liveStreams.streams.add(this);
+    }
+
+    m_drainThread = std::thread([this]() { _runDrainThread(); });
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream()
+{
+    {
+        auto& liveStreams = _getLiveStreams();
+        std::lock_guard<std::mutex> lock(liveStreams.mutex);
+        liveStreams.streams.remove(this);
+    }
+
+    // The drain thread writes out everything left in the ring buffers before it stops
+    m_stop.store(true, std::memory_order_release);
+    m_drainThread.join();
+
+    m_fileStream.close();
+}
+
+AsyncFileOutputStream::RingBuffer* AsyncFileOutputStream::_getThreadRingBuffer()
+{
+    // A thread usually writes to the same stream each time, so remember the ring buffer it used
+    // last. The stream id is used rather than the stream's address, as the address can be reused.
+    struct Cache
+    {
+        uint64_t streamId = 0;
+        RingBuffer* ringBuffer = nullptr;
+    };
+    static thread_local Cache cache;
+    if (cache.streamId == m_streamId)
+    {
+        return cache.ringBuffer;
+    }
+
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock(m_ringBuffersMutex);
+    RingBuffer* ringBuffer = nullptr;
+    for (auto& existing : m_ringBuffers)
+    {
+        if (existing->threadId == threadId)
+        {
+            ringBuffer = existing;
+            break;
+        }
+    }
+    if (!ringBuffer)
+    {
+        ringBuffer = new RingBuffer(threadId);
+        m_ringBuffers.add(Slang::RefPtr<RingBuffer>(ringBuffer));
+    }
+
+    cache.streamId = m_streamId;
+    cache.ringBuffer = ringBuffer;
+    return ringBuffer;
+}
+
+void AsyncFileOutputStream::write(const void* data, size_t len)
+{
+    RingBuffer* ringBuffer = _getThreadRingBuffer();
+    const uint64_t sequence = m_nextSequence.fetch_add(1);
+
+    // A write that doesn't fit in a single entry is split over several, so that any write can
+    // be added to the ring buffer while the drain thread takes the entries before it.
+    const size_t kMaxEntryDataSize = RingBuffer::kCapacity / 4;
+
+    const uint8_t* src = (const uint8_t*)data;
+    size_t remaining = len;
+    do
+    {
+        const size_t size = std::min(remaining, kMaxEntryDataSize);
+        const size_t entrySize = sizeof(EntryHeader) + size;
+
+        const uint64_t writePos = ringBuffer->writePos.load(std::memory_order_relaxed);
+        while (writePos + entrySize - ringBuffer->readPos.load(std::memory_order_acquire) >
+               RingBuffer::kCapacity)
+        {
+            // Wait for the drain thread to make space
+            std::this_thread::yield();
+        }
+
+        EntryHeader header;
+        header.sequence = sequence;
+        header.sizeInBytes = uint32_t(size);
+        header.isLast = (size == remaining) ? 1 : 0;
+        ringBuffer->copyIn(writePos, &header, sizeof(header));
+        ringBuffer->copyIn(writePos + sizeof(header), src, size);
+        ringBuffer->writePos.store(writePos + entrySize, std::memory_order_release);
+
+        src += size;
+        remaining -= size;
+    } while (remaining > 0);
+}
+
+bool AsyncFileOutputStream::_peekEntry(RingBuffer* ringBuffer, EntryHeader& outHeader)
+{
+    const uint64_t readPos = ringBuffer->readPos.load(std::memory_order_relaxed);
+    const uint64_t writePos = ringBuffer->writePos.load(std::memory_order_acquire);
+    if (writePos - readPos < sizeof(EntryHeader))
+    {
+        return false;
+    }
+    ringBuffer->copyOut(readPos, &outHeader, sizeof(EntryHeader));
+    return true;
+}
+
+bool AsyncFileOutputStream::_drain(bool force)
+{
+    // Must be called with m_drainMutex and m_ringBuffersMutex held
+
+    bool drained = false;
+    for (;;)
+    {
+        // Find the ring buffer that holds the next write
+        RingBuffer* next = nullptr;
+        uint64_t nextSequence = 0;
+        RingBuffer* first = nullptr;
+        uint64_t firstSequence = 0;
+        for (auto& ringBuffer : m_ringBuffers)
+        {
+            EntryHeader header;
+            if (!_peekEntry(ringBuffer, header))
+            {
+                continue;
+            }
+            if (header.sequence <= m_drainSequence)
+            {
+                next = ringBuffer;
+                nextSequence = header.sequence;
+                break;
+            }
+            if (!first || header.sequence < firstSequence)
+            {
+                first = ringBuffer;
+                firstSequence = header.sequence;
+            }
+        }
+
+        if (!next)
+        {
+            // The next write has been given its sequence number, but hasn't been added to its
+            // ring buffer yet. When forced, the thread making it may never get to add it, so skip
+            // over it.
+            if (!force || !first)
+            {
+                break;
+            }
+            next = first;
+            nextSequence = firstSequence;
+            m_drainSequence = firstSequence;
+        }
+
+        bool isComplete = false;
+        EntryHeader header;
+        while (_peekEntry(next, header) && header.sequence == nextSequence)
+        {
+            const uint64_t dataPos = next->readPos.load(std::memory_order_relaxed) +
+                                     sizeof(EntryHeader);
+            const Slang::Index stagedCount = m_staging.getCount();
+            m_staging.setCount(stagedCount + header.sizeInBytes);
+            next->copyOut(dataPos, m_staging.getBuffer() + stagedCount, header.sizeInBytes);
+            next->readPos.store(dataPos + header.sizeInBytes, std::memory_order_release);
+            drained = true;
+
+            if (header.isLast)
+            {
+                isComplete = true;
+                break;
+            }
+        }
+
+        if (m_staging.getCount() >= kStagingSize)
+        {
+            _writeStaged();
+        }
+
+        if (!isComplete)
+        {
+            // The rest of the write is still being added
+            if (!force)
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (nextSequence == m_drainSequence)
+        {
+            m_drainSequence++;
+        }
+    }
+
+    // While writes keep coming, keep collecting them so that they are written in larger blocks
+    if (!drained || force)
+    {
+        _writeStaged();
+    }
+    return drained;
+}
+
+void AsyncFileOutputStream::_writeStaged()
+{
+    if (m_staging.getCount() == 0)
+    {
+        return;
+    }
+
+    if (m_useLZ4)
+    {
+        Slang::CompressionStyle style;
+        style.m_type = Slang::CompressionStyle::Type::BestSpeed;
+
+        Slang::ComPtr<ISlangBlob> compressed;
+        SLANG_RECORD_CHECK(Slang::LZ4CompressionSystem::getSingleton()->compress(
+            &style,
+            m_staging.getBuffer(),
+            size_t(m_staging.getCount()),
+            compressed.writeRef()));
+
+        LZ4FrameHeader frameHeader;
+        frameHeader.uncompressedSizeInBytes = uint32_t(m_staging.getCount());
+        frameHeader.compressedSizeInBytes = uint32_t(compressed->getBufferSize());
+        SLANG_RECORD_CHECK(m_fileStream.write(&frameHeader, sizeof(frameHeader)));
+        SLANG_RECORD_CHECK(
+            m_fileStream.write(compressed->getBufferPointer(), compressed->getBufferSize()));
+    }
+    else
+    {
+        SLANG_RECORD_CHECK(m_fileStream.write(m_staging.getBuffer(), m_staging.getCount()));
+    }
+    SLANG_RECORD_CHECK(m_fileStream.flush());
+
+    m_staging.clear();
+}
+
+void AsyncFileOutputStream::_runDrainThread()
+{
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        bool drained = false;
+        {
+            std::lock_guard<std::mutex> drainLock(m_drainMutex);
+            std::lock_guard<std::mutex> ringBuffersLock(m_ringBuffersMutex);
+            drained = _drain(false);
+        }
+        if (!drained)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::lock_guard<std::mutex> drainLock(m_drainMutex);
+    std::lock_guard<std::mutex> ringBuffersLock(m_ringBuffersMutex);
+    _drain(true);
+}
+
+void AsyncFileOutputStream::_drainOnExit()
+{
+    // The drain thread may be part way through writing, so give it a moment to finish. Don't
+    // wait for long, as the process may have stopped with the locks held.
+    for (int attempt = 0; attempt < 100; ++attempt)
+    {
+        if (m_drainMutex.try_lock())
+        {
+            if (m_ringBuffersMutex.try_lock())
+            {
+                _drain(true);
+                m_ringBuffersMutex.unlock();
+                m_drainMutex.unlock();
+                return;
+            }
+            m_drainMutex.unlock();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void AsyncFileOutputStream::drainAllStreams()
+{
+    auto& liveStreams = _getLiveStreams();
+    if (!liveStreams.mutex.try_lock())
+    {
+        return;
+    }
+    for (auto stream : liveStreams.streams)
+    {
+        stream->_drainOnExit();
+    }
+    liveStreams.mutex.unlock();
+}
+} // namespace SlangRecord
@@ -0,0 +1,97 @@
+#ifndef ASYNC_OUTPUT_STREAM_H
+#define ASYNC_OUTPUT_STREAM_H
+
+#include "../../core/slang-list.h"
+#include "../../core/slang-stream.h"
+#include "../../core/slang-string.h"
+#include "output-stream.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace SlangRecord
+{
+// An output stream that writes to a file on a background thread.
+//
+// Each thread that writes to the stream gets its own ring buffer. A write only copies the data
+// into the ring buffer of the calling thread, without taking any lock, and the background thread
+// drains the ring buffers to the file. Each write is given a sequence number, so that the writes
+// from all threads are written to the file in the order they were made.
+//
+// If useLZ4 is set, the data is written as LZ4 compressed frames (see LZ4FrameHeader), otherwise
+// it is written as is.
+//
+// Buffered data is written out when the stream is destroyed, at exit, and (on a best effort
+// basis) when the process is terminated by a signal or std::terminate.
+class AsyncFileOutputStream : public OutputStream
+{
+public:
+    AsyncFileOutputStream(const Slang::String& fileName, bool useLZ4);
+    virtual ~AsyncFileOutputStream() override;
+    virtual void write(const void* data, size_t len) override;
+
+    // The background thread writes the data to the file as soon as it can, so there is nothing
+    // for flush to do.
+    virtual void flush() override {}
+
+    // Write out the data buffered by all the live streams. Used on abnormal exit.
+    static void drainAllStreams();
+
+private:
+    struct EntryHeader
+    {
+        uint64_t sequence;
+        uint32_t sizeInBytes;
+        uint32_t isLast;
+    };
+
+    class RingBuffer : public Slang::RefObject
+    {
+    public:
+        // Must be a power of 2
+        static const size_t kCapacity = size_t(1) << 20;
+
+        RingBuffer(std::thread::id inThreadId);
+
+        void copyIn(uint64_t pos, const void* src, size_t size);
+        void copyOut(uint64_t pos, void* dst, size_t size) const;
+
+        std::thread::id threadId;
+        Slang::List<uint8_t> data;
+
+        // Only changed by the thread that owns the ring buffer
+        std::atomic<uint64_t> writePos{0};
+        // Only changed by the thread that drains the ring buffer
+        std::atomic<uint64_t> readPos{0};
+    };
+
+    RingBuffer* _getThreadRingBuffer();
+    bool _peekEntry(RingBuffer* ringBuffer, EntryHeader& outHeader);
+    bool _drain(bool force);
+    void _writeStaged();
+    void _runDrainThread();
+    void _drainOnExit();
+
+    const uint64_t m_streamId;
+    const bool m_useLZ4;
+
+    Slang::FileStream m_fileStream;
+
+    // Guards m_ringBuffers. Only taken when a thread writes to the stream for the first time, and
+    // when draining.
+    std::mutex m_ringBuffersMutex;
+    Slang::List<Slang::RefPtr<RingBuffer>> m_ringBuffers;
+
+    std::atomic<uint64_t> m_nextSequence{0};
+
+    // Guards the state below, which is only used when draining
+    std::mutex m_drainMutex;
+    uint64_t m_drainSequence = 0;
+    Slang::List<uint8_t> m_staging;
+
+    std::atomic<bool> m_stop{false};
+    std::thread m_drainThread;
+};
+} // namespace SlangRecord
+#endif // ASYNC_OUTPUT_STREAM_H
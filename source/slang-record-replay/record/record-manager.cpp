@@ -2,6 +2,7 @@
 
 #include "../../core/slang-io.h"
 #include "../util/record-utility.h"
+#include "async-output-stream.h"
 
 #include <sstream>
 #include <thread>
@@ -28,7 +29,18 @@ RecordManager::RecordManager(uint64_t globalSessionHandle)
 
     Slang::String recordFilePath =
         Slang::Path::combine(m_recordFileDirectory, Slang::String(ss.str().c_str()));
-    m_fileStream = new FileOutputStream(recordFilePath);
+    switch (getRecordWriteMode())
+    {
+    case RecordWriteMode::Async:
+        m_fileStream = new AsyncFileOutputStream(recordFilePath, false);
+        break;
+    case RecordWriteMode::AsyncLZ4:
+        m_fileStream = new AsyncFileOutputStream(recordFilePath, true);
+        break;
+    default:
+        m_fileStream = new FileOutputStream(recordFilePath);
+        break;
+    }
 }
 
 void RecordManager::clearWithHeader(const ApiCallId& callId, uint64_t handleId)
@@ -28,7 +28,7 @@ private:
     void clearWithTailer();
 
     MemoryStream m_memoryStream;
-    Slang::RefPtr<FileOutputStream> m_fileStream;
+    Slang::RefPtr<OutputStream> m_fileStream;
     Slang::String m_recordFileDirectory = Slang::Path::getCurrentPath();
     ParameterRecorder m_recorder;
 };
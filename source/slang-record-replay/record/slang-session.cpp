@@ -514,6 +514,62 @@ SLANG_NO_THROW bool SessionRecorder::isBinaryModuleUpToDate(
     return result;
 }
 
+SLANG_NO_THROW SlangResult SessionRecorder::compileBatch(
+    slang::BatchCompileRequest const* requests,
+    SlangInt requestCount,
+    slang::BatchCompileResult* outResults)
+{
+    slangRecordLog(LogLevel::Verbose, "%s\n", __PRETTY_FUNCTION__);
+
+    // The requests refer to our module recorders, so the actual modules are passed on
+    List<slang::BatchCompileRequest> actualRequests;
+    for (SlangInt i = 0; i < requestCount; i++)
+    {
+        slang::BatchCompileRequest request = requests[i];
+        ComPtr<IModuleRecorder> moduleRecord;
+        if (request.module &&
+            request.module->queryInterface(
+                IModuleRecorder::getTypeGuid(),
+                (void**)moduleRecord.writeRef()) == SLANG_OK)
+        {
+            request.module = static_cast<ModuleRecorder*>(moduleRecord.get())->getActualModule();
+        }
+        actualRequests.add(request);
+    }
+
+    ParameterRecorder* recorder{};
+    {
+        recorder =
+            m_recordManager->beginMethodRecord(ApiCallId::ISession_compileBatch, m_sessionHandle);
+        recorder->recordInt64(requestCount);
+        for (auto const& request : actualRequests)
+        {
+            recorder->recordAddress(request.module);
+            recorder->recordString(request.entryPointName);
+            recorder->recordEnumValue(request.stage);
+            recorder->recordStructArray(request.specializationArgs, request.specializationArgCount);
+            recorder->recordInt64(request.targetIndex);
+        }
+        recorder = m_recordManager->endMethodRecord();
+    }
+
+    SlangResult result =
+        m_actualSession->compileBatch(actualRequests.getBuffer(), requestCount, outResults);
+
+    {
+        // The batch only produces blobs, the component types it creates along the way
+        // aren't returned to the application.
+        for (SlangInt i = 0; i < requestCount; i++)
+        {
+            recorder->recordAddress(outResults[i].code);
+            recorder->recordAddress(outResults[i].diagnostics);
+        }
+        m_recordManager->apendOutput();
+    }
+
+    return result;
+}
+
 IModuleRecorder* SessionRecorder::getModuleRecorder(slang::IModule* module)
 {
     IModuleRecorder* moduleRecord = nullptr;
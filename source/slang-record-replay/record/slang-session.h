@@ -81,6 +81,10 @@ public:
     SLANG_NO_THROW slang::IModule* SLANG_MCALL getLoadedModule(SlangInt index) override;
     SLANG_NO_THROW bool SLANG_MCALL
     isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob) override;
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileBatch(
+        slang::BatchCompileRequest const* requests,
+        SlangInt requestCount,
+        slang::BatchCompileResult* outResults) override;
 
 private:
     SLANG_FORCE_INLINE slang::ISession* asExternal(SessionRecorder* session)
@@ -8,6 +8,20 @@
 
 namespace SlangRecord
 {
+/// A request recorded by `ISession::compileBatch`, with the objects it refers to and
+/// the blobs it produced identified by their recorded address.
+struct BatchCompileRequestRecord
+{
+    ObjectID moduleId = 0;
+    char const* entryPointName = nullptr;
+    SlangStage stage = SLANG_STAGE_NONE;
+    slang::SpecializationArg const* specializationArgs = nullptr;
+    SlangInt specializationArgCount = 0;
+    SlangInt targetIndex = 0;
+    ObjectID outCodeId = 0;
+    ObjectID outDiagnosticsId = 0;
+};
+
 class IDecoderConsumer
 {
 public:
@@ -197,6 +211,11 @@ public:
 
     virtual void ISession_isBinaryModuleUpToDate(ObjectID objectId) { (void)objectId; }
 
+    virtual void ISession_compileBatch(
+        ObjectID objectId,
+        BatchCompileRequestRecord const* requests,
+        SlangInt requestCount) = 0;
+
     // IModule
     virtual void IModule_findEntryPointByName(
         ObjectID objectId,
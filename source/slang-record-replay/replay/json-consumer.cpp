@@ -2354,6 +2354,70 @@ void JsonConsumer::ISession_getLoadedModule(ObjectID objectId, SlangInt index, O
     m_fileStream.flush();
 }
 
+void JsonConsumer::ISession_compileBatch(
+    ObjectID objectId,
+    BatchCompileRequestRecord const* requests,
+    SlangInt requestCount)
+{
+    SANITY_CHECK();
+    Slang::StringBuilder builder;
+    int indent = 0;
+
+    {
+        ScopeWritterForKey scopeWritter(&builder, &indent, "ISession::compileBatch");
+        {
+            _writePair(
+                builder,
+                indent,
+                "this",
+                Slang::StringUtil::makeStringWithFormat("0x%llX", objectId));
+            if (requestCount)
+                _writePair(builder, indent, "requestCount", requestCount);
+            else
+                _writePairNoComma(builder, indent, "requestCount", requestCount);
+            for (SlangInt i = 0; i < requestCount; i++)
+            {
+                auto const& request = requests[i];
+                ScopeWritterForKey scopeWritterForRequest(
+                    &builder,
+                    &indent,
+                    Slang::StringUtil::makeStringWithFormat("requests[%d]", int(i)),
+                    i == requestCount - 1);
+                _writePair(
+                    builder,
+                    indent,
+                    "module",
+                    Slang::StringUtil::makeStringWithFormat("0x%llX", request.moduleId));
+                _writePair(
+                    builder,
+                    indent,
+                    "entryPointName",
+                    request.entryPointName ? request.entryPointName : "nullptr");
+                _writePair(builder, indent, "stage", SlangStageToString(request.stage));
+                _writePair(
+                    builder,
+                    indent,
+                    "specializationArgCount",
+                    request.specializationArgCount);
+                _writePair(builder, indent, "targetIndex", request.targetIndex);
+                _writePair(
+                    builder,
+                    indent,
+                    "outCode",
+                    Slang::StringUtil::makeStringWithFormat("0x%llX", request.outCodeId));
+                _writePairNoComma(
+                    builder,
+                    indent,
+                    "outDiagnostics",
+                    Slang::StringUtil::makeStringWithFormat("0x%llX", request.outDiagnosticsId));
+            }
+        }
+    }
+
+    m_fileStream.write(builder.produceString().begin(), builder.produceString().getLength());
+    m_fileStream.flush();
+}
+
 
 // IModule
 void JsonConsumer::IModule_findEntryPointByName(
@@ -273,6 +273,11 @@ public:
 
     virtual void ISession_isBinaryModuleUpToDate(ObjectID objectId) { (void)objectId; }
 
+    virtual void ISession_compileBatch(
+        ObjectID objectId,
+        BatchCompileRequestRecord const* requests,
+        SlangInt requestCount);
+
     // IModule
     virtual void IModule_findEntryPointByName(
         ObjectID objectId,
@@ -1,5 +1,6 @@
 #include "recordFile-processor.h"
 
+#include "../../core/slang-lz4-compression-system.h"
 #include "../util/record-format.h"
 #include "parameter-decoder.h"
 
@@ -12,7 +13,7 @@ RecordFileProcessor::RecordFileProcessor(const Slang::String& filePath)
     Slang::FileShare fileShare = Slang::FileShare::None;
 
     // Open the record file with read-only access
-    SlangResult res = m_inputStream.init(filePath, fileMode, fileAccess, fileShare);
+    SlangResult res = m_fileStream.init(filePath, fileMode, fileAccess, fileShare);
 
     if (res != SLANG_OK)
     {
@@ -23,10 +24,63 @@ RecordFileProcessor::RecordFileProcessor(const Slang::String& filePath)
         std::abort();
     }
 
+    // A file written with LZ4 framing starts with a frame rather than a record
+    uint32_t magic = 0;
+    size_t readBytes = 0;
+    res = m_fileStream.read(&magic, sizeof(magic), readBytes);
+    m_fileStream.seek(Slang::SeekOrigin::Start, 0);
+    if (res == SLANG_OK && readBytes == sizeof(magic) && magic == MAGIC_LZ4_FRAME)
+    {
+        readLZ4Frames();
+        m_inputStream = &m_memoryStream;
+    }
+
     // Enable log system
     setLogLevel();
 }
 
+void RecordFileProcessor::readLZ4Frames()
+{
+    Slang::List<uint8_t> contents;
+    Slang::List<uint8_t> compressed;
+    for (;;)
+    {
+        LZ4FrameHeader frameHeader;
+        size_t readBytes = 0;
+        SlangResult res = m_fileStream.read(&frameHeader, sizeof(frameHeader), readBytes);
+        if (res != SLANG_OK || readBytes != sizeof(frameHeader) ||
+            frameHeader.magic != MAGIC_LZ4_FRAME)
+        {
+            break;
+        }
+
+        // The last frame can be cut short if the process recording it ended abnormally, in which
+        // case the records before it are still used.
+        compressed.setCount(frameHeader.compressedSizeInBytes);
+        res = m_fileStream.read(compressed.getBuffer(), compressed.getCount(), readBytes);
+        if (res != SLANG_OK || readBytes != size_t(compressed.getCount()))
+        {
+            slangRecordLog(LogLevel::Error, "Record file ends part way through a frame\n");
+            break;
+        }
+
+        const Slang::Index offset = contents.getCount();
+        contents.setCount(offset + frameHeader.uncompressedSizeInBytes);
+        res = Slang::LZ4CompressionSystem::getSingleton()->decompress(
+            compressed.getBuffer(),
+            compressed.getCount(),
+            frameHeader.uncompressedSizeInBytes,
+            contents.getBuffer() + offset);
+        if (res != SLANG_OK)
+        {
+            slangRecordLog(LogLevel::Error, "Failed to decompress a record file frame\n");
+            contents.setCount(offset);
+            break;
+        }
+    }
+    m_memoryStream.swapContents(contents);
+}
+
 bool RecordFileProcessor::processNextBlock()
 {
     FunctionHeader header{};
@@ -45,7 +99,7 @@ bool RecordFileProcessor::processNextBlock()
 
     if (header.dataSizeInBytes)
     {
-        res = m_inputStream.read(m_parameterBuffer.getBuffer(), header.dataSizeInBytes, readBytes);
+        res = m_inputStream->read(m_parameterBuffer.getBuffer(), header.dataSizeInBytes, readBytes);
     }
 
     if (res != SLANG_OK || readBytes != header.dataSizeInBytes)
@@ -62,7 +116,7 @@ bool RecordFileProcessor::processNextBlock()
     if (tailer.dataSizeInBytes)
     {
         m_outputBuffer.reserve(tailer.dataSizeInBytes);
-        res = m_inputStream.read(m_outputBuffer.getBuffer(), tailer.dataSizeInBytes, readBytes);
+        res = m_inputStream->read(m_outputBuffer.getBuffer(), tailer.dataSizeInBytes, readBytes);
 
         if (res != SLANG_OK || readBytes != tailer.dataSizeInBytes)
         {
@@ -94,7 +148,7 @@ bool RecordFileProcessor::processNextBlock()
 bool RecordFileProcessor::processHeader(FunctionHeader& header)
 {
     size_t readBytes = 0;
-    SlangResult res = m_inputStream.read(&header, sizeof(FunctionHeader), readBytes);
+    SlangResult res = m_inputStream->read(&header, sizeof(FunctionHeader), readBytes);
 
     if (res != SLANG_OK || readBytes != sizeof(FunctionHeader))
     {
@@ -112,7 +166,7 @@ bool RecordFileProcessor::processHeader(FunctionHeader& header)
 RecordFileResultCode RecordFileProcessor::processTailer(FunctionTailer& tailer)
 {
     size_t readBytes = 0;
-    SlangResult res = m_inputStream.read(&tailer, sizeof(FunctionTailer), readBytes);
+    SlangResult res = m_inputStream->read(&tailer, sizeof(FunctionTailer), readBytes);
 
     if (res != SLANG_OK || readBytes != sizeof(FunctionTailer))
     {
@@ -125,7 +179,7 @@ RecordFileResultCode RecordFileProcessor::processTailer(FunctionTailer& tailer)
     {
         // revert back to last read position, and clear tailer
         int64_t offset = -(int64_t)sizeof(FunctionTailer);
-        m_inputStream.seek(Slang::SeekOrigin::Current, offset);
+        m_inputStream->seek(Slang::SeekOrigin::Current, offset);
         memset(&tailer, 0, sizeof(FunctionTailer));
         return NOT_EXSIT;
     }
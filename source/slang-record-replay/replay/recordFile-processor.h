@@ -40,7 +40,13 @@ public:
     bool processFunction(FunctionHeader const& header, const uint8_t* buffer, int64_t bufferSize);
 
 private:
-    Slang::FileStream m_inputStream;
+    void readLZ4Frames();
+
+    Slang::FileStream m_fileStream;
+    // Holds the records of a file written with LZ4 framing, once decompressed
+    Slang::OwnedMemoryStream m_memoryStream{Slang::FileAccess::Read};
+    // The stream the records are read from
+    Slang::Stream* m_inputStream = &m_fileStream;
     Slang::List<uint8_t> m_parameterBuffer;
     Slang::List<uint8_t> m_outputBuffer;
 
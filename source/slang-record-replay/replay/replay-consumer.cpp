@@ -1098,6 +1098,63 @@ void ReplayConsumer::ISession_getLoadedModule(
     }
 }
 
+void ReplayConsumer::ISession_compileBatch(
+    ObjectID objectId,
+    BatchCompileRequestRecord const* requests,
+    SlangInt requestCount)
+{
+    InputObjectSanityCheck(objectId);
+
+    slang::ISession* session = getObjectPointer<slang::ISession>(objectId);
+
+    Slang::List<slang::BatchCompileRequest> batchRequests;
+    batchRequests.reserve(requestCount);
+    for (SlangInt i = 0; i < requestCount; i++)
+    {
+        auto const& request = requests[i];
+        slang::BatchCompileRequest batchRequest;
+        if (request.moduleId)
+        {
+            InputObjectSanityCheck(request.moduleId);
+            batchRequest.module = getObjectPointer<slang::IModule>(request.moduleId);
+        }
+        batchRequest.entryPointName = request.entryPointName;
+        batchRequest.stage = request.stage;
+        batchRequest.specializationArgs = request.specializationArgs;
+        batchRequest.specializationArgCount = request.specializationArgCount;
+        batchRequest.targetIndex = request.targetIndex;
+        batchRequests.add(batchRequest);
+    }
+
+    Slang::List<slang::BatchCompileResult> results;
+    results.setCount(requestCount);
+
+    SlangResult res =
+        session->compileBatch(batchRequests.getBuffer(), requestCount, results.getBuffer());
+
+    for (SlangInt i = 0; i < requestCount; i++)
+    {
+        auto& result = results[i];
+        if (result.code && SLANG_SUCCEEDED(result.result))
+        {
+            m_objectMap.addIfNotExists(requests[i].outCodeId, result.code);
+        }
+
+        printDiagnosticMessage(result.diagnostics);
+        if (result.diagnostics)
+            result.diagnostics->release();
+    }
+
+    if (SLANG_FAILED(res))
+    {
+        slangRecordLog(
+            LogLevel::Error,
+            "ISession::compileBatch fails, ret: 0x%X, this: 0x%X\n",
+            res,
+            objectId);
+    }
+}
+
 
 // IModule
 void ReplayConsumer::IModule_findEntryPointByName(
@@ -286,6 +286,11 @@ public:
 
     virtual void ISession_isBinaryModuleUpToDate(ObjectID objectId) override { (void)objectId; }
 
+    virtual void ISession_compileBatch(
+        ObjectID objectId,
+        BatchCompileRequestRecord const* requests,
+        SlangInt requestCount) override;
+
     // IModule
     virtual void IModule_findEntryPointByName(
         ObjectID objectId,
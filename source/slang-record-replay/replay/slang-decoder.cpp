@@ -196,6 +196,9 @@ bool SlangDecoder::processISessionMethods(
     case ApiCallId::ISession_isBinaryModuleUpToDate:
         ISession_isBinaryModuleUpToDate(objectId, parameterBlock);
         break;
+    case ApiCallId::ISession_compileBatch:
+        ISession_compileBatch(objectId, parameterBlock);
+        break;
     }
     return true;
 }
@@ -1540,6 +1543,80 @@ void SlangDecoder::ISession_isBinaryModuleUpToDate(
         __PRETTY_FUNCTION__);
 }
 
+void SlangDecoder::ISession_compileBatch(ObjectID objectId, ParameterBlock const& parameterBlock)
+{
+    size_t readByte = 0;
+    int64_t requestCount = 0;
+    readByte = ParameterDecoder::decodeInt64(
+        parameterBlock.parameterBuffer,
+        parameterBlock.parameterBufferSize,
+        requestCount);
+
+    std::vector<BatchCompileRequestRecord> requests;
+    std::vector<std::vector<slang::SpecializationArg>> specializationArgs;
+    requests.resize(requestCount);
+    specializationArgs.resize(requestCount);
+    for (int64_t i = 0; i < requestCount; i++)
+    {
+        auto& request = requests[i];
+        readByte += ParameterDecoder::decodeAddress(
+            parameterBlock.parameterBuffer + readByte,
+            parameterBlock.parameterBufferSize - readByte,
+            request.moduleId);
+
+        PointerDecoder<char*> entryPointName;
+        readByte += ParameterDecoder::decodeString(
+            parameterBlock.parameterBuffer + readByte,
+            parameterBlock.parameterBufferSize - readByte,
+            entryPointName);
+        request.entryPointName = entryPointName.getPointer();
+
+        readByte += ParameterDecoder::decodeEnumValue(
+            parameterBlock.parameterBuffer + readByte,
+            parameterBlock.parameterBufferSize - readByte,
+            request.stage);
+
+        uint32_t arrayCount = 0;
+        readByte += ParameterDecoder::decodeUint32(
+            parameterBlock.parameterBuffer + readByte,
+            parameterBlock.parameterBufferSize - readByte,
+            arrayCount);
+        specializationArgs[i].resize(arrayCount);
+        readByte += ParameterDecoder::decodeStructArray(
+            parameterBlock.parameterBuffer + readByte,
+            parameterBlock.parameterBufferSize - readByte,
+            specializationArgs[i].data(),
+            arrayCount);
+        request.specializationArgs = specializationArgs[i].data();
+        request.specializationArgCount = arrayCount;
+
+        int64_t targetIndex = 0;
+        readByte += ParameterDecoder::decodeInt64(
+            parameterBlock.parameterBuffer + readByte,
+            parameterBlock.parameterBufferSize - readByte,
+            targetIndex);
+        request.targetIndex = targetIndex;
+    }
+
+    readByte = 0;
+    for (auto& request : requests)
+    {
+        readByte += ParameterDecoder::decodeAddress(
+            parameterBlock.outputBuffer + readByte,
+            parameterBlock.outputBufferSize - readByte,
+            request.outCodeId);
+        readByte += ParameterDecoder::decodeAddress(
+            parameterBlock.outputBuffer + readByte,
+            parameterBlock.outputBufferSize - readByte,
+            request.outDiagnosticsId);
+    }
+
+    for (auto consumer : m_consumers)
+    {
+        consumer->ISession_compileBatch(objectId, requests.data(), SlangInt(requests.size()));
+    }
+}
+
 
 void SlangDecoder::IModule_findEntryPointByName(
     ObjectID objectId,
@@ -149,6 +149,7 @@ public:
     void ISession_getLoadedModuleCount(ObjectID objectId, ParameterBlock const& parameterBlock);
     void ISession_getLoadedModule(ObjectID objectId, ParameterBlock const& parameterBlock);
     void ISession_isBinaryModuleUpToDate(ObjectID objectId, ParameterBlock const& parameterBlock);
+    void ISession_compileBatch(ObjectID objectId, ParameterBlock const& parameterBlock);
 
     void IModule_findEntryPointByName(ObjectID objectId, ParameterBlock const& parameterBlock);
     void IModule_getDefinedEntryPointCount(ObjectID objectId, ParameterBlock const& parameterBlock);
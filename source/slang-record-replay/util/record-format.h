@@ -42,6 +42,7 @@ typedef AddressFormat ObjectID;
 constexpr uint64_t g_globalFunctionHandle = 0;
 constexpr uint32_t MAGIC_HEADER = 0x44414548;
 constexpr uint32_t MAGIC_TAILER = 0x4C494154;
+constexpr uint32_t MAGIC_LZ4_FRAME = 0x345A4C46;
 
 enum IComponentTypeMethodId : uint16_t
 {
@@ -111,6 +112,7 @@ enum ApiCallId : uint32_t
     ISession_getLoadedModuleCount = makeApiCallId(Class_ISession, 0x0011),
     ISession_getLoadedModule = makeApiCallId(Class_ISession, 0x0012),
     ISession_isBinaryModuleUpToDate = makeApiCallId(Class_ISession, 0x0013),
+    ISession_compileBatch = makeApiCallId(Class_ISession, 0x0014),
 
 
     IModule_findEntryPointByName = makeApiCallId(Class_IModule, 0x0001),
@@ -231,5 +233,14 @@ struct FunctionTailer
     uint32_t dataSizeInBytes{0};
 };
 
+// When records are written with LZ4 framing, the record file is a sequence of frames, each
+// holding the LZ4 compressed bytes of one or more whole or partial records.
+struct LZ4FrameHeader
+{
+    uint32_t magic{MAGIC_LZ4_FRAME};
+    uint32_t uncompressedSizeInBytes{0};
+    uint32_t compressedSizeInBytes{0};
+};
+
 } // namespace SlangRecord
 #endif
@@ -11,6 +11,7 @@
 
 constexpr const char* kRecordLayerEnvVar = "SLANG_RECORD_LAYER";
 constexpr const char* kRecordLayerLogLevel = "SLANG_RECORD_LOG_LEVEL";
+constexpr const char* kRecordLayerWriteMode = "SLANG_RECORD_WRITE_MODE";
 
 namespace SlangRecord
 {
@@ -48,6 +49,23 @@ bool isRecordLayerEnabled()
     return false;
 }
 
+RecordWriteMode getRecordWriteMode()
+{
+    Slang::String envVarStr;
+    if (getEnvironmentVariable(kRecordLayerWriteMode, envVarStr))
+    {
+        if (envVarStr == "async")
+        {
+            return RecordWriteMode::Async;
+        }
+        if (envVarStr == "async-lz4")
+        {
+            return RecordWriteMode::AsyncLZ4;
+        }
+    }
+    return RecordWriteMode::Sync;
+}
+
 void setLogLevel()
 {
     // We only want to set the log level once
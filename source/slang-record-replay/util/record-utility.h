@@ -17,7 +17,16 @@ enum LogLevel : unsigned int
     Verbose = 3,
 };
 
+// How the records are written to the record file
+enum class RecordWriteMode
+{
+    Sync,     ///< Each record is written and flushed by the thread making the call
+    Async,    ///< Records are buffered and written by a background thread
+    AsyncLZ4, ///< As Async, with the records written as LZ4 compressed frames
+};
+
 bool isRecordLayerEnabled();
+RecordWriteMode getRecordWriteMode();
 void slangRecordLog(LogLevel logLevel, const char* fmt, ...);
 void setLogLevel();
 } // namespace SlangRecord
@@ -83,6 +83,12 @@ void CompilerOptionSet::writeCommandLineArgs(Session* globalSession, StringBuild
                     sb << "=" << v.stringValue2;
             }
             break;
+        case CompilerOptionName::SpecializeConstant:
+            for (auto v : option.value)
+            {
+                sb << " " << name << " " << v.stringValue << "=" << v.stringValue2;
+            }
+            break;
         case CompilerOptionName::VulkanBindShift: // intValue0 (higher 8 bits): kind;
                                                   // intValue0(higher bits): set; intValue1:
                                                   // shift
@@ -197,6 +203,7 @@ bool CompilerOptionSet::allowDuplicate(CompilerOptionName name)
     case CompilerOptionName::DownstreamArgs:
     case CompilerOptionName::VulkanBindShift:
     case CompilerOptionName::VulkanBindShiftAll:
+    case CompilerOptionName::SpecializeConstant:
         return true;
     }
     return false;
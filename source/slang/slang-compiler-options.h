@@ -330,6 +330,15 @@ struct CompilerOptionSet
         add(CompilerOptionName::MacroDefine, v);
     }
 
+    void addSpecializationConstantValue(String name, String value)
+    {
+        CompilerOptionValue v;
+        v.stringValue = name;
+        v.stringValue2 = value;
+        v.kind = CompilerOptionValueKind::String;
+        add(CompilerOptionName::SpecializeConstant, v);
+    }
+
     void addSearchPath(String path) { add(CompilerOptionName::Include, String(path)); }
 
     bool shouldEmitSPIRVDirectly()
@@ -1170,10 +1170,25 @@ SlangResult passthroughDownstreamDiagnostics(
     return SLANG_OK;
 }
 
+void DownstreamCompileJob::run()
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    result = compiler->compile(options, artifact.writeRef());
+    elapsedTime = (std::chrono::high_resolution_clock::now() - startTime).count() * 0.000000001;
+}
+
 SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>& outArtifact)
 {
     outArtifact.setNull();
 
+    RefPtr<DownstreamCompileJob> job;
+    SLANG_RETURN_ON_FAIL(prepareDownstreamCompile(job));
+    job->run();
+    return finishDownstreamCompile(job, outArtifact);
+}
+
+SlangResult CodeGenContext::prepareDownstreamCompile(RefPtr<DownstreamCompileJob>& outJob)
+{
     auto sink = getSink();
     auto session = getSession();
 
@@ -1184,8 +1199,6 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     RefPtr<ExtensionTracker> extensionTracker = _newExtensionTracker(target);
     PassThroughMode compilerType;
 
-    SliceAllocator allocator;
-
     if (auto endToEndReq = isPassThroughEnabled())
     {
         compilerType = endToEndReq->m_passThrough;
@@ -1229,11 +1242,18 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     List<String> includePaths;
 
     typedef DownstreamCompileOptions CompileOptions;
-    CompileOptions options;
 
-    List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+    // The options, and the data they refer to, are held by the job so that they stay valid
+    // until it is run.
+    RefPtr<DownstreamCompileJob> job = new DownstreamCompileJob;
+    job->compiler = compiler;
+    CompileOptions& options = job->options;
+    SliceAllocator& allocator = job->allocator;
+    List<DownstreamCompileOptions::CapabilityVersion>& requiredCapabilityVersions =
+        job->requiredCapabilityVersions;
+    List<ComPtr<IArtifact>>& libraries = job->libraries;
+
     List<String> compilerSpecificArguments;
-    List<ComPtr<IArtifact>> libraries;
     List<String> libraryPaths;
 
     // Set compiler specific args
@@ -1255,7 +1275,7 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
         }
     }
 
-    ComPtr<IArtifact> sourceArtifact;
+    ComPtr<IArtifact>& sourceArtifact = job->sourceArtifact;
 
     /* This is more convoluted than the other scenarios, because when we invoke C/C++ compiler we
     would ideally like to use the original file. We want to do this because we want includes
@@ -1694,6 +1714,13 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
 
         // Add all of the module libraries
         libraries.addRange(linkage->m_libModules.getBuffer(), linkage->m_libModules.getCount());
+
+        // DXC and FXC resolve `#include`s through the linkage's file system and source manager,
+        // and the module libraries are artifacts shared with every other compile. Anything else
+        // the compile uses belongs to this job.
+        job->canRunConcurrently = compilerType != PassThroughMode::Dxc &&
+                                  compilerType != PassThroughMode::Fxc &&
+                                  linkage->m_libModules.getCount() == 0;
     }
 
     auto program = getProgram();
@@ -1730,18 +1757,24 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     options.libraries = SliceUtil::asSlice(libraries);
     options.libraryPaths = allocator.allocate(libraryPaths);
 
-    // Compile
-    ComPtr<IArtifact> artifact;
-    auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
-    auto downstreamElapsedTime =
-        (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-    getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+    outJob = job;
+    return SLANG_OK;
+}
+
+SlangResult CodeGenContext::finishDownstreamCompile(
+    DownstreamCompileJob* job,
+    ComPtr<IArtifact>& outArtifact)
+{
+    outArtifact.setNull();
 
-    SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), compiler, artifact));
+    getSession()->addDownstreamCompileTime(job->elapsedTime);
+    SLANG_RETURN_ON_FAIL(job->result);
+
+    ComPtr<IArtifact> artifact = job->artifact;
+    SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), job->compiler, artifact));
 
     // Copy over all of the information associated with the source into the output
-    if (sourceArtifact)
+    if (auto sourceArtifact = job->sourceArtifact)
     {
         for (auto associatedArtifact : sourceArtifact->getAssociated())
         {
@@ -1835,6 +1868,30 @@ SlangResult CodeGenContext::_emitEntryPoints(ComPtr<IArtifact>& outArtifact)
     return SLANG_FAIL;
 }
 
+bool CodeGenContext::isDownstreamCompileLastStep()
+{
+    // These are the targets that `_emitEntryPoints` hands straight to
+    // `emitWithDownstreamForEntryPoints`.
+    switch (getTargetFormat())
+    {
+    case CodeGenTarget::SPIRV:
+        return !getTargetProgram()->getOptionSet().shouldEmitSPIRVDirectly();
+    case CodeGenTarget::DXIL:
+    case CodeGenTarget::DXBytecode:
+    case CodeGenTarget::MetalLib:
+    case CodeGenTarget::PTX:
+    case CodeGenTarget::ShaderHostCallable:
+    case CodeGenTarget::ShaderSharedLibrary:
+    case CodeGenTarget::HostExecutable:
+    case CodeGenTarget::HostHostCallable:
+    case CodeGenTarget::HostSharedLibrary:
+    case CodeGenTarget::WGSLSPIRV:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // Do emit logic for a zero or more entry points
 SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
 {
@@ -2096,6 +2153,63 @@ IArtifact* TargetProgram::getOrCreateEntryPointResult(Int entryPointIndex, Diagn
     return _createEntryPointResult(entryPointIndex, sink);
 }
 
+IArtifact* TargetProgram::beginEntryPointResult(
+    Int entryPointIndex,
+    DiagnosticSink* sink,
+    RefPtr<DownstreamCompileJob>& outJob)
+{
+    outJob = nullptr;
+
+    if (entryPointIndex >= m_entryPointResults.getCount())
+        m_entryPointResults.setCount(entryPointIndex + 1);
+
+    if (IArtifact* artifact = m_entryPointResults[entryPointIndex])
+        return artifact;
+
+    if (!getOrCreateIRModuleForLayout(sink))
+    {
+        return nullptr;
+    }
+
+    CodeGenContext::EntryPointIndices entryPointIndices;
+    entryPointIndices.add(entryPointIndex);
+
+    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, nullptr);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    if (!codeGenContext.isDownstreamCompileLastStep())
+    {
+        return _createEntryPointResult(entryPointIndex, sink);
+    }
+
+    CompileTimerRAII recordCompileTime(getProgram()->getLinkage()->getSessionImpl());
+    codeGenContext.prepareDownstreamCompile(outJob);
+    return nullptr;
+}
+
+IArtifact* TargetProgram::endEntryPointResult(
+    Int entryPointIndex,
+    DownstreamCompileJob* job,
+    DiagnosticSink* sink)
+{
+    CodeGenContext::EntryPointIndices entryPointIndices;
+    entryPointIndices.add(entryPointIndex);
+
+    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, nullptr);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    CompileTimerRAII recordCompileTime(getProgram()->getLinkage()->getSessionImpl());
+    ComPtr<IArtifact> artifact;
+    if (SLANG_FAILED(codeGenContext.finishDownstreamCompile(job, artifact)))
+    {
+        return nullptr;
+    }
+    codeGenContext.maybeDumpIntermediate(artifact);
+
+    m_entryPointResults[entryPointIndex] = artifact;
+    return artifact;
+}
+
 void EndToEndCompileRequest::generateOutput(TargetProgram* targetProgram)
 {
     auto program = targetProgram->getProgram();
@@ -2140,6 +2254,10 @@ SlangResult EndToEndCompileRequest::writeContainerToStream(Stream* stream)
 
     options.compressionType = linkage->m_optionSet.getEnumOption<SerialCompressionType>(
         CompilerOptionName::IrCompression);
+    options.frameCompressionType = CompressionSystemType(
+        linkage->m_optionSet.getIntOption(CompilerOptionName::ModuleCompression));
+    options.useIRSerialData =
+        linkage->m_optionSet.getBoolOption(CompilerOptionName::SerialIRViaData);
 
     // If debug information is enabled, enable writing out source locs
     if (_shouldWriteSourceLocs(linkage))
@@ -2685,6 +2803,10 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSeriali
 {
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
+    writeOptions.frameCompressionType = CompressionSystemType(
+        getLinkage()->m_optionSet.getIntOption(CompilerOptionName::ModuleCompression));
+    writeOptions.useIRSerialData =
+        getLinkage()->m_optionSet.getBoolOption(CompilerOptionName::SerialIRViaData);
     OwnedMemoryStream memoryStream(FileAccess::Write);
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(this, writeOptions, &memoryStream));
     *outSerializedBlob = RawBlob::create(
@@ -2698,6 +2820,10 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 {
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
+    writeOptions.frameCompressionType = CompressionSystemType(
+        getLinkage()->m_optionSet.getIntOption(CompilerOptionName::ModuleCompression));
+    writeOptions.useIRSerialData =
+        getLinkage()->m_optionSet.getBoolOption(CompilerOptionName::SerialIRViaData);
     FileStream fileStream;
     SLANG_RETURN_ON_FAIL(fileStream.init(fileName, FileMode::Create));
     return SerialContainerUtil::write(this, writeOptions, &fileStream);
@@ -7,12 +7,14 @@
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-include-system.h"
 #include "../compiler-core/slang-name.h"
+#include "../compiler-core/slang-slice-allocator.h"
 #include "../compiler-core/slang-source-embed-util.h"
 #include "../compiler-core/slang-spirv-core-grammar.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-command-options.h"
 #include "../core/slang-crypto.h"
 #include "../core/slang-file-system.h"
+#include "../core/slang-shared-file-cache.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-std-writers.h"
 #include "slang-capability.h"
@@ -38,6 +40,7 @@ class PtrType;
 class TargetProgram;
 class TargetRequest;
 class TypeLayout;
+class TypeLayoutCache;
 class Artifact;
 
 enum class CompilerMode
@@ -159,6 +162,7 @@ enum class OptimizationLevel : SlangOptimizationLevelIntegral
 };
 
 struct CodeGenContext;
+struct DownstreamCompileJob;
 class EndToEndCompileRequest;
 class FrontEndCompileRequest;
 class Linkage;
@@ -1345,6 +1349,7 @@ public:
     }
 
     SubtypeWitness* getSubtypeWitness() { return m_subtypeWitness; }
+    Int getConformanceIdOverride() { return m_conformanceIdOverride; }
     IRModule* getIRModule() { return m_irModule.Ptr(); }
 
 protected:
@@ -2069,6 +2074,99 @@ struct ContainerTypeKey
     }
 };
 
+/// Identifies the result of specializing a component type with a list of arguments.
+struct SpecializedComponentTypeKey
+{
+    /// The structural identity of the component type being specialized, so that
+    /// specializing a rebuilt copy of it finds the earlier result.
+    SHA1::Digest base;
+    /// The canonical form of each specialization argument.
+    List<Val*> args;
+    bool operator==(SpecializedComponentTypeKey const& other) const
+    {
+        return base == other.base && args == other.args;
+    }
+    Slang::HashCode getHashCode() const
+    {
+        Slang::HashCode hash = base.getHashCode();
+        for (auto arg : args)
+            hash = Slang::combineHash(hash, Slang::getHashCode(arg));
+        return hash;
+    }
+};
+
+/// Identifies the result of linking a component type with options that give values to its
+/// specialization and link-time constants.
+struct LinkedComponentTypeKey
+{
+    /// The structural identity of the component type being linked.
+    SHA1::Digest base;
+    /// The hash of the options given when linking, with the constant values sorted by name.
+    SHA1::Digest optionsHash;
+    bool operator==(LinkedComponentTypeKey const& other) const
+    {
+        return base == other.base && optionsHash == other.optionsHash;
+    }
+    Slang::HashCode getHashCode() const
+    {
+        return Slang::combineHash(base.getHashCode(), optionsHash.getHashCode());
+    }
+};
+
+/// A cache of component types created from other component types. Each of them holds on to the
+/// code generated for it, so only the most recently used ones are kept.
+template<typename TKey>
+class ComponentTypeCache
+{
+public:
+    /// The number of component types that are kept
+    static const Index kMaxCount = 64;
+
+    ComponentType* tryGet(const TKey& key)
+    {
+        auto entry = m_entries.tryGetValue(key);
+        if (!entry)
+            return nullptr;
+        entry->lastUse = ++m_useCount;
+        return entry->componentType;
+    }
+
+    void add(const TKey& key, ComponentType* componentType)
+    {
+        if (m_entries.getCount() >= kMaxCount && !m_entries.containsKey(key))
+        {
+            // Evict the least recently used
+            const TKey* oldestKey = nullptr;
+            uint64_t oldestUse = 0;
+            for (const auto& [entryKey, entry] : m_entries)
+            {
+                if (!oldestKey || entry.lastUse < oldestUse)
+                {
+                    oldestKey = &entryKey;
+                    oldestUse = entry.lastUse;
+                }
+            }
+            const TKey evictedKey = *oldestKey;
+            m_entries.remove(evictedKey);
+        }
+        Entry entry;
+        entry.componentType = componentType;
+        entry.lastUse = ++m_useCount;
+        m_entries[key] = entry;
+    }
+
+    Index getCount() const { return m_entries.getCount(); }
+
+private:
+    struct Entry
+    {
+        RefPtr<ComponentType> componentType;
+        uint64_t lastUse = 0;
+    };
+    Dictionary<TKey, Entry> m_entries;
+    uint64_t m_useCount = 0;
+};
+
 /// A dictionary of currently loaded modules. Used by `findOrImportModule` to
 /// lookup additional loaded modules.
 typedef Dictionary<Name*, Module*> LoadedModuleDictionary;
@@ -2080,6 +2178,7 @@ enum ModuleBlobType
 };
 
 struct SerialContainerDataModule;
+struct PrefetchedBinaryModule;
 
 /// A context for loading and re-using code modules.
 class Linkage : public RefObject, public slang::ISession
@@ -2157,6 +2256,10 @@ public:
     virtual SLANG_NO_THROW slang::IModule* SLANG_MCALL getLoadedModule(SlangInt index) override;
     virtual SLANG_NO_THROW bool SLANG_MCALL
     isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob) override;
+    SLANG_NO_THROW SlangResult SLANG_MCALL compileBatch(
+        slang::BatchCompileRequest const* requests,
+        SlangInt requestCount,
+        slang::BatchCompileResult* outResults) override;
 
     // Updates the supplied builder with linkage-related information, which includes preprocessor
     // defines, the compiler version, and other compiler options. This is then merged with the hash
@@ -2205,6 +2308,19 @@ public:
     // Cache for container types.
     Dictionary<ContainerTypeKey, Type*> m_containerTypes;
 
+    // Cache of the component types created by `ComponentType::specialize`, so that
+    // specializing a component type with the same arguments again gives the same
+    // component type, along with any code already generated for it.
+    //
+    // The cache is held by the linkage rather than the base component type, so that
+    // a program that is rebuilt from the same parts also finds the earlier results.
+    ComponentTypeCache<SpecializedComponentTypeKey> m_specializedComponentTypes;
+
+    // Cache of the component types created by `ComponentType::linkWithOptions` when the
+    // options give values to specialization or link-time constants, so that asking for
+    // the same variant again reuses the code already generated for it.
+    ComponentTypeCache<LinkedComponentTypeKey> m_constantSpecializedComponentTypes;
+
     // cache used by type checking, implemented in check.cpp
     TypeCheckingCache* getTypeCheckingCache();
     void destroyTypeCheckingCache();
@@ -2285,7 +2401,8 @@ public:
         ISlangBlob* fileContentsBlob,
         SourceLoc const& loc,
         DiagnosticSink* sink,
-        const LoadedModuleDictionary* additionalLoadedModules);
+        const LoadedModuleDictionary* additionalLoadedModules,
+        PrefetchedBinaryModule* prefetchedModule = nullptr);
     RefPtr<Module> loadDeserializedModule(
         Name* name,
         const PathInfo& filePathInfo,
@@ -2305,6 +2422,34 @@ public:
 
     bool isBinaryModuleUpToDate(String fromPath, RiffContainer* container);
 
+    /// Load the precompiled modules imported (directly or indirectly) by the module in
+    /// `container`. The import graph is found from the module headers, the IR of the modules is
+    /// read concurrently, and the modules are then added to the linkage in dependency order.
+    ///
+    /// This only reads ahead, so nothing is diagnosed. A module that can't be found or loaded here
+    /// is left for `findOrImportModule` to diagnose when it is imported.
+    void _loadBinaryModuleImports(
+        RiffContainer* container,
+        Name* moduleName,
+        const PathInfo& filePathInfo,
+        SourceLoc const& loc,
+        const LoadedModuleDictionary* additionalLoadedModules);
+
+    /// Find the file of the module `name` imported at `loc`, either its precompiled module or
+    /// its source. The file is looked for relative to the file of the import site, then on the
+    /// search paths.
+    SlangResult _findModuleFile(
+        IncludeSystem& includeSystem,
+        Name* name,
+        SourceLoc const& loc,
+        bool isBinaryModule,
+        bool translateUnderScore,
+        PathInfo& outFilePathInfo);
+
+    /// Get a location that represents the precompiled module at `modulePath`. The modules it
+    /// imports are found as if imported at this location.
+    SourceLoc getBinaryModuleLoc(String const& modulePath);
+
     RefPtr<Module> findOrImportModule(
         Name* name,
         SourceLoc const& loc,
@@ -2694,6 +2839,27 @@ public:
         DiagnosticSink* sink,
         EndToEndCompileRequest* endToEndReq = nullptr);
 
+    /// Like `getOrCreateEntryPointResult`, except that if the last step of creating the
+    /// result is a compile by a downstream compiler, that compile is returned in `outJob`
+    /// instead of being run.
+    ///
+    /// The caller runs the job, possibly on another thread, and then calls
+    /// `endEntryPointResult` to get the result. If `outJob` is null the result has already
+    /// been created, and is returned.
+    ///
+    IArtifact* beginEntryPointResult(
+        Int entryPointIndex,
+        DiagnosticSink* sink,
+        RefPtr<DownstreamCompileJob>& outJob);
+
+    /// Finish creating the result for an entry point, once the `job` returned by
+    /// `beginEntryPointResult` has been run.
+    ///
+    IArtifact* endEntryPointResult(
+        Int entryPointIndex,
+        DownstreamCompileJob* job,
+        DiagnosticSink* sink);
+
     RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
     RefPtr<IRModule> getExistingIRModuleForLayout() { return m_irModuleForLayout; }
@@ -2763,6 +2929,34 @@ class ExtensionTracker : public RefObject
 public:
 };
 
+/// A compile by a downstream compiler, set up by a `CodeGenContext` to be run separately.
+///
+/// Setting up the compile and reporting its outcome use the state of the session, but
+/// running it (see `canRunConcurrently`) only uses the state held by the job.
+struct DownstreamCompileJob : public RefObject
+{
+    /// Run the compile, storing its outcome in the job.
+    void run();
+
+    IDownstreamCompiler* compiler = nullptr;
+    DownstreamCompileOptions options;
+
+    /// Storage for the data that `options` refers to
+    SliceAllocator allocator;
+    List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+    List<ComPtr<IArtifact>> libraries;
+    ComPtr<IArtifact> sourceArtifact;
+
+    /// True if `run` doesn't use anything shared with other jobs or with the session, so jobs
+    /// can be run on different threads at the same time.
+    bool canRunConcurrently = false;
+
+    /// The outcome of `run`
+    SlangResult result = SLANG_OK;
+    ComPtr<IArtifact> artifact;
+    double elapsedTime = 0;
+};
+
 /// A context for code generation in the compiler back-end
 struct CodeGenContext
 {
@@ -2878,6 +3072,18 @@ public:
 
     SlangResult emitPrecompiledDownstreamIR(ComPtr<IArtifact>& outArtifact);
 
+    /// True if `emitEntryPoints` compiles the entry points with a downstream compiler, as the
+    /// last step, so that `prepareDownstreamCompile` can be used instead.
+    bool isDownstreamCompileLastStep();
+
+    /// Do everything `emitEntryPoints` would up to the downstream compile, and return that
+    /// compile in `outJob` without running it.
+    SlangResult prepareDownstreamCompile(RefPtr<DownstreamCompileJob>& outJob);
+
+    /// Report the outcome of a job from `prepareDownstreamCompile` that has been run, and get
+    /// the artifact it produced.
+    SlangResult finishDownstreamCompile(DownstreamCompileJob* job, ComPtr<IArtifact>& outArtifact);
+
     void maybeDumpIntermediate(IArtifact* artifact);
 
     // Used to cause instructions available in precompiled blobs to be
@@ -3528,6 +3734,13 @@ public:
 
     RefPtr<SharedASTBuilder> m_sharedASTBuilder;
 
+    /// Get the file cache shared by all sessions created with
+    /// `kSessionFlags_UseSharedFileCache`.
+    SharedFileCache* getSharedFileCache();
+
+    /// Get the cache of type layouts shared by all sessions
+    TypeLayoutCache* getTypeLayoutCache();
+
     SPIRVCoreGrammarInfo& getSPIRVCoreGrammarInfo()
     {
         if (!spirvCoreGrammarInfo)
@@ -3621,6 +3834,12 @@ private:
 
     double m_downstreamCompileTime = 0.0;
     double m_totalCompileTime = 0.0;
+
+    /// File contents shared across sessions. See `getSharedFileCache`.
+    ComPtr<SharedFileCache> m_sharedFileCache;
+
+    /// Type layouts shared across sessions. See `getTypeLayoutCache`.
+    RefPtr<TypeLayoutCache> m_typeLayoutCache;
 };
 
 const char* getBuiltinModuleNameStr(slang::BuiltinModuleName name);
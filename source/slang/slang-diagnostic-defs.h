@@ -2245,6 +2245,12 @@ DIAGNOSTIC(
 
 DIAGNOSTIC(41903, Error, unableToSizeOf, "sizeof could not be performed for type '$0'.")
 DIAGNOSTIC(41904, Error, unableToAlignOf, "alignof could not be performed for type '$0'.")
+DIAGNOSTIC(
+    41905,
+    Warning,
+    checkpointBudgetExceeded,
+    "'$0' needs $1 bytes to checkpoint values that can't be recomputed, which is over the "
+    "checkpoint budget of $2 bytes")
 
 DIAGNOSTIC(
     42001,
@@ -2260,6 +2266,11 @@ DIAGNOSTIC(
     "use [PreferRecompute(SideEffectBehavior.Allow)], or mark function with [__NoSideEffect]")
 
 DIAGNOSTIC(45001, Error, unresolvedSymbol, "unresolved external symbol '$0'.")
+DIAGNOSTIC(
+    45002,
+    Error,
+    invalidSpecializationConstantValue,
+    "'$0' is not a valid value for constant '$1'.")
 
 DIAGNOSTIC(
     41201,
@@ -2540,6 +2551,12 @@ DIAGNOSTIC(
     unsupportedSpecializationConstantForNumThreads,
     "Specialization constants are not supported in the 'numthreads' attribute for the current "
     "target.")
+DIAGNOSTIC(
+    55206,
+    Error,
+    groupSyncNotSupportedInHostCode,
+    "'$0' is only supported in compute kernels on CPU, which are compiled for a shader target "
+    "such as 'shader-host-callable' or 'shader-sharedlib'.")
 DIAGNOSTIC(
     56001,
     Error,
@@ -2609,6 +2626,86 @@ DIAGNOSTIC(
     "$0 bytes ($1) used to checkpoint the following item:")
 DIAGNOSTIC(-1, Note, reportCheckpointCounter, "$0 bytes ($1) used for a loop counter here:")
 DIAGNOSTIC(-1, Note, reportCheckpointNone, "no checkpoint contexts to report")
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportCheckpointBudget,
+    "checkpoint budget of $1 bytes for '$0': $2 bytes stored ($3 bytes for values that can't be "
+    "recomputed), estimated recompute cost $4")
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportCheckpointBudgetStored,
+    "$0 bytes used to store the following item, instead of recomputing it (estimated cost $1):")
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportCheckpointBudgetRecomputed,
+    "the following item is recomputed (estimated cost $0), instead of storing $1 bytes:")
+
+// Inlining reporting
+DIAGNOSTIC(-1, Note, inlinedCall, "inlined call to '$0' into '$1' (size $2, threshold $3)")
+DIAGNOSTIC(
+    -1,
+    Note,
+    notInlinedOverThreshold,
+    "did not inline call to '$0' into '$1': size $2 is over the threshold of $3")
+DIAGNOSTIC(
+    -1,
+    Note,
+    notInlinedCallerTooLarge,
+    "did not inline call to '$0' into '$1': '$1' would grow to $2, over the limit of $3")
+DIAGNOSTIC(
+    -1,
+    Note,
+    notInlinedRecursive,
+    "did not inline call to '$0' into '$1': '$0' is recursive")
+DIAGNOSTIC(
+    -1,
+    Note,
+    notInlinedNoInline,
+    "did not inline call to '$0' into '$1': '$0' is marked [noinline]")
+
+// Dynamic dispatch reporting
+DIAGNOSTIC(
+    -1,
+    Note,
+    dynamicDispatchCalledDirectly,
+    "dynamic call to '$0' can only reach the implementation for '$1', and is called directly")
+DIAGNOSTIC(
+    -1,
+    Note,
+    dynamicDispatchNarrowed,
+    "dynamic call to '$0' can only reach $1 of the $2 types that conform to '$3'")
+DIAGNOSTIC(
+    -1,
+    Note,
+    dynamicDispatchSummary,
+    "$0 dynamic dispatch call sites: $1 called directly, $2 narrowed, $3 dispatched over every "
+    "conforming type")
+
+// AnyValue packing reporting
+DIAGNOSTIC(
+    -1,
+    Note,
+    anyValuePackedSize,
+    "'$0' is packed into $1 bytes of interface value storage, $2 bytes with natural alignment")
+
+// Loop unrolling reporting
+DIAGNOSTIC(-1, Note, unrolledLoop, "unrolled loop with $0 iterations (size $1, budget $2)")
+DIAGNOSTIC(
+    -1,
+    Note,
+    loopNotUnrolledOverBudget,
+    "did not unroll loop with $0 iterations: size $1 is over the budget of $2")
+
+// Register pressure reporting
+DIAGNOSTIC(
+    -1,
+    Note,
+    registerPressureReduced,
+    "'$0' has an estimated peak of $1 live registers before sinking and rematerialization, and $2 "
+    "after")
 
 // 9xxxx - Documentation generation
 DIAGNOSTIC(
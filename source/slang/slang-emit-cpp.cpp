@@ -5,6 +5,7 @@
 #include "../core/slang-token-reader.h"
 #include "../core/slang-writer.h"
 #include "slang-emit-source-writer.h"
+#include "slang-ir-call-graph.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-util.h"
 #include "slang-mangled-lexer.h"
@@ -1004,6 +1005,13 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
         // Because the workhorse function doesn't have the right signature to service
         // general-purpose calls, it is being emitted with a `_` prefix.
         //
+        // When the threads of a group are run in blocks of lanes, the workhorse has to be
+        // inlined into the loop over the lanes for the loop to be vectorized.
+        if (_getLaneCount() > 1)
+        {
+            m_writer->emit("SLANG_LANE_INLINE ");
+        }
+
         StringBuilder prefixName;
         prefixName << "_" << name;
         emitType(resultType, prefixName);
@@ -1347,6 +1355,19 @@ bool CPPSourceEmitter::tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOut
             return false;
         }
 
+    case kIROp_GroupMemoryBarrierWithGroupSync:
+        {
+            // On CPU the barrier is given the thread group, see `_slang_groupSync`
+            if (inst->getOperandCount() == 0)
+            {
+                return false;
+            }
+            m_writer->emit("_slang_groupSync(");
+            emitOperand(inst->getOperand(0), getInfo(EmitOp::General));
+            m_writer->emit(")");
+            return true;
+        }
+
     case kIROp_InOutImplicitCast:
     case kIROp_OutImplicitCast:
         {
@@ -2081,14 +2102,24 @@ static void _calcAxisOrder(
 
 void CPPSourceEmitter::_emitEntryPointGroup(
     const Int sizeAlongAxis[kThreadGroupAxisCount],
+    Int laneCount,
     const String& funcName)
 {
     List<AxisWithSize> axes;
     _calcAxisOrder(sizeAlongAxis, false, axes);
 
+    // If lanes are enabled, the inner most axis is run in blocks of lanes, instead of one
+    // thread at a time. Only do so if there are enough threads along the axis to fill a block.
+    Index loopCount = axes.getCount();
+    const bool useLanes = laneCount > 1 && loopCount > 0 && axes.getLast().size >= laneCount;
+    if (useLanes)
+    {
+        loopCount--;
+    }
+
     // Open all the loops
     StringBuilder builder;
-    for (Index i = 0; i < axes.getCount(); ++i)
+    for (Index i = 0; i < loopCount; ++i)
     {
         const auto& axis = axes[i];
         builder.clear();
@@ -2103,19 +2134,121 @@ void CPPSourceEmitter::_emitEntryPointGroup(
         m_writer->emit(builder);
     }
 
-    // just call at inner loop point
-    m_writer->emit("_");
-    m_writer->emit(funcName);
-    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+    if (useLanes)
+    {
+        const auto& axis = axes.getLast();
+        _emitEntryPointGroupLanes(axis.axis, axis.size, laneCount, funcName);
+    }
+    else
+    {
+        // just call at inner loop point
+        _emitEntryPointThreadCall(funcName, "&threadInput");
+    }
 
     // Close all the loops
-    for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
+    for (Index i = loopCount - 1; i >= 0; --i)
     {
         m_writer->dedent();
         m_writer->emit("}\n");
     }
 }
 
+void CPPSourceEmitter::_emitEntryPointGroupLanes(
+    int axis,
+    Int size,
+    Int laneCount,
+    const String& funcName)
+{
+    const char elem[2] = {s_xyzwNames[axis], 0};
+    const Int blockedSize = size - (size % laneCount);
+
+    // Each block runs `laneCount` threads in a loop with a constant trip count, that the
+    // workhorse function is inlined into, and that is marked as worth vectorizing. The C++
+    // compiler decides whether the iterations can safely run as the lanes of SIMD vectors.
+    StringBuilder builder;
+    builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << blockedSize << "; "
+            << elem << " += " << laneCount << ")\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+
+    builder.clear();
+    builder << "SLANG_VECTORIZE_LANES\n";
+    builder << "for (uint32_t lane = 0; lane < " << laneCount << "; ++lane)\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+
+    builder.clear();
+    builder << m_threadVaryingInputTypeName << " laneInput = threadInput;\n";
+    builder << "laneInput.groupThreadID." << elem << " = " << elem << " + lane;\n";
+    m_writer->emit(builder);
+    _emitEntryPointThreadCall(funcName, "&laneInput");
+
+    m_writer->dedent();
+    m_writer->emit("}\n");
+    m_writer->dedent();
+    m_writer->emit("}\n");
+
+    // The threads that don't fill a block are run one at a time
+    if (blockedSize < size)
+    {
+        builder.clear();
+        builder << "for (uint32_t " << elem << " = " << blockedSize << "; " << elem << " < "
+                << size << "; ++" << elem << ")\n{\n";
+        m_writer->emit(builder);
+        m_writer->indent();
+
+        builder.clear();
+        builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        m_writer->emit(builder);
+        _emitEntryPointThreadCall(funcName, "&threadInput");
+
+        m_writer->dedent();
+        m_writer->emit("}\n");
+    }
+}
+
+void CPPSourceEmitter::_emitEntryPointThreadCall(
+    const String& funcName,
+    const char* threadInputName)
+{
+    StringBuilder builder;
+    builder << "_" << funcName << "(" << threadInputName << ", entryPointParams, globalParams";
+    if (m_entryPointHasGroupShared)
+    {
+        builder << ", &groupShared";
+    }
+    builder << ");\n";
+    m_writer->emit(builder);
+}
+
+void CPPSourceEmitter::_emitEntryPointGroupFibers(
+    const Int sizeAlongAxis[kThreadGroupAxisCount],
+    const String& funcName)
+{
+    // Each thread of the group runs on its own fiber, and a barrier switches to the next
+    // thread that hasn't reached it yet. See `_slang_runGroupFibers` in the prelude.
+    StringBuilder builder;
+    builder << "_slang_runGroupFibers(threadInput, " << sizeAlongAxis[0] << ", "
+            << sizeAlongAxis[1] << ", " << sizeAlongAxis[2]
+            << ", [&](" << m_threadVaryingInputTypeName << "* fiberInput)\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+    _emitEntryPointThreadCall(funcName, "fiberInput");
+    m_writer->dedent();
+    m_writer->emit("});\n");
+}
+
+Int CPPSourceEmitter::_getLaneCount()
+{
+    if (m_target != CodeGenTarget::CPPSource && m_target != CodeGenTarget::HostCPPSource)
+    {
+        return 0;
+    }
+    const Int laneCount =
+        getTargetProgram()->getOptionSet().getIntOption(CompilerOptionName::CPUSIMDWidth);
+    return laneCount > 1 ? laneCount : 0;
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(
     const Int sizeAlongAxis[kThreadGroupAxisCount],
     const String& funcName)
@@ -2220,6 +2353,89 @@ void CPPSourceEmitter::_emitForwardDeclarations(const List<EmitAction>& actions)
     }
 }
 
+// Returns true if `func` synchronizes the threads of a group. On CPU the barriers are given the
+// group to synchronize when the entry point parameters are legalized.
+static bool _hasGroupBarrier(IRFunc* func)
+{
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (inst->getOp() == kIROp_GroupMemoryBarrierWithGroupSync &&
+                inst->getOperandCount() > 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+// Returns the entry points that synchronize the threads of a group, directly or through the
+// functions they call.
+static HashSet<IRFunc*> _getEntryPointsWithGroupBarriers(IRModule* module)
+{
+    Dictionary<IRInst*, HashSet<IRFunc*>> referencingEntryPoints;
+    buildEntryPointReferenceGraph(referencingEntryPoints, module);
+
+    HashSet<IRFunc*> entryPoints;
+    bool hasUnreachedBarrier = false;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func || !_hasGroupBarrier(func))
+            continue;
+        if (auto callers = getReferencingEntryPoints(referencingEntryPoints, func))
+        {
+            for (auto entryPoint : *callers)
+                entryPoints.add(entryPoint);
+        }
+        else
+        {
+            hasUnreachedBarrier = true;
+        }
+    }
+
+    // A function that no entry point calls directly may still be called through a witness table
+    // or a function pointer, so its barriers have to be assumed to be reachable from anywhere.
+    if (hasUnreachedBarrier)
+    {
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            if (globalInst->getOp() == kIROp_Func &&
+                globalInst->findDecoration<IREntryPointDecoration>())
+                entryPoints.add(as<IRFunc>(globalInst));
+        }
+    }
+    return entryPoints;
+}
+
+// Returns true if the entry points take a `ComputeGroupThreadVaryingInput` rather than a
+// `ComputeThreadVaryingInput`, which is the case when the module synchronizes thread groups.
+static bool _usesGroupThreadVaryingInput(IRModule* module)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (!as<IRStructType>(globalInst))
+            continue;
+        auto decor = globalInst->findDecoration<IRTargetIntrinsicDecoration>();
+        if (decor && decor->getDefinition() == toSlice("ComputeGroupThreadVaryingInput"))
+            return true;
+    }
+    return false;
+}
+
+// Returns the type of the `groupshared` storage taken by the entry point, or nullptr if
+// it doesn't take any. It is the last parameter, added by `introduceExplicitGlobalContext`.
+static IRType* _getGroupSharedType(IRFunc* func)
+{
+    auto lastParam = func->getLastParam();
+    auto ptrType = lastParam ? as<IRPtrType>(lastParam->getDataType()) : nullptr;
+    if (ptrType && ptrType->getAddressSpace() == AddressSpace::GroupShared)
+    {
+        return ptrType->getValueType();
+    }
+    return nullptr;
+}
+
 void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 {
     SLANG_UNUSED(sink);
@@ -2266,6 +2482,11 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 
     // Finally we need to output dll entry points
 
+    const auto entryPointsWithGroupBarriers = _getEntryPointsWithGroupBarriers(module);
+    const bool usesGroupThreadVaryingInput = _usesGroupThreadVaryingInput(module);
+    m_threadVaryingInputTypeName = usesGroupThreadVaryingInput ? "ComputeGroupThreadVaryingInput"
+                                                               : "ComputeThreadVaryingInput";
+
     for (auto action : actions)
     {
         if (action.level == EmitAction::Level::Definition && _isFunction(action.inst->getOp()))
@@ -2281,6 +2502,20 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                 getComputeThreadGroupSize(func, groupThreadSize);
 
                 String funcName = getName(func);
+                const bool hasGroupBarriers = entryPointsWithGroupBarriers.contains(func);
+
+                // The `groupshared` variables are stored in a local of the functions that run
+                // a thread or a group, and passed to the threads of the group
+                auto groupSharedType = _getGroupSharedType(func);
+                m_entryPointHasGroupShared = groupSharedType != nullptr;
+                auto emitGroupSharedDecl = [&]()
+                {
+                    if (groupSharedType)
+                    {
+                        emitType(groupSharedType, String("groupShared"));
+                        m_writer->emit(";\n");
+                    }
+                };
 
                 {
                     StringBuilder builder;
@@ -2293,9 +2528,21 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                         threadFuncName,
                         UnownedStringSlice::fromLiteral("ComputeThreadVaryingInput"));
 
-                    m_writer->emit("_");
-                    m_writer->emit(funcName);
-                    m_writer->emit("(varyingInput, entryPointParams, globalParams);\n");
+                    emitGroupSharedDecl();
+                    if (usesGroupThreadVaryingInput)
+                    {
+                        // A single thread has no group to synchronize with, so barriers do
+                        // nothing
+                        m_writer->emit("ComputeGroupThreadVaryingInput threadInput = {};\n");
+                        m_writer->emit("threadInput.groupID = varyingInput->groupID;\n");
+                        m_writer->emit(
+                            "threadInput.groupThreadID = varyingInput->groupThreadID;\n");
+                        _emitEntryPointThreadCall(funcName, "&threadInput");
+                    }
+                    else
+                    {
+                        _emitEntryPointThreadCall(funcName, "varyingInput");
+                    }
 
                     _emitEntryPointDefinitionEnd(func);
                 }
@@ -2313,10 +2560,19 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                         groupFuncName,
                         UnownedStringSlice::fromLiteral("ComputeVaryingInput"));
 
-                    m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
+                    m_writer->emit(m_threadVaryingInputTypeName);
+                    m_writer->emit(" threadInput = {};\n");
                     m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
+                    emitGroupSharedDecl();
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                    if (hasGroupBarriers)
+                    {
+                        _emitEntryPointGroupFibers(groupThreadSize, funcName);
+                    }
+                    else
+                    {
+                        _emitEntryPointGroup(groupThreadSize, _getLaneCount(), funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
@@ -117,7 +117,19 @@ protected:
     void _emitEntryPointDefinitionEnd(IRFunc* func);
     void _emitEntryPointGroup(
         const Int sizeAlongAxis[kThreadGroupAxisCount],
+        Int laneCount,
         const String& funcName);
+    void _emitEntryPointGroupLanes(int axis, Int size, Int laneCount, const String& funcName);
+    /// Emit a call of the function implementing the entry point for one thread.
+    void _emitEntryPointThreadCall(const String& funcName, const char* threadInputName);
+    /// Emit the threads of a group run as fibers, so they can synchronize at barriers.
+    void _emitEntryPointGroupFibers(
+        const Int sizeAlongAxis[kThreadGroupAxisCount],
+        const String& funcName);
+
+    /// Get the number of threads of a compute thread group run per iteration, or 0 if they
+    /// are run one at a time.
+    Int _getLaneCount();
     void _emitEntryPointGroupRange(
         const Int sizeAlongAxis[kThreadGroupAxisCount],
         const String& funcName);
@@ -151,6 +163,12 @@ protected:
     List<IRWitnessTable*> pendingWitnessTableDefinitions;
 
     bool m_hasString = false;
+
+    // True if the entry point being emitted takes the `groupshared` storage of its group
+    bool m_entryPointHasGroupShared = false;
+
+    // The type of the varying input that the entry points take for each thread
+    const char* m_threadVaryingInputTypeName = "ComputeThreadVaryingInput";
 };
 
 } // namespace Slang
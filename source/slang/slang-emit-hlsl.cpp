@@ -1068,9 +1068,10 @@ bool HLSLSourceEmitter::tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOu
         {
             // Similar to the case for a load, we want to specialize
             // the generated code for the case where we store a `uint`
-            // or a vector of `uint`.
+            // or a vector of `uint`, which we determine from the type
+            // of the value being stored (the store itself has no type).
             //
-            auto elementType = inst->getDataType();
+            auto elementType = inst->getOperand(inst->getOperandCount() - 1)->getDataType();
             IRIntegerValue elementCount = 1;
             if (auto vecType = as<IRVectorType>(elementType))
             {
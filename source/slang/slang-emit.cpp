@@ -80,6 +80,7 @@
 #include "slang-ir-metal-legalize.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
 #include "slang-ir-pytorch-cpp-binding.h"
+#include "slang-ir-reduce-register-pressure.h"
 #include "slang-ir-redundancy-removal.h"
 #include "slang-ir-resolve-texture-format.h"
 #include "slang-ir-resolve-varying-input-ref.h"
@@ -588,6 +589,42 @@ static void validateMatrixDimensions(DiagnosticSink* sink, IRModule* module)
     }
 }
 
+// Host code isn't run in thread groups, so it can't have `groupshared` variables or barriers. Only
+// compute kernels, which are emitted as `CPPSource`, run the threads of a group together.
+static void validateGroupSyncForHostCPU(DiagnosticSink* sink, IRModule* module)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto globalVar = as<IRGlobalVar>(globalInst))
+        {
+            auto ptrType = as<IRPtrTypeBase>(globalVar->getDataType());
+            if (ptrType && ptrType->getAddressSpace() == AddressSpace::GroupShared)
+            {
+                sink->diagnose(
+                    globalVar->sourceLoc,
+                    Diagnostics::groupSyncNotSupportedInHostCode,
+                    "groupshared");
+            }
+        }
+        else if (auto func = as<IRFunc>(globalInst))
+        {
+            for (auto block : func->getBlocks())
+            {
+                for (auto inst : block->getChildren())
+                {
+                    if (inst->getOp() == kIROp_GroupMemoryBarrierWithGroupSync)
+                    {
+                        sink->diagnose(
+                            inst->sourceLoc,
+                            Diagnostics::groupSyncNotSupportedInHostCode,
+                            "GroupMemoryBarrierWithGroupSync");
+                    }
+                }
+            }
+        }
+    }
+}
+
 Result linkAndOptimizeIR(
     CodeGenContext* codeGenContext,
     LinkingAndOptimizationOptions const& options,
@@ -1057,6 +1094,17 @@ Result linkAndOptimizeIR(
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
     performForceInlining(irModule);
 
+    // At higher optimization levels, also inline the calls that a cost model judges to be
+    // worth it. The simplification below then folds the constant arguments into the inlined
+    // bodies.
+    if (!fastIRSimplificationOptions.minimalOptimization)
+    {
+        performCostModelInlining(
+            irModule,
+            CostModelInliningOptions::getForTarget(targetProgram),
+            sink);
+    }
+
     // Push `structuredBufferLoad` to the end of access chain to avoid loading unnecessary data.
     if (isKhronosTarget(targetRequest) || isMetalTarget(targetRequest) ||
         isWGPUTarget(targetRequest))
@@ -1073,6 +1121,14 @@ Result linkAndOptimizeIR(
     else
     {
         simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+
+        // At higher optimization levels, unroll the small loops whose trip count is now known,
+        // so that the targets that don't unroll them downstream see straight-line code.
+        unrollConstantTripCountLoopsInModule(
+            targetProgram,
+            irModule,
+            AutoLoopUnrollOptions::getForTarget(targetProgram),
+            sink);
     }
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
@@ -1350,6 +1406,21 @@ Result linkAndOptimizeIR(
             break;
         }
 
+        // Adjacent fields that end up being loaded or stored one at a time can
+        // instead be accessed together, as `uint` vectors of up to this many bytes.
+        // Metal only supports byte-address buffer accesses of a single `uint`, so
+        // there it is only the fields that share a word that are coalesced.
+        //
+        if (target == CodeGenTarget::HLSL || isKhronosTarget(targetRequest) ||
+            isCPUTarget(targetRequest))
+        {
+            byteAddressBufferOptions.maxCoalescedLoadStoreSize = 16;
+        }
+        else if (isMetalTarget(targetRequest))
+        {
+            byteAddressBufferOptions.maxCoalescedLoadStoreSize = 4;
+        }
+
         legalizeByteAddressBufferOps(
             session,
             targetProgram,
@@ -1446,6 +1517,11 @@ Result linkAndOptimizeIR(
             legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
         }
         break;
+    case CodeGenTarget::HostCPPSource:
+        {
+            validateGroupSyncForHostCPU(sink, irModule);
+        }
+        break;
 
     case CodeGenTarget::CUDASource:
         {
@@ -1654,6 +1730,18 @@ Result linkAndOptimizeIR(
         simplifyIR(targetProgram, irModule, simplificationOptions, sink);
     }
 
+    // Earlier passes can leave values computed far from where they are used, which keeps them
+    // live, and in registers, for longer than needed. At higher optimization levels, move them
+    // closer to their uses while the IR is still in SSA form.
+    if (!fastIRSimplificationOptions.minimalOptimization &&
+        targetProgram->getOptionSet().getOptimizationLevel() >= OptimizationLevel::High)
+    {
+        reduceRegisterPressure(
+            irModule,
+            targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ReportRegisterPressure),
+            sink);
+    }
+
     // As a late step, we need to take the SSA-form IR and move things *out*
     // of SSA form, by eliminating all "phi nodes" (block parameters) and
     // introducing explicit temporaries instead. Doing this at the IR level
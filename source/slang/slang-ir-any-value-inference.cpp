@@ -1,6 +1,7 @@
 #include "slang-ir-any-value-inference.h"
 
 #include "../core/slang-func-ptr.h"
+#include "slang-ir-any-value-marshalling.h"
 #include "slang-ir-generics-lowering-context.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-layout.h"
@@ -216,13 +217,10 @@ void inferAnyValueSizeWhereNecessary(TargetProgram* targetProgram, IRModule* mod
         IRIntegerValue maxAnyValueSize = -1;
         for (auto implType : mapInterfaceToImplementations[interfaceType])
         {
-            IRSizeAndAlignment sizeAndAlignment;
-            getNaturalSizeAndAlignment(
-                targetProgram->getOptionSet(),
-                (IRType*)implType,
-                &sizeAndAlignment);
+            SlangInt storageSize = 0;
+            getAnyValueStorageSize(targetProgram, (IRType*)implType, &storageSize);
 
-            maxAnyValueSize = Math::Max(maxAnyValueSize, sizeAndAlignment.size);
+            maxAnyValueSize = Math::Max(maxAnyValueSize, (IRIntegerValue)storageSize);
         }
 
         // Should not encounter interface types without any conforming implementations.
@@ -1,13 +1,69 @@
 #include "slang-ir-any-value-marshalling.h"
 
 #include "../core/slang-math.h"
+#include "slang-compiler.h"
 #include "slang-ir-generics-lowering-context.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
 #include "slang-ir.h"
 #include "slang-legalize-types.h"
 
 namespace Slang
 {
+// The number of bits that a basic value or resource handle of `type` takes up when it is
+// tightly packed, or 0 if `type` is not one.
+static uint32_t _getTightPackedBitCount(IRType* type)
+{
+    switch (type->getOp())
+    {
+    case kIROp_BoolType:
+        return 1;
+    case kIROp_Int8Type:
+    case kIROp_UInt8Type:
+        return 8;
+    case kIROp_Int16Type:
+    case kIROp_UInt16Type:
+    case kIROp_HalfType:
+        return 16;
+    case kIROp_IntType:
+    case kIROp_UIntType:
+    case kIROp_FloatType:
+    case kIROp_Int8x4PackedType:
+    case kIROp_UInt8x4PackedType:
+#if SLANG_PTR_IS_32
+    case kIROp_IntPtrType:
+    case kIROp_UIntPtrType:
+#endif
+        return 32;
+    case kIROp_Int64Type:
+    case kIROp_UInt64Type:
+    case kIROp_DoubleType:
+    case kIROp_PtrType:
+#if SLANG_PTR_IS_64
+    case kIROp_IntPtrType:
+    case kIROp_UIntPtrType:
+#endif
+        return 64;
+    default:
+        return isResourceType(type) ? 64 : 0;
+    }
+}
+
+// Whether a 32-bit value of `type` is stored into an `AnyValue` field as it is, rather than
+// being bit cast to `uint` first.
+static bool _isStoredAsAnyValueField(IRType* type)
+{
+    switch (type->getOp())
+    {
+    case kIROp_UIntType:
+    case kIROp_Int8x4PackedType:
+    case kIROp_UInt8x4PackedType:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // This is a subpass of generics lowering IR transformation.
 // This pass generates packing/unpacking functions for `AnyValue`s,
 // and replaces all `IRPackAnyValue` and `IRUnpackAnyValue` with calls to these
@@ -16,6 +72,13 @@ struct AnyValueMarshallingContext
 {
     SharedGenericsLoweringContext* sharedContext;
 
+    // Whether values are packed with the tight layout of `-tight-any-value-packing`, rather than
+    // with each field aligned to its natural size.
+    bool tightPacking = false;
+
+    // The types whose packed size has been reported, for `-report-any-value-packing`.
+    HashSet<IRType*> reportedTypes;
+
     // Stores information about generated `AnyValue` struct types.
     struct AnyValueTypeInfo : RefObject
     {
@@ -259,6 +322,212 @@ struct AnyValueMarshallingContext
         }
     }
 
+    // Collects the basic values and resource handles that `emitMarshallingCode` visits, so that
+    // they can be laid out once all of them are known.
+    struct TypeLeafCollectingContext : TypeMarshallingContext
+    {
+        struct Leaf
+        {
+            IRType* type;
+            IRInst* concreteVar;
+            uint32_t bitCount;
+            uint32_t bitOffset;
+        };
+        List<Leaf> leaves;
+
+        void addLeaf(IRType* dataType, IRInst* concreteVar)
+        {
+            Leaf leaf;
+            leaf.type = dataType;
+            leaf.concreteVar = concreteVar;
+            leaf.bitCount = _getTightPackedBitCount(dataType);
+            leaf.bitOffset = 0;
+            leaves.add(leaf);
+        }
+
+        virtual void marshalBasicType(IRBuilder* builder, IRType* dataType, IRInst* concreteVar)
+            override
+        {
+            SLANG_UNUSED(builder);
+            addLeaf(dataType, concreteVar);
+        }
+
+        virtual void marshalResourceHandle(
+            IRBuilder* builder,
+            IRType* dataType,
+            IRInst* concreteVar) override
+        {
+            SLANG_UNUSED(builder);
+            addLeaf(dataType, concreteVar);
+        }
+
+        // Lays the leaves out from the widest to the narrowest. Every width is a power of two,
+        // so each leaf starts at a multiple of its width, and no leaf needs padding before it or
+        // straddles two fields.
+        void assignTightBitOffsets()
+        {
+            leaves.stableSort([](const Leaf& a, const Leaf& b) { return a.bitCount > b.bitCount; });
+            uint32_t bitOffset = 0;
+            for (auto& leaf : leaves)
+            {
+                leaf.bitOffset = bitOffset;
+                bitOffset += leaf.bitCount;
+            }
+        }
+    };
+
+    // Packs the value in `concreteTypedVar` into `anyValueVar` with the tight layout.
+    void emitTightPackingCode(
+        IRBuilder* builder,
+        AnyValueTypeInfo* anyValInfo,
+        IRInst* anyValueVar,
+        IRInst* concreteTypedVar)
+    {
+        TypeLeafCollectingContext context;
+        context.anyValInfo = anyValInfo;
+        context.fieldOffset = context.intraFieldOffset = 0;
+        context.uintPtrType = builder->getPtrType(builder->getUIntType());
+        context.anyValueVar = anyValueVar;
+        emitMarshallingCode(builder, &context, concreteTypedVar);
+        context.assignTightBitOffsets();
+
+        auto uintType = builder->getUIntType();
+        auto fieldCount = static_cast<uint32_t>(anyValInfo->fieldKeys.getCount());
+        for (auto& leaf : context.leaves)
+        {
+            auto fieldOffset = leaf.bitOffset / 32;
+            auto intraFieldBitOffset = leaf.bitOffset % 32;
+            if (fieldOffset + (leaf.bitCount + 31) / 32 > fieldCount)
+                continue;
+
+            auto srcVal = builder->emitLoad(leaf.concreteVar);
+            auto dstAddr = builder->emitFieldAddress(
+                context.uintPtrType,
+                anyValueVar,
+                anyValInfo->fieldKeys[fieldOffset]);
+            if (leaf.bitCount == 64)
+            {
+                auto bits = builder->emitBitCast(builder->getUInt64Type(), srcVal);
+                auto lowBits = builder->emitCast(uintType, bits);
+                auto highBits = builder->emitShr(
+                    builder->getUInt64Type(),
+                    bits,
+                    builder->getIntValue(builder->getIntType(), 32));
+                highBits = builder->emitCast(uintType, highBits);
+                builder->emitStore(dstAddr, lowBits);
+                auto highAddr = builder->emitFieldAddress(
+                    context.uintPtrType,
+                    anyValueVar,
+                    anyValInfo->fieldKeys[fieldOffset + 1]);
+                builder->emitStore(highAddr, highBits);
+            }
+            else if (leaf.bitCount == 32)
+            {
+                if (!_isStoredAsAnyValueField(leaf.type))
+                    srcVal = builder->emitBitCast(uintType, srcVal);
+                builder->emitStore(dstAddr, srcVal);
+            }
+            else
+            {
+                // A narrower value is inserted into the bits of the field that it shares with
+                // other values.
+                IRInst* bits = nullptr;
+                if (leaf.type->getOp() == kIROp_BoolType)
+                {
+                    IRInst* args[] = {
+                        srcVal,
+                        builder->getIntValue(uintType, 1),
+                        builder->getIntValue(uintType, 0)};
+                    bits = builder->emitIntrinsicInst(uintType, kIROp_Select, 3, args);
+                }
+                else
+                {
+                    if (leaf.type->getOp() == kIROp_HalfType)
+                        srcVal = builder->emitBitCast(builder->getType(kIROp_UInt16Type), srcVal);
+                    bits = builder->emitCast(uintType, srcVal);
+                }
+                auto dstVal = builder->emitLoad(dstAddr);
+                dstVal = builder->emitBitfieldInsert(
+                    uintType,
+                    dstVal,
+                    bits,
+                    builder->getIntValue(uintType, intraFieldBitOffset),
+                    builder->getIntValue(uintType, leaf.bitCount));
+                builder->emitStore(dstAddr, dstVal);
+            }
+        }
+    }
+
+    // Unpacks the value in `anyValueVar` into `concreteTypedVar` with the tight layout.
+    void emitTightUnpackingCode(
+        IRBuilder* builder,
+        AnyValueTypeInfo* anyValInfo,
+        IRInst* anyValueVar,
+        IRInst* concreteTypedVar)
+    {
+        TypeLeafCollectingContext context;
+        context.anyValInfo = anyValInfo;
+        context.fieldOffset = context.intraFieldOffset = 0;
+        context.uintPtrType = builder->getPtrType(builder->getUIntType());
+        context.anyValueVar = anyValueVar;
+        emitMarshallingCode(builder, &context, concreteTypedVar);
+        context.assignTightBitOffsets();
+
+        auto uintType = builder->getUIntType();
+        auto fieldCount = static_cast<uint32_t>(anyValInfo->fieldKeys.getCount());
+        for (auto& leaf : context.leaves)
+        {
+            auto fieldOffset = leaf.bitOffset / 32;
+            auto intraFieldBitOffset = leaf.bitOffset % 32;
+            if (fieldOffset + (leaf.bitCount + 31) / 32 > fieldCount)
+                continue;
+
+            auto srcAddr = builder->emitFieldAddress(
+                context.uintPtrType,
+                anyValueVar,
+                anyValInfo->fieldKeys[fieldOffset]);
+            IRInst* srcVal = builder->emitLoad(srcAddr);
+            if (leaf.bitCount == 64)
+            {
+                auto highAddr = builder->emitFieldAddress(
+                    context.uintPtrType,
+                    anyValueVar,
+                    anyValInfo->fieldKeys[fieldOffset + 1]);
+                auto highBits = builder->emitLoad(highAddr);
+                srcVal = builder->emitMakeUInt64(srcVal, highBits);
+                if (leaf.type->getOp() != kIROp_UInt64Type)
+                    srcVal = builder->emitBitCast(leaf.type, srcVal);
+            }
+            else if (leaf.bitCount == 32)
+            {
+                if (!_isStoredAsAnyValueField(leaf.type))
+                    srcVal = builder->emitBitCast(leaf.type, srcVal);
+            }
+            else
+            {
+                srcVal = builder->emitBitfieldExtract(
+                    uintType,
+                    srcVal,
+                    builder->getIntValue(uintType, intraFieldBitOffset),
+                    builder->getIntValue(uintType, leaf.bitCount));
+                switch (leaf.type->getOp())
+                {
+                case kIROp_BoolType:
+                    srcVal = builder->emitNeq(srcVal, builder->getIntValue(uintType, 0));
+                    break;
+                case kIROp_HalfType:
+                    srcVal = builder->emitCast(builder->getType(kIROp_UInt16Type), srcVal);
+                    srcVal = builder->emitBitCast(leaf.type, srcVal);
+                    break;
+                default:
+                    srcVal = builder->emitCast(leaf.type, srcVal);
+                    break;
+                }
+            }
+            builder->emitStore(leaf.concreteVar, srcVal);
+        }
+    }
+
     struct TypePackingContext : TypeMarshallingContext
     {
         virtual void marshalBasicType(IRBuilder* builder, IRType* dataType, IRInst* concreteVar)
@@ -505,12 +774,19 @@ struct AnyValueMarshallingContext
             builder.emitStore(fieldAddr, builder.getIntValue(builder.getUIntType(), 0));
         }
 
-        TypePackingContext context;
-        context.anyValInfo = anyValInfo;
-        context.fieldOffset = context.intraFieldOffset = 0;
-        context.uintPtrType = builder.getPtrType(builder.getUIntType());
-        context.anyValueVar = resultVar;
-        emitMarshallingCode(&builder, &context, concreteTypedVar);
+        if (tightPacking)
+        {
+            emitTightPackingCode(&builder, anyValInfo, resultVar, concreteTypedVar);
+        }
+        else
+        {
+            TypePackingContext context;
+            context.anyValInfo = anyValInfo;
+            context.fieldOffset = context.intraFieldOffset = 0;
+            context.uintPtrType = builder.getPtrType(builder.getUIntType());
+            context.anyValueVar = resultVar;
+            emitMarshallingCode(&builder, &context, concreteTypedVar);
+        }
 
         auto load = builder.emitLoad(resultVar);
         builder.emitReturn(load);
@@ -733,21 +1009,53 @@ struct AnyValueMarshallingContext
         builder.emitStore(anyValueVar, param);
         auto resultVar = builder.emitVar(type);
 
-        TypeUnpackingContext context;
-        context.anyValInfo = anyValInfo;
-        context.fieldOffset = context.intraFieldOffset = 0;
-        context.uintPtrType = builder.getPtrType(builder.getUIntType());
-        context.anyValueVar = anyValueVar;
-        emitMarshallingCode(&builder, &context, resultVar);
+        if (tightPacking)
+        {
+            emitTightUnpackingCode(&builder, anyValInfo, anyValueVar, resultVar);
+        }
+        else
+        {
+            TypeUnpackingContext context;
+            context.anyValInfo = anyValInfo;
+            context.fieldOffset = context.intraFieldOffset = 0;
+            context.uintPtrType = builder.getPtrType(builder.getUIntType());
+            context.anyValueVar = anyValueVar;
+            emitMarshallingCode(&builder, &context, resultVar);
+        }
         auto load = builder.emitLoad(resultVar);
         builder.emitReturn(load);
         return func;
     }
 
+    void reportPackedSize(IRType* type, SourceLoc usageLoc)
+    {
+        if (!reportedTypes.add(type))
+            return;
+        auto naturalSize = getAnyValueSize(type);
+        auto packedSize = tightPacking ? getTightAnyValueSize(type) : naturalSize;
+        if (naturalSize < 0 || packedSize < 0)
+            return;
+        sharedContext->sink->diagnose(
+            usageLoc,
+            Diagnostics::anyValuePackedSize,
+            type,
+            packedSize,
+            naturalSize);
+    }
+
     // Ensures the marshalling functions between `type` and `anyValueType` are already generated.
     // Returns the generated marshalling functions.
-    MarshallingFunctionSet ensureMarshallingFunc(IRType* type, IRAnyValueType* anyValueType)
+    MarshallingFunctionSet ensureMarshallingFunc(
+        IRType* type,
+        IRAnyValueType* anyValueType,
+        SourceLoc usageLoc)
     {
+        if (sharedContext->targetProgram->getOptionSet().getBoolOption(
+                CompilerOptionName::ReportAnyValuePacking))
+        {
+            reportPackedSize(type, usageLoc);
+        }
+
         auto size = getIntVal(anyValueType->getSize());
         MarshallingFunctionKey key;
         key.originalType = type;
@@ -766,7 +1074,8 @@ struct AnyValueMarshallingContext
         auto operand = packInst->getValue();
         auto func = ensureMarshallingFunc(
             operand->getDataType(),
-            cast<IRAnyValueType>(packInst->getDataType()));
+            cast<IRAnyValueType>(packInst->getDataType()),
+            packInst->sourceLoc);
         IRBuilder builderStorage(sharedContext->module);
         auto builder = &builderStorage;
         builder->setInsertBefore(packInst);
@@ -780,7 +1089,8 @@ struct AnyValueMarshallingContext
         auto operand = unpackInst->getValue();
         auto func = ensureMarshallingFunc(
             unpackInst->getDataType(),
-            cast<IRAnyValueType>(operand->getDataType()));
+            cast<IRAnyValueType>(operand->getDataType()),
+            unpackInst->sourceLoc);
         IRBuilder builderStorage(sharedContext->module);
         auto builder = &builderStorage;
         builder->setInsertBefore(unpackInst);
@@ -845,6 +1155,8 @@ void generateAnyValueMarshallingFunctions(SharedGenericsLoweringContext* sharedC
 {
     AnyValueMarshallingContext context;
     context.sharedContext = sharedContext;
+    context.tightPacking = sharedContext->targetProgram->getOptionSet().getBoolOption(
+        CompilerOptionName::TightAnyValuePacking);
     context.processModule();
 }
 
@@ -1046,4 +1358,105 @@ SlangInt getAnyValueSize(IRType* type)
         return rawSize;
     return alignUp(rawSize, 4);
 }
+
+// The number of bits that a value of `type` takes up when it is tightly packed. As the tight
+// layout needs no padding, this is the sum of the bits of the values it holds.
+SlangInt _getTightAnyValueBitCount(IRType* type)
+{
+    if (auto bitCount = _getTightPackedBitCount(type))
+        return bitCount;
+
+    switch (type->getOp())
+    {
+    case kIROp_VectorType:
+        {
+            auto vectorType = static_cast<IRVectorType*>(type);
+            auto elementBitCount = _getTightAnyValueBitCount(vectorType->getElementType());
+            if (elementBitCount < 0)
+                return elementBitCount;
+            return elementBitCount * (SlangInt)getIntVal(vectorType->getElementCount());
+        }
+    case kIROp_MatrixType:
+        {
+            auto matrixType = static_cast<IRMatrixType*>(type);
+            auto elementBitCount = _getTightAnyValueBitCount(matrixType->getElementType());
+            if (elementBitCount < 0)
+                return elementBitCount;
+            return elementBitCount * (SlangInt)getIntVal(matrixType->getRowCount()) *
+                   (SlangInt)getIntVal(matrixType->getColumnCount());
+        }
+    case kIROp_ArrayType:
+        {
+            auto arrayType = cast<IRArrayType>(type);
+            auto elementBitCount = _getTightAnyValueBitCount(arrayType->getElementType());
+            if (elementBitCount < 0)
+                return elementBitCount;
+            return elementBitCount * (SlangInt)getIntVal(arrayType->getElementCount());
+        }
+    case kIROp_StructType:
+        {
+            SlangInt bitCount = 0;
+            for (auto field : cast<IRStructType>(type)->getFields())
+            {
+                auto fieldBitCount = _getTightAnyValueBitCount(field->getFieldType());
+                if (fieldBitCount < 0)
+                    return fieldBitCount;
+                bitCount += fieldBitCount;
+            }
+            return bitCount;
+        }
+    case kIROp_TupleType:
+        {
+            SlangInt bitCount = 0;
+            for (UInt i = 0; i < type->getOperandCount(); i++)
+            {
+                auto elementBitCount = _getTightAnyValueBitCount((IRType*)type->getOperand(i));
+                if (elementBitCount < 0)
+                    return elementBitCount;
+                bitCount += elementBitCount;
+            }
+            return bitCount;
+        }
+    default:
+        {
+            // Other values, such as nested `AnyValue`s and witness table IDs, are made of whole
+            // 32-bit fields, as with natural alignment.
+            auto size = _getAnyValueSizeRaw(type, 0);
+            if (size < 0)
+                return size;
+            return alignUp(size, 4) * 8;
+        }
+    }
+}
+
+SlangInt getTightAnyValueSize(IRType* type)
+{
+    auto bitCount = _getTightAnyValueBitCount(type);
+    if (bitCount < 0)
+        return bitCount;
+    return alignUp(bitCount, 32) / 8;
+}
+
+SlangInt getAnyValueSize(TargetProgram* targetProgram, IRType* type)
+{
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::TightAnyValuePacking))
+        return getTightAnyValueSize(type);
+    return getAnyValueSize(type);
+}
+
+SlangResult getAnyValueStorageSize(TargetProgram* targetProgram, IRType* type, SlangInt* outSize)
+{
+    IRSizeAndAlignment sizeAndAlignment;
+    SLANG_RETURN_ON_FAIL(
+        getNaturalSizeAndAlignment(targetProgram->getOptionSet(), type, &sizeAndAlignment));
+    *outSize = (SlangInt)sizeAndAlignment.size;
+
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::TightAnyValuePacking))
+    {
+        auto tightSize = getTightAnyValueSize(type);
+        if (tightSize >= 0)
+            *outSize = tightSize;
+    }
+    return SLANG_OK;
+}
 } // namespace Slang
@@ -7,6 +7,7 @@ namespace Slang
 {
 struct IRType;
 struct SharedGenericsLoweringContext;
+class TargetProgram;
 
 /// Generates functions that pack and unpack `AnyValue`s, and replaces
 /// all `IRPackAnyValue` and `IRUnpackAnyValue` instructions with calls
@@ -17,4 +18,17 @@ void generateAnyValueMarshallingFunctions(SharedGenericsLoweringContext* sharedC
 
 /// Get the AnyValue size required to hold a value of `type`.
 SlangInt getAnyValueSize(IRType* type);
+
+/// Get the AnyValue size required to hold a value of `type` when it is tightly packed, with its
+/// fields ordered from the widest to the narrowest and narrow fields sharing 32-bit words.
+SlangInt getTightAnyValueSize(IRType* type);
+
+/// Get the AnyValue size required to hold a value of `type` with the packing that
+/// `targetProgram` uses.
+SlangInt getAnyValueSize(TargetProgram* targetProgram, IRType* type);
+
+/// Get the number of bytes that a value of `type` takes up when it is stored in the AnyValue of
+/// an existential value for `targetProgram`.
+/// Fails if `type` can't be stored in ordinary memory on the target.
+SlangResult getAnyValueStorageSize(TargetProgram* targetProgram, IRType* type, SlangInt* outSize);
 } // namespace Slang
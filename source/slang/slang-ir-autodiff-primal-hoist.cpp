@@ -4,6 +4,7 @@
 #include "slang-ast-support-types.h"
 #include "slang-ir-autodiff-region.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
 #include "slang-ir-simplify-cfg.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -2119,7 +2120,10 @@ void buildIndexedBlocks(
 // For each primal inst that is used in reverse blocks, decide if we should recompute or store
 // its value, then make them accessible in reverse blocks based the decision.
 //
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink)
 {
     sortBlocksInFunc(func);
 
@@ -2141,8 +2145,21 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     // If we decide to recompute the inst, emit the recompute inst in the corresponding recompute
     // block.
     //
-    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy = new DefaultCheckpointPolicy(func->getModule());
-    chkPolicy->preparePolicy(func);
+    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy;
+    if (targetProgram &&
+        targetProgram->getOptionSet().hasOption(CompilerOptionName::CheckpointBudget))
+    {
+        chkPolicy = new BudgetedCheckpointPolicy(
+            func->getModule(),
+            targetProgram,
+            sink,
+            targetProgram->getOptionSet().getIntOption(CompilerOptionName::CheckpointBudget));
+    }
+    else
+    {
+        chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    }
+    chkPolicy->preparePolicy(func, indexedBlockInfo);
     auto primalsInfo = chkPolicy->processFunc(func, recomputeBlockMap, cloneCtx, indexedBlockInfo);
 
     // Legalize the primal inst accesses by introducing local variables / arrays and emitting
@@ -2151,9 +2168,12 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     return ensurePrimalAvailability(primalsInfo, func, indexedBlockInfo);
 }
 
-void DefaultCheckpointPolicy::preparePolicy(IRGlobalValueWithCode* func)
+void DefaultCheckpointPolicy::preparePolicy(
+    IRGlobalValueWithCode* func,
+    Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo)
 {
     SLANG_UNUSED(func)
+    SLANG_UNUSED(blockIndexInfo)
     return;
 }
 
@@ -2440,4 +2460,376 @@ HoistResult DefaultCheckpointPolicy::classify(UseOrPseudoUse use)
     }
 }
 
+// Is `inst` a primal value of `func`, that the checkpoint policy may be asked to classify?
+static bool isPrimalValueOfFunc(IRGlobalValueWithCode* func, IRInst* inst)
+{
+    auto block = as<IRBlock>(inst->getParent());
+    if (!block || block->getParent() != func)
+        return false;
+    return !isDifferentialBlock(block) && !isDifferentialInst(inst);
+}
+
+static bool calleeHasDecoration(IRInst* callee, IROp decorationOp)
+{
+    callee = getResolvedInstForDecorations(callee, true);
+    return callee->findDecorationImpl(decorationOp) != nullptr;
+}
+
+// Estimated cost of computing `inst` once its operands are available
+static IRIntegerValue getInstComputeCost(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    // Not real computations.
+    case kIROp_Param:
+    case kIROp_Var:
+    case kIROp_CastFloatToInt:
+    case kIROp_CastIntToFloat:
+    case kIROp_IntCast:
+    case kIROp_FloatCast:
+    case kIROp_Reinterpret:
+    case kIROp_BitCast:
+    case kIROp_MakeVectorFromScalar:
+    case kIROp_MakeMatrixFromScalar:
+    case kIROp_MakeStruct:
+    case kIROp_MakeTuple:
+    case kIROp_MakeArray:
+    case kIROp_MakeArrayFromElement:
+    case kIROp_MakeVector:
+    case kIROp_MakeMatrix:
+    case kIROp_MakeDifferentialPair:
+    case kIROp_MakeDifferentialPairUserCode:
+    case kIROp_DifferentialPairGetPrimal:
+    case kIROp_DifferentialPairGetPrimalUserCode:
+    case kIROp_DefaultConstruct:
+    case kIROp_GetElement:
+    case kIROp_FieldExtract:
+    case kIROp_swizzle:
+    case kIROp_GetTupleElement:
+    case kIROp_Specialize:
+    case kIROp_LookupWitness:
+    case kIROp_DetachDerivative:
+    case kIROp_undefined:
+        return 0;
+
+    case kIROp_Div:
+    case kIROp_FRem:
+    case kIROp_IRem:
+        return 4;
+
+    case kIROp_Load:
+        return 2;
+
+    case kIROp_Call:
+        {
+            // Calls cost about as much as the body of the callee. Intrinsics are assumed to be a
+            // little more than an arithmetic op.
+            auto callee = getResolvedInstForDecorations(inst->getOperand(0), true);
+            auto calleeFunc = as<IRGlobalValueWithCode>(callee);
+            if (!calleeFunc || !calleeFunc->getFirstBlock())
+                return 8;
+
+            const IRIntegerValue maxCost = 1024;
+            IRIntegerValue cost = 1;
+            for (auto block : calleeFunc->getBlocks())
+            {
+                for (auto child : block->getOrdinaryInsts())
+                {
+                    SLANG_UNUSED(child);
+                    if (++cost >= maxCost)
+                        return maxCost;
+                }
+            }
+            return cost;
+        }
+
+    default:
+        return 1;
+    }
+}
+
+IRIntegerValue BudgetedCheckpointPolicy::getStorageSize(
+    IRInst* inst,
+    Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo)
+{
+    auto type = inst->getDataType();
+    if (auto var = as<IRVar>(inst))
+        type = var->getDataType()->getValueType();
+    if (!type || !canTypeBeStored(type))
+        return -1;
+
+    IRSizeAndAlignment sizeAndAlignment;
+    if (SLANG_FAILED(getNaturalSizeAndAlignment(
+            m_targetProgram->getOptionSet(),
+            type,
+            &sizeAndAlignment)))
+    {
+        return -1;
+    }
+
+    // Values in loops are stored for each iteration.
+    IRIntegerValue size = sizeAndAlignment.size;
+    if (auto indices = blockIndexInfo.tryGetValue(as<IRBlock>(inst->getParent())))
+    {
+        for (auto& index : *indices)
+        {
+            if (index.maxIters >= 0)
+                size *= index.maxIters + 1;
+        }
+    }
+    return size;
+}
+
+void BudgetedCheckpointPolicy::preparePolicy(
+    IRGlobalValueWithCode* func,
+    Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo)
+{
+    collectInductionValues(func);
+    m_decisions.clear();
+
+    // Find the primal values that the reverse pass may need: those used by differential code,
+    // and the operands of any of them that might be recomputed.
+    //
+    List<IRInst*> neededInsts;
+    HashSet<IRInst*> neededSet;
+    auto addNeeded = [&](IRInst* inst)
+    {
+        if (inst && isPrimalValueOfFunc(func, inst) && neededSet.add(inst))
+            neededInsts.add(inst);
+    };
+
+    for (auto block : func->getBlocks())
+    {
+        if (block == func->getFirstBlock() || !isDifferentialBlock(block))
+            continue;
+
+        for (auto child : block->getChildren())
+        {
+            for (UInt i = 0; i < child->getOperandCount(); ++i)
+                addNeeded(child->getOperand(i));
+
+            for (auto decoration : child->getDecorations())
+            {
+                if (auto primalCtxDecoration =
+                        as<IRBackwardDerivativePrimalContextDecoration>(decoration))
+                    addNeeded(primalCtxDecoration->primalContextVar.get());
+                else if (auto loopExitDecoration = as<IRLoopExitPrimalValueDecoration>(decoration))
+                    addNeeded(loopExitDecoration->exitVal.get());
+            }
+        }
+    }
+
+    // How each needed value can be made available.
+    struct ValueInfo
+    {
+        IRIntegerValue size = -1;     ///< Bytes to store the value, or -1 if it can't be stored
+        bool storedByDefault = false; ///< How `DefaultCheckpointPolicy` would classify it
+        bool canTrade = false;        ///< Whether it can be either stored or recomputed
+    };
+    Dictionary<IRInst*, ValueInfo> valueInfos;
+
+    for (Index i = 0; i < neededInsts.getCount(); ++i)
+    {
+        auto inst = neededInsts[i];
+        if (as<IRType>(inst))
+            continue;
+
+        ValueInfo info;
+        info.size = getStorageSize(inst, blockIndexInfo);
+
+        if (auto var = as<IRVar>(inst))
+        {
+            // The context vars of calls follow the decision for the call.
+            info.storedByDefault = shouldStoreVar(var);
+            valueInfos[inst] = info;
+            continue;
+        }
+
+        const UseOrPseudoUse use(inst, inst);
+        const bool recomputable = canRecompute(use);
+        if (auto param = as<IRParam>(inst))
+        {
+            info.storedByDefault = !recomputable;
+            valueInfos[inst] = info;
+            if (!recomputable || inductionValueInsts.containsKey(param))
+                continue;
+
+            // Recomputing a phi needs the arguments from each predecessor.
+            auto paramBlock = as<IRBlock>(param->getParent());
+            UInt paramIndex = 0;
+            for (auto blockParam : paramBlock->getParams())
+            {
+                if (blockParam == param)
+                    break;
+                paramIndex++;
+            }
+            for (auto predecessor : paramBlock->getPredecessors())
+            {
+                auto branch = as<IRUnconditionalBranch>(predecessor->getTerminator());
+                if (branch && paramIndex < branch->getArgCount())
+                    addNeeded(branch->getArg(paramIndex));
+            }
+            continue;
+        }
+
+        info.storedByDefault = shouldStoreInst(inst) || !recomputable;
+
+        // A value can be traded if it can be recomputed without repeating side effects, and
+        // stored, and the code doesn't ask for one or the other.
+        info.canTrade = recomputable && info.size >= 0 && !inst->mightHaveSideEffects();
+        if (auto call = as<IRCall>(inst))
+        {
+            auto callee = call->getCallee();
+            if (calleeHasDecoration(callee, kIROp_PreferCheckpointDecoration) ||
+                calleeHasDecoration(callee, kIROp_PreferRecomputeDecoration))
+                info.canTrade = false;
+
+            // Calls that are stored by default may read memory that changes, and calls that
+            // write through pointers are tied to the decision for the vars they write.
+            if (info.storedByDefault && !calleeHasDecoration(callee, kIROp_ReadNoneDecoration))
+                info.canTrade = false;
+            for (UInt a = 0; a < call->getArgCount(); ++a)
+            {
+                if (as<IRPtrTypeBase>(call->getArg(a)->getDataType()))
+                    info.canTrade = false;
+            }
+        }
+        valueInfos[inst] = info;
+
+        if (info.storedByDefault && !info.canTrade)
+            continue;
+
+        // The value might be recomputed, which needs its operands.
+        for (UInt o = 0; o < inst->getOperandCount(); ++o)
+            addNeeded(inst->getOperand(o));
+    }
+
+    // Estimate the cost of recomputing each value, including the operands that would have to
+    // be recomputed with it. Blocks are sorted, so operands are visited before their users.
+    //
+    struct Candidate
+    {
+        IRInst* inst;
+        IRIntegerValue size;
+        IRIntegerValue cost;
+        bool storedByDefault;
+    };
+    List<Candidate> candidates;
+    Dictionary<IRInst*, IRIntegerValue> recomputeCosts;
+    IRIntegerValue requiredSize = 0;
+
+    for (auto block : func->getBlocks())
+    {
+        for (auto child : block->getChildren())
+        {
+            auto info = valueInfos.tryGetValue(child);
+            if (!info)
+                continue;
+
+            if (!info->canTrade)
+            {
+                if (info->storedByDefault)
+                {
+                    requiredSize += Math::Max(info->size, IRIntegerValue(0));
+                    continue;
+                }
+                if (as<IRParam>(child) || as<IRVar>(child))
+                    continue;
+            }
+
+            IRIntegerValue cost = getInstComputeCost(child);
+            for (UInt o = 0; o < child->getOperandCount(); ++o)
+            {
+                if (auto operandCost = recomputeCosts.tryGetValue(child->getOperand(o)))
+                    cost += *operandCost;
+            }
+            cost = Math::Min(cost, IRIntegerValue(1) << 24);
+            recomputeCosts[child] = cost;
+
+            if (info->canTrade && cost > 0)
+                candidates.add(Candidate{child, info->size, cost, info->storedByDefault});
+        }
+    }
+
+    // Store the values that save the most recompute cost per byte first, while they fit in
+    // what is left of the budget. Values that are cheaper to recompute than to reload (taken
+    // as one unit of cost per 16 bytes) are always recomputed.
+    //
+    candidates.sort(
+        [](const Candidate& a, const Candidate& b)
+        { return double(a.cost) * double(b.size) > double(b.cost) * double(a.size); });
+
+    IRIntegerValue remaining = m_budget - requiredSize;
+    IRIntegerValue storedSize = requiredSize;
+    IRIntegerValue recomputeCost = 0;
+    for (auto& candidate : candidates)
+    {
+        const IRIntegerValue reloadCost = 1 + candidate.size / 16;
+        const bool store = candidate.cost > reloadCost && candidate.size <= remaining;
+        if (store)
+        {
+            remaining -= candidate.size;
+            storedSize += candidate.size;
+        }
+        else
+        {
+            recomputeCost += candidate.cost;
+        }
+        m_decisions[candidate.inst] =
+            store ? HoistResult::Mode::Store : HoistResult::Mode::Recompute;
+    }
+
+    if (!m_sink)
+        return;
+
+    if (requiredSize > m_budget)
+        m_sink->diagnose(func, Diagnostics::checkpointBudgetExceeded, func, requiredSize, m_budget);
+
+    if (!m_targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::ReportCheckpointIntermediates))
+        return;
+
+    m_sink->diagnose(
+        func,
+        Diagnostics::reportCheckpointBudget,
+        func,
+        m_budget,
+        storedSize,
+        requiredSize,
+        recomputeCost);
+    for (auto& candidate : candidates)
+    {
+        const bool stored = m_decisions[candidate.inst] == HoistResult::Mode::Store;
+        if (stored == candidate.storedByDefault)
+            continue;
+        if (stored)
+        {
+            m_sink->diagnose(
+                candidate.inst,
+                Diagnostics::reportCheckpointBudgetStored,
+                candidate.size,
+                candidate.cost);
+        }
+        else
+        {
+            m_sink->diagnose(
+                candidate.inst,
+                Diagnostics::reportCheckpointBudgetRecomputed,
+                candidate.cost,
+                candidate.size);
+        }
+    }
+}
+
+HoistResult BudgetedCheckpointPolicy::classify(UseOrPseudoUse use)
+{
+    if (auto mode = m_decisions.tryGetValue(use.usedVal))
+    {
+        if (*mode == HoistResult::Mode::Store)
+            return HoistResult::store(use.usedVal);
+        return HoistResult::recompute(use.usedVal);
+    }
+    return DefaultCheckpointPolicy::classify(use);
+}
+
 }; // namespace Slang
@@ -316,7 +316,9 @@ public:
     // 'global' checkpointing methods that consider the entire
     // function)
     //
-    virtual void preparePolicy(IRGlobalValueWithCode* func) = 0;
+    virtual void preparePolicy(
+        IRGlobalValueWithCode* func,
+        Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo) = 0;
 
     virtual HoistResult classify(UseOrPseudoUse diffBlockUse) = 0;
 
@@ -334,12 +336,59 @@ public:
     {
     }
 
-    virtual void preparePolicy(IRGlobalValueWithCode* func);
+    virtual void preparePolicy(
+        IRGlobalValueWithCode* func,
+        Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo);
     virtual HoistResult classify(UseOrPseudoUse use);
 
-private:
+protected:
     bool canRecompute(UseOrPseudoUse use);
 };
 
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func);
+// Checkpoint policy used with `-checkpoint-budget`, that limits the bytes used to store
+// the primal values of a function.
+//
+// The storage size and recompute cost of each primal value the reverse pass may use
+// are estimated up front. Values that can only be stored take from the budget first,
+// the rest of the budget goes to the values that save the most recompute cost per byte,
+// and everything else is recomputed. A budget of 0 gives the plan that uses the least
+// memory, and a large enough budget the plan that recomputes the least.
+//
+class BudgetedCheckpointPolicy : public DefaultCheckpointPolicy
+{
+public:
+    BudgetedCheckpointPolicy(
+        IRModule* module,
+        TargetProgram* targetProgram,
+        DiagnosticSink* sink,
+        IRIntegerValue budget)
+        : DefaultCheckpointPolicy(module)
+        , m_targetProgram(targetProgram)
+        , m_sink(sink)
+        , m_budget(budget)
+    {
+    }
+
+    virtual void preparePolicy(
+        IRGlobalValueWithCode* func,
+        Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo) override;
+    virtual HoistResult classify(UseOrPseudoUse use) override;
+
+private:
+    IRIntegerValue getStorageSize(
+        IRInst* inst,
+        Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo);
+
+    TargetProgram* m_targetProgram;
+    DiagnosticSink* m_sink;
+    IRIntegerValue m_budget;
+
+    // The classification chosen for each value that could either be stored or recomputed.
+    Dictionary<IRInst*, HoistResult::Mode> m_decisions;
+};
+
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink);
 }; // namespace Slang
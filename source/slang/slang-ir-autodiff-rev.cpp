@@ -854,7 +854,8 @@ void BackwardDiffTranscriberBase::transcribeFuncImpl(
 
     // Apply checkpointing policy to legalize cross-scope uses of primal values
     // using either recompute or store strategies.
-    auto primalsInfo = applyCheckpointPolicy(diffPropagateFunc);
+    auto primalsInfo =
+        applyCheckpointPolicy(diffPropagateFunc, autoDiffSharedContext->targetProgram, sink);
 
     eliminateDeadCode(diffPropagateFunc);
 
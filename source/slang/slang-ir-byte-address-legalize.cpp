@@ -130,7 +130,18 @@ struct ByteAddressBufferLegalizationContext
         auto buffer = load->getOperand(0);
         auto offset = load->getOperand(1);
         auto alignment = load->getOperand(2);
+
+        // The simple loads that the legalized load is made of are recorded as
+        // they are emitted, so that adjacent ones can be coalesced afterwards.
+        //
+        List<SimpleAccess> simpleAccesses;
+        if (m_options.maxCoalescedLoadStoreSize >= 4)
+        {
+            m_simpleAccesses = &simpleAccesses;
+            m_simpleAccessInsertPoint = load;
+        }
         auto legalLoad = emitLegalLoad(type, buffer, offset, 0, alignment);
+        m_simpleAccesses = nullptr;
 
         // If it currently possible for the legalization
         // to fail (perhaps because of something else that
@@ -140,6 +151,12 @@ struct ByteAddressBufferLegalizationContext
         if (!legalLoad)
             return;
 
+        coalesceSimpleLoads(
+            simpleAccesses,
+            buffer,
+            offset,
+            getKnownOffsetAlignment(offset, alignment, type));
+
         // If we were able to generate a legal load operation,
         // then the value it yields can be used to fully
         // replace the previous illegal load.
@@ -288,23 +305,13 @@ struct ByteAddressBufferLegalizationContext
             // When loading a value of `struct` type, we will
             // load each field with its own operation.
             //
-            // Note: A more "clever" implementation might try
-            // to emit a minimal number of loads of whatever
-            // is the largest supported type matching the
-            // alignment of `structType`, and then break those
-            // loaded values into fields with bit-level ops
-            // once they are in registers.
-            //
-            // Such an approach could conceivably allow more
-            // types to be loadable even on targets that
-            // don't directly support them (e.g., a structure
-            // with an `int` and two `int16_t` could be loadable
-            // even when targetting DXBC).
-            //
-            // The flip side to such an approach would be that
-            // it would complicate the generated code, and also
-            // make the rules about when a type is supported
-            // for byte-address load/store much more complicated.
+            // Note: Once the whole load has been legalized, the
+            // loads of adjacent fields may be coalesced into
+            // wider loads of `uint` vectors, with the field
+            // values extracted from them afterwards (see
+            // `coalesceSimpleLoads()`). Doing that as a separate
+            // step keeps the rules about when a type is supported
+            // for byte-address load/store simple.
 
             // We collect the loaded per-field values into an
             // array, which we will then use to construct the
@@ -626,11 +633,30 @@ struct ByteAddressBufferLegalizationContext
     // which is meant to handle the base case where we do *not* want to
     // recurse on the structure of `type`.
     //
+    // While a load is being legalized, each simple load is also recorded
+    // so that it can be coalesced with its neighbors later.
+    //
     IRInst* emitSimpleLoad(
         IRType* type,
         IRInst* buffer,
         IRInst* baseOffset,
         IRIntegerValue immediateOffset)
+    {
+        if (!m_simpleAccesses)
+            return emitSimpleLoadImpl(type, buffer, baseOffset, immediateOffset);
+
+        auto prevInst = m_simpleAccessInsertPoint->getPrevInst();
+        auto value = emitSimpleLoadImpl(type, buffer, baseOffset, immediateOffset);
+        if (value)
+            recordSimpleAccess(type, immediateOffset, value, prevInst);
+        return value;
+    }
+
+    IRInst* emitSimpleLoadImpl(
+        IRType* type,
+        IRInst* buffer,
+        IRInst* baseOffset,
+        IRIntegerValue immediateOffset)
     {
         // For all of the operations above this in the call chain we have been
         // tracking a pair of a `baseOffset` as an IR instruction, and an
@@ -1119,6 +1145,16 @@ struct ByteAddressBufferLegalizationContext
         //
         m_builder.setInsertBefore(store);
 
+        // As for loads, the simple stores that are emitted are recorded
+        // so that adjacent ones can be coalesced.
+        //
+        List<SimpleAccess> simpleAccesses;
+        if (m_options.maxCoalescedLoadStoreSize >= 4)
+        {
+            m_simpleAccesses = &simpleAccesses;
+            m_simpleAccessInsertPoint = store;
+        }
+
         // It is possible that our attempt to emit a replacement will fail
         // (this should only happen if we run into types that shouldn't
         // actually be allowed on a target), and in those cases we will
@@ -1133,9 +1169,16 @@ struct ByteAddressBufferLegalizationContext
             0,
             store->getOperand(2),
             value);
+        m_simpleAccesses = nullptr;
         if (SLANG_FAILED(result))
             return;
 
+        coalesceSimpleStores(
+            simpleAccesses,
+            store->getOperand(0),
+            store->getOperand(1),
+            getKnownOffsetAlignment(store->getOperand(1), store->getOperand(2), type));
+
         store->removeAndDeallocate();
     }
 
@@ -1356,6 +1399,22 @@ struct ByteAddressBufferLegalizationContext
         IRInst* baseOffset,
         IRIntegerValue immediateOffset,
         IRInst* value)
+    {
+        if (!m_simpleAccesses)
+            return emitSimpleStoreImpl(type, buffer, baseOffset, immediateOffset, value);
+
+        auto prevInst = m_simpleAccessInsertPoint->getPrevInst();
+        SLANG_RETURN_ON_FAIL(emitSimpleStoreImpl(type, buffer, baseOffset, immediateOffset, value));
+        recordSimpleAccess(type, immediateOffset, value, prevInst);
+        return SLANG_OK;
+    }
+
+    Result emitSimpleStoreImpl(
+        IRType* type,
+        IRInst* buffer,
+        IRInst* baseOffset,
+        IRIntegerValue immediateOffset,
+        IRInst* value)
     {
         IRInst* offset = emitOffsetAddIfNeeded(baseOffset, immediateOffset);
         if (m_options.translateToStructuredBufferOps)
@@ -1497,6 +1556,550 @@ struct ByteAddressBufferLegalizationContext
 
         return SLANG_OK;
     }
+
+    // Legalizing a load or store of an aggregate type often produces many
+    // small accesses to adjacent locations in the buffer, such as one
+    // `Load<float>` per field of a structure. Most targets can access the
+    // same bytes with fewer, wider operations on `uint` vectors, so once a
+    // load or store has been legalized we try to coalesce the simple
+    // accesses that it was split into.
+    //
+    // Each simple access is recorded along with the range of instructions
+    // that were emitted for it, so that they can be removed if the access
+    // gets coalesced.
+    //
+    struct SimpleAccess
+    {
+        IRType* type = nullptr;
+        IRIntegerValue immediateOffset = 0;
+        IRInst* value = nullptr;     // The value that is loaded, or stored.
+        IRInst* firstInst = nullptr; // The first instruction emitted for the access.
+        IRInst* lastInst = nullptr;  // The last instruction emitted for the access.
+    };
+
+    // The accesses are only recorded while a load or store is being legalized,
+    // in which case all of the new instructions are emitted right before the
+    // original instruction.
+    //
+    List<SimpleAccess>* m_simpleAccesses = nullptr;
+    IRInst* m_simpleAccessInsertPoint = nullptr;
+
+    void recordSimpleAccess(
+        IRType* type,
+        IRIntegerValue immediateOffset,
+        IRInst* value,
+        IRInst* prevInst)
+    {
+        auto firstInst = prevInst ? prevInst->getNextInst()
+                                  : m_simpleAccessInsertPoint->getParent()->getFirstChild();
+        if (firstInst == m_simpleAccessInsertPoint)
+            return;
+
+        SimpleAccess access;
+        access.type = type;
+        access.immediateOffset = immediateOffset;
+        access.value = value;
+        access.firstInst = firstInst;
+        access.lastInst = m_simpleAccessInsertPoint->getPrevInst();
+        m_simpleAccesses->add(access);
+    }
+
+    // The offset of an access only tells us how its `immediateOffset` is
+    // aligned, so we also need to know how the base offset is aligned. Unlike
+    // `isAligned()`, this doesn't diagnose anything, because coalescing is
+    // only an optimization.
+    //
+    IRIntegerValue getKnownOffsetAlignment(IRInst* offset, IRInst* alignment, IRType* type)
+    {
+        const IRIntegerValue kMaxKnownAlignment = 16;
+        if (auto offsetLit = as<IRIntLit>(offset))
+            return getKnownAlignment(kMaxKnownAlignment, offsetLit->getValue());
+
+        // Otherwise the offset is assumed to be aligned to the explicit alignment
+        // of the operation, if any, and at least to the natural alignment of the
+        // type, as the leaf accesses emitted above already assume.
+        //
+        IRIntegerValue result = 1;
+        if (auto alignmentLit = as<IRIntLit>(alignment))
+        {
+            if (alignmentLit->getValue() > 0)
+                result = getKnownAlignment(kMaxKnownAlignment, alignmentLit->getValue());
+        }
+        IRSizeAndAlignment typeLayout;
+        if (SLANG_SUCCEEDED(
+                getNaturalSizeAndAlignment(m_targetProgram->getOptionSet(), type, &typeLayout)))
+        {
+            result = Math::Max(result, (IRIntegerValue)typeLayout.alignment);
+        }
+        return Math::Min(result, kMaxKnownAlignment);
+    }
+
+    static IRIntegerValue getKnownAlignment(IRIntegerValue baseAlignment, IRIntegerValue offset)
+    {
+        if (offset == 0)
+            return baseAlignment;
+        return Math::Min(baseAlignment, offset & -offset);
+    }
+
+    // An access can be coalesced if it is of a 32-bit scalar or vector type,
+    // which is rebuilt from whole words. On targets where smaller types are
+    // accessed through the word that contains them anyway, 8- and 16-bit
+    // scalars that share a word can also be coalesced.
+    //
+    bool getCoalescableScalarSize(IRType* type, IRIntegerValue* outSize)
+    {
+        switch (type->getOp())
+        {
+        case kIROp_IntType:
+        case kIROp_UIntType:
+        case kIROp_FloatType:
+            *outSize = 4;
+            return true;
+        case kIROp_Int8Type:
+        case kIROp_UInt8Type:
+            *outSize = 1;
+            return m_options.lowerBasicTypeOps;
+        case kIROp_Int16Type:
+        case kIROp_UInt16Type:
+        case kIROp_HalfType:
+            *outSize = 2;
+            return m_options.lowerBasicTypeOps;
+        default:
+            return false;
+        }
+    }
+
+    bool isCoalescableAccess(SimpleAccess const& access, IRIntegerValue* outSize)
+    {
+        auto offset = access.immediateOffset;
+        if (auto vectorType = as<IRVectorType>(access.type))
+        {
+            auto elementCount = as<IRIntLit>(vectorType->getElementCount());
+            IRIntegerValue elementSize = 0;
+            if (!elementCount ||
+                !getCoalescableScalarSize(vectorType->getElementType(), &elementSize) ||
+                elementSize != 4)
+                return false;
+            *outSize = elementCount->getValue() * 4;
+            return offset % 4 == 0;
+        }
+        IRIntegerValue size = 0;
+        if (!getCoalescableScalarSize(access.type, &size))
+            return false;
+        *outSize = size;
+        return offset % size == 0 && offset % 4 + size <= 4;
+    }
+
+    // A run is a sequence of coalescable accesses that cover consecutive
+    // words, which will be accessed as `uint` vectors with the given numbers
+    // of words.
+    //
+    struct CoalescedRun
+    {
+        List<Index> accessIndices;
+        IRIntegerValue firstWord = 0;
+        IRIntegerValue wordCount = 0;
+        List<IRIntegerValue> chunkWordCounts;
+    };
+
+    void findCoalescedRuns(
+        List<SimpleAccess> const& accesses,
+        IRIntegerValue baseAlignment,
+        List<CoalescedRun>& outRuns)
+    {
+        if (accesses.getCount() < 2 || baseAlignment < 4)
+            return;
+
+        // Words that are touched by an access that can't be coalesced are left
+        // alone, so that we never have to merge with it.
+        //
+        HashSet<IRIntegerValue> blockedWords;
+        List<Index> candidates;
+        List<IRIntegerValue> sizes;
+        sizes.setCount(accesses.getCount());
+        for (Index i = 0; i < accesses.getCount(); i++)
+        {
+            auto& access = accesses[i];
+            if (isCoalescableAccess(access, &sizes[i]))
+            {
+                candidates.add(i);
+                continue;
+            }
+            IRSizeAndAlignment typeLayout;
+            if (SLANG_FAILED(getNaturalSizeAndAlignment(
+                    m_targetProgram->getOptionSet(),
+                    access.type,
+                    &typeLayout)) ||
+                typeLayout.size <= 0)
+                return;
+            auto lastWord = (access.immediateOffset + typeLayout.size - 1) / 4;
+            for (auto word = access.immediateOffset / 4; word <= lastWord; word++)
+                blockedWords.add(word);
+        }
+        candidates.sort(
+            [&](Index a, Index b)
+            { return accesses[a].immediateOffset < accesses[b].immediateOffset; });
+
+        CoalescedRun run;
+        for (auto index : candidates)
+        {
+            auto firstWord = accesses[index].immediateOffset / 4;
+            auto lastWord = (accesses[index].immediateOffset + sizes[index] - 1) / 4;
+            bool isBlocked = false;
+            for (auto word = firstWord; word <= lastWord; word++)
+                isBlocked = isBlocked || blockedWords.contains(word);
+            if (isBlocked)
+                continue;
+
+            if (run.accessIndices.getCount() && firstWord > run.firstWord + run.wordCount)
+            {
+                addCoalescedRunIfProfitable(run, baseAlignment, outRuns);
+                run = CoalescedRun();
+            }
+            if (!run.accessIndices.getCount())
+                run.firstWord = firstWord;
+            run.accessIndices.add(index);
+            run.wordCount = Math::Max(run.wordCount, lastWord - run.firstWord + 1);
+        }
+        if (run.accessIndices.getCount())
+            addCoalescedRunIfProfitable(run, baseAlignment, outRuns);
+    }
+
+    void addCoalescedRunIfProfitable(
+        CoalescedRun& run,
+        IRIntegerValue baseAlignment,
+        List<CoalescedRun>& outRuns)
+    {
+        IRIntegerValue maxWordCount = m_options.maxCoalescedLoadStoreSize / 4;
+        auto endWord = run.firstWord + run.wordCount;
+        for (auto word = run.firstWord; word < endWord;)
+        {
+            auto wordCount = Math::Min(maxWordCount, endWord - word);
+            if (m_options.translateToStructuredBufferOps)
+            {
+                // A structured buffer is indexed by dividing the offset by the
+                // stride of its element type, so a `uint` vector has to be
+                // aligned to its own size. Each width also needs a buffer
+                // declaration of its own, so only the widest one is used.
+                //
+                auto alignment = getKnownAlignment(baseAlignment, word * 4);
+                if (wordCount != maxWordCount || wordCount * 4 > alignment)
+                    wordCount = 1;
+            }
+            run.chunkWordCounts.add(wordCount);
+            word += wordCount;
+        }
+
+        // Accesses that don't share their words with anything are cheaper to
+        // leave the way they are.
+        //
+        if (run.chunkWordCounts.getCount() < run.accessIndices.getCount())
+            outRuns.add(run);
+    }
+
+    IRType* getUIntVectorType(IRIntegerValue wordCount)
+    {
+        auto uintType = m_builder.getUIntType();
+        if (wordCount == 1)
+            return uintType;
+        return m_builder.getVectorType(uintType, wordCount);
+    }
+
+    // Once an access has been coalesced, the instructions that were emitted
+    // for it are removed in reverse order, so that each one is unused by the
+    // time it is reached.
+    //
+    void removeSimpleAccess(SimpleAccess const& access)
+    {
+        auto inst = access.lastInst;
+        for (;;)
+        {
+            auto prevInst = inst == access.firstInst ? nullptr : inst->getPrevInst();
+            if (!inst->hasUses())
+                inst->removeAndDeallocate();
+            if (!prevInst)
+                break;
+            inst = prevInst;
+        }
+    }
+
+    // Coalescing can leave some of the structured buffers that were declared
+    // for the original accesses unused.
+    //
+    void removeUnusedStructuredBufferParams()
+    {
+        List<KeyValuePair<IRInst*, IRInst*>> unusedKeys;
+        for (auto& [key, param] : m_cachedStructuredBuffers)
+        {
+            if (param && !param->hasUses())
+                unusedKeys.add(key);
+        }
+        for (auto& key : unusedKeys)
+        {
+            m_cachedStructuredBuffers[key]->removeAndDeallocate();
+            m_cachedStructuredBuffers.remove(key);
+        }
+    }
+
+    void coalesceSimpleLoads(
+        List<SimpleAccess> const& accesses,
+        IRInst* buffer,
+        IRInst* baseOffset,
+        IRIntegerValue baseAlignment)
+    {
+        List<CoalescedRun> runs;
+        findCoalescedRuns(accesses, baseAlignment, runs);
+        if (!runs.getCount())
+            return;
+
+        auto uintType = m_builder.getUIntType();
+        for (auto& run : runs)
+        {
+            // The wide loads have to come before any use of the values that
+            // they replace, so we emit them ahead of the earliest of the
+            // accesses in the run.
+            //
+            Index firstAccessIndex = run.accessIndices[0];
+            for (auto index : run.accessIndices)
+                firstAccessIndex = Math::Min(firstAccessIndex, index);
+            m_builder.setInsertBefore(accesses[firstAccessIndex].firstInst);
+
+            List<IRInst*> chunks;
+            List<IRIntegerValue> chunkFirstWords;
+            auto word = run.firstWord;
+            for (auto wordCount : run.chunkWordCounts)
+            {
+                auto chunk =
+                    emitSimpleLoad(getUIntVectorType(wordCount), buffer, baseOffset, word * 4);
+                if (!chunk)
+                    return;
+                chunks.add(chunk);
+                chunkFirstWords.add(word);
+                word += wordCount;
+            }
+
+            // Words are extracted from the wide loads as they are needed.
+            //
+            List<IRInst*> words;
+            words.setCount(run.wordCount);
+            for (auto& w : words)
+                w = nullptr;
+            auto getWord = [&](IRIntegerValue wordIndex)
+            {
+                auto& result = words[Index(wordIndex - run.firstWord)];
+                if (!result)
+                {
+                    Index chunkIndex = chunks.getCount() - 1;
+                    while (chunkFirstWords[chunkIndex] > wordIndex)
+                        chunkIndex--;
+                    auto chunk = chunks[chunkIndex];
+                    auto elementIndex = wordIndex - chunkFirstWords[chunkIndex];
+                    result = chunk->getDataType() == uintType
+                                 ? chunk
+                                 : m_builder.emitElementExtract(chunk, elementIndex);
+                }
+                return result;
+            };
+
+            for (auto index : run.accessIndices)
+            {
+                auto& access = accesses[index];
+                auto type = access.type;
+                auto offset = access.immediateOffset;
+                IRIntegerValue size = 0;
+                isCoalescableAccess(access, &size);
+                IRInst* value = nullptr;
+                if (auto vectorType = as<IRVectorType>(type))
+                {
+                    auto elementCount = getIntVal(vectorType->getElementCount());
+                    auto chunkIndex = chunkFirstWords.indexOf(offset / 4);
+                    IRInst* uintVector = nullptr;
+                    if (chunkIndex >= 0 && run.chunkWordCounts[chunkIndex] == elementCount)
+                    {
+                        uintVector = chunks[chunkIndex];
+                    }
+                    else
+                    {
+                        List<IRInst*> elements;
+                        for (IRIntegerValue i = 0; i < elementCount; i++)
+                            elements.add(getWord(offset / 4 + i));
+                        uintVector = m_builder.emitMakeVector(
+                            m_builder.getVectorType(uintType, elementCount),
+                            elements);
+                    }
+                    value = vectorType->getElementType() == uintType
+                                ? uintVector
+                                : m_builder.emitBitCast(type, uintVector);
+                }
+                else if (type == uintType)
+                {
+                    value = getWord(offset / 4);
+                }
+                else if (size == 4)
+                {
+                    value = m_builder.emitBitCast(type, getWord(offset / 4));
+                }
+                else
+                {
+                    // A smaller value is shifted down to the bottom of its word,
+                    // and truncated to its own size.
+                    //
+                    auto bits = getWord(offset / 4);
+                    if (auto shift = (offset % 4) * 8)
+                    {
+                        bits = m_builder.emitShr(
+                            uintType,
+                            bits,
+                            m_builder.getIntValue(uintType, shift));
+                    }
+                    auto unsignedType = getSameSizeUIntType(type);
+                    value = m_builder.emitCast(unsignedType, bits);
+                    if (unsignedType != type)
+                        value = m_builder.emitBitCast(type, value);
+                }
+                access.value->replaceUsesWith(value);
+            }
+
+            for (auto index : run.accessIndices)
+                removeSimpleAccess(accesses[index]);
+        }
+
+        if (m_options.translateToStructuredBufferOps)
+            removeUnusedStructuredBufferParams();
+    }
+
+    void coalesceSimpleStores(
+        List<SimpleAccess> const& accesses,
+        IRInst* buffer,
+        IRInst* baseOffset,
+        IRIntegerValue baseAlignment)
+    {
+        List<CoalescedRun> runs;
+        findCoalescedRuns(accesses, baseAlignment, runs);
+        if (!runs.getCount())
+            return;
+
+        // The wide stores are emitted right before the original store, where
+        // all of the values being stored are available.
+        //
+        auto uintType = m_builder.getUIntType();
+        for (auto& run : runs)
+        {
+            // We start by collecting the value of each word, along with a mask
+            // of the bytes in it that are being stored.
+            //
+            List<IRInst*> words;
+            List<UInt> byteMasks;
+            words.setCount(run.wordCount);
+            byteMasks.setCount(run.wordCount);
+            for (Index i = 0; i < words.getCount(); i++)
+            {
+                words[i] = nullptr;
+                byteMasks[i] = 0;
+            }
+            for (auto index : run.accessIndices)
+            {
+                auto& access = accesses[index];
+                auto type = access.type;
+                auto offset = access.immediateOffset;
+                IRIntegerValue size = 0;
+                isCoalescableAccess(access, &size);
+                auto wordIndex = Index(offset / 4 - run.firstWord);
+                if (auto vectorType = as<IRVectorType>(type))
+                {
+                    auto elementCount = getIntVal(vectorType->getElementCount());
+                    auto uintVector = vectorType->getElementType() == uintType
+                                          ? access.value
+                                          : m_builder.emitBitCast(
+                                                m_builder.getVectorType(uintType, elementCount),
+                                                access.value);
+                    for (IRIntegerValue i = 0; i < elementCount; i++)
+                    {
+                        words[wordIndex + Index(i)] = m_builder.emitElementExtract(uintVector, i);
+                        byteMasks[wordIndex + Index(i)] = 0xF;
+                    }
+                }
+                else if (type == uintType)
+                {
+                    words[wordIndex] = access.value;
+                    byteMasks[wordIndex] = 0xF;
+                }
+                else if (size == 4)
+                {
+                    words[wordIndex] = m_builder.emitBitCast(uintType, access.value);
+                    byteMasks[wordIndex] = 0xF;
+                }
+                else
+                {
+                    // A smaller value is widened, and shifted into its place in
+                    // its word.
+                    //
+                    auto bits = m_builder.emitCast(
+                        uintType,
+                        m_builder.emitBitCast(getSameSizeUIntType(type), access.value));
+                    if (auto shift = (offset % 4) * 8)
+                    {
+                        bits = m_builder.emitShl(
+                            uintType,
+                            bits,
+                            m_builder.getIntValue(uintType, shift));
+                    }
+                    auto& word = words[wordIndex];
+                    word = word ? m_builder.emitBitOr(uintType, word, bits) : bits;
+                    byteMasks[wordIndex] |= ((UInt(1) << size) - 1) << (offset % 4);
+                }
+            }
+
+            // Any bytes of a word that aren't being stored have to keep their
+            // existing contents.
+            //
+            for (Index i = 0; i < words.getCount(); i++)
+            {
+                if (byteMasks[i] == 0xF)
+                    continue;
+                IRIntegerValue keepMask = 0;
+                for (UInt byte = 0; byte < 4; byte++)
+                {
+                    if (!(byteMasks[i] & (UInt(1) << byte)))
+                        keepMask |= IRIntegerValue(0xFF) << (byte * 8);
+                }
+                auto existingWord =
+                    emitSimpleLoad(uintType, buffer, baseOffset, (run.firstWord + i) * 4);
+                if (!existingWord)
+                    return;
+                auto keptBits = m_builder.emitBitAnd(
+                    uintType,
+                    existingWord,
+                    m_builder.getIntValue(uintType, keepMask));
+                words[i] = m_builder.emitBitOr(uintType, keptBits, words[i]);
+            }
+
+            Index wordIndex = 0;
+            for (auto wordCount : run.chunkWordCounts)
+            {
+                auto chunkType = getUIntVectorType(wordCount);
+                auto chunk = wordCount == 1 ? words[wordIndex]
+                                            : m_builder.emitMakeVector(
+                                                  chunkType,
+                                                  UInt(wordCount),
+                                                  words.getBuffer() + wordIndex);
+                if (SLANG_FAILED(emitSimpleStore(
+                        chunkType,
+                        buffer,
+                        baseOffset,
+                        (run.firstWord + wordIndex) * 4,
+                        chunk)))
+                    return;
+                wordIndex += Index(wordCount);
+            }
+
+            for (auto index : run.accessIndices)
+                removeSimpleAccess(accesses[index]);
+        }
+
+        if (m_options.translateToStructuredBufferOps)
+            removeUnusedStructuredBufferParams();
+    }
 };
 
 
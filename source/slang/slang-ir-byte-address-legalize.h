@@ -20,6 +20,11 @@ struct ByteAddressBufferLegalizationOptions
     /// define `ByteAddressBuffer`/`StructuredBuffer` and introduce operations which prevent DCE
     /// from destroying old definitions of `ByteAddressBuffer` after variable replacement.
     bool treatGetEquivalentStructuredBufferAsGetThis = false;
+
+    /// The size in bytes of the widest `uint` vector load or store that the accesses
+    /// of adjacent scalar and vector fields may be coalesced into, or 0 to access
+    /// each of them separately.
+    int maxCoalescedLoadStoreSize = 0;
 };
 
 /// Legalize byte-address buffer `Load()` and `Store()` operations.
@@ -116,4 +116,123 @@ HashSet<IRFunc*>* getReferencingEntryPoints(
     return referencingEntryPoints;
 }
 
+IRFunc* getCalledFunc(IRCall* call)
+{
+    auto func = as<IRFunc>(getResolvedInstForDecorations(call->getCallee()));
+    if (!func || !func->getFirstBlock())
+        return nullptr;
+    return func;
+}
+
+void collectCallsFromFunc(IRFunc* func, List<IRCall*>& outCalls)
+{
+    outCalls.clear();
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            auto call = as<IRCall>(inst);
+            if (call && getCalledFunc(call))
+                outCalls.add(call);
+        }
+    }
+}
+
+void buildCallGraph(IRModule* module, IRCallGraph& outCallGraph)
+{
+    List<IRFunc*> funcs;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        IRInst* inst = globalInst;
+        if (auto generic = as<IRGeneric>(globalInst))
+            inst = findGenericReturnVal(generic);
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->getFirstBlock())
+            continue;
+        funcs.add(func);
+
+        List<IRCall*> calls;
+        collectCallsFromFunc(func, calls);
+        for (auto call : calls)
+        {
+            auto callee = getCalledFunc(call);
+            if (auto count = outCallGraph.callCountToFunc.tryGetValue(callee))
+                (*count)++;
+            else
+                outCallGraph.callCountToFunc.add(callee, 1);
+        }
+        outCallGraph.callsFromFunc.add(func, _Move(calls));
+    }
+
+    // Find the strongly connected components of the call graph with Tarjan's algorithm, which
+    // finds each component after all of the components it calls into. A component of more than
+    // one function, or of a function that calls itself, is a recursive cycle.
+    struct StackEntry
+    {
+        IRFunc* func;
+        Index nextCall;
+    };
+    Dictionary<IRFunc*, Index> indices;
+    Dictionary<IRFunc*, Index> lowLinks;
+    HashSet<IRFunc*> onComponentStack;
+    List<IRFunc*> componentStack;
+    List<StackEntry> stack;
+    auto push = [&](IRFunc* func)
+    {
+        Index index = indices.getCount();
+        indices.add(func, index);
+        lowLinks.add(func, index);
+        componentStack.add(func);
+        onComponentStack.add(func);
+        stack.add({func, 0});
+    };
+    for (auto root : funcs)
+    {
+        if (indices.containsKey(root))
+            continue;
+        push(root);
+        while (stack.getCount())
+        {
+            auto func = stack.getLast().func;
+            auto& calls = outCallGraph.callsFromFunc[func];
+            if (stack.getLast().nextCall < calls.getCount())
+            {
+                auto callee = getCalledFunc(calls[stack.getLast().nextCall++]);
+                if (!outCallGraph.callsFromFunc.containsKey(callee))
+                    continue;
+                if (callee == func)
+                    outCallGraph.recursiveFuncs.add(func);
+                if (!indices.containsKey(callee))
+                    push(callee);
+                else if (onComponentStack.contains(callee))
+                    lowLinks[func] = Math::Min(lowLinks[func], indices[callee]);
+                continue;
+            }
+
+            stack.removeLast();
+            if (stack.getCount())
+            {
+                auto caller = stack.getLast().func;
+                lowLinks[caller] = Math::Min(lowLinks[caller], lowLinks[func]);
+            }
+            if (lowLinks[func] != indices[func])
+                continue;
+
+            // `func` is the first function found in its component, so the rest of the
+            // component is above it on the component stack.
+            Index componentStart = componentStack.indexOf(func);
+            bool isCycle = componentStack.getCount() - componentStart > 1;
+            for (Index i = componentStart; i < componentStack.getCount(); i++)
+            {
+                auto member = componentStack[i];
+                onComponentStack.remove(member);
+                outCallGraph.bottomUpOrder.add(member);
+                if (isCycle)
+                    outCallGraph.recursiveFuncs.add(member);
+            }
+            componentStack.setCount(componentStart);
+        }
+    }
+}
+
 } // namespace Slang
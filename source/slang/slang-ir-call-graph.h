@@ -12,4 +12,31 @@ HashSet<IRFunc*>* getReferencingEntryPoints(
     Dictionary<IRInst*, HashSet<IRFunc*>>& m_referencingEntryPoints,
     IRInst* inst);
 
+/// The calls between the functions defined in a module.
+struct IRCallGraph
+{
+    /// The functions defined in the module, ordered so that a function comes after the
+    /// functions it calls, unless they are part of the same recursive cycle.
+    List<IRFunc*> bottomUpOrder;
+
+    /// The calls made by each function to functions defined in the module.
+    Dictionary<IRFunc*, List<IRCall*>> callsFromFunc;
+
+    /// The number of calls to each function.
+    Dictionary<IRFunc*, Index> callCountToFunc;
+
+    /// The functions that can call themselves, directly or through other functions.
+    HashSet<IRFunc*> recursiveFuncs;
+};
+
+/// Get the function defined in the module that `call` calls, looking through a `specialize`
+/// of a generic function. Returns null if the callee isn't known.
+IRFunc* getCalledFunc(IRCall* call);
+
+/// Collect the calls made by `func` to functions defined in the module.
+void collectCallsFromFunc(IRFunc* func, List<IRCall*>& outCalls);
+
+/// Build the call graph of the functions defined in `module`.
+void buildCallGraph(IRModule* module, IRCallGraph& outCallGraph);
+
 } // namespace Slang
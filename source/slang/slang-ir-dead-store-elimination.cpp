@@ -0,0 +1,470 @@
+// slang-ir-dead-store-elimination.cpp
+#include "slang-ir-dead-store-elimination.h"
+
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Functions with more distinct locations than this are left alone, since the analysis keeps a
+// set of locations per location.
+static const Index kMaxTrackedLocations = 1024;
+
+struct DeadStoreEliminationContext
+{
+    IRGlobalValueWithCode* func;
+
+    // A location inside of a local variable, identified by the fields and elements that are
+    // accessed to reach it from the variable.
+    struct Location
+    {
+        IRInst* var = nullptr;
+        Index parent = -1;
+        Index depth = 0;
+
+        // The field key for a field of `parent`, or null for an element of `parent`.
+        IRInst* key = nullptr;
+        IRIntegerValue index = 0;
+        bool isDynamicIndex = false;
+
+        // True if no element along the chain from the variable is accessed with a dynamic index.
+        bool isExact = true;
+
+        IRType* valueType = nullptr;
+    };
+
+    List<Location> locations;
+    Dictionary<IRInst*, Index> mapAddrToLocation;
+    Dictionary<KeyValuePair<Index, IRInst*>, Index> mapFieldToLocation;
+    Dictionary<KeyValuePair<Index, IRIntegerValue>, Index> mapElementToLocation;
+    Dictionary<Index, Index> mapDynamicElementToLocation;
+
+    // The locations that may overlap each location.
+    List<UIntSet> aliasingLocations;
+
+    // The locations that are completely overwritten by a store to each location.
+    List<UIntSet> coveredLocations;
+
+    // The stores to a location that are known to reach a point, on every path to it.
+    typedef Dictionary<Index, IRStore*> AvailableStores;
+
+    bool isTrackedAddress(IRInst* addr)
+    {
+        if (!as<IRPtrTypeBase>(addr->getDataType()))
+            return false;
+        for (auto use = addr->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (as<IRDecoration>(user))
+                continue;
+            switch (user->getOp())
+            {
+            case kIROp_Load:
+                continue;
+            case kIROp_Store:
+                // Storing the address itself somewhere lets it escape.
+                if (use != user->getOperands())
+                    return false;
+                continue;
+            case kIROp_FieldAddress:
+            case kIROp_GetElementPtr:
+                if (use != user->getOperands() || !isTrackedAddress(user))
+                    return false;
+                continue;
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Index addLocation(const Location& location)
+    {
+        auto result = locations.getCount();
+        locations.add(location);
+        return result;
+    }
+
+    Index getChildLocation(Index parent, IRInst* addr)
+    {
+        Location location;
+        location.var = locations[parent].var;
+        location.parent = parent;
+        location.depth = locations[parent].depth + 1;
+        location.isExact = locations[parent].isExact;
+        location.valueType = as<IRPtrTypeBase>(addr->getDataType())->getValueType();
+
+        if (auto fieldAddress = as<IRFieldAddress>(addr))
+        {
+            location.key = fieldAddress->getField();
+            auto fieldKey = KeyValuePair<Index, IRInst*>(parent, location.key);
+            if (auto existing = mapFieldToLocation.tryGetValue(fieldKey))
+                return *existing;
+            return mapFieldToLocation[fieldKey] = addLocation(location);
+        }
+
+        auto index = as<IRIntLit>(as<IRGetElementPtr>(addr)->getIndex());
+        if (!index)
+        {
+            location.isDynamicIndex = true;
+            location.isExact = false;
+            if (auto existing = mapDynamicElementToLocation.tryGetValue(parent))
+                return *existing;
+            return mapDynamicElementToLocation[parent] = addLocation(location);
+        }
+
+        location.index = index->getValue();
+        auto elementKey = KeyValuePair<Index, IRIntegerValue>(parent, location.index);
+        if (auto existing = mapElementToLocation.tryGetValue(elementKey))
+            return *existing;
+        return mapElementToLocation[elementKey] = addLocation(location);
+    }
+
+    void addAddressLocations(IRInst* addr, Index location)
+    {
+        mapAddrToLocation[addr] = location;
+        for (auto use = addr->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->getOp())
+            {
+            case kIROp_FieldAddress:
+            case kIROp_GetElementPtr:
+                addAddressLocations(user, getChildLocation(location, user));
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    bool mayAlias(Index a, Index b)
+    {
+        if (locations[a].var != locations[b].var)
+            return false;
+
+        // A location overlaps all of the locations inside of it, so only the chains up to the
+        // depth of the shallower location are compared.
+        while (locations[a].depth > locations[b].depth)
+            a = locations[a].parent;
+        while (locations[b].depth > locations[a].depth)
+            b = locations[b].parent;
+        for (; a != b; a = locations[a].parent, b = locations[b].parent)
+        {
+            auto& locationA = locations[a];
+            auto& locationB = locations[b];
+            if (locationA.isDynamicIndex || locationB.isDynamicIndex)
+                continue;
+            if (locationA.key != locationB.key || locationA.index != locationB.index)
+                return false;
+        }
+        return true;
+    }
+
+    bool covers(Index outer, Index inner)
+    {
+        if (!locations[outer].isExact)
+            return false;
+        while (locations[inner].depth > locations[outer].depth)
+            inner = locations[inner].parent;
+        return inner == outer;
+    }
+
+    bool collectLocations()
+    {
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto var = as<IRVar>(inst);
+                if (!var || !isTrackedAddress(var))
+                    continue;
+                Location location;
+                location.var = var;
+                location.valueType = var->getDataType()->getValueType();
+                addAddressLocations(var, addLocation(location));
+                if (locations.getCount() > kMaxTrackedLocations)
+                    return false;
+            }
+        }
+        if (locations.getCount() == 0)
+            return false;
+
+        auto count = locations.getCount();
+        aliasingLocations.setCount(count);
+        coveredLocations.setCount(count);
+        for (Index i = 0; i < count; i++)
+        {
+            aliasingLocations[i].resizeAndClear(UInt(count));
+            coveredLocations[i].resizeAndClear(UInt(count));
+            for (Index j = 0; j < count; j++)
+            {
+                if (mayAlias(i, j))
+                    aliasingLocations[i].add(UInt(j));
+                if (covers(i, j))
+                    coveredLocations[i].add(UInt(j));
+            }
+        }
+        return true;
+    }
+
+    Index getLocation(IRInst* addr)
+    {
+        if (auto location = mapAddrToLocation.tryGetValue(addr))
+            return *location;
+        return -1;
+    }
+
+    // Forwarding loads.
+
+    static bool isSameAvailableStores(AvailableStores& a, AvailableStores& b)
+    {
+        if (a.getCount() != b.getCount())
+            return false;
+        for (auto& [location, store] : a)
+        {
+            auto otherStore = b.tryGetValue(location);
+            if (!otherStore || *otherStore != store)
+                return false;
+        }
+        return true;
+    }
+
+    void getAvailableStoresAtEntry(
+        IRBlock* block,
+        Dictionary<IRBlock*, AvailableStores>& availableAtExit,
+        AvailableStores& outAvailable)
+    {
+        outAvailable.clear();
+        bool isFirst = true;
+        for (auto pred : block->getPredecessors())
+        {
+            // A predecessor that has not been visited yet doesn't restrict the result. It is
+            // visited on a later iteration, if it is reachable.
+            auto predAvailable = availableAtExit.tryGetValue(pred);
+            if (!predAvailable)
+                continue;
+            if (isFirst)
+            {
+                outAvailable = *predAvailable;
+                isFirst = false;
+                continue;
+            }
+            List<Index> locationsToRemove;
+            for (auto& [location, store] : outAvailable)
+            {
+                auto predStore = predAvailable->tryGetValue(location);
+                if (!predStore || *predStore != store)
+                    locationsToRemove.add(location);
+            }
+            for (auto location : locationsToRemove)
+                outAvailable.remove(location);
+        }
+    }
+
+    bool tryForwardLoad(IRLoad* load, AvailableStores& available)
+    {
+        auto loadLocation = getLocation(load->getPtr());
+        if (loadLocation == -1 || !locations[loadLocation].isExact)
+            return false;
+        if (locations[loadLocation].valueType != load->getDataType())
+            return false;
+
+        // Find the innermost location containing the loaded one that has a known value.
+        IRStore* store = nullptr;
+        List<Index> path;
+        for (auto location = loadLocation; location != -1; location = locations[location].parent)
+        {
+            if (auto availableStore = available.tryGetValue(location))
+            {
+                store = *availableStore;
+                break;
+            }
+            path.add(location);
+        }
+        if (!store)
+            return false;
+        if (locations[getLocation(store->getPtr())].valueType != store->getVal()->getDataType())
+            return false;
+
+        // The store reaches the load on every path, so it dominates the load, and so does the
+        // stored value.
+        IRBuilder builder(func);
+        builder.setInsertBefore(load);
+        IRInst* value = store->getVal();
+        for (Index i = path.getCount() - 1; i >= 0; i--)
+        {
+            auto& location = locations[path[i]];
+            if (location.key)
+            {
+                value = builder.emitFieldExtract(location.valueType, value, location.key);
+            }
+            else
+            {
+                value = builder.emitElementExtract(
+                    location.valueType,
+                    value,
+                    builder.getIntValue(builder.getIntType(), location.index));
+            }
+        }
+        load->replaceUsesWith(value);
+        load->removeAndDeallocate();
+        return true;
+    }
+
+    bool updateAvailableStores(IRBlock* block, AvailableStores& available, bool forwardLoads)
+    {
+        bool changed = false;
+        for (auto inst = block->getFirstChild(); inst;)
+        {
+            auto nextInst = inst->getNextInst();
+            if (auto load = as<IRLoad>(inst))
+            {
+                if (forwardLoads)
+                    changed |= tryForwardLoad(load, available);
+            }
+            else if (auto store = as<IRStore>(inst))
+            {
+                auto storeLocation = getLocation(store->getPtr());
+                if (storeLocation != -1)
+                {
+                    List<Index> locationsToRemove;
+                    for (auto& [location, availableStore] : available)
+                    {
+                        if (aliasingLocations[storeLocation].contains(UInt(location)))
+                            locationsToRemove.add(location);
+                    }
+                    for (auto location : locationsToRemove)
+                        available.remove(location);
+                    if (locations[storeLocation].isExact)
+                        available[storeLocation] = store;
+                }
+            }
+            inst = nextInst;
+        }
+        return changed;
+    }
+
+    bool forwardLoads()
+    {
+        auto blocks = getReversePostorder(func);
+        Dictionary<IRBlock*, AvailableStores> availableAtExit;
+        AvailableStores available;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (auto block : blocks)
+            {
+                getAvailableStoresAtEntry(block, availableAtExit, available);
+                updateAvailableStores(block, available, false);
+                auto existing = availableAtExit.tryGetValue(block);
+                if (existing && isSameAvailableStores(*existing, available))
+                    continue;
+                availableAtExit[block] = available;
+                changed = true;
+            }
+        }
+
+        bool changed = false;
+        for (auto block : blocks)
+        {
+            getAvailableStoresAtEntry(block, availableAtExit, available);
+            changed |= updateAvailableStores(block, available, true);
+        }
+        return changed;
+    }
+
+    // Removing dead stores.
+
+    void updateLiveLocations(IRBlock* block, UIntSet& live, List<IRStore*>* outDeadStores)
+    {
+        for (auto inst = block->getLastChild(); inst; inst = inst->getPrevInst())
+        {
+            if (auto load = as<IRLoad>(inst))
+            {
+                auto location = getLocation(load->getPtr());
+                if (location != -1)
+                    live.add(UInt(location));
+            }
+            else if (auto store = as<IRStore>(inst))
+            {
+                auto location = getLocation(store->getPtr());
+                if (location == -1)
+                    continue;
+                if (outDeadStores && !UIntSet::hasIntersection(live, aliasingLocations[location]))
+                    outDeadStores->add(store);
+                live.subtractWith(coveredLocations[location]);
+            }
+        }
+    }
+
+    void getLiveLocationsAtExit(
+        IRBlock* block,
+        Dictionary<IRBlock*, UIntSet>& liveAtEntry,
+        UIntSet& outLive)
+    {
+        outLive.resizeAndClear(UInt(locations.getCount()));
+        for (auto succ : block->getSuccessors())
+        {
+            if (auto succLive = liveAtEntry.tryGetValue(succ))
+                outLive.unionWith(*succLive);
+        }
+    }
+
+    bool removeDeadStores()
+    {
+        // Local variables are dead when the function returns, so a store is dead if no path
+        // from it loads an overlapping location before the location is completely overwritten.
+        auto blocks = getPostorder(func);
+        Dictionary<IRBlock*, UIntSet> liveAtEntry;
+        UIntSet live;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (auto block : blocks)
+            {
+                getLiveLocationsAtExit(block, liveAtEntry, live);
+                updateLiveLocations(block, live, nullptr);
+                auto existing = liveAtEntry.tryGetValue(block);
+                if (existing && *existing == live)
+                    continue;
+                liveAtEntry[block] = live;
+                changed = true;
+            }
+        }
+
+        List<IRStore*> deadStores;
+        for (auto block : blocks)
+        {
+            getLiveLocationsAtExit(block, liveAtEntry, live);
+            updateLiveLocations(block, live, &deadStores);
+        }
+        for (auto store : deadStores)
+            store->removeAndDeallocate();
+        return deadStores.getCount() != 0;
+    }
+
+    bool processFunc()
+    {
+        if (!func->getFirstBlock())
+            return false;
+        if (!collectLocations())
+            return false;
+
+        bool changed = forwardLoads();
+        changed |= removeDeadStores();
+        return changed;
+    }
+};
+
+bool eliminateDeadStoresAndForwardLoads(IRGlobalValueWithCode* func)
+{
+    DeadStoreEliminationContext context;
+    context.func = func;
+    return context.processFunc();
+}
+
+} // namespace Slang
@@ -0,0 +1,17 @@
+// slang-ir-dead-store-elimination.h
+#pragma once
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+
+/// Forward stored values to loads and remove dead stores for the local variables of `func`.
+///
+/// Only variables whose address is used by nothing other than loads, stores and constant or
+/// dynamic field/element address chains are considered. Within such a variable, a load is
+/// replaced by the value of the store that reaches it on every path through the CFG, and a
+/// store is removed if no path from it reads the location before it is overwritten or the
+/// function returns. Returns true if anything was changed.
+///
+bool eliminateDeadStoresAndForwardLoads(IRGlobalValueWithCode* func);
+} // namespace Slang
@@ -69,6 +69,16 @@ struct ConvertEntryPointPtrParamsToRawPtrsPass
                 if (!as<IRPtrTypeBase>(paramType) && !as<IRPointerLikeType>(paramType))
                     continue;
 
+                // The storage for `groupshared` variables is allocated by the
+                // generated code that runs the group, which passes it with
+                // its actual type.
+                //
+                if (auto ptrType = as<IRPtrTypeBase>(paramType))
+                {
+                    if (ptrType->getAddressSpace() == AddressSpace::GroupShared)
+                        continue;
+                }
+
                 // We will overwrite the type of the parameter to
                 // be the raw pointer type instead.
                 //
@@ -140,6 +140,14 @@ struct IntroduceExplicitGlobalContextPass
     IRStructType* m_contextStructType = nullptr;
     IRPtrType* m_contextStructPtrType = nullptr;
 
+    // On CPU all of the threads in a group run on the same OS thread, so
+    // `groupshared` variables can't be locals of the entry point. Instead
+    // they are fields of a `GroupShared` struct, which the caller allocates
+    // once per thread group and passes to the entry point by pointer.
+    //
+    IRStructType* m_groupSharedStructType = nullptr;
+    Dictionary<IRInst*, IRStructKey*> m_mapGroupSharedVarToKey;
+
     struct GlobalParamInfo
     {
         // Original global param inst.
@@ -348,6 +356,16 @@ struct IntroduceExplicitGlobalContextPass
                 getGlobalVarPtrType(globalVar));
         }
 
+        // Kernels for the `shader-host-callable` and `shader-sharedlib` targets
+        // are emitted as `CPPSource` too. Host code (`HostCPPSource`) doesn't
+        // run in thread groups, and `groupshared` variables are diagnosed for it
+        // before this pass would be run.
+        //
+        if (m_target == CodeGenTarget::CPPSource)
+        {
+            createGroupSharedStruct();
+        }
+
         // Once all the fields have been created, we can process the entry points.
         //
         // Each entry point will create a local `KernelContext` variable and
@@ -449,6 +467,37 @@ struct IntroduceExplicitGlobalContextPass
         m_mapInstToContextFieldInfo.add(originalInst, ContextFieldInfo{key, needDereference});
     }
 
+    void createGroupSharedStruct()
+    {
+        IRBuilder builder(m_module);
+        for (auto globalVar : m_globalVars)
+        {
+            if (!m_mapInstToContextFieldInfo[globalVar].needDereference)
+                continue;
+
+            if (!m_groupSharedStructType)
+            {
+                builder.setInsertBefore(m_contextStructType);
+                m_groupSharedStructType = builder.createStructType();
+                builder.addNameHintDecoration(
+                    m_groupSharedStructType,
+                    UnownedTerminatedStringSlice("GroupShared"));
+            }
+
+            builder.setInsertBefore(m_groupSharedStructType);
+            auto key = builder.createStructKey();
+            builder.createStructField(
+                m_groupSharedStructType,
+                key,
+                globalVar->getDataType()->getValueType());
+            if (auto nameDecor = globalVar->findDecoration<IRNameHintDecoration>())
+            {
+                builder.addNameHintDecoration(key, nameDecor->getName());
+            }
+            m_mapGroupSharedVarToKey.add(globalVar, key);
+        }
+    }
+
     void createContextForEntryPoint(IRFunc* entryPointFunc)
     {
         // We can only introduce the explicit context into
@@ -508,6 +557,21 @@ struct IntroduceExplicitGlobalContextPass
             placeholderParam->insertBefore(firstOrdinary);
         }
 
+        // The `GroupShared` storage for the group is passed as the last parameter.
+        //
+        IRParam* groupSharedParam = nullptr;
+        if (m_groupSharedStructType)
+        {
+            groupSharedParam = builder.createParam(builder.getPtrType(
+                kIROp_PtrType,
+                m_groupSharedStructType,
+                AddressSpace::GroupShared));
+            builder.addNameHintDecoration(
+                groupSharedParam,
+                UnownedTerminatedStringSlice("groupShared"));
+            groupSharedParam->insertBefore(firstOrdinary);
+        }
+
         // The `KernelContext` to use inside the entry point
         // will be a local variable declared in the first block.
         //
@@ -545,19 +609,31 @@ struct IntroduceExplicitGlobalContextPass
         //
         // To support groupshared variables on Metal,we need to allocate the
         // memory by defining a local variable in the entry point, and pass
-        // the address of that variable to the context.
+        // the address of that variable to the context. On CPU the address
+        // is that of the field in the `GroupShared` parameter.
         //
         for (auto globalVar : m_globalVars)
         {
             auto fieldInfo = m_mapInstToContextFieldInfo[globalVar];
             if (fieldInfo.needDereference)
             {
-                auto var = builder.emitVar(
-                    globalVar->getDataType()->getValueType(),
-                    AddressSpace::GroupShared);
-                if (auto nameDecor = globalVar->findDecoration<IRNameHintDecoration>())
+                IRInst* var = nullptr;
+                if (groupSharedParam)
                 {
-                    builder.addNameHintDecoration(var, nameDecor->getName());
+                    var = builder.emitFieldAddress(
+                        getGlobalVarPtrType(globalVar),
+                        groupSharedParam,
+                        m_mapGroupSharedVarToKey[globalVar]);
+                }
+                else
+                {
+                    var = builder.emitVar(
+                        globalVar->getDataType()->getValueType(),
+                        AddressSpace::GroupShared);
+                    if (auto nameDecor = globalVar->findDecoration<IRNameHintDecoration>())
+                    {
+                        builder.addNameHintDecoration(var, nameDecor->getName());
+                    }
                 }
                 auto ptrPtrType =
                     builder.getPtrType(getGlobalVarPtrType(globalVar), getAddressSpaceOfLocal());
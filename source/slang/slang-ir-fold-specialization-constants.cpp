@@ -0,0 +1,166 @@
+// slang-ir-fold-specialization-constants.cpp
+#include "slang-ir-fold-specialization-constants.h"
+
+#include "../core/slang-string-util.h"
+#include "slang-compiler.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+#include <float.h>
+
+namespace Slang
+{
+
+// Find the value given for `inst`, if it is a constant that can be given a value.
+static String* _findConstantValue(IRInst* inst, Dictionary<String, String>& mapNameToValue)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_GlobalParam:
+        {
+            auto varLayout = findVarLayout(inst);
+            if (!varLayout)
+                return nullptr;
+            auto offsetAttr = varLayout->findOffsetAttr(LayoutResourceKind::SpecializationConstant);
+            if (!offsetAttr)
+                return nullptr;
+            if (auto value = mapNameToValue.tryGetValue(String(int64_t(offsetAttr->getOffset()))))
+                return value;
+            break;
+        }
+    case kIROp_GlobalConstant:
+        // Only a constant declared `extern` or `export` is meant to be given its value at link
+        // time; an ordinary `static const` keeps the value it is declared with.
+        if (!inst->findDecoration<IRUserExternDecoration>() &&
+            !inst->findDecoration<IRHLSLExportDecoration>())
+            return nullptr;
+        break;
+    default:
+        return nullptr;
+    }
+
+    if (auto nameHint = inst->findDecoration<IRNameHintDecoration>())
+        return mapNameToValue.tryGetValue(String(nameHint->getName()));
+    return nullptr;
+}
+
+// Make a literal of the scalar `type` from `text`, or return null if `text` isn't one.
+static IRInst* _parseConstantValue(IRBuilder& builder, IRType* type, UnownedStringSlice text)
+{
+    text = text.trim();
+    if (as<IRBoolType>(type))
+    {
+        if (text == "true" || text == "1")
+            return builder.getBoolValue(true);
+        if (text == "false" || text == "0")
+            return builder.getBoolValue(false);
+        return nullptr;
+    }
+    if (isIntegralType(type))
+    {
+        int64_t value = 0;
+        if (SLANG_FAILED(StringUtil::parseInt64(text, value)))
+            return nullptr;
+
+        // A value that doesn't fit in the type is an error, rather than wrapping around.
+        IntInfo info;
+        switch (type->getOp())
+        {
+        case kIROp_IntPtrType:
+            info = {64, true};
+            break;
+        case kIROp_UIntPtrType:
+            info = {64, false};
+            break;
+        default:
+            info = getIntTypeInfo(type);
+            break;
+        }
+        if (!info.isSigned && value < 0)
+            return nullptr;
+        if (info.width < 64)
+        {
+            const int64_t limit = int64_t(1) << (info.width - (info.isSigned ? 1 : 0));
+            if (value >= limit || (info.isSigned && value < -limit))
+                return nullptr;
+        }
+        return builder.getIntValue(type, value);
+    }
+    if (isFloatingType(type))
+    {
+        double value = 0;
+        if (text.getLength() == 0 || SLANG_FAILED(StringUtil::parseDouble(text, value)))
+            return nullptr;
+
+        // A value too large for the type would become infinite.
+        double largest = 0;
+        switch (getFloatingTypeInfo(type).width)
+        {
+        case 16:
+            largest = 65504.0;
+            break;
+        case 32:
+            largest = FLT_MAX;
+            break;
+        default:
+            largest = DBL_MAX;
+            break;
+        }
+        if (!(value >= -largest && value <= largest))
+            return nullptr;
+        return builder.getFloatValue(type, value);
+    }
+    return nullptr;
+}
+
+bool foldSpecializationConstants(
+    IRModule* module,
+    CompilerOptionSet& optionSet,
+    DiagnosticSink* sink)
+{
+    // A later value for the same constant replaces an earlier one.
+    Dictionary<String, String> mapNameToValue;
+    for (auto& option : optionSet.getArray(CompilerOptionName::SpecializeConstant))
+        mapNameToValue[option.stringValue] = option.stringValue2;
+    if (mapNameToValue.getCount() == 0)
+        return false;
+
+    // Replacing a constant can change the global insts that use it, so the constants are found
+    // before any of them is replaced.
+    List<KeyValuePair<IRInst*, String>> constants;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto text = _findConstantValue(inst, mapNameToValue))
+            constants.add(KeyValuePair<IRInst*, String>(inst, *text));
+    }
+
+    IRBuilder builder(module);
+    bool changed = false;
+    for (auto& constant : constants)
+    {
+        auto inst = constant.key;
+        builder.setInsertBefore(inst);
+        auto value =
+            _parseConstantValue(builder, inst->getDataType(), constant.value.getUnownedSlice());
+        if (!value)
+        {
+            if (sink)
+            {
+                sink->diagnose(
+                    inst,
+                    Diagnostics::invalidSpecializationConstantValue,
+                    constant.value,
+                    inst);
+            }
+            continue;
+        }
+
+        inst->replaceUsesWith(value);
+        inst->removeAndDeallocate();
+        changed = true;
+    }
+    return changed;
+}
+
+} // namespace Slang
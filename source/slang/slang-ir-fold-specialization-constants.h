@@ -0,0 +1,22 @@
+// slang-ir-fold-specialization-constants.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+struct CompilerOptionSet;
+class DiagnosticSink;
+
+/// Replace the specialization constants and link-time constants of `module` that are given a
+/// value by a `CompilerOptionName::SpecializeConstant` option in `optionSet` with that value.
+///
+/// A specialization constant is matched by its name or its `constant_id`, and a link-time
+/// (`extern` or `export`) constant by its name. The constant is removed, so that later
+/// constant propagation and dead code elimination can fold the code that depends on it.
+/// Returns true if any constant was replaced.
+///
+bool foldSpecializationConstants(
+    IRModule* module,
+    CompilerOptionSet& optionSet,
+    DiagnosticSink* sink);
+} // namespace Slang
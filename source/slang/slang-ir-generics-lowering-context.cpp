@@ -2,6 +2,7 @@
 
 #include "slang-ir-generics-lowering-context.h"
 
+#include "slang-ir-any-value-marshalling.h"
 #include "slang-ir-layout.h"
 #include "slang-ir-util.h"
 
@@ -240,12 +241,9 @@ IRType* SharedGenericsLoweringContext::lowerType(
                 //   (which consists of only uniform bytes). In this case, the
                 //   value must be stored out-of-line.
                 //
-                IRSizeAndAlignment sizeAndAlignment;
-                Result result = getNaturalSizeAndAlignment(
-                    targetProgram->getOptionSet(),
-                    concreteType,
-                    &sizeAndAlignment);
-                if (SLANG_FAILED(result) || (sizeAndAlignment.size > anyValueSize))
+                SlangInt storageSize = 0;
+                Result result = getAnyValueStorageSize(targetProgram, concreteType, &storageSize);
+                if (SLANG_FAILED(result) || (storageSize > anyValueSize))
                 {
                     // If the value must be stored out-of-line, we construct
                     // a "pseudo pointer" to the concrete type, and the
@@ -411,13 +409,12 @@ bool SharedGenericsLoweringContext::doesTypeFitInAnyValue(
     if (outLimit)
         *outLimit = anyValueSize;
 
-    IRSizeAndAlignment sizeAndAlignment;
-    Result result =
-        getNaturalSizeAndAlignment(targetProgram->getOptionSet(), concreteType, &sizeAndAlignment);
+    SlangInt storageSize = 0;
+    Result result = getAnyValueStorageSize(targetProgram, concreteType, &storageSize);
     if (outTypeSize)
-        *outTypeSize = sizeAndAlignment.size;
+        *outTypeSize = storageSize;
 
-    if (SLANG_FAILED(result) || (sizeAndAlignment.size > anyValueSize))
+    if (SLANG_FAILED(result) || (storageSize > anyValueSize))
     {
         // The value does not fit, either because it is too large,
         // or because it includes types that cannot be stored
@@ -2,6 +2,8 @@
 #include "slang-ir-inline.h"
 
 #include "../core/slang-performance-profiler.h"
+#include "slang-compiler.h"
+#include "slang-ir-call-graph.h"
 #include "slang-ir-ssa-simplification.h"
 // This file provides general facilities for inlining function calls.
 
@@ -1063,4 +1065,311 @@ bool inlineCall(IRCall* call)
     return pass.considerCallSite(call);
 }
 
+CostModelInliningOptions CostModelInliningOptions::getForTarget(TargetProgram* targetProgram)
+{
+    auto& optionSet = targetProgram->getOptionSet();
+
+    CostModelInliningOptions options;
+    switch (optionSet.getOptimizationLevel())
+    {
+    case OptimizationLevel::High:
+        options.sizeThreshold = 40;
+        options.constantArgBonus = 10;
+        options.singleCallSiteThreshold = 200;
+        options.maxCallerSize = 2000;
+        break;
+    case OptimizationLevel::Maximal:
+        options.sizeThreshold = 80;
+        options.constantArgBonus = 20;
+        options.singleCallSiteThreshold = 400;
+        options.maxCallerSize = 4000;
+        break;
+    default:
+        // Inlining only what is marked `[ForceInline]` keeps the output close to the source at
+        // lower levels.
+        break;
+    }
+
+    if (optionSet.hasOption(CompilerOptionName::InlineThreshold))
+    {
+        // An explicit threshold also scales the other limits, so that they keep the same
+        // proportions as at -O2.
+        Index threshold = optionSet.getIntOption(CompilerOptionName::InlineThreshold);
+        options.sizeThreshold = threshold;
+        options.constantArgBonus = threshold / 4;
+        options.singleCallSiteThreshold = threshold * 5;
+        options.maxCallerSize = Math::Max(threshold * 50, Index(2000));
+    }
+    options.reportDecisions = optionSet.getBoolOption(CompilerOptionName::ReportInlining);
+    return options;
+}
+
+/// An inlining pass that decides whether to inline a call by comparing the estimated size of
+/// the callee against what inlining it is expected to save.
+struct CostModelInliningPass : InliningPassBase
+{
+    typedef InliningPassBase Super;
+
+    CostModelInliningOptions m_options;
+    DiagnosticSink* m_sink = nullptr;
+
+    IRCallGraph m_callGraph;
+
+    /// The estimated size of each function, computed once all calls in it have been considered.
+    Dictionary<IRFunc*, Index> m_funcSizes;
+
+    /// The function whose calls are being considered, and its current estimated size.
+    IRFunc* m_caller = nullptr;
+    Index m_callerSize = 0;
+
+    CostModelInliningPass(
+        IRModule* module,
+        CostModelInliningOptions const& options,
+        DiagnosticSink* sink)
+        : Super(module), m_options(options), m_sink(sink)
+    {
+    }
+
+    static Index getInstCost(IRInst* inst)
+    {
+        switch (inst->getOp())
+        {
+        case kIROp_Param:
+        case kIROp_DebugLine:
+        case kIROp_DebugVar:
+        case kIROp_DebugValue:
+            return 0;
+        case kIROp_Call:
+            // A call also has to pass each argument.
+            return getCallCost(as<IRCall>(inst));
+        default:
+            return 1;
+        }
+    }
+
+    static Index getCallCost(IRCall* call) { return 1 + (Index)call->getArgCount(); }
+
+    static Index getFuncSize(IRFunc* func)
+    {
+        Index size = 0;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+                size += getInstCost(inst);
+        }
+        return size;
+    }
+
+    /// Whether `value` decides a branch, either directly or through a comparison.
+    static bool isUsedInBranchCondition(IRInst* value, bool throughComparison = true)
+    {
+        for (auto use = value->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->getOp())
+            {
+            case kIROp_conditionalBranch:
+            case kIROp_ifElse:
+            case kIROp_Switch:
+                if (user->getOperand(0) == value)
+                    return true;
+                break;
+            case kIROp_Eql:
+            case kIROp_Neq:
+            case kIROp_Less:
+            case kIROp_Greater:
+            case kIROp_Leq:
+            case kIROp_Geq:
+            case kIROp_Not:
+                if (throughComparison && isUsedInBranchCondition(user, false))
+                    return true;
+                break;
+            }
+        }
+        return false;
+    }
+
+    /// Whether inlining `call` lets its callee be removed, so the code doesn't grow.
+    static bool isOnlyReference(IRCall* call)
+    {
+        auto callee = call->getCallee();
+        if (callee->hasMoreThanOneUse())
+            return false;
+        auto outer = callee;
+        if (auto specialize = as<IRSpecialize>(callee))
+        {
+            outer = specialize->getBase();
+            if (outer->hasMoreThanOneUse())
+                return false;
+        }
+        for (auto decor : outer->getDecorations())
+        {
+            switch (decor->getOp())
+            {
+            case kIROp_KeepAliveDecoration:
+            case kIROp_ExportDecoration:
+            case kIROp_EntryPointDecoration:
+            case kIROp_DllExportDecoration:
+            case kIROp_ExternCppDecoration:
+            case kIROp_CudaKernelDecoration:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static IRInst* getNamedInst(IRFunc* func)
+    {
+        if (auto generic = findOuterGeneric(func))
+            return generic;
+        return func;
+    }
+
+    bool shouldInline(CallSiteInfo const& info)
+    {
+        auto call = info.call;
+        auto callee = info.callee;
+        auto calleeName = getNamedInst(callee);
+        auto callerName = getNamedInst(m_caller);
+
+        for (auto decor : callee->getDecorations())
+        {
+            // The definition of a function that has a target specific implementation must be
+            // kept as a call, so that the implementation is used.
+            if (as<IRTargetSpecificDecoration>(decor))
+                return false;
+            if (as<IRNoInlineDecoration>(decor))
+            {
+                if (m_options.reportDecisions)
+                    m_sink->diagnose(
+                        call,
+                        Diagnostics::notInlinedNoInline,
+                        calleeName,
+                        callerName);
+                return false;
+            }
+        }
+        if (m_callGraph.recursiveFuncs.contains(callee))
+        {
+            if (m_options.reportDecisions)
+                m_sink->diagnose(call, Diagnostics::notInlinedRecursive, calleeName, callerName);
+            return false;
+        }
+
+        Index calleeSize = 0;
+        if (auto size = m_funcSizes.tryGetValue(callee))
+            calleeSize = *size;
+        else
+            calleeSize = getFuncSize(callee);
+        Index callCost = getCallCost(call);
+
+        Index threshold = m_options.sizeThreshold;
+        Int argIndex = 0;
+        for (auto param : callee->getParams())
+        {
+            if (argIndex >= (Int)call->getArgCount())
+                break;
+            if (as<IRConstant>(call->getArg(argIndex++)))
+            {
+                threshold += m_options.constantArgBonus;
+                if (isUsedInBranchCondition(param))
+                    threshold += m_options.constantArgBonus;
+            }
+        }
+        Index* callCount = m_callGraph.callCountToFunc.tryGetValue(callee);
+        if (callCount && *callCount == 1 && isOnlyReference(call))
+            threshold = Math::Max(threshold, m_options.singleCallSiteThreshold);
+        threshold += callCost;
+
+        if (calleeSize > threshold)
+        {
+            if (m_options.reportDecisions)
+                m_sink->diagnose(
+                    call,
+                    Diagnostics::notInlinedOverThreshold,
+                    calleeName,
+                    callerName,
+                    calleeSize,
+                    threshold);
+            return false;
+        }
+
+        Index newCallerSize = m_callerSize + calleeSize - callCost;
+        if (newCallerSize > m_options.maxCallerSize)
+        {
+            if (m_options.reportDecisions)
+                m_sink->diagnose(
+                    call,
+                    Diagnostics::notInlinedCallerTooLarge,
+                    calleeName,
+                    callerName,
+                    newCallerSize,
+                    m_options.maxCallerSize);
+            return false;
+        }
+
+        if (m_options.reportDecisions)
+            m_sink->diagnose(
+                call,
+                Diagnostics::inlinedCall,
+                calleeName,
+                callerName,
+                calleeSize,
+                threshold);
+
+        // The calls made by the callee are now also made from the caller.
+        m_callerSize = newCallerSize;
+        if (callCount)
+            (*callCount)--;
+        for (auto calleeCall : m_callGraph.callsFromFunc[callee])
+        {
+            auto calledFunc = getCalledFunc(calleeCall);
+            if (auto count = m_callGraph.callCountToFunc.tryGetValue(calledFunc))
+                (*count)++;
+        }
+        return true;
+    }
+
+    bool considerCallsFromFunc(IRFunc* func)
+    {
+        m_caller = func;
+        m_callerSize = getFuncSize(func);
+
+        bool changed = false;
+        auto& calls = m_callGraph.callsFromFunc[func];
+        for (auto call : List<IRCall*>(calls))
+            changed |= considerCallSite(call);
+
+        // The callers of `func` see it as it is after inlining.
+        if (changed)
+            collectCallsFromFunc(func, calls);
+        m_funcSizes[func] = getFuncSize(func);
+        return changed;
+    }
+
+    bool run()
+    {
+        buildCallGraph(m_module, m_callGraph);
+
+        bool changed = false;
+        for (auto func : m_callGraph.bottomUpOrder)
+            changed |= considerCallsFromFunc(func);
+        return changed;
+    }
+};
+
+bool performCostModelInlining(
+    IRModule* module,
+    CostModelInliningOptions const& options,
+    DiagnosticSink* sink)
+{
+    SLANG_PROFILE;
+
+    if (options.sizeThreshold <= 0)
+        return false;
+
+    CostModelInliningPass pass(module, options, sink);
+    return pass.run();
+}
+
 } // namespace Slang
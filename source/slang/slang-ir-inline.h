@@ -40,4 +40,39 @@ void performIntrinsicFunctionInlining(IRModule* module);
 
 /// Inline a specific call.
 bool inlineCall(IRCall* call);
+
+/// Thresholds for `performCostModelInlining`, measured in the estimated number of instructions
+/// that a function will generate.
+struct CostModelInliningOptions
+{
+    /// A call is inlined if the callee is no larger than this, plus the size of the call itself
+    /// and the bonus for its constant arguments. 0 disables cost model inlining.
+    Index sizeThreshold = 0;
+
+    /// Added to the threshold for each constant argument, and added twice for an argument that
+    /// the callee uses in a branch condition, as inlining lets those branches be folded.
+    Index constantArgBonus = 0;
+
+    /// The threshold used instead for the only call to a function that can be removed once the
+    /// call is inlined, so that inlining it doesn't grow the code.
+    Index singleCallSiteThreshold = 0;
+
+    /// No call is inlined into a function that would grow larger than this.
+    Index maxCallerSize = 0;
+
+    /// Report each decision that is made as a note.
+    bool reportDecisions = false;
+
+    /// Get the options for the optimization level and options of `targetProgram`.
+    static CostModelInliningOptions getForTarget(TargetProgram* targetProgram);
+};
+
+/// Inline the calls that the cost model in `options` judges to be worth it, working up from the
+/// leaves of the call graph so that a callee has been simplified by inlining before its own
+/// callers consider it. Recursive functions and functions marked `[noinline]` are not inlined.
+/// Returns true if any call was inlined.
+bool performCostModelInlining(
+    IRModule* module,
+    CostModelInliningOptions const& options,
+    DiagnosticSink* sink);
 } // namespace Slang
@@ -1354,12 +1354,25 @@ struct CPUEntryPointVaryingParamLegalizeContext : EntryPointVaryingParamLegalize
 
     IRStructKey* groupIDKey = nullptr;
     IRStructKey* groupThreadIDKey = nullptr;
+    IRStructKey* groupKey = nullptr;
+
+    // If any code in the module synchronizes the threads of a group, the
+    // barriers need the thread group that the calling thread is running in.
+    // The `ComputeThreadVaryingInput` is part of the host interface and can't
+    // be extended, so the entry points take a `ComputeGroupThreadVaryingInput`
+    // instead, which has a `group` field as well. Each entry point stores the
+    // group in a global variable, which is then made available to all functions
+    // by the explicit global context pass.
+    IRGlobalVar* groupVar = nullptr;
 
     void beginModuleImpl() SLANG_OVERRIDE
     {
         IRBuilder builder(m_module);
         builder.setInsertInto(m_module->getModuleInst());
 
+        List<IRInst*> barriers;
+        _findGroupBarriers(barriers);
+
         uintType = builder.getBasicType(BaseType::UInt);
         uint3Type = builder.getVectorType(uintType, builder.getIntValue(builder.getIntType(), 3));
         uint3PtrType = builder.getPtrType(uint3Type);
@@ -1375,7 +1388,8 @@ struct CPUEntryPointVaryingParamLegalizeContext : EntryPointVaryingParamLegalize
         builder.addTargetIntrinsicDecoration(
             varyingInputStructType,
             CapabilitySet::makeEmpty(),
-            UnownedTerminatedStringSlice("ComputeThreadVaryingInput"));
+            barriers.getCount() ? UnownedTerminatedStringSlice("ComputeGroupThreadVaryingInput")
+                                : UnownedTerminatedStringSlice("ComputeThreadVaryingInput"));
 
         groupIDKey = builder.createStructKey();
         builder.addTargetIntrinsicDecoration(
@@ -1390,6 +1404,60 @@ struct CPUEntryPointVaryingParamLegalizeContext : EntryPointVaryingParamLegalize
             CapabilitySet::makeEmpty(),
             UnownedTerminatedStringSlice("groupThreadID"));
         builder.createStructField(varyingInputStructType, groupThreadIDKey, uint3Type);
+
+        if (barriers.getCount())
+        {
+            groupKey = builder.createStructKey();
+            builder.addTargetIntrinsicDecoration(
+                groupKey,
+                CapabilitySet::makeEmpty(),
+                UnownedTerminatedStringSlice("group"));
+            builder.createStructField(
+                varyingInputStructType,
+                groupKey,
+                builder.getRawPointerType());
+
+            _replaceGroupBarriers(builder, barriers);
+        }
+    }
+
+    void _findGroupBarriers(List<IRInst*>& outBarriers)
+    {
+        for (auto globalInst : m_module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(globalInst);
+            if (!func)
+                continue;
+            for (auto block : func->getBlocks())
+            {
+                for (auto inst : block->getChildren())
+                {
+                    if (inst->getOp() == kIROp_GroupMemoryBarrierWithGroupSync &&
+                        inst->getOperandCount() == 0)
+                        outBarriers.add(inst);
+                }
+            }
+        }
+    }
+
+    void _replaceGroupBarriers(IRBuilder& builder, const List<IRInst*>& barriers)
+    {
+        builder.setInsertInto(m_module->getModuleInst());
+        groupVar = builder.createGlobalVar(builder.getRawPointerType());
+        builder.addNameHintDecoration(groupVar, UnownedTerminatedStringSlice("threadGroup"));
+
+        // The barriers are replaced with ones that take the group as an operand.
+        for (auto barrier : barriers)
+        {
+            builder.setInsertBefore(barrier);
+            IRInst* group = builder.emitLoad(groupVar);
+            builder.emitIntrinsicInst(
+                builder.getVoidType(),
+                kIROp_GroupMemoryBarrierWithGroupSync,
+                1,
+                &group);
+            barrier->removeAndDeallocate();
+        }
     }
 
     // While the declaration of the `ComputeVaryingThreadInput` type
@@ -1426,6 +1494,17 @@ struct CPUEntryPointVaryingParamLegalizeContext : EntryPointVaryingParamLegalize
         groupThreadID = builder.emitLoad(
             builder.emitFieldAddress(uint3PtrType, varyingInputParam, groupThreadIDKey));
 
+        if (groupVar)
+        {
+            auto rawPtrType = builder.getRawPointerType();
+            builder.emitStore(
+                groupVar,
+                builder.emitLoad(builder.emitFieldAddress(
+                    builder.getPtrType(rawPtrType),
+                    varyingInputParam,
+                    groupKey)));
+        }
+
         // Note: we need to rely on the presence of the `[numthreads(...)]` attribute
         // to tell us the size of the compute thread group, which we will then use
         // when computing the dispatch thread ID and group thread index.
@@ -5,6 +5,7 @@
 #include "../core/slang-performance-profiler.h"
 #include "slang-capability.h"
 #include "slang-ir-autodiff.h"
+#include "slang-ir-fold-specialization-constants.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-layout.h"
 #include "slang-ir-specialize-target-switch.h"
@@ -1948,6 +1949,14 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     // Specialize target_switch branches to use the best branch for the target.
     specializeTargetSwitch(targetReq, state->irModule, codeGenContext->getSink());
 
+    // Replace the specialization and link-time constants that were given values with
+    // those values. This happens before checking for unresolved symbols, so an `extern`
+    // constant without a definition can be given its value this way.
+    foldSpecializationConstants(
+        state->irModule,
+        targetProgram->getOptionSet(),
+        codeGenContext->getSink());
+
     // Diagnose on unresolved symbols if we are compiling into a target that does
     // not allow incomplete symbols.
     // At this point, we should not see any [import] symbols that does not have a
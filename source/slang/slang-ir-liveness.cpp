@@ -1674,4 +1674,147 @@ static void _processFunction(IRFunc* funcInst, List<IRVar*>& ioVars)
     }
 }
 
+/* static */ Index RegisterPressure::getRegisterCount(IRType* type)
+{
+    if (auto basicType = as<IRBasicType>(type))
+    {
+        switch (basicType->getOp())
+        {
+        case kIROp_VoidType:
+            return 0;
+        case kIROp_Int64Type:
+        case kIROp_UInt64Type:
+        case kIROp_DoubleType:
+            return 2;
+        default:
+            return 1;
+        }
+    }
+    if (auto vectorType = as<IRVectorType>(type))
+    {
+        auto count = as<IRIntLit>(vectorType->getElementCount());
+        return (count ? count->getValue() : 1) * getRegisterCount(vectorType->getElementType());
+    }
+    if (auto matrixType = as<IRMatrixType>(type))
+    {
+        auto rows = as<IRIntLit>(matrixType->getRowCount());
+        auto columns = as<IRIntLit>(matrixType->getColumnCount());
+        return (rows ? rows->getValue() : 1) * (columns ? columns->getValue() : 1) *
+               getRegisterCount(matrixType->getElementType());
+    }
+    if (auto arrayType = as<IRArrayType>(type))
+    {
+        auto count = as<IRIntLit>(arrayType->getElementCount());
+        return (count ? count->getValue() : 1) * getRegisterCount(arrayType->getElementType());
+    }
+    if (auto structType = as<IRStructType>(type))
+    {
+        Index count = 0;
+        for (auto field : structType->getFields())
+            count += getRegisterCount(field->getFieldType());
+        return count;
+    }
+    return 0;
+}
+
+/* static */ RegisterPressure RegisterPressure::estimate(IRGlobalValueWithCode* func)
+{
+    RegisterPressure result;
+
+    // Number the values that take registers.
+    Dictionary<IRInst*, Index> valueIndices;
+    List<Index> valueRegisterCounts;
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (as<IRVar>(inst))
+                continue;
+            auto registerCount = getRegisterCount(inst->getDataType());
+            if (registerCount == 0)
+                continue;
+            valueIndices[inst] = valueRegisterCounts.getCount();
+            valueRegisterCounts.add(registerCount);
+        }
+    }
+    auto valueCount = UInt(valueRegisterCounts.getCount());
+
+    // Find the values live into each block, by walking the blocks backwards from the live values
+    // of their successors until nothing changes.
+    auto blocks = getPostorder(func);
+    Dictionary<IRBlock*, UIntSet> liveIns;
+    UIntSet live;
+
+    auto getLiveOut = [&](IRBlock* block)
+    {
+        live.resizeAndClear(valueCount);
+        for (auto succ : block->getSuccessors())
+        {
+            if (auto succLive = liveIns.tryGetValue(succ))
+                live.unionWith(*succLive);
+        }
+    };
+    auto kill = [&](IRInst* inst, Index& ioRegisterCount)
+    {
+        auto index = valueIndices.tryGetValue(inst);
+        if (index && live.contains(UInt(*index)))
+        {
+            live.remove(UInt(*index));
+            ioRegisterCount -= valueRegisterCounts[*index];
+        }
+    };
+    auto use = [&](IRInst* inst, Index& ioRegisterCount)
+    {
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            auto index = valueIndices.tryGetValue(inst->getOperand(i));
+            if (index && !live.contains(UInt(*index)))
+            {
+                live.add(UInt(*index));
+                ioRegisterCount += valueRegisterCounts[*index];
+            }
+        }
+    };
+    // Walk `block` backwards from the values in `live`, and return the largest register count.
+    auto walkBlock = [&](IRBlock* block)
+    {
+        Index registerCount = 0;
+        for (auto index : live)
+            registerCount += valueRegisterCounts[Index(index)];
+        Index peak = registerCount;
+        for (auto inst = block->getLastChild(); inst; inst = inst->getPrevInst())
+        {
+            kill(inst, registerCount);
+            if (!as<IRParam>(inst))
+                use(inst, registerCount);
+            peak = Math::Max(peak, registerCount);
+        }
+        return peak;
+    };
+
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (auto block : blocks)
+        {
+            getLiveOut(block);
+            walkBlock(block);
+            auto existing = liveIns.tryGetValue(block);
+            if (existing && *existing == live)
+                continue;
+            liveIns[block] = live;
+            changed = true;
+        }
+    }
+
+    for (auto block : blocks)
+    {
+        getLiveOut(block);
+        auto peak = walkBlock(block);
+        result.blockPeaks[block] = peak;
+        result.peak = Math::Max(result.peak, peak);
+    }
+    return result;
+}
+
 } // namespace Slang
@@ -197,6 +197,27 @@ struct LivenessUtil
     static void addRangeEnds(IRModule* module, LivenessMode mode);
 };
 
+/* An estimate of the number of registers needed to hold the SSA values of a function.
+
+Unlike the variable ranges above, this tracks the values of instructions and block parameters. A
+value is live from its definition to its last use on any path. A scalar takes one register (two for
+64-bit types), vectors and matrices take one per element, and structs and arrays the sum of their
+elements. Variables, pointers and other values that aren't held in registers are not counted. */
+struct RegisterPressure
+{
+    /// The largest number of registers live at any point in each block.
+    Dictionary<IRBlock*, Index> blockPeaks;
+
+    /// The largest number of registers live at any point in the function.
+    Index peak = 0;
+
+    /// Estimate the register pressure of `func`, which must be in SSA form.
+    static RegisterPressure estimate(IRGlobalValueWithCode* func);
+
+    /// Get the number of registers a value of `type` takes.
+    static Index getRegisterCount(IRType* type);
+};
+
 } // namespace Slang
 
 #endif // SLANG_IR_LIVENESS_H
@@ -0,0 +1,166 @@
+// slang-ir-loop-invariant-code-motion.cpp
+#include "slang-ir-loop-invariant-code-motion.h"
+
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct LoopInvariantCodeMotionContext
+{
+    IRGlobalValueWithCode* func;
+    IRDominatorTree* dom;
+
+    // The blocks ending in an `IRLoop` for the loops that a block is inside, from the innermost
+    // loop outwards.
+    List<IRBlock*> enclosingLoopHeaders;
+
+    void findEnclosingLoops(IRBlock* block)
+    {
+        enclosingLoopHeaders.clear();
+        for (auto parentBlock = dom->getImmediateDominator(block); parentBlock;
+             parentBlock = dom->getImmediateDominator(parentBlock))
+        {
+            auto loop = as<IRLoop>(parentBlock->getTerminator());
+            if (!loop)
+                continue;
+            // Blocks after the loop are dominated by its break block.
+            if (dom->dominates(loop->getBreakBlock(), block))
+                continue;
+            enclosingLoopHeaders.add(parentBlock);
+        }
+    }
+
+    bool canHoistInst(IRInst* inst)
+    {
+        if (inst->mightHaveSideEffects())
+            return false;
+
+        // The inst is executed on entry to the loop, even if the loop body would not have
+        // executed it, so it must not depend on memory that can change, or be able to trap.
+        if (!isMovableInst(inst))
+            return false;
+
+        switch (inst->getOp())
+        {
+        case kIROp_IRem:
+            {
+                // An integer remainder can trap when the divisor is zero, or when it is -1
+                // and the dividend is the smallest signed value.
+                auto divisor = as<IRIntLit>(inst->getOperand(1));
+                return divisor && divisor->getValue() != 0 && divisor->getValue() != -1;
+            }
+        default:
+            return true;
+        }
+    }
+
+    bool isAvailableAt(IRInst* value, IRBlock* block)
+    {
+        if (!value)
+            return true;
+
+        // Values from outside of this function are available everywhere in it.
+        auto valueBlock = as<IRBlock>(value->getParent());
+        if (!valueBlock)
+            return value->getParent() != func;
+        if (valueBlock->getParent() != func)
+            return true;
+
+        return dom->dominates(valueBlock, block);
+    }
+
+    bool isInvariantAt(IRInst* inst, IRBlock* loopHeader)
+    {
+        if (!isAvailableAt(inst->getFullType(), loopHeader))
+            return false;
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            if (!isAvailableAt(inst->getOperand(i), loopHeader))
+                return false;
+        }
+        return true;
+    }
+
+    bool processBlock(IRBlock* block)
+    {
+        findEnclosingLoops(block);
+        if (enclosingLoopHeaders.getCount() == 0)
+            return false;
+
+        bool changed = false;
+        for (auto inst : block->getModifiableChildren())
+        {
+            if (!canHoistInst(inst))
+                continue;
+
+            // Find the outermost loop that the inst is invariant in. The operands of the inst
+            // have already been hoisted as far as they can go, as they are visited first.
+            IRBlock* target = nullptr;
+            for (auto loopHeader : enclosingLoopHeaders)
+            {
+                if (!isInvariantAt(inst, loopHeader))
+                    break;
+                target = loopHeader;
+            }
+            if (!target)
+                continue;
+
+            inst->insertBefore(target->getTerminator());
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool processFunc()
+    {
+        auto firstBlock = func->getFirstBlock();
+        if (!firstBlock)
+            return false;
+
+        // Visit the blocks in dominator tree order, so that the operands of an inst are hoisted
+        // before the inst itself is considered.
+        List<IRBlock*> blocks;
+        blocks.add(firstBlock);
+        for (Index i = 0; i < blocks.getCount(); i++)
+        {
+            for (auto child : dom->getImmediatelyDominatedBlocks(blocks[i]))
+                blocks.add(child);
+        }
+
+        bool changed = false;
+        for (auto block : blocks)
+            changed |= processBlock(block);
+        return changed;
+    }
+};
+
+static bool _hoistLoopInvariantInstsInFunc(IRGlobalValueWithCode* func)
+{
+    auto module = func->getModule();
+    if (!module || !func->getFirstBlock())
+        return false;
+
+    // Moving insts doesn't change the control flow graph, so the dominator tree stays valid.
+    LoopInvariantCodeMotionContext context;
+    context.func = func;
+    context.dom = module->findOrCreateDominatorTree(func);
+    return context.processFunc();
+}
+
+bool hoistLoopInvariantInsts(IRGlobalValueWithCode* func)
+{
+    bool changed = false;
+    if (auto genericFunc = as<IRGeneric>(func))
+    {
+        if (auto inner = as<IRFunc>(findGenericReturnVal(genericFunc)))
+            changed |= _hoistLoopInvariantInstsInFunc(inner);
+    }
+    changed |= _hoistLoopInvariantInstsInFunc(func);
+    return changed;
+}
+
+} // namespace Slang
@@ -0,0 +1,15 @@
+// slang-ir-loop-invariant-code-motion.h
+#pragma once
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+
+/// Move instructions that compute the same value on every iteration of a loop out of the loop.
+///
+/// An instruction is moved to the block that enters the outermost loop it is invariant in, if it
+/// has no side effects and is safe to execute even when the loop body would not have executed
+/// it. Returns true if any instruction was moved.
+///
+bool hoistLoopInvariantInsts(IRGlobalValueWithCode* func);
+} // namespace Slang
@@ -1,11 +1,13 @@
 #include "slang-ir-loop-unroll.h"
 
 #include "../core/slang-performance-profiler.h"
+#include "slang-compiler.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-dominators.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-peephole.h"
+#include "slang-ir-sccp.h"
 #include "slang-ir-simplify-cfg.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -146,7 +148,7 @@ static void _foldAndSimplifyLoopIteration(
     }
 }
 
-// Unroll loop up to a predefined maximum number of iterations.
+// Unroll loop up to `maxIterations` iterations.
 // Returns true if we can statically determine that the loop terminated within the iteration limit.
 // This operation assumes the loop does not have `continue` jumps, i.e. continueBlock ==
 // targetBlock.
@@ -154,7 +156,8 @@ static bool _unrollLoop(
     TargetProgram* targetProgram,
     IRModule* module,
     IRLoop* loopInst,
-    List<IRBlock*>& blocks)
+    List<IRBlock*>& blocks,
+    int maxIterations)
 {
     if (blocks.getCount() == 0)
     {
@@ -165,7 +168,6 @@ static bool _unrollLoop(
         return true;
     }
 
-    auto maxIterations = _getLoopMaxIterationsToUnroll(loopInst);
     if (maxIterations < 0)
         return true;
 
@@ -471,7 +473,8 @@ bool unrollLoopsInFunc(
 
         auto blocks = collectBlocksInRegion(func, loop);
         auto loopLoc = loop->sourceLoc;
-        if (!_unrollLoop(targetProgram, module, loop, blocks))
+        auto maxIterations = _getLoopMaxIterationsToUnroll(loop);
+        if (!_unrollLoop(targetProgram, module, loop, blocks, maxIterations))
         {
             if (sink)
                 sink->diagnose(loopLoc, Diagnostics::cannotUnrollLoop);
@@ -505,6 +508,314 @@ bool unrollLoopsInModule(TargetProgram* target, IRModule* module, DiagnosticSink
     return true;
 }
 
+AutoLoopUnrollOptions AutoLoopUnrollOptions::getForTarget(TargetProgram* targetProgram)
+{
+    auto& optionSet = targetProgram->getOptionSet();
+
+    AutoLoopUnrollOptions options;
+    switch (optionSet.getOptimizationLevel())
+    {
+    case OptimizationLevel::High:
+        options.sizeBudget = 64;
+        break;
+    case OptimizationLevel::Maximal:
+        options.sizeBudget = 256;
+        break;
+    default:
+        // Lower levels keep loops as they are written, and leave unrolling to the downstream
+        // compiler.
+        break;
+    }
+
+    if (optionSet.hasOption(CompilerOptionName::LoopUnrollBudget))
+        options.sizeBudget = optionSet.getIntOption(CompilerOptionName::LoopUnrollBudget);
+    options.reportUnrolledLoops = optionSet.getBoolOption(CompilerOptionName::ReportLoopUnrolling);
+    return options;
+}
+
+static bool _canAutoUnrollLoop(IRLoop* loop)
+{
+    // Loops marked `[ForceUnroll]` are unrolled by `unrollLoopsInFunc`, and loops marked
+    // `[loop]` are asked to be kept as loops.
+    if (loop->findDecoration<IRForceUnrollDecoration>())
+        return false;
+    if (auto loopControl = loop->findDecoration<IRLoopControlDecoration>())
+    {
+        if (loopControl->getMode() == kIRLoopControl_Loop)
+            return false;
+    }
+    return true;
+}
+
+static bool _isInIntTypeRange(IRType* type, IRIntegerValue value)
+{
+    auto info = getIntTypeInfo(type);
+    if (info.width >= 64)
+        return info.isSigned || value >= 0;
+    if (info.isSigned)
+    {
+        auto limit = IRIntegerValue(1) << (info.width - 1);
+        return value >= -limit && value < limit;
+    }
+    return value >= 0 && value < (IRIntegerValue(1) << info.width);
+}
+
+// Get the constant that `nextValue` adds to `counter`.
+static bool _getCounterStep(IRInst* counter, IRInst* nextValue, IRIntegerValue& outStep)
+{
+    switch (nextValue->getOp())
+    {
+    case kIROp_Add:
+        if (nextValue->getOperand(0) == counter)
+        {
+            if (auto step = as<IRIntLit>(nextValue->getOperand(1)))
+            {
+                outStep = step->getValue();
+                return true;
+            }
+        }
+        else if (nextValue->getOperand(1) == counter)
+        {
+            if (auto step = as<IRIntLit>(nextValue->getOperand(0)))
+            {
+                outStep = step->getValue();
+                return true;
+            }
+        }
+        return false;
+    case kIROp_Sub:
+        if (nextValue->getOperand(0) == counter)
+        {
+            if (auto step = as<IRIntLit>(nextValue->getOperand(1)))
+            {
+                outStep = -step->getValue();
+                return true;
+            }
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+// Get the number of times the body of `loop` runs, if the loop is controlled by a counter that
+// starts at a constant, changes by a constant on every iteration, and is compared against a
+// constant in the loop header. Returns -1 if the count isn't known or is over `maxTripCount`.
+static Index _getConstantTripCount(IRLoop* loop, Index maxTripCount)
+{
+    auto header = loop->getTargetBlock();
+    auto branch = as<IRConditionalBranch>(header->getTerminator());
+    if (!branch)
+        return -1;
+    bool exitsWhenTrue = false;
+    if (branch->getTrueBlock() == loop->getBreakBlock())
+        exitsWhenTrue = true;
+    else if (branch->getFalseBlock() != loop->getBreakBlock())
+        return -1;
+
+    auto condition = branch->getCondition();
+    switch (condition->getOp())
+    {
+    case kIROp_Less:
+    case kIROp_Leq:
+    case kIROp_Greater:
+    case kIROp_Geq:
+    case kIROp_Eql:
+    case kIROp_Neq:
+        break;
+    default:
+        return -1;
+    }
+
+    auto counter = as<IRParam>(condition->getOperand(0));
+    auto bound = as<IRIntLit>(condition->getOperand(1));
+    bool isCounterOnLeft = true;
+    if (!counter || !bound)
+    {
+        counter = as<IRParam>(condition->getOperand(1));
+        bound = as<IRIntLit>(condition->getOperand(0));
+        isCounterOnLeft = false;
+    }
+    if (!counter || !bound || counter->getParent() != header)
+        return -1;
+    auto type = counter->getDataType();
+    if (!isIntegralType(type) || !_isInIntTypeRange(type, bound->getValue()))
+        return -1;
+
+    // The initial value is passed by the loop inst, and the next value by each back edge.
+    UInt paramIndex = 0;
+    for (auto param : header->getParams())
+    {
+        if (param == counter)
+            break;
+        paramIndex++;
+    }
+    if (paramIndex >= loop->getArgCount())
+        return -1;
+    auto initialValue = as<IRIntLit>(loop->getArg(paramIndex));
+    if (!initialValue)
+        return -1;
+
+    IRIntegerValue step = 0;
+    for (auto pred : header->getPredecessors())
+    {
+        if (pred == loop->getParent())
+            continue;
+        auto backEdge = as<IRUnconditionalBranch>(pred->getTerminator());
+        if (!backEdge || paramIndex >= backEdge->getArgCount())
+            return -1;
+        IRIntegerValue backEdgeStep = 0;
+        if (!_getCounterStep(counter, backEdge->getArg(paramIndex), backEdgeStep))
+            return -1;
+        if (step != 0 && backEdgeStep != step)
+            return -1;
+        step = backEdgeStep;
+    }
+    if (step == 0)
+        return -1;
+
+    IRIntegerValue value = initialValue->getValue();
+    for (Index tripCount = 0; tripCount <= maxTripCount; tripCount++)
+    {
+        // Stop at a value that would wrap around, rather than modeling the wrapping.
+        if (!_isInIntTypeRange(type, value))
+            return -1;
+
+        auto lhs = isCounterOnLeft ? value : bound->getValue();
+        auto rhs = isCounterOnLeft ? bound->getValue() : value;
+        bool result = false;
+        switch (condition->getOp())
+        {
+        case kIROp_Less:
+            result = lhs < rhs;
+            break;
+        case kIROp_Leq:
+            result = lhs <= rhs;
+            break;
+        case kIROp_Greater:
+            result = lhs > rhs;
+            break;
+        case kIROp_Geq:
+            result = lhs >= rhs;
+            break;
+        case kIROp_Eql:
+            result = lhs == rhs;
+            break;
+        default:
+            result = lhs != rhs;
+            break;
+        }
+        if (result == exitsWhenTrue)
+            return tripCount;
+        value += step;
+    }
+    return -1;
+}
+
+static Index _getLoopBodySize(List<IRBlock*> const& blocks)
+{
+    Index size = 0;
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            switch (inst->getOp())
+            {
+            case kIROp_Param:
+            case kIROp_DebugLine:
+            case kIROp_DebugVar:
+            case kIROp_DebugValue:
+                break;
+            default:
+                size++;
+                break;
+            }
+        }
+    }
+    return size;
+}
+
+static bool _unrollConstantTripCountLoopsInFunc(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    IRGlobalValueWithCode* func,
+    AutoLoopUnrollOptions const& options,
+    DiagnosticSink* sink)
+{
+    List<IRLoop*> loops = collectLoopsInFunc(func, _canAutoUnrollLoop);
+
+    bool changed = false;
+    for (auto loop : loops)
+    {
+        if (!loop->parent)
+            continue;
+
+        // Every iteration has at least one inst, so no loop that runs more times than the
+        // budget can fit in it.
+        auto tripCount = _getConstantTripCount(loop, options.sizeBudget);
+        if (tripCount < 0)
+            continue;
+
+        auto loopLoc = loop->sourceLoc;
+        auto size = _getLoopBodySize(collectBlocksInRegion(func, loop)) * tripCount;
+        if (size > options.sizeBudget)
+        {
+            if (options.reportUnrolledLoops && sink)
+            {
+                sink->diagnose(
+                    loopLoc,
+                    Diagnostics::loopNotUnrolledOverBudget,
+                    tripCount,
+                    size,
+                    options.sizeBudget);
+            }
+            continue;
+        }
+
+        eliminateContinueBlocks(module, loop);
+        auto blocks = collectBlocksInRegion(func, loop);
+
+        // The last peeled iteration only evaluates the loop condition, and exits.
+        bool unrolled = _unrollLoop(targetProgram, module, loop, blocks, int(tripCount + 1));
+        if (unrolled && options.reportUnrolledLoops && sink)
+        {
+            sink->diagnose(loopLoc, Diagnostics::unrolledLoop, tripCount, size, options.sizeBudget);
+        }
+        changed = true;
+
+        // Fold the values that are now constant in each copy of the body before considering the
+        // outer loops.
+        applySparseConditionalConstantPropagation(func, sink);
+        peepholeOptimize(targetProgram, func);
+        simplifyCFG(func, CFGSimplificationOptions::getDefault());
+        eliminateDeadCode(func);
+    }
+    return changed;
+}
+
+bool unrollConstantTripCountLoopsInModule(
+    TargetProgram* target,
+    IRModule* module,
+    AutoLoopUnrollOptions const& options,
+    DiagnosticSink* sink)
+{
+    SLANG_PROFILE;
+
+    if (options.sizeBudget <= 0)
+        return false;
+
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (as<IRGeneric>(inst))
+            continue;
+
+        if (auto func = as<IRGlobalValueWithCode>(inst))
+            changed |= _unrollConstantTripCountLoopsInFunc(target, module, func, options, sink);
+    }
+    return changed;
+}
+
 void eliminateContinueBlocks(IRModule* module, IRLoop* loopInst)
 {
     // Eliminate the continue jumps by turning a loop in the form of:
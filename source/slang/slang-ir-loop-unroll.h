@@ -21,6 +21,31 @@ bool unrollLoopsInFunc(
 
 bool unrollLoopsInModule(TargetProgram* target, IRModule* module, DiagnosticSink* sink);
 
+/// Limits for `unrollConstantTripCountLoopsInModule`, measured in the number of instructions in
+/// the loop body times the number of iterations.
+struct AutoLoopUnrollOptions
+{
+    /// A loop is unrolled if its unrolled size is no larger than this. 0 disables automatic
+    /// unrolling.
+    int sizeBudget = 0;
+
+    /// Report each loop that is unrolled, or that is over the budget, as a note.
+    bool reportUnrolledLoops = false;
+
+    /// Get the options for the optimization level and options of `targetProgram`.
+    static AutoLoopUnrollOptions getForTarget(TargetProgram* targetProgram);
+};
+
+/// Unroll the loops that are not marked `[ForceUnroll]` or `[loop]`, whose number of iterations
+/// is known at compile time, and whose unrolled size fits in the budget of `options`. Each
+/// function with an unrolled loop is then cleaned up with SCCP, peephole optimization, CFG
+/// simplification and DCE. Returns true if any loop was unrolled.
+bool unrollConstantTripCountLoopsInModule(
+    TargetProgram* target,
+    IRModule* module,
+    AutoLoopUnrollOptions const& options,
+    DiagnosticSink* sink);
+
 // Turn a loop with continue block into a loop with only back jumps and breaks.
 // Each iteration will be wrapped in a breakable region, where everything before `continue`
 // is within the breakable region, and everything after `continue` is outside the breakable
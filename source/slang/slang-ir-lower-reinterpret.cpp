@@ -60,7 +60,7 @@ struct ReinterpretLoweringContext
         auto operand = inst->getOperand(0);
         auto fromType = operand->getDataType();
         auto toType = inst->getDataType();
-        SlangInt fromTypeSize = getAnyValueSize(fromType);
+        SlangInt fromTypeSize = getAnyValueSize(targetProgram, fromType);
         bool cantPack = false;
         if (fromTypeSize < 0)
         {
@@ -70,7 +70,7 @@ struct ReinterpretLoweringContext
                 Slang::Diagnostics::typeCannotBePackedIntoAnyValue,
                 fromType);
         }
-        SlangInt toTypeSize = getAnyValueSize(toType);
+        SlangInt toTypeSize = getAnyValueSize(targetProgram, toType);
         if (toTypeSize < 0)
         {
             cantPack = true;
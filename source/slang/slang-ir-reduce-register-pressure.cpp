@@ -0,0 +1,281 @@
+// slang-ir-reduce-register-pressure.cpp
+#include "slang-ir-reduce-register-pressure.h"
+
+#include "slang-compiler.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-liveness.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+struct RegisterPressureReductionContext
+{
+    IRGlobalValueWithCode* func;
+    IRDominatorTree* dom;
+
+    Dictionary<IRBlock*, IRLoop*> mapBlockToInnermostLoop;
+    Dictionary<IRBlock*, Index> mapBlockToOrder;
+
+    static bool isRepeatingLoop(IRLoop* loop)
+    {
+        // A loop that is only used as a breakable region has no back edge into its target.
+        return loop->getTargetBlock()->getPredecessors().getCount() > 1;
+    }
+
+    IRLoop* getInnermostLoop(IRBlock* block)
+    {
+        if (auto loop = mapBlockToInnermostLoop.tryGetValue(block))
+            return *loop;
+
+        IRLoop* result = nullptr;
+        for (auto parentBlock = dom->getImmediateDominator(block); parentBlock;
+             parentBlock = dom->getImmediateDominator(parentBlock))
+        {
+            auto loop = as<IRLoop>(parentBlock->getTerminator());
+            if (!loop)
+                continue;
+            // Blocks after the loop are dominated by its break block.
+            if (dom->dominates(loop->getBreakBlock(), block))
+                continue;
+            if (!isRepeatingLoop(loop))
+                continue;
+            result = loop;
+            break;
+        }
+        mapBlockToInnermostLoop[block] = result;
+        return result;
+    }
+
+    bool isLocalValue(IRInst* value)
+    {
+        auto block = as<IRBlock>(value->getParent());
+        return block && block->getParent() == func;
+    }
+
+    static bool canMoveInst(IRInst* inst)
+    {
+        return isMovableInst(inst) && !inst->mightHaveSideEffects();
+    }
+
+    // Whether `inst` is cheap enough to compute again in each block that uses it.
+    static bool isCheapInst(IRInst* inst)
+    {
+        switch (inst->getOp())
+        {
+        case kIROp_MakeVector:
+        case kIROp_MakeVectorFromScalar:
+        case kIROp_MakeMatrixFromScalar:
+        case kIROp_swizzle:
+        case kIROp_GetElement:
+        case kIROp_FieldExtract:
+        case kIROp_IntCast:
+        case kIROp_FloatCast:
+        case kIROp_CastIntToFloat:
+        case kIROp_CastFloatToInt:
+        case kIROp_BitCast:
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Neg:
+        case kIROp_Not:
+        case kIROp_BitAnd:
+        case kIROp_BitOr:
+        case kIROp_BitXor:
+        case kIROp_BitNot:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_Less:
+        case kIROp_Greater:
+        case kIROp_Leq:
+        case kIROp_Geq:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Whether the operands of `inst` are live in `block` even if `inst` isn't computed there.
+    bool areOperandsLiveIn(IRInst* inst, IRBlock* block)
+    {
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            auto operand = inst->getOperand(i);
+            if (!isLocalValue(operand))
+                continue;
+            bool isUsedInBlock = false;
+            for (auto use = operand->firstUse; use; use = use->nextUse)
+            {
+                if (use->getUser() != inst && use->getUser()->getParent() == block)
+                {
+                    isUsedInBlock = true;
+                    break;
+                }
+            }
+            if (!isUsedInBlock)
+                return false;
+        }
+        return true;
+    }
+
+    bool tryRematerializeInst(IRInst* inst)
+    {
+        if (!isCheapInst(inst) || !canMoveInst(inst) || !inst->hasUses())
+            return false;
+        auto block = as<IRBlock>(inst->getParent());
+        auto loop = getInnermostLoop(block);
+
+        // Every use must be in another block, otherwise the original inst stays, and the
+        // copies would be deduplicated into it again.
+        List<IRUse*> uses;
+        List<IRBlock*> useBlocks;
+        HashSet<IRInst*> users;
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            auto userBlock = as<IRBlock>(use->getUser()->getParent());
+            if (!userBlock || userBlock == block || !mapBlockToOrder.containsKey(userBlock))
+                return false;
+            if (getInnermostLoop(userBlock) != loop)
+                return false;
+            uses.add(use);
+            users.add(use->getUser());
+            if (!useBlocks.contains(userBlock))
+                useBlocks.add(userBlock);
+        }
+        useBlocks.sort([&](IRBlock* a, IRBlock* b)
+                       { return mapBlockToOrder.getValue(a) < mapBlockToOrder.getValue(b); });
+
+        // A block that is dominated by another block with a copy uses that copy, the same as
+        // deduplication would make it.
+        List<IRBlock*> copyBlocks;
+        Dictionary<IRBlock*, IRBlock*> mapUseBlockToCopyBlock;
+        for (auto useBlock : useBlocks)
+        {
+            IRBlock* copyBlock = nullptr;
+            for (auto existingCopyBlock : copyBlocks)
+            {
+                if (dom->dominates(existingCopyBlock, useBlock))
+                {
+                    copyBlock = existingCopyBlock;
+                    break;
+                }
+            }
+            if (!copyBlock)
+            {
+                if (!areOperandsLiveIn(inst, useBlock))
+                    return false;
+                copyBlock = useBlock;
+                copyBlocks.add(copyBlock);
+            }
+            mapUseBlockToCopyBlock[useBlock] = copyBlock;
+        }
+
+        IRBuilder builder(func);
+        Dictionary<IRBlock*, IRInst*> mapBlockToCopy;
+        for (auto copyBlock : copyBlocks)
+        {
+            IRInst* firstUser = copyBlock->getFirstOrdinaryInst();
+            while (!users.contains(firstUser))
+                firstUser = firstUser->getNextInst();
+            builder.setInsertBefore(firstUser);
+            IRCloneEnv cloneEnv;
+            mapBlockToCopy[copyBlock] = cloneInst(&cloneEnv, &builder, inst);
+        }
+        for (auto use : uses)
+        {
+            auto userBlock = as<IRBlock>(use->getUser()->getParent());
+            use->set(mapBlockToCopy.getValue(mapUseBlockToCopyBlock.getValue(userBlock)));
+        }
+        inst->removeAndDeallocate();
+        return true;
+    }
+
+    bool trySinkInst(IRInst* inst)
+    {
+        if (!canMoveInst(inst))
+            return false;
+        auto use = inst->firstUse;
+        if (!use || use->nextUse)
+            return false;
+        auto user = use->getUser();
+        if (user == inst->getNextInst())
+            return false;
+        auto userBlock = as<IRBlock>(user->getParent());
+        if (!userBlock || userBlock->getParent() != func)
+            return false;
+
+        // Moving an inst into a loop would compute it on every iteration.
+        auto block = as<IRBlock>(inst->getParent());
+        if (userBlock != block && getInnermostLoop(userBlock) != getInnermostLoop(block))
+            return false;
+
+        // The inst dominates its use, so its operands are still available there.
+        inst->insertBefore(user);
+        return true;
+    }
+
+    bool processFunc()
+    {
+        auto blocks = getReversePostorder(func);
+        for (Index i = 0; i < blocks.getCount(); i++)
+            mapBlockToOrder[blocks[i]] = i;
+
+        bool changed = false;
+        for (auto block : blocks)
+        {
+            for (auto inst : block->getModifiableChildren())
+                changed |= tryRematerializeInst(inst);
+        }
+
+        // Visit the uses before the insts they use, so that a chain of single use insts is moved
+        // together.
+        for (Index i = blocks.getCount() - 1; i >= 0; i--)
+        {
+            for (auto inst = blocks[i]->getLastChild(); inst;)
+            {
+                auto prevInst = inst->getPrevInst();
+                changed |= trySinkInst(inst);
+                inst = prevInst;
+            }
+        }
+        return changed;
+    }
+};
+
+bool reduceRegisterPressure(IRModule* module, bool reportPressure, DiagnosticSink* sink)
+{
+    bool changed = false;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func || !func->getFirstBlock())
+            continue;
+
+        Index peakBefore = 0;
+        if (reportPressure)
+            peakBefore = RegisterPressure::estimate(func).peak;
+
+        // Moving insts doesn't change the control flow graph, so the dominator tree stays valid.
+        RegisterPressureReductionContext context;
+        context.func = func;
+        context.dom = module->findOrCreateDominatorTree(func);
+        changed |= context.processFunc();
+
+        if (reportPressure && sink)
+        {
+            sink->diagnose(
+                func,
+                Diagnostics::registerPressureReduced,
+                func,
+                peakBefore,
+                RegisterPressure::estimate(func).peak);
+        }
+    }
+    return changed;
+}
+
+} // namespace Slang
@@ -0,0 +1,18 @@
+// slang-ir-reduce-register-pressure.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+class DiagnosticSink;
+
+/// Shorten the live ranges of the SSA values in the functions of `module`.
+///
+/// A cheap instruction whose operands are live in the blocks that use it anyway is recomputed in
+/// those blocks, and a pure instruction with a single use is moved to just before that use.
+/// Instructions are never moved into a loop. If `reportPressure` is true, the estimated peak
+/// register pressure of each function before and after is reported as a note. Returns true if
+/// anything was changed.
+///
+bool reduceRegisterPressure(IRModule* module, bool reportPressure, DiagnosticSink* sink);
+} // namespace Slang
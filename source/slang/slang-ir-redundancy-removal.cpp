@@ -1,5 +1,6 @@
 #include "slang-ir-redundancy-removal.h"
 
+#include "slang-ir-dead-store-elimination.h"
 #include "slang-ir-dominators.h"
 #include "slang-ir-util.h"
 
@@ -152,6 +153,7 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func)
     if (auto normalFunc = as<IRFunc>(func))
     {
         result |= eliminateRedundantLoadStore(normalFunc);
+        result |= eliminateDeadStoresAndForwardLoads(normalFunc);
     }
     return result;
 }
@@ -3,19 +3,25 @@
 #include "slang-ir-generics-lowering-context.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
+#include "slang-ir-witness-table-flow.h"
 #include "slang-ir.h"
 
 namespace Slang
 {
-IRFunc* specializeDispatchFunction(
-    SharedGenericsLoweringContext* sharedContext,
-    IRFunc* dispatchFunc)
+static IRInst* _getDispatchConformanceType(IRFunc* dispatchFunc)
 {
     auto witnessTableType = cast<IRFuncType>(dispatchFunc->getDataType())->getParamType(0);
-    auto conformanceType = cast<IRWitnessTableTypeBase>(witnessTableType)->getConformanceType();
-    // Collect all witness tables of `witnessTableType` in current module.
-    List<IRWitnessTable*> witnessTables =
-        sharedContext->getWitnessTablesFromInterfaceType(conformanceType);
+    return cast<IRWitnessTableTypeBase>(witnessTableType)->getConformanceType();
+}
+
+// Create a dispatch function that calls the implementation of the requirement from the witness
+// table that is passed in, out of the `witnessTables` given.
+static IRFunc* _createSwitchDispatchFunction(
+    SharedGenericsLoweringContext* sharedContext,
+    IRFunc* dispatchFunc,
+    List<IRWitnessTable*> const& witnessTables)
+{
+    auto conformanceType = _getDispatchConformanceType(dispatchFunc);
 
     SLANG_ASSERT(dispatchFunc->getFirstBlock() == dispatchFunc->getLastBlock());
     auto block = dispatchFunc->getFirstBlock();
@@ -65,7 +71,6 @@ IRFunc* specializeDispatchFunction(
 
     auto newDipsatchFuncType = builder->getFuncType(paramTypes, dispatchFunc->getResultType());
     newDispatchFunc->setFullType(newDipsatchFuncType);
-    dispatchFunc->transferDecorationsTo(newDispatchFunc);
 
     builder->setInsertInto(newDispatchFunc);
     auto newBlock = builder->emitBlock();
@@ -170,6 +175,20 @@ IRFunc* specializeDispatchFunction(
             builder->emitReturn(defaultValue);
         }
     }
+    return newDispatchFunc;
+}
+
+IRFunc* specializeDispatchFunction(
+    SharedGenericsLoweringContext* sharedContext,
+    IRFunc* dispatchFunc)
+{
+    // Collect all witness tables of the interface in current module.
+    List<IRWitnessTable*> witnessTables =
+        sharedContext->getWitnessTablesFromInterfaceType(_getDispatchConformanceType(dispatchFunc));
+    auto newDispatchFunc =
+        _createSwitchDispatchFunction(sharedContext, dispatchFunc, witnessTables);
+    dispatchFunc->transferDecorationsTo(newDispatchFunc);
+
     // Remove old implementation.
     dispatchFunc->replaceUsesWith(newDispatchFunc);
     dispatchFunc->removeAndDeallocate();
@@ -291,14 +310,145 @@ void fixupDispatchFuncCall(SharedGenericsLoweringContext* sharedContext, IRFunc*
     }
 }
 
+struct DispatchNarrowingStats
+{
+    Index callSiteCount = 0;
+    Index directCallCount = 0;
+    Index narrowedCallCount = 0;
+};
+
+// Narrows the dispatch at each call site of `dispatchFunc` to the witness tables that can reach
+// it, as found by `flow`. A call that can only reach one witness table calls its implementation
+// of the requirement directly. A call that can reach more than one, but not all of the witness
+// tables of the interface, calls a dispatch function that only switches over those it can reach.
+// The dispatch functions created for that are added to `outNarrowedFuncs`.
+static void _narrowDispatchCallSites(
+    SharedGenericsLoweringContext* sharedContext,
+    IRWitnessTableFlow* flow,
+    IRInst* requirementKey,
+    IRFunc* dispatchFunc,
+    List<IRFunc*>& outNarrowedFuncs,
+    DispatchNarrowingStats& stats)
+{
+    auto sink = sharedContext->sink;
+    const bool report = sharedContext->targetProgram->getOptionSet().getBoolOption(
+        CompilerOptionName::ReportDynamicDispatch);
+
+    auto conformanceType = _getDispatchConformanceType(dispatchFunc);
+    List<IRWitnessTable*> allWitnessTables =
+        sharedContext->getWitnessTablesFromInterfaceType(conformanceType);
+
+    List<IRCall*> calls;
+    for (auto use = dispatchFunc->firstUse; use; use = use->nextUse)
+    {
+        auto call = as<IRCall>(use->getUser());
+        if (call && call->getCallee() == dispatchFunc)
+            calls.add(call);
+    }
+
+    // The witness tables that each narrowed dispatch function switches over.
+    List<List<IRWitnessTable*>> narrowedFuncWitnessTables;
+
+    HashSet<IRWitnessTable*> possibleWitnessTables;
+    for (auto call : calls)
+    {
+        stats.callSiteCount++;
+        if (!flow->getPossibleWitnessTables(call->getArg(0), possibleWitnessTables))
+            continue;
+
+        // Keep the order of the witness tables in the module, so that the same set of witness
+        // tables always gives the same function.
+        List<IRWitnessTable*> witnessTables;
+        for (auto witnessTable : allWitnessTables)
+        {
+            if (possibleWitnessTables.contains(witnessTable))
+                witnessTables.add(witnessTable);
+        }
+
+        // A call that no witness table can reach is never executed, so it is left as it is.
+        if (witnessTables.getCount() == 0 ||
+            witnessTables.getCount() == allWitnessTables.getCount())
+            continue;
+
+        IRBuilder builder(sharedContext->module);
+        if (witnessTables.getCount() == 1)
+        {
+            auto callee = findWitnessTableEntry(witnessTables[0], requirementKey);
+            if (!callee)
+                continue;
+            if (report)
+            {
+                sink->diagnose(
+                    call,
+                    Diagnostics::dynamicDispatchCalledDirectly,
+                    requirementKey,
+                    witnessTables[0]->getConcreteType());
+            }
+
+            builder.setInsertBefore(call);
+            List<IRInst*> args;
+            for (UInt i = 1; i < call->getArgCount(); i++)
+                args.add(call->getArg(i));
+            auto directCall = builder.emitCallInst(call->getFullType(), callee, args);
+            call->replaceUsesWith(directCall);
+            call->removeAndDeallocate();
+            stats.directCallCount++;
+            continue;
+        }
+
+        // Call sites that can reach the same witness tables share a dispatch function.
+        Index narrowedFuncIndex = narrowedFuncWitnessTables.indexOf(witnessTables);
+        if (narrowedFuncIndex < 0)
+        {
+            auto narrowedFunc =
+                _createSwitchDispatchFunction(sharedContext, dispatchFunc, witnessTables);
+            if (auto nameHint = dispatchFunc->findDecoration<IRNameHintDecoration>())
+                builder.addNameHintDecoration(narrowedFunc, nameHint->getName());
+
+            narrowedFuncIndex = outNarrowedFuncs.getCount();
+            outNarrowedFuncs.add(narrowedFunc);
+            narrowedFuncWitnessTables.add(witnessTables);
+        }
+        if (report)
+        {
+            sink->diagnose(
+                call,
+                Diagnostics::dynamicDispatchNarrowed,
+                requirementKey,
+                witnessTables.getCount(),
+                allWitnessTables.getCount(),
+                conformanceType);
+        }
+        call->setOperand(0, outNarrowedFuncs[narrowedFuncIndex]);
+        stats.narrowedCallCount++;
+    }
+}
+
 void specializeDispatchFunctions(SharedGenericsLoweringContext* sharedContext)
 {
     // First we ensure that all witness table objects has a sequential ID assigned.
     ensureWitnessTableSequentialIDs(sharedContext);
 
+    // Treating the module as the whole program, find the witness tables that can reach each
+    // call site, so that its dispatch only has to consider those.
+    auto flow = computeWitnessTableFlow(sharedContext->module);
+    DispatchNarrowingStats stats;
+
     // Generate specialized dispatch functions and fixup call sites.
-    for (const auto& [_, dispatchFunc] : sharedContext->mapInterfaceRequirementKeyToDispatchMethods)
+    for (const auto& [requirementKey, dispatchFunc] :
+         sharedContext->mapInterfaceRequirementKeyToDispatchMethods)
     {
+        List<IRFunc*> narrowedFuncs;
+        _narrowDispatchCallSites(
+            sharedContext,
+            flow,
+            requirementKey,
+            dispatchFunc,
+            narrowedFuncs,
+            stats);
+        for (auto narrowedFunc : narrowedFuncs)
+            fixupDispatchFuncCall(sharedContext, narrowedFunc);
+
         // Generate a specialized `switch` statement based dispatch func,
         // from the witness tables present in the module.
         auto newDispatchFunc = specializeDispatchFunction(sharedContext, dispatchFunc);
@@ -307,5 +457,18 @@ void specializeDispatchFunctions(SharedGenericsLoweringContext* sharedContext)
         // witness table objects.
         fixupDispatchFuncCall(sharedContext, newDispatchFunc);
     }
+
+    if (stats.callSiteCount != 0 &&
+        sharedContext->targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::ReportDynamicDispatch))
+    {
+        sharedContext->sink->diagnose(
+            SourceLoc(),
+            Diagnostics::dynamicDispatchSummary,
+            stats.callSiteCount,
+            stats.directCallCount,
+            stats.narrowedCallCount,
+            stats.callSiteCount - stats.directCallCount - stats.narrowedCallCount);
+    }
 }
 } // namespace Slang
@@ -4,6 +4,7 @@
 #include "../core/slang-performance-profiler.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-deduplicate-generic-children.h"
+#include "slang-ir-loop-invariant-code-motion.h"
 #include "slang-ir-peephole.h"
 #include "slang-ir-propagate-func-properties.h"
 #include "slang-ir-redundancy-removal.h"
@@ -16,6 +17,13 @@
 
 namespace Slang
 {
+static bool _shouldHoistLoopInvariantInsts(TargetProgram* targetProgram, bool minimalOptimization)
+{
+    if (!targetProgram || minimalOptimization)
+        return false;
+    return targetProgram->getOptionSet().getOptimizationLevel() >= OptimizationLevel::High;
+}
+
 IRSimplificationOptions IRSimplificationOptions::getDefault(TargetProgram* targetProgram)
 {
     IRSimplificationOptions result;
@@ -30,6 +38,8 @@ IRSimplificationOptions IRSimplificationOptions::getDefault(TargetProgram* targe
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
+    result.loopInvariantCodeMotion =
+        _shouldHoistLoopInvariantInsts(targetProgram, result.minimalOptimization);
     return result;
 }
 
@@ -44,6 +54,8 @@ IRSimplificationOptions IRSimplificationOptions::getFast(TargetProgram* targetPr
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
+    result.loopInvariantCodeMotion =
+        _shouldHoistLoopInvariantInsts(targetProgram, result.minimalOptimization);
     return result;
 }
 
@@ -92,6 +104,8 @@ void simplifyIR(
                 if (options.removeRedundancy)
                     funcChanged |= removeRedundancyInFunc(func);
                 funcChanged |= simplifyCFG(func, options.cfgOptions);
+                if (options.loopInvariantCodeMotion)
+                    funcChanged |= hoistLoopInvariantInsts(func);
                 // Note: we disregard the `changed` state from dead code elimination pass since
                 // SCCP pass could be generating temporarily evaluated constant values and never
                 // actually use them. DCE will always remove those nearly generated consts and
@@ -155,6 +169,8 @@ void simplifyFunc(
         if (!options.minimalOptimization)
             changed |= removeRedundancyInFunc(func);
         changed |= simplifyCFG(func, options.cfgOptions);
+        if (options.loopInvariantCodeMotion)
+            changed |= hoistLoopInvariantInsts(func);
 
         // Note: we disregard the `changed` state from dead code elimination pass since
         // SCCP pass could be generating temporarily evaluated constant values and never actually
@@ -20,6 +20,8 @@ struct IRSimplificationOptions
 
     bool minimalOptimization = false;
     bool removeRedundancy = false;
+    // Hoist loop-invariant insts out of loops. Enabled at -O2 and above.
+    bool loopInvariantCodeMotion = false;
 
     static IRSimplificationOptions getDefault(TargetProgram* targetProgram);
 
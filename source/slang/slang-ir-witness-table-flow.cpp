@@ -0,0 +1,552 @@
+// slang-ir-witness-table-flow.cpp
+#include "slang-ir-witness-table-flow.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+bool IRWitnessTableFlow::getPossibleWitnessTables(
+    IRInst* value,
+    HashSet<IRWitnessTable*>& outTables)
+{
+    outTables.clear();
+    if (auto witnessTable = as<IRWitnessTable>(value))
+    {
+        outTables.add(witnessTable);
+        return true;
+    }
+
+    // A value that nothing flows into can't hold any witness table, such as one that is only
+    // computed in unreachable code.
+    auto node = nodes.tryGetValue(value);
+    if (!node)
+        return true;
+    if (node->isUnknown)
+        return false;
+    for (auto table : node->tables)
+        outTables.add(table);
+    return true;
+}
+
+struct WitnessTableFlowContext
+{
+    IRWitnessTableFlow* flow;
+
+    /// Whether a value of a type can hold a witness table, directly or inside of it.
+    Dictionary<IRInst*, bool> canHoldWitnessTableCache;
+
+    /// The values that satisfy each requirement key, across every witness table in the module.
+    Dictionary<IRInst*, List<IRInst*>> satisfyingValsForKey;
+
+    bool typeCanHoldWitnessTable(IRInst* type)
+    {
+        if (!type)
+            return false;
+        if (auto cached = canHoldWitnessTableCache.tryGetValue(type))
+            return *cached;
+
+        // Assume that a type can't hold a witness table while it is being checked, so that a
+        // type that refers to itself through a pointer terminates.
+        canHoldWitnessTableCache[type] = false;
+
+        bool result = false;
+        switch (type->getOp())
+        {
+        case kIROp_WitnessTableType:
+        case kIROp_WitnessTableIDType:
+            result = true;
+            break;
+        case kIROp_TupleType:
+            for (UInt i = 0; i < type->getOperandCount(); i++)
+                result = result || typeCanHoldWitnessTable(type->getOperand(i));
+            break;
+        case kIROp_StructType:
+            for (auto field : as<IRStructType>(type)->getFields())
+                result = result || typeCanHoldWitnessTable(field->getFieldType());
+            break;
+        default:
+            if (auto arrayType = as<IRArrayTypeBase>(type))
+                result = typeCanHoldWitnessTable(arrayType->getElementType());
+            else if (auto ptrType = as<IRPtrTypeBase>(type))
+                result = typeCanHoldWitnessTable(ptrType->getValueType());
+            break;
+        }
+        canHoldWitnessTableCache[type] = result;
+        return result;
+    }
+
+    bool valueCanHoldWitnessTable(IRInst* value)
+    {
+        return typeCanHoldWitnessTable(value->getDataType());
+    }
+
+    IRWitnessTableFlow::Node& getNode(IRInst* inst)
+    {
+        return flow->nodes.getOrAddValue(inst, IRWitnessTableFlow::Node());
+    }
+
+    void addFlow(IRInst* from, IRInst* to)
+    {
+        getNode(to);
+        getNode(from).successors.add(to);
+    }
+
+    void markUnknown(IRInst* inst) { getNode(inst).isUnknown = true; }
+
+    /// Find the variable or pointer parameter whose memory `address` points into, or null if it
+    /// points into memory that the analysis doesn't track.
+    IRInst* getAddressRoot(IRInst* address)
+    {
+        for (;;)
+        {
+            switch (address->getOp())
+            {
+            case kIROp_FieldAddress:
+            case kIROp_GetElementPtr:
+                address = address->getOperand(0);
+                continue;
+            case kIROp_Var:
+            case kIROp_GlobalVar:
+                return address;
+            case kIROp_Param:
+                {
+                    // Only the parameters of a function are tracked, not those of other blocks.
+                    auto block = as<IRBlock>(address->getParent());
+                    auto func = block ? as<IRFunc>(block->getParent()) : nullptr;
+                    return func && func->getFirstBlock() == block ? address : nullptr;
+                }
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    /// Whether `root` is a variable or pointer parameter that `getAddressRoot` can return.
+    bool isAddressRoot(IRInst* root) { return getAddressRoot(root) == root; }
+
+    /// Mark `root` unknown if its address, or an address derived from it, is used by an inst
+    /// that the analysis doesn't follow, such as a cast, a pointer phi or a store of the
+    /// address itself. The memory could then be written through a pointer that isn't seen.
+    void markUnknownIfAddressEscapes(IRInst* root)
+    {
+        List<IRInst*> addresses;
+        addresses.add(root);
+        for (Index i = 0; i < addresses.getCount(); i++)
+        {
+            for (auto use = addresses[i]->firstUse; use; use = use->nextUse)
+            {
+                auto user = use->getUser();
+                if (as<IRDecoration>(user))
+                    continue;
+                switch (user->getOp())
+                {
+                case kIROp_Load:
+                    continue;
+                case kIROp_Store:
+                    if (use == as<IRStore>(user)->getPtrUse())
+                        continue;
+                    break;
+                case kIROp_FieldAddress:
+                case kIROp_GetElementPtr:
+                    if (use == user->getOperands())
+                    {
+                        addresses.add(user);
+                        continue;
+                    }
+                    break;
+                case kIROp_Call:
+                    // Arguments are followed into the callee by `processCall`.
+                    if (use != as<IRCall>(user)->getCalleeUse())
+                        continue;
+                    break;
+                }
+                markUnknown(root);
+                return;
+            }
+        }
+    }
+
+    /// Mark unknown every variable or pointer parameter that `address` could point into, when
+    /// `getAddressRoot` can't tell which one it is. Pointer phis are followed back to their
+    /// incoming values, and casts to the address they cast.
+    void markAddressRootsUnknown(IRInst* address)
+    {
+        List<IRInst*> addresses;
+        HashSet<IRInst*> seen;
+        addresses.add(address);
+        seen.add(address);
+        for (Index i = 0; i < addresses.getCount(); i++)
+        {
+            auto current = addresses[i];
+            if (isAddressRoot(current))
+            {
+                markUnknown(current);
+                continue;
+            }
+            switch (current->getOp())
+            {
+            case kIROp_FieldAddress:
+            case kIROp_GetElementPtr:
+            case kIROp_GetOffsetPtr:
+            case kIROp_PtrCast:
+            case kIROp_BitCast:
+                if (seen.add(current->getOperand(0)))
+                    addresses.add(current->getOperand(0));
+                break;
+            case kIROp_Param:
+                {
+                    auto block = as<IRBlock>(current->getParent());
+                    if (!block)
+                        break;
+                    UInt paramIndex = 0;
+                    for (auto param : block->getParams())
+                    {
+                        if (param == current)
+                            break;
+                        paramIndex++;
+                    }
+                    for (auto pred : block->getPredecessors())
+                    {
+                        auto branch = as<IRUnconditionalBranch>(pred->getTerminator());
+                        if (!branch || paramIndex >= branch->getArgCount())
+                            continue;
+                        auto arg = branch->getArg(paramIndex);
+                        if (seen.add(arg))
+                            addresses.add(arg);
+                    }
+                }
+                break;
+            default:
+                // Any other address comes from memory that isn't tracked, or from a root that
+                // escaped and was marked unknown by `markUnknownIfAddressEscapes`.
+                break;
+            }
+        }
+    }
+
+    /// Whether `func` can be called from somewhere other than a call or dynamic dispatch that
+    /// the analysis can see.
+    bool hasUnknownCallers(IRFunc* func)
+    {
+        for (auto decor : func->getDecorations())
+        {
+            switch (decor->getOp())
+            {
+            case kIROp_EntryPointDecoration:
+            case kIROp_KeepAliveDecoration:
+            case kIROp_ExportDecoration:
+            case kIROp_DllExportDecoration:
+            case kIROp_ExternCppDecoration:
+            case kIROp_CudaKernelDecoration:
+                return true;
+            }
+        }
+        for (auto use = func->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (auto call = as<IRCall>(user))
+            {
+                if (call->getCallee() == func)
+                    continue;
+            }
+            if (auto entry = as<IRWitnessTableEntry>(user))
+            {
+                if (entry->getSatisfyingVal() == func)
+                    continue;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void processCallTarget(IRCall* call, IRFunc* callee)
+    {
+        UInt argIndex = 0;
+        for (auto param : callee->getParams())
+        {
+            if (argIndex >= call->getArgCount())
+                break;
+            auto arg = call->getArg(argIndex++);
+            if (!valueCanHoldWitnessTable(param))
+                continue;
+
+            // A pointer parameter shares its memory with the argument, so what is stored
+            // through either one can be loaded through the other.
+            if (as<IRPtrTypeBase>(param->getDataType()))
+            {
+                if (auto root = getAddressRoot(arg))
+                {
+                    addFlow(root, param);
+                    addFlow(param, root);
+                }
+                else
+                {
+                    markUnknown(param);
+                }
+            }
+            else
+            {
+                addFlow(arg, param);
+            }
+        }
+        if (valueCanHoldWitnessTable(call))
+            addFlow(callee, call);
+    }
+
+    void processCall(IRCall* call)
+    {
+        List<IRFunc*> targets;
+        bool targetsAreKnown = true;
+        auto callee = call->getCallee();
+        if (auto lookup = as<IRLookupWitnessMethod>(callee))
+        {
+            // A dynamic call can reach the function that satisfies the requirement in any
+            // witness table.
+            if (auto vals = satisfyingValsForKey.tryGetValue(lookup->getRequirementKey()))
+            {
+                for (auto val : *vals)
+                {
+                    auto func = as<IRFunc>(val);
+                    if (func && func->getFirstBlock())
+                        targets.add(func);
+                    else
+                        targetsAreKnown = false;
+                }
+            }
+        }
+        else
+        {
+            auto func = as<IRFunc>(callee);
+            if (func && func->getFirstBlock())
+                targets.add(func);
+            else
+                targetsAreKnown = false;
+        }
+
+        if (!targetsAreKnown)
+        {
+            // The callee could return any witness table, or store one through a pointer.
+            if (valueCanHoldWitnessTable(call))
+                markUnknown(call);
+            for (UInt i = 0; i < call->getArgCount(); i++)
+            {
+                auto arg = call->getArg(i);
+                if (!as<IRPtrTypeBase>(arg->getDataType()) || !valueCanHoldWitnessTable(arg))
+                    continue;
+                if (auto root = getAddressRoot(arg))
+                    markUnknown(root);
+            }
+        }
+        for (auto target : targets)
+            processCallTarget(call, target);
+    }
+
+    void processInst(IRInst* inst)
+    {
+        switch (inst->getOp())
+        {
+        case kIROp_WitnessTable:
+            getNode(inst).tables.add(as<IRWitnessTable>(inst));
+            break;
+        case kIROp_Store:
+            {
+                auto store = as<IRStore>(inst);
+                if (!valueCanHoldWitnessTable(store->getVal()))
+                    break;
+                // A store through an address that can't be followed back to its variable could
+                // write any variable that the address might point into.
+                if (auto root = getAddressRoot(store->getPtr()))
+                    addFlow(store->getVal(), root);
+                else
+                    markAddressRootsUnknown(store->getPtr());
+            }
+            break;
+        case kIROp_Load:
+            if (!valueCanHoldWitnessTable(inst))
+                break;
+            if (auto root = getAddressRoot(inst->getOperand(0)))
+                addFlow(root, inst);
+            else
+                markUnknown(inst);
+            break;
+        case kIROp_Call:
+            processCall(as<IRCall>(inst));
+            break;
+        case kIROp_Return:
+            {
+                auto returnVal = as<IRReturn>(inst)->getVal();
+                if (valueCanHoldWitnessTable(returnVal))
+                    addFlow(returnVal, getParentFunc(inst));
+            }
+            break;
+        case kIROp_MakeTuple:
+        case kIROp_MakeStruct:
+        case kIROp_MakeArray:
+        case kIROp_MakeArrayFromElement:
+        case kIROp_MakeExistential:
+        case kIROp_MakeExistentialWithRTTI:
+        case kIROp_UpdateElement:
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+            {
+                auto operand = inst->getOperand(i);
+                if (valueCanHoldWitnessTable(operand))
+                    addFlow(operand, inst);
+            }
+            break;
+        case kIROp_GetTupleElement:
+        case kIROp_FieldExtract:
+        case kIROp_GetElement:
+        case kIROp_ExtractExistentialWitnessTable:
+            if (valueCanHoldWitnessTable(inst))
+                addFlow(inst->getOperand(0), inst);
+            break;
+        case kIROp_Var:
+            // The memory of a variable starts out empty, and addresses are followed back to
+            // their variable by `getAddressRoot`.
+            if (valueCanHoldWitnessTable(inst))
+                markUnknownIfAddressEscapes(inst);
+            break;
+        case kIROp_FieldAddress:
+        case kIROp_GetElementPtr:
+            break;
+        case kIROp_GlobalVar:
+            // The initial value of a global variable isn't tracked.
+            if (!valueCanHoldWitnessTable(inst))
+                break;
+            if (as<IRGlobalVar>(inst)->getFirstBlock())
+                markUnknown(inst);
+            else
+                markUnknownIfAddressEscapes(inst);
+            break;
+        default:
+            if (valueCanHoldWitnessTable(inst))
+                markUnknown(inst);
+            break;
+        }
+    }
+
+    void processFunc(IRFunc* func)
+    {
+        bool unknownCallers = hasUnknownCallers(func);
+        for (auto block : func->getBlocks())
+        {
+            UInt paramIndex = 0;
+            for (auto param : block->getParams())
+            {
+                UInt index = paramIndex++;
+                if (!valueCanHoldWitnessTable(param))
+                    continue;
+                if (block == func->getFirstBlock())
+                {
+                    // The arguments of the calls to `func` are added by `processCallTarget`.
+                    if (unknownCallers)
+                        markUnknown(param);
+                    else if (as<IRPtrTypeBase>(param->getDataType()))
+                        markUnknownIfAddressEscapes(param);
+                    continue;
+                }
+                for (auto pred : block->getPredecessors())
+                {
+                    auto branch = as<IRUnconditionalBranch>(pred->getTerminator());
+                    if (branch && index < branch->getArgCount())
+                        addFlow(branch->getArg(index), param);
+                    else
+                        markUnknown(param);
+                }
+            }
+            for (auto inst : block->getOrdinaryInsts())
+                processInst(inst);
+        }
+    }
+
+    void solve()
+    {
+        List<IRInst*> workList;
+        HashSet<IRInst*> workListSet;
+        for (auto& [inst, node] : flow->nodes)
+        {
+            if (node.isUnknown || node.tables.getCount())
+            {
+                workList.add(inst);
+                workListSet.add(inst);
+            }
+        }
+
+        // Nodes are not added while solving, so references to them stay valid.
+        while (workList.getCount())
+        {
+            auto inst = workList.getLast();
+            workList.removeLast();
+            workListSet.remove(inst);
+
+            auto& node = flow->nodes[inst];
+            for (auto successor : node.successors)
+            {
+                auto& successorNode = flow->nodes[successor];
+                if (successorNode.isUnknown)
+                    continue;
+
+                bool changed = false;
+                if (node.isUnknown)
+                {
+                    successorNode.isUnknown = true;
+                    successorNode.tables.clear();
+                    changed = true;
+                }
+                else
+                {
+                    for (auto table : node.tables)
+                        changed |= successorNode.tables.add(table);
+                }
+                if (changed && workListSet.add(successor))
+                    workList.add(successor);
+            }
+        }
+    }
+
+    void processModule(IRModule* module)
+    {
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            if (auto witnessTable = as<IRWitnessTable>(globalInst))
+            {
+                for (auto entry : witnessTable->getEntries())
+                {
+                    satisfyingValsForKey.getOrAddValue(entry->getRequirementKey(), List<IRInst*>())
+                        .add(entry->getSatisfyingVal());
+                }
+            }
+        }
+
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            switch (globalInst->getOp())
+            {
+            case kIROp_Func:
+                processFunc(as<IRFunc>(globalInst));
+                break;
+            case kIROp_Generic:
+                // Generics that are still in the module at this point are only called through
+                // intrinsics.
+                break;
+            default:
+                processInst(globalInst);
+                break;
+            }
+        }
+        solve();
+    }
+};
+
+RefPtr<IRWitnessTableFlow> computeWitnessTableFlow(IRModule* module)
+{
+    RefPtr<IRWitnessTableFlow> flow = new IRWitnessTableFlow();
+    WitnessTableFlowContext context;
+    context.flow = flow;
+    context.processModule(module);
+    return flow;
+}
+
+} // namespace Slang
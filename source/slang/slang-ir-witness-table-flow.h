@@ -0,0 +1,47 @@
+// slang-ir-witness-table-flow.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRInst;
+struct IRModule;
+struct IRWitnessTable;
+
+/// The witness tables that can reach each value in a module, found by following them through
+/// the values, memory and calls that carry them.
+///
+/// The module is assumed to be the whole program, so a witness table can only come from a
+/// witness table defined in it, or from somewhere the analysis can't see into: a shader
+/// parameter or buffer, a parameter of an entry point or exported function, or an operation
+/// that the analysis doesn't model. A value reached from one of those is unknown.
+///
+struct IRWitnessTableFlow : public RefObject
+{
+    struct Node
+    {
+        /// The value can hold a witness table that isn't known at compile time.
+        bool isUnknown = false;
+
+        /// The witness tables that the value can hold, directly or inside of an aggregate.
+        HashSet<IRWitnessTable*> tables;
+
+        /// The values that whatever this value holds flows into.
+        List<IRInst*> successors;
+    };
+
+    /// Get the witness tables that `value` can hold. Returns false if it can hold a witness
+    /// table that isn't known at compile time.
+    ///
+    /// Aggregates and memory are not split into their fields, so the tables for a value
+    /// include the tables of every value stored alongside it.
+    ///
+    bool getPossibleWitnessTables(IRInst* value, HashSet<IRWitnessTable*>& outTables);
+
+    Dictionary<IRInst*, Node> nodes;
+};
+
+/// Compute the witness tables that can reach each value in `module`.
+RefPtr<IRWitnessTableFlow> computeWitnessTableFlow(IRModule* module);
+} // namespace Slang
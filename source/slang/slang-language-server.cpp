@@ -25,6 +25,7 @@
 #include "slang-mangle.h"
 #include "slang-workspace-version.h"
 
+#include <exception>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -93,9 +94,13 @@ slang::IGlobalSession* LanguageServerCore::getOrCreateGlobalSession()
     return m_session;
 }
 
-void LanguageServer::resetDiagnosticUpdateTime()
+Workspace* LanguageServerCore::getAnalyzedWorkspace(const String& canonicalPath)
 {
-    m_lastDiagnosticUpdateTime = std::chrono::system_clock::now();
+    // Fall back to checking the live workspace when there is no snapshot yet, or the document
+    // was opened after the snapshot was taken.
+    if (m_analyzedWorkspace && m_analyzedWorkspace->openedDocuments.containsKey(canonicalPath))
+        return m_analyzedWorkspace;
+    return m_workspace;
 }
 
 String uriToCanonicalPath(const String& uri)
@@ -560,15 +565,16 @@ LanguageServerResult<LanguageServerProtocol::Hover> LanguageServerCore::hover(
     const LanguageServerProtocol::HoverParams& args)
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
+    auto workspace = getAnalyzedWorkspace(canonicalPath);
     RefPtr<DocumentVersion> doc;
-    if (!m_workspace->openedDocuments.tryGetValue(canonicalPath, doc))
+    if (!workspace->openedDocuments.tryGetValue(canonicalPath, doc))
     {
         return std::nullopt;
     }
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = workspace->getCurrentVersion();
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
@@ -697,7 +703,7 @@ LanguageServerResult<LanguageServerProtocol::Hover> LanguageServerCore::hover(
             auto humaneLoc = version->linkage->getSourceManager()->getHumaneLoc(
                 declRef.getLoc(),
                 SourceLocType::Actual);
-            appendDefinitionLocation(sb, m_workspace, humaneLoc);
+            appendDefinitionLocation(sb, workspace, humaneLoc);
             maybeAppendAdditionalOverloadsHint();
             auto nodeHumaneLoc = version->linkage->getSourceManager()->getHumaneLoc(leafNode->loc);
             doc->oneBasedUTF8LocToZeroBasedUTF16Loc(
@@ -794,7 +800,7 @@ LanguageServerResult<LanguageServerProtocol::Hover> LanguageServerCore::hover(
         if (const auto higherOrderExpr = as<HigherOrderInvokeExpr>(expr))
         {
             String documentation;
-            String signature = getExprDeclSignature(expr, &documentation, nullptr);
+            String signature = getExprDeclSignature(version, expr, &documentation, nullptr);
             if (signature.getLength() == 0)
                 return;
             sb << "```\n" << signature << "\n```\n";
@@ -1102,12 +1108,32 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
 
-    RefPtr<DocumentVersion> doc;
-    if (!m_workspace->openedDocuments.tryGetValue(canonicalPath, doc))
+    RefPtr<DocumentVersion> liveDoc;
+    if (!m_workspace->openedDocuments.tryGetValue(canonicalPath, liveDoc))
     {
         return std::nullopt;
     }
 
+    // Completion checks the document again with the cursor marked in it, so do that check in the
+    // analyzed snapshot when there is one, with the snapshot's copy of the document given the
+    // current text while the completion runs. The text is copied rather than shared, since the
+    // snapshot is released on the analysis thread.
+    auto workspace = getAnalyzedWorkspace(canonicalPath);
+    RefPtr<DocumentVersion> doc = liveDoc;
+    String snapshotText;
+    if (workspace != m_workspace.Ptr())
+    {
+        doc = workspace->openedDocuments[canonicalPath];
+        snapshotText = doc->getText();
+        doc->setText(String(liveDoc->getText().getUnownedSlice()));
+    }
+    auto restoreSnapshotText = makeDeferred(
+        [&]()
+        {
+            if (doc != liveDoc)
+                doc->setText(snapshotText);
+        });
+
     // Don't show completion at case label or after single '>' operator.
     if (args.context.triggerKind == LanguageServerProtocol::kCompletionTriggerKindTriggerCharacter)
     {
@@ -1157,7 +1183,8 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
 
     // Always create a new workspace version for the completion request since we
     // will use a modified source.
-    auto version = m_workspace->createVersionForCompletion();
+    auto version = workspace->createVersionForCompletion();
+    m_completionWorkspace = workspace;
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
     auto moduleName = getMangledNameFromNameString(canonicalPath.getUnownedSlice());
@@ -1253,7 +1280,13 @@ LanguageServerResult<LanguageServerProtocol::CompletionItem> LanguageServerCore:
 
     LanguageServerProtocol::CompletionItem resolvedItem = args;
     int itemId = stringToInt(args.data);
-    auto version = m_workspace->getCurrentCompletionVersion();
+    // The snapshot the completion was made in may have been replaced since
+    Workspace* workspace = m_completionWorkspace;
+    if (!workspace || (workspace != m_workspace.Ptr() && workspace != m_analyzedWorkspace.Ptr()))
+    {
+        return resolvedItem;
+    }
+    auto version = workspace->getCurrentCompletionVersion();
     if (!version || !version->linkage)
     {
         return resolvedItem;
@@ -1291,13 +1324,14 @@ LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore:
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
 
+    auto workspace = getAnalyzedWorkspace(canonicalPath);
     RefPtr<DocumentVersion> doc;
-    if (!m_workspace->openedDocuments.tryGetValue(canonicalPath, doc))
+    if (!workspace->openedDocuments.tryGetValue(canonicalPath, doc))
     {
         return std::nullopt;
     }
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = workspace->getCurrentVersion();
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
@@ -1332,13 +1366,14 @@ LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore:
 }
 
 String LanguageServerCore::getExprDeclSignature(
+    WorkspaceVersion* version,
     Expr* expr,
     String* outDocumentation,
     List<Slang::Range<Index>>* outParamRanges)
 {
     if (auto declRefExpr = as<DeclRefExpr>(expr))
     {
-        return getDeclRefSignature(declRefExpr->declRef, outDocumentation, outParamRanges);
+        return getDeclRefSignature(version, declRefExpr->declRef, outDocumentation, outParamRanges);
     }
 
     auto higherOrderExpr = as<HigherOrderInvokeExpr>(expr);
@@ -1351,7 +1386,6 @@ String LanguageServerCore::getExprDeclSignature(
     if (!funcType)
         return String();
 
-    auto version = m_workspace->getCurrentVersion();
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
     SignatureInformation sigInfo;
@@ -1407,7 +1441,7 @@ String LanguageServerCore::getExprDeclSignature(
             declRefExpr->declRef.getLoc(),
             SourceLocType::Actual);
         _tryGetDocumentation(docSB, version, declRefExpr->declRef.getDecl());
-        appendDefinitionLocation(docSB, m_workspace, humaneLoc);
+        appendDefinitionLocation(docSB, version->workspace, humaneLoc);
         *outDocumentation = docSB.produceString();
     }
 
@@ -1415,11 +1449,11 @@ String LanguageServerCore::getExprDeclSignature(
 }
 
 String LanguageServerCore::getDeclRefSignature(
+    WorkspaceVersion* version,
     DeclRef<Decl> declRef,
     String* outDocumentation,
     List<Slang::Range<Index>>* outParamRanges)
 {
-    auto version = m_workspace->getCurrentVersion();
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
     ASTPrinter printer(
@@ -1439,7 +1473,7 @@ String LanguageServerCore::getDeclRefSignature(
             declRef.getLoc(),
             SourceLocType::Actual);
         _tryGetDocumentation(docSB, version, declRef.getDecl());
-        appendDefinitionLocation(docSB, m_workspace, humaneLoc);
+        appendDefinitionLocation(docSB, version->workspace, humaneLoc);
         *outDocumentation = docSB.produceString();
     }
     return printer.getString();
@@ -1463,15 +1497,16 @@ LanguageServerResult<LanguageServerProtocol::SignatureHelp> LanguageServerCore::
     const LanguageServerProtocol::SignatureHelpParams& args)
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
+    auto workspace = getAnalyzedWorkspace(canonicalPath);
     RefPtr<DocumentVersion> doc;
-    if (!m_workspace->openedDocuments.tryGetValue(canonicalPath, doc))
+    if (!workspace->openedDocuments.tryGetValue(canonicalPath, doc))
     {
         return std::nullopt;
     }
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = workspace->getCurrentVersion();
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
@@ -1558,7 +1593,7 @@ LanguageServerResult<LanguageServerProtocol::SignatureHelp> LanguageServerCore::
 
         List<Slang::Range<Index>> paramRanges;
         String documentation;
-        sigInfo.label = getDeclRefSignature(declRef, &documentation, &paramRanges);
+        sigInfo.label = getDeclRefSignature(version, declRef, &documentation, &paramRanges);
         sigInfo.documentation.value = documentation;
         sigInfo.documentation.kind = "markdown";
 
@@ -1577,7 +1612,7 @@ LanguageServerResult<LanguageServerProtocol::SignatureHelp> LanguageServerCore::
         SignatureInformation sigInfo;
         List<Slang::Range<Index>> paramRanges;
         String documentation;
-        sigInfo.label = getExprDeclSignature(expr, &documentation, &paramRanges);
+        sigInfo.label = getExprDeclSignature(version, expr, &documentation, &paramRanges);
         if (sigInfo.label.getLength() == 0)
             return;
         sigInfo.documentation.value = documentation;
@@ -1920,21 +1955,11 @@ LanguageServerResult<List<LanguageServerProtocol::TextEdit>> LanguageServerCore:
 
 void LanguageServer::publishDiagnostics()
 {
-    if (std::chrono::system_clock::now() - m_lastDiagnosticUpdateTime <
-        std::chrono::milliseconds(1000))
-    {
-        return;
-    }
-    m_lastDiagnosticUpdateTime = std::chrono::system_clock::now();
-
-    auto version = m_core.m_workspace->getCurrentVersion();
-    SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
-
     // Send updates to clear diagnostics for files that no longer have any messages.
     List<String> filesToRemove;
     for (const auto& [filepath, _] : m_lastPublishedDiagnostics)
     {
-        if (!version->diagnostics.containsKey(filepath))
+        if (!m_analyzedDiagnostics.containsKey(filepath))
         {
             PublishDiagnosticsParams args;
             args.uri = URI::fromLocalFilePath(filepath.getUnownedSlice()).uri;
@@ -1947,7 +1972,7 @@ void LanguageServer::publishDiagnostics()
         m_lastPublishedDiagnostics.remove(toRemove);
     }
     // Send updates for any files whose diagnostic messages has changed since last update.
-    for (const auto& [listKey, listValue] : version->diagnostics)
+    for (const auto& [listKey, listValue] : m_analyzedDiagnostics)
     {
         auto lastPublished = m_lastPublishedDiagnostics.tryGetValue(listKey);
         if (!lastPublished || *lastPublished != listValue.originalOutput)
@@ -2228,7 +2253,7 @@ LanguageServerResult<LanguageServerProtocol::Hover> LanguageServerCore::tryGetMa
     sb << "\n```\n\n";
     auto humaneLoc =
         version->linkage->getSourceManager()->getHumaneLoc(def->loc, SourceLocType::Actual);
-    appendDefinitionLocation(sb, m_workspace, humaneLoc);
+    appendDefinitionLocation(sb, version->workspace, humaneLoc);
     hover.contents.kind = "markdown";
     hover.contents.value = sb.produceString();
     return hover;
@@ -2409,6 +2434,27 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
     return SLANG_OK;
 }
 
+// Describes the exception being handled, for logging. Must be called from a catch block.
+static String _describeCurrentException()
+{
+    try
+    {
+        throw;
+    }
+    catch (const Exception& e)
+    {
+        return e.Message.getLength() ? e.Message : String("internal compiler error");
+    }
+    catch (const std::exception& e)
+    {
+        return e.what();
+    }
+    catch (...)
+    {
+        return "unknown exception";
+    }
+}
+
 SlangResult LanguageServer::runCommand(Command& call)
 {
     try
@@ -2434,6 +2480,7 @@ SlangResult LanguageServer::runCommand(Command& call)
     }
     catch (...)
     {
+        logMessage(1, "Error handling " + call.method + ": " + _describeCurrentException());
         return SLANG_FAIL;
     }
 
@@ -2498,35 +2545,118 @@ SlangResult LanguageServer::runCommand(Command& call)
     catch (...)
     {
         // If we encountered an internal compiler error, don't crash the language server.
-        // Instead we just return a null response.
+        // Instead we just log it and return a null response.
+        logMessage(1, "Error handling " + call.method + ": " + _describeCurrentException());
         return m_connection->sendResult(NullResponse::get(), call.id);
     }
 
     return m_connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
 }
 
-void LanguageServer::processCommands()
+// Returns the uri of the document a request is about, or an empty string if it isn't about a
+// document.
+static String _getRequestDocumentURI(Command& cmd)
+{
+    if (cmd.hoverArgs.isValid())
+        return cmd.hoverArgs.get().textDocument.uri;
+    if (cmd.definitionArgs.isValid())
+        return cmd.definitionArgs.get().textDocument.uri;
+    if (cmd.completionArgs.isValid())
+        return cmd.completionArgs.get().textDocument.uri;
+    if (cmd.semanticTokenArgs.isValid())
+        return cmd.semanticTokenArgs.get().textDocument.uri;
+    if (cmd.signatureHelpArgs.isValid())
+        return cmd.signatureHelpArgs.get().textDocument.uri;
+    if (cmd.documentSymbolArgs.isValid())
+        return cmd.documentSymbolArgs.get().textDocument.uri;
+    if (cmd.inlayHintArgs.isValid())
+        return cmd.inlayHintArgs.get().textDocument.uri;
+    if (cmd.formattingArgs.isValid())
+        return cmd.formattingArgs.get().textDocument.uri;
+    if (cmd.rangeFormattingArgs.isValid())
+        return cmd.rangeFormattingArgs.get().textDocument.uri;
+    if (cmd.onTypeFormattingArgs.isValid())
+        return cmd.onTypeFormattingArgs.get().textDocument.uri;
+    return String();
+}
+
+bool LanguageServer::isCommandCanceled(Index commandIndex)
 {
-    HashSet<int64_t> canceledIDs;
-    for (auto& cmd : commands)
+    auto& cmd = commands[commandIndex];
+    if (cmd.id.getKind() != JSONValue::Kind::Integer)
+        return false;
+
+    const auto id = cmd.id.asInteger();
+    if (m_canceledRequestIds.contains(id))
     {
-        if (cmd.method == "$/cancelRequest")
+        m_canceledRequestIds.remove(id);
+        return true;
+    }
+    for (auto& other : commands)
+    {
+        if (other.cancelArgs.isValid() && other.cancelArgs.get().id > 0 &&
+            other.cancelArgs.get().id == id)
         {
-            auto id = cmd.cancelArgs.get().id;
-            if (id > 0)
-            {
-                canceledIDs.add(id);
-            }
+            return true;
         }
     }
+    return false;
+}
+
+bool LanguageServer::isCommandSuperseded(Index commandIndex)
+{
+    // A request is superseded if the document it's about is changed or closed by a later
+    // command, as the result would be for a version of the document the client no longer has.
+    const String uri = _getRequestDocumentURI(commands[commandIndex]);
+    if (uri.getLength() == 0)
+        return false;
+
+    for (Index i = commandIndex + 1; i < commands.getCount(); ++i)
+    {
+        auto& cmd = commands[i];
+        if ((cmd.changeDocArgs.isValid() && cmd.changeDocArgs.get().textDocument.uri == uri) ||
+            (cmd.closeDocArgs.isValid() && cmd.closeDocArgs.get().textDocument.uri == uri))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LanguageServer::processCommands()
+{
     const int kErrorRequestCanceled = -32800;
-    for (auto& cmd : commands)
+    const int kErrorContentModified = -32801;
+    const Index kMaxCanceledRequestIds = 256;
+
+    for (Index i = 0; i < commands.getCount(); ++i)
     {
-        if (cmd.id.getKind() == JSONValue::Kind::Integer &&
-            canceledIDs.contains(cmd.id.asInteger()))
+        // Read the messages that arrived while the previous command was running, as they may
+        // cancel or supersede the commands that are still queued.
+        if (i > 0)
+        {
+            readMessages();
+        }
+
+        auto& cmd = commands[i];
+        if (cmd.cancelArgs.isValid())
+        {
+            // The canceled request may not have been received yet, so remember the id for when
+            // it is. Cancellations of requests that already completed are never claimed, so
+            // only a limited number are kept.
+            if (m_canceledRequestIds.getCount() >= kMaxCanceledRequestIds)
+                m_canceledRequestIds.clear();
+            m_canceledRequestIds.add(cmd.cancelArgs.get().id);
+        }
+
+        if (isCommandCanceled(i))
         {
             m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, cmd.id);
         }
+        else if (isCommandSuperseded(i))
+        {
+            m_connection->sendError((JSONRPC::ErrorCode)kErrorContentModified, cmd.id);
+        }
         else
         {
             runCommand(cmd);
@@ -2536,7 +2666,6 @@ void LanguageServer::processCommands()
 
 SlangResult LanguageServer::didCloseTextDocument(const DidCloseTextDocumentParams& args)
 {
-    resetDiagnosticUpdateTime();
     return m_core.didCloseTextDocument(args);
 }
 
@@ -2549,7 +2678,6 @@ SlangResult LanguageServerCore::didCloseTextDocument(const DidCloseTextDocumentP
 
 SlangResult LanguageServer::didChangeTextDocument(const DidChangeTextDocumentParams& args)
 {
-    resetDiagnosticUpdateTime();
     return m_core.didChangeTextDocument(args);
 }
 
@@ -2579,7 +2707,158 @@ void LanguageServer::update()
 {
     if (!m_core.m_workspace)
         return;
-    publishDiagnostics();
+
+    // Let the analysis thread know the workspace has changed. It waits for the changes to stop
+    // before analyzing, so that it doesn't redo the analysis on every keystroke.
+    const uint32_t changeCount = m_core.m_workspace->getChangeCount();
+    if (changeCount != m_lastChangeCount)
+    {
+        m_lastChangeCount = changeCount;
+        m_lastChangeTime = std::chrono::system_clock::now();
+        m_analysisCondition.notify_all();
+    }
+
+    // The analysis thread can't use the connection, so it leaves its errors to be logged here
+    for (const auto& error : m_analysisErrors)
+    {
+        logMessage(1, error);
+    }
+    m_analysisErrors.clear();
+
+    // Publish the diagnostics once the analysis has caught up with the changes
+    if (m_analyzedChangeCount == changeCount && m_publishedChangeCount != changeCount)
+    {
+        m_publishedChangeCount = changeCount;
+        publishDiagnostics();
+    }
+}
+
+void LanguageServer::analysisThreadMain()
+{
+    // How long the documents have to be left unchanged before they are analyzed
+    const auto kAnalysisDelay = std::chrono::milliseconds(300);
+
+    // The message thread keeps using the workspace's global session while the analysis runs, and
+    // the global session of the last finished snapshot to serve requests, so the analysis needs
+    // two of its own, and uses whichever one the message thread isn't using.
+    ComPtr<slang::IGlobalSession> globalSessions[2];
+    Index sessionIndex = 0;
+
+    std::unique_lock<std::mutex> lock(m_workspaceMutex);
+    while (!m_analysisQuit)
+    {
+        auto workspace = m_core.m_workspace.Ptr();
+        if (!workspace || workspace->getChangeCount() == m_analyzedChangeCount)
+        {
+            m_analysisCondition.wait(lock);
+            continue;
+        }
+
+        const auto sinceChange = std::chrono::system_clock::now() - m_lastChangeTime;
+        if (sinceChange < kAnalysisDelay)
+        {
+            m_analysisCondition.wait_for(lock, kAnalysisDelay - sinceChange);
+            continue;
+        }
+
+        auto& globalSession = globalSessions[sessionIndex];
+        if (!globalSession)
+        {
+            SlangGlobalSessionDesc desc = {};
+            desc.enableGLSL = true;
+            if (SLANG_FAILED(slang_createGlobalSession2(&desc, globalSession.writeRef())))
+            {
+                break;
+            }
+        }
+
+        if (analyzeWorkspace(lock, globalSession))
+        {
+            sessionIndex ^= 1;
+        }
+    }
+
+    // The snapshot refers to the global sessions, so it can't outlive this thread
+    m_core.m_analyzedWorkspace = nullptr;
+    m_core.m_completionWorkspace = nullptr;
+}
+
+bool LanguageServer::analyzeWorkspace(
+    std::unique_lock<std::mutex>& lock,
+    slang::IGlobalSession* globalSession)
+{
+    // Check a snapshot of the workspace, so the mutex doesn't have to be held while the modules
+    // are checked, and the message thread can keep handling requests and changes meanwhile.
+    RefPtr<Workspace> snapshot = m_core.m_workspace->createSnapshot(globalSession);
+    const uint32_t changeCount = snapshot->getChangeCount();
+    lock.unlock();
+
+    RefPtr<WorkspaceVersion> version = snapshot->getCurrentVersion();
+    List<String> errors;
+    bool isOutOfDate = false;
+    for (const auto& [path, _] : snapshot->openedDocuments)
+    {
+        // If the workspace changed, this analysis is out of date, and a new one will be started
+        // once the changes stop.
+        if (m_analysisQuit || m_lastChangeCount != changeCount)
+        {
+            isOutOfDate = true;
+            break;
+        }
+
+        try
+        {
+            SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
+            version->getOrLoadModule(path);
+        }
+        catch (...)
+        {
+            // Don't let an internal compiler error stop the analysis of the other documents
+            errors.add("Error checking " + path + ": " + _describeCurrentException());
+        }
+    }
+
+    // An unfinished snapshot is only ever used on this thread, so release it before taking the
+    // lock. A finished one is handed over with no references to it left here.
+    auto diagnostics = _Move(version->diagnostics);
+    version = nullptr;
+    if (isOutOfDate)
+    {
+        snapshot = nullptr;
+    }
+
+    lock.lock();
+    m_analysisErrors.addRange(errors);
+    if (isOutOfDate)
+    {
+        return false;
+    }
+
+    // Serve requests from the snapshot from now on, even if the workspace has changed since it
+    // was taken, as it is still closer to the workspace than the previous one.
+    m_core.m_analyzedWorkspace = _Move(snapshot);
+
+    // Publish the diagnostics, unless the workspace changed since the snapshot was taken
+    if (m_core.m_workspace->getChangeCount() == changeCount)
+    {
+        m_analyzedDiagnostics = _Move(diagnostics);
+        m_analyzedChangeCount = changeCount;
+    }
+    return true;
+}
+
+void LanguageServer::stopAnalysisThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workspaceMutex);
+        m_analysisQuit = true;
+    }
+    m_analysisCondition.notify_all();
+
+    if (m_analysisThread.joinable())
+    {
+        m_analysisThread.join();
+    }
 }
 
 void LanguageServer::updateConfigFromJSON(const JSONValue& jsonVal)
@@ -2640,43 +2919,57 @@ void LanguageServer::updateConfigFromJSON(const JSONValue& jsonVal)
     }
 }
 
+void LanguageServer::readMessages()
+{
+    while (true)
+    {
+        m_connection->tryReadMessage();
+        if (!m_connection->hasMessage())
+            break;
+        parseNextMessage();
+    }
+}
+
 SlangResult LanguageServer::execute()
 {
     m_connection = new JSONRPCConnection();
     m_connection->initWithStdStreams();
 
+    m_analysisThread = std::thread([this]() { analysisThreadMain(); });
+
     while (m_connection->isActive() && !m_quit)
     {
-        // Consume all messages first.
-        commands.clear();
-        while (true)
         {
-            m_connection->tryReadMessage();
-            if (!m_connection->hasMessage())
-                break;
-            parseNextMessage();
-        }
+            std::lock_guard<std::mutex> lock(m_workspaceMutex);
 
-        auto workStart = platform::PerformanceCounter::now();
+            // Consume all messages first.
+            commands.clear();
+            readMessages();
 
-        processCommands();
+            auto workStart = platform::PerformanceCounter::now();
 
-        // Report diagnostics if it hasn't been updated for a while.
-        update();
+            processCommands();
 
-        auto workTime = platform::PerformanceCounter::getElapsedTimeInSeconds(workStart);
+            // Start analysis of any changes, and report diagnostics once it's done.
+            update();
 
-        if (commands.getCount() > 0 && m_initialized && m_traceOptions != TraceOptions::Off)
-        {
-            StringBuilder msgBuilder;
-            msgBuilder << "Server processed " << commands.getCount() << " commands, executed in "
-                       << String(int(workTime * 1000)) << "ms";
-            logMessage(3, msgBuilder.produceString());
+            auto workTime = platform::PerformanceCounter::getElapsedTimeInSeconds(workStart);
+
+            if (commands.getCount() > 0 && m_initialized && m_traceOptions != TraceOptions::Off)
+            {
+                StringBuilder msgBuilder;
+                msgBuilder << "Server processed " << commands.getCount()
+                           << " commands, executed in " << String(int(workTime * 1000)) << "ms";
+                logMessage(3, msgBuilder.produceString());
+            }
         }
 
-        m_connection->getUnderlyingConnection()->waitForResult(1000);
+        // Wait for messages without holding the workspace, so the analysis thread can use it.
+        // The timeout is short so diagnostics are published soon after the analysis finishes.
+        m_connection->getUnderlyingConnection()->waitForResult(100);
     }
 
+    stopAnalysisThread();
     return SLANG_OK;
 }
 
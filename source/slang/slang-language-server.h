@@ -8,7 +8,11 @@
 #include "slang-workspace-version.h"
 #include "slang.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace Slang
 {
@@ -98,6 +102,11 @@ public:
     CommitCharacterBehavior m_commitCharacterBehavior = CommitCharacterBehavior::MembersOnly;
     ComPtr<slang::IGlobalSession> m_session;
     RefPtr<Workspace> m_workspace;
+    // The last snapshot of the workspace that finished analysis, if the workspace is analyzed in
+    // the background. Hover, completion, semantic tokens and signature help are served from it,
+    // so the live workspace isn't checked again after every edit.
+    RefPtr<Workspace> m_analyzedWorkspace;
+    Workspace* m_completionWorkspace = nullptr; ///< Workspace of the last completion request
     FormatOptions m_formatOptions;
     Slang::InlayHintOptions m_inlayHintOptions;
     List<LanguageServerProtocol::WorkspaceFolder> m_workspaceFolders;
@@ -139,10 +148,12 @@ public:
     LanguageServerResult<List<LanguageServerProtocol::TextEdit>> onTypeFormatting(
         const LanguageServerProtocol::DocumentOnTypeFormattingParams& args);
     String getExprDeclSignature(
+        WorkspaceVersion* version,
         Expr* expr,
         String* outDocumentation,
         List<Slang::Range<Index>>* outParamRanges);
     String getDeclRefSignature(
+        WorkspaceVersion* version,
         DeclRef<Decl> declRef,
         String* outDocumentation,
         List<Slang::Range<Index>>* outParamRanges);
@@ -150,6 +161,9 @@ public:
 private:
     slang::IGlobalSession* getOrCreateGlobalSession();
 
+    // Returns the analyzed snapshot if it has the document open, and the live workspace otherwise
+    Workspace* getAnalyzedWorkspace(const String& canonicalPath);
+
     FormatOptions getFormatOptions(Workspace* workspace, FormatOptions inOptions);
     LanguageServerResult<LanguageServerProtocol::Hover> tryGetMacroHoverInfo(
         WorkspaceVersion* version,
@@ -186,7 +200,7 @@ public:
     RttiTypeFuncsMap m_typeMap;
     bool m_initialized = false;
     TraceOptions m_traceOptions = TraceOptions::Off;
-    std::chrono::time_point<std::chrono::system_clock> m_lastDiagnosticUpdateTime;
+    std::chrono::time_point<std::chrono::system_clock> m_lastChangeTime;
     Dictionary<String, String> m_lastPublishedDiagnostics;
 
     LanguageServer(LanguageServerStartupOptions options)
@@ -240,7 +254,7 @@ public:
 
 private:
     SlangResult parseNextMessage();
-    void resetDiagnosticUpdateTime();
+    void readMessages();
     void publishDiagnostics();
     void updatePredefinedMacros(const JSONValue& macros);
     void updateSearchPaths(const JSONValue& value);
@@ -263,6 +277,34 @@ private:
     SlangResult queueJSONCall(JSONRPCCall call);
     SlangResult runCommand(Command& cmd);
     void processCommands();
+    bool isCommandCanceled(Index commandIndex);
+    bool isCommandSuperseded(Index commandIndex);
+
+    // The workspace is analyzed on a background thread, so diagnostics are produced without
+    // holding up the message thread. A global session can only be used by one thread at a time,
+    // so the analysis thread checks a snapshot of the workspace with its own global session.
+    // m_workspaceMutex guards the workspace while the snapshot is taken, and the results of the
+    // analysis while they are handed over to the message thread. A finished snapshot is handed
+    // over too, to serve requests from, so the analysis alternates between two global sessions to
+    // leave the one of the handed over snapshot to the message thread.
+    void analysisThreadMain();
+    bool analyzeWorkspace(std::unique_lock<std::mutex>& lock, slang::IGlobalSession* globalSession);
+    void stopAnalysisThread();
+
+    std::mutex m_workspaceMutex;
+    std::condition_variable m_analysisCondition; ///< Wakes the analysis thread
+    std::thread m_analysisThread;
+    std::atomic<bool> m_analysisQuit{false};
+    std::atomic<uint32_t> m_lastChangeCount{0}; ///< Workspace change count last seen by the
+                                                ///< message thread
+    uint32_t m_analyzedChangeCount = 0;  ///< Change count of the last completed analysis
+    uint32_t m_publishedChangeCount = 0; ///< Change count of the last published diagnostics
+    Dictionary<String, DocumentDiagnostics> m_analyzedDiagnostics; ///< Diagnostics of the last
+                                                                   ///< completed analysis
+    List<String> m_analysisErrors; ///< Internal errors hit by the analysis, to be logged
+
+    // Ids of requests that were canceled before they were received
+    HashSet<int64_t> m_canceledRequestIds;
 };
 
 inline bool _isIdentifierChar(char ch)
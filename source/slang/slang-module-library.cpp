@@ -67,6 +67,8 @@ SlangResult loadModuleLibrary(
         options.sink = req->getSink();
         options.astBuilder = linkage->getASTBuilder();
         options.modulePath = path;
+        options.useIRSerialData =
+            linkage->m_optionSet.getBoolOption(CompilerOptionName::SerialIRViaData);
         SLANG_RETURN_ON_FAIL(
             SerialContainerUtil::read(&riffContainer, options, nullptr, containerData));
         DiagnosticSink sink;
@@ -478,6 +478,13 @@ void initCommandOptions(CommandOptions& options)
          nullptr,
          "Reports information about checkpoint contexts used for reverse-mode automatic "
          "differentiation."},
+        {OptionKind::CheckpointBudget,
+         "-checkpoint-budget",
+         "-checkpoint-budget <bytes>",
+         "Limits the bytes used to checkpoint the primal values of each function for reverse-mode "
+         "automatic differentiation. Values that are cheapest to recompute for their size are "
+         "recomputed instead of stored until the rest fit. 0 recomputes everything that can be "
+         "recomputed. With -report-checkpoint-intermediates, the chosen trade-offs are reported."},
         {OptionKind::SkipSPIRVValidation,
          "-skip-spirv-validation",
          nullptr,
@@ -520,7 +527,12 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::EmitReflectionJSON,
          "-reflection-json",
          "reflection-json <path>",
-         "Emit reflection data in JSON format to a file."}};
+         "Emit reflection data in JSON format to a file."},
+        {OptionKind::EmitReflectionBinary,
+         "-reflection-binary",
+         "reflection-binary <path>",
+         "Emit layout reflection data as a binary reflection blob to a file. The format can be "
+         "read without Slang using the accessors in slang-reflection-blob.h."}};
 
     _addOptions(makeConstArrayView(generalOpts), options);
 
@@ -582,6 +594,59 @@ void initCommandOptions(CommandOptions& options)
          "-O...",
          "-O<optimization-level>",
          "Set the optimization level."},
+        {OptionKind::InlineThreshold,
+         "-inline-threshold",
+         "-inline-threshold <size>",
+         "Sets the estimated instruction count below which a function is inlined into its callers. "
+         "Cost model inlining is enabled at -O2 and above, with a threshold of 40 at -O2 and 80 at "
+         "-O3. 0 disables it."},
+        {OptionKind::ReportInlining,
+         "-report-inlining",
+         nullptr,
+         "Reports the decisions made by cost model inlining."},
+        {OptionKind::ReportDynamicDispatch,
+         "-report-dynamic-dispatch",
+         nullptr,
+         "Reports the dynamic dispatch call sites that only some of the types conforming to an "
+         "interface can reach, and so are narrowed to a switch over those types or a direct call."},
+        {OptionKind::TightAnyValuePacking,
+         "-tight-any-value-packing",
+         nullptr,
+         "Packs the values stored in interface-typed values tightly: fields are ordered from the "
+         "widest to the narrowest, and bools, 8-bit and 16-bit values share 32-bit words instead "
+         "of each being aligned to its natural size. This changes the layout of dynamic dispatch "
+         "payloads, so all code that shares them must be compiled with it."},
+        {OptionKind::ReportAnyValuePacking,
+         "-report-any-value-packing",
+         nullptr,
+         "Reports the size that each type takes up when packed into an interface-typed value, with "
+         "and without -tight-any-value-packing."},
+        {OptionKind::LoopUnrollBudget,
+         "-loop-unroll-budget",
+         "-loop-unroll-budget <size>",
+         "Sets the instruction count, summed over all iterations, up to which a loop with a trip "
+         "count known at compile time is unrolled. Automatic unrolling is enabled at -O2 and "
+         "above, with a budget of 64 at -O2 and 256 at -O3. 0 disables it."},
+        {OptionKind::ReportLoopUnrolling,
+         "-report-loop-unrolling",
+         nullptr,
+         "Reports the loops that are unrolled automatically, and the ones over the budget."},
+        {OptionKind::ReportRegisterPressure,
+         "-report-register-pressure",
+         nullptr,
+         "Reports the estimated peak number of live registers in each function before and after "
+         "values are moved closer to their uses. This is done at -O2 and above."},
+        {OptionKind::SpecializeConstant,
+         "-specialize-constant",
+         "-specialize-constant <name>=<value>",
+         "Gives a value to a specialization constant, matched by its name or constant_id, or to "
+         "an extern or export static const, matched by its name. The constant is replaced with "
+         "the value, and the code that depends on it is folded."},
+        {OptionKind::DisableTypeLayoutCache,
+         "-disable-type-layout-cache",
+         nullptr,
+         "Lays out every struct type for each program, instead of reusing the layouts of struct "
+         "types that only depend on the target."},
         {OptionKind::Obfuscate,
          "-obfuscate",
          nullptr,
@@ -666,7 +731,13 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::BindlessSpaceIndex,
          "-bindless-space-index",
          "-bindless-space-index <index>",
-         "Specify the space index for the system defined global bindless resource array."}};
+         "Specify the space index for the system defined global bindless resource array."},
+        {OptionKind::CPUSIMDWidth,
+         "-cpu-simd-width",
+         "-cpu-simd-width <0|4|8|16>",
+         "Run the threads of a CPU compute thread group in blocks of this many lanes, as a hint "
+         "that the C/C++ compiler may vectorize across them. 0 (the default) runs one thread at "
+         "a time."}};
 
     _addOptions(makeConstArrayView(targetOpts), options);
 
@@ -792,6 +863,12 @@ void initCommandOptions(CommandOptions& options)
          "-serial-ir",
          nullptr,
          "Serialize the IR between front-end and back-end."},
+        {OptionKind::SerialIRViaData,
+         "-serial-ir-via-data",
+         nullptr,
+         "Write and read the IR of serialized modules through intermediate arrays of serialized "
+         "instructions, rather than directly. The output is the same, this is used to compare "
+         "the two."},
         {OptionKind::SkipCodeGen, "-skip-codegen", nullptr, "Skip the code generation phase."},
         {OptionKind::ValidateIr, "-validate-ir", nullptr, "Validate the IR between the phases."},
         {OptionKind::VerbosePaths,
@@ -867,6 +944,17 @@ void initCommandOptions(CommandOptions& options)
          "-ir-compression <type>",
          "Set compression for IR and AST outputs.\n"
          "Accepted compression types: none, lite"},
+        {OptionKind::ModuleCompression,
+         "-module-compression",
+         "-module-compression <type>",
+         "Compress each chunk of serialized modules as an independent frame, that is only "
+         "decompressed when a module is loaded.\n"
+         "Accepted compression types: none, deflate, lz4"},
+        {OptionKind::ModuleLoadThreadCount,
+         "-module-load-threads",
+         "-module-load-threads <count>",
+         "Read the precompiled modules imported by a precompiled module on up to <count> threads. "
+         "0 (the default) uses a thread for each hardware thread."},
         {OptionKind::LoadCoreModule,
          "-load-core-module",
          "-load-core-module <filename>",
@@ -2154,6 +2242,14 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::LoopInversion:
         case OptionKind::UnscopedEnum:
         case OptionKind::PreserveParameters:
+        case OptionKind::SerialIRViaData:
+        case OptionKind::ReportInlining:
+        case OptionKind::ReportDynamicDispatch:
+        case OptionKind::TightAnyValuePacking:
+        case OptionKind::ReportAnyValuePacking:
+        case OptionKind::ReportLoopUnrolling:
+        case OptionKind::ReportRegisterPressure:
+        case OptionKind::DisableTypeLayoutCache:
             linkage->m_optionSet.set(optionKind, true);
             break;
         case OptionKind::MatrixLayoutRow:
@@ -2695,6 +2791,16 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::EmitReflectionBinary:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::EmitReflectionBinary,
+                    outputPath.value);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
@@ -2923,6 +3029,113 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.add(OptionKind::BindlessSpaceIndex, (int)index);
                 break;
             }
+        case OptionKind::CheckpointBudget:
+            {
+                Int budget = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, budget));
+                if (budget < 0)
+                {
+                    m_sink->diagnose(
+                        arg.loc,
+                        Diagnostics::unknownCommandLineValue,
+                        "0 or more bytes");
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.add(OptionKind::CheckpointBudget, (int)budget);
+                break;
+            }
+        case OptionKind::InlineThreshold:
+            {
+                Int threshold = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, threshold));
+                if (threshold < 0)
+                {
+                    m_sink->diagnose(arg.loc, Diagnostics::unknownCommandLineValue, "0 or more");
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.add(OptionKind::InlineThreshold, (int)threshold);
+                break;
+            }
+        case OptionKind::LoopUnrollBudget:
+            {
+                Int budget = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, budget));
+                if (budget < 0)
+                {
+                    m_sink->diagnose(arg.loc, Diagnostics::unknownCommandLineValue, "0 or more");
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.add(OptionKind::LoopUnrollBudget, (int)budget);
+                break;
+            }
+        case OptionKind::SpecializeConstant:
+            {
+                CommandLineArg constantValue;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(constantValue));
+                UnownedStringSlice slice = constantValue.value.getUnownedSlice();
+                const Index equalIndex = slice.indexOf('=');
+                if (equalIndex <= 0)
+                {
+                    m_sink->diagnose(
+                        constantValue.loc,
+                        Diagnostics::unknownCommandLineValue,
+                        "<name>=<value>");
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.addSpecializationConstantValue(
+                    slice.head(equalIndex),
+                    slice.tail(equalIndex + 1));
+                break;
+            }
+        case OptionKind::CPUSIMDWidth:
+            {
+                Int width = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, width));
+                if (width != 0 && width != 4 && width != 8 && width != 16)
+                {
+                    m_sink->diagnose(arg.loc, Diagnostics::unknownCommandLineValue, "0, 4, 8, 16");
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.add(OptionKind::CPUSIMDWidth, (int)width);
+                break;
+            }
+        case OptionKind::ModuleLoadThreadCount:
+            {
+                Int count = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, count));
+                if (count < 0)
+                {
+                    m_sink->diagnose(
+                        arg.loc,
+                        Diagnostics::unknownCommandLineValue,
+                        "0 or more threads");
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.add(OptionKind::ModuleLoadThreadCount, (int)count);
+                break;
+            }
+        case OptionKind::ModuleCompression:
+            {
+                CommandLineArg name;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(name));
+                CompressionSystemType compressionType;
+                if (name.value == "none")
+                    compressionType = CompressionSystemType::None;
+                else if (name.value == "deflate")
+                    compressionType = CompressionSystemType::Deflate;
+                else if (name.value == "lz4")
+                    compressionType = CompressionSystemType::LZ4;
+                else
+                {
+                    m_sink->diagnose(
+                        name.loc,
+                        Diagnostics::unknownCommandLineValue,
+                        "none, deflate, lz4");
+                    return SLANG_FAIL;
+                }
+                linkage->m_optionSet.add(OptionKind::ModuleCompression, (int)compressionType);
+                break;
+            }
         default:
             {
                 // Hmmm, we looked up and produced a valid enum, but it wasn't handled in the
@@ -1328,6 +1328,18 @@ static void addExplicitParameterBindings_GLSL(
         }
     }
 
+    // The layout of a `struct` type can be shared with other programs through the type layout
+    // cache, so this parameter gets its own copy to add its bindings to.
+    if (typeLayout->isShared)
+    {
+        auto structTypeLayout = as<StructTypeLayout>(typeLayout);
+        SLANG_RELEASE_ASSERT(structTypeLayout);
+        RefPtr<StructTypeLayout> copy = new StructTypeLayout(*structTypeLayout);
+        copy->isShared = false;
+        typeLayout = copy;
+        varLayout->typeLayout = copy;
+    }
+
     if (warnedMissingVulkanLayoutModifier)
     {
         // If we warn due to invalid bindings and user did not set how to interpret 'hlsl style
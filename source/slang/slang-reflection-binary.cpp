@@ -0,0 +1,427 @@
+// slang-reflection-binary.cpp
+#include "slang-reflection-binary.h"
+
+#include "../core/slang-blob.h"
+#include "slang-reflection-blob.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+/* Flattens the reflection of a program into the tables of a reflection blob.
+
+Type layouts are deduplicated by identity, so a type that is used by many parameters is only written
+once. Records that must be contiguous (fields, parameters, sizes etc) are reserved before any
+nested type layouts are written, and only filled in once their contents has been determined, as
+writing nested records can grow (and so reallocate) the tables. */
+struct ReflectionBinaryWriter
+{
+    typedef slang::TypeLayoutReflection TypeLayout;
+    typedef slang::VariableLayoutReflection VarLayout;
+
+    SlangResult write(slang::ShaderReflection* programReflection, ComPtr<ISlangBlob>& outBlob);
+
+    uint32_t addString(const char* text);
+    uint32_t addTypeLayout(TypeLayout* typeLayout);
+    uint32_t addVarLayout(VarLayout* varLayout);
+    void writeVarLayout(uint32_t index, VarLayout* varLayout);
+
+    static uint32_t toIndex(Index index) { return uint32_t(index); }
+    static uint32_t toSize(size_t size);
+
+    template<typename T>
+    static uint32_t reserve(List<T>& list, Index count)
+    {
+        const Index first = list.getCount();
+        list.growToCount(first + count);
+        return toIndex(first);
+    }
+
+    List<char> m_strings;
+    Dictionary<String, uint32_t> m_stringMap;
+    Dictionary<TypeLayout*, uint32_t> m_typeLayoutMap;
+
+    List<SlangReflectionBlobTypeLayout> m_typeLayouts;
+    List<SlangReflectionBlobVarLayout> m_varLayouts;
+    List<SlangReflectionBlobSize> m_sizes;
+    List<SlangReflectionBlobOffset> m_offsets;
+    List<SlangReflectionBlobBindingRange> m_bindingRanges;
+    List<SlangReflectionBlobDescriptorSet> m_descriptorSets;
+    List<SlangReflectionBlobDescriptorRange> m_descriptorRanges;
+    List<SlangReflectionBlobSubObjectRange> m_subObjectRanges;
+    List<SlangReflectionBlobEntryPoint> m_entryPoints;
+};
+
+uint32_t ReflectionBinaryWriter::toSize(size_t size)
+{
+    if (size == SLANG_UNBOUNDED_SIZE)
+        return SLANG_REFLECTION_BLOB_UNBOUNDED;
+    if (size >= SLANG_REFLECTION_BLOB_UNKNOWN)
+        return SLANG_REFLECTION_BLOB_UNKNOWN;
+    return uint32_t(size);
+}
+
+uint32_t ReflectionBinaryWriter::addString(const char* text)
+{
+    if (!text || text[0] == 0)
+        return 0;
+
+    const String string(text);
+    if (auto offset = m_stringMap.tryGetValue(string))
+        return *offset;
+
+    const uint32_t offset = toIndex(m_strings.getCount());
+    m_strings.addRange(string.getBuffer(), string.getLength() + 1);
+    m_stringMap.add(string, offset);
+    return offset;
+}
+
+uint32_t ReflectionBinaryWriter::addVarLayout(VarLayout* varLayout)
+{
+    if (!varLayout)
+        return SLANG_REFLECTION_BLOB_NONE;
+    const uint32_t index = reserve(m_varLayouts, 1);
+    writeVarLayout(index, varLayout);
+    return index;
+}
+
+void ReflectionBinaryWriter::writeVarLayout(uint32_t index, VarLayout* varLayout)
+{
+    SlangReflectionBlobVarLayout record = {};
+
+    // Var layouts for scopes and containers don't have a variable
+    auto variable = varLayout->getVariable();
+    record.name = addString(variable ? variable->getName() : nullptr);
+    record.semanticName = addString(varLayout->getSemanticName());
+    record.semanticIndex = toSize(varLayout->getSemanticIndex());
+    record.stage = uint32_t(varLayout->getStage());
+
+    auto typeLayout = varLayout->getTypeLayout();
+
+    const unsigned categoryCount = typeLayout ? typeLayout->getCategoryCount() : 0;
+    record.firstOffset = reserve(m_offsets, categoryCount);
+    record.offsetCount = categoryCount;
+    for (unsigned i = 0; i < categoryCount; ++i)
+    {
+        const auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+
+        auto& offset = m_offsets[record.firstOffset + i];
+        offset.category = uint32_t(category);
+        offset.offset = toSize(varLayout->getOffset(category));
+        offset.space = toSize(varLayout->getBindingSpace(category));
+    }
+
+    record.typeLayout = addTypeLayout(typeLayout);
+
+    m_varLayouts[index] = record;
+}
+
+uint32_t ReflectionBinaryWriter::addTypeLayout(TypeLayout* typeLayout)
+{
+    if (!typeLayout)
+        return SLANG_REFLECTION_BLOB_NONE;
+
+    if (auto existing = m_typeLayoutMap.tryGetValue(typeLayout))
+        return *existing;
+
+    // Add to the map before writing anything nested, so recursive types terminate
+    const uint32_t index = reserve(m_typeLayouts, 1);
+    m_typeLayoutMap.add(typeLayout, index);
+
+    SlangReflectionBlobTypeLayout record = {};
+
+    record.kind = uint32_t(typeLayout->getKind());
+    record.parameterCategory = uint32_t(typeLayout->getParameterCategory());
+    record.matrixLayoutMode = uint32_t(typeLayout->getMatrixLayoutMode());
+
+    if (auto type = typeLayout->getType())
+    {
+        record.name = addString(type->getName());
+        record.scalarType = uint32_t(type->getScalarType());
+        record.resourceShape = uint32_t(type->getResourceShape());
+        record.resourceAccess = uint32_t(type->getResourceAccess());
+        record.rowCount = type->getRowCount();
+        record.columnCount = type->getColumnCount();
+        record.elementCount = toSize(type->getElementCount());
+    }
+
+    // Sizes
+    {
+        const unsigned categoryCount = typeLayout->getCategoryCount();
+        record.firstSize = reserve(m_sizes, categoryCount);
+        record.sizeCount = categoryCount;
+        for (unsigned i = 0; i < categoryCount; ++i)
+        {
+            const auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+
+            auto& size = m_sizes[record.firstSize + i];
+            size.category = uint32_t(category);
+            size.size = toSize(typeLayout->getSize(category));
+            size.alignment = uint32_t(typeLayout->getAlignment(category));
+            size.stride = toSize(typeLayout->getStride(category));
+        }
+    }
+
+    // Descriptor sets and their ranges
+    {
+        const SlangInt setCount = typeLayout->getDescriptorSetCount();
+        record.firstDescriptorSet = reserve(m_descriptorSets, setCount);
+        record.descriptorSetCount = toIndex(setCount);
+        for (SlangInt i = 0; i < setCount; ++i)
+        {
+            const SlangInt rangeCount = typeLayout->getDescriptorSetDescriptorRangeCount(i);
+
+            auto& set = m_descriptorSets[record.firstDescriptorSet + i];
+            set.spaceOffset = toIndex(typeLayout->getDescriptorSetSpaceOffset(i));
+            set.firstDescriptorRange = reserve(m_descriptorRanges, rangeCount);
+            set.descriptorRangeCount = toIndex(rangeCount);
+
+            for (SlangInt j = 0; j < rangeCount; ++j)
+            {
+                auto& range = m_descriptorRanges[set.firstDescriptorRange + j];
+                range.indexOffset =
+                    toIndex(typeLayout->getDescriptorSetDescriptorRangeIndexOffset(i, j));
+                range.descriptorCount =
+                    toSize(typeLayout->getDescriptorSetDescriptorRangeDescriptorCount(i, j));
+                range.bindingType =
+                    uint32_t(typeLayout->getDescriptorSetDescriptorRangeType(i, j));
+                range.category =
+                    uint32_t(typeLayout->getDescriptorSetDescriptorRangeCategory(i, j));
+            }
+        }
+    }
+
+    // Binding ranges. The leaf type layouts are written once the ranges are complete.
+    const SlangInt bindingRangeCount = typeLayout->getBindingRangeCount();
+    record.firstBindingRange = reserve(m_bindingRanges, bindingRangeCount);
+    record.bindingRangeCount = toIndex(bindingRangeCount);
+    for (SlangInt i = 0; i < bindingRangeCount; ++i)
+    {
+        auto& range = m_bindingRanges[record.firstBindingRange + i];
+        range.bindingType = uint32_t(typeLayout->getBindingRangeType(i));
+        range.bindingCount = toSize(typeLayout->getBindingRangeBindingCount(i));
+        range.imageFormat = uint32_t(typeLayout->getBindingRangeImageFormat(i));
+        range.descriptorSetIndex = toIndex(typeLayout->getBindingRangeDescriptorSetIndex(i));
+        range.firstDescriptorRange =
+            toIndex(typeLayout->getBindingRangeFirstDescriptorRangeIndex(i));
+        range.descriptorRangeCount = toIndex(typeLayout->getBindingRangeDescriptorRangeCount(i));
+        range.leafTypeLayout = SLANG_REFLECTION_BLOB_NONE;
+    }
+
+    const SlangInt subObjectRangeCount = typeLayout->getSubObjectRangeCount();
+    record.firstSubObjectRange = reserve(m_subObjectRanges, subObjectRangeCount);
+    record.subObjectRangeCount = toIndex(subObjectRangeCount);
+
+    const unsigned fieldCount = typeLayout->getFieldCount();
+    record.firstField = reserve(m_varLayouts, fieldCount);
+    record.fieldCount = fieldCount;
+
+    // Everything that is contiguous is now reserved, so we can write nested records.
+
+    for (unsigned i = 0; i < fieldCount; ++i)
+    {
+        writeVarLayout(record.firstField + i, typeLayout->getFieldByIndex(i));
+    }
+
+    for (SlangInt i = 0; i < bindingRangeCount; ++i)
+    {
+        const uint32_t leaf = addTypeLayout(typeLayout->getBindingRangeLeafTypeLayout(i));
+        m_bindingRanges[record.firstBindingRange + i].leafTypeLayout = leaf;
+    }
+
+    for (SlangInt i = 0; i < subObjectRangeCount; ++i)
+    {
+        SlangReflectionBlobSubObjectRange range;
+        range.bindingRangeIndex = toIndex(typeLayout->getSubObjectRangeBindingRangeIndex(i));
+        range.spaceOffset = toIndex(typeLayout->getSubObjectRangeSpaceOffset(i));
+        range.offsetVarLayout = addVarLayout(typeLayout->getSubObjectRangeOffset(i));
+        m_subObjectRanges[record.firstSubObjectRange + i] = range;
+    }
+
+    record.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+    record.elementVarLayout = addVarLayout(typeLayout->getElementVarLayout());
+    record.containerVarLayout = addVarLayout(typeLayout->getContainerVarLayout());
+
+    m_typeLayouts[index] = record;
+    return index;
+}
+
+// Pad with zeros, so the output is deterministic
+static void _alignData(List<uint8_t>& data)
+{
+    while (data.getCount() & 3)
+        data.add(0);
+}
+
+template<typename T>
+static void _writeSection(
+    List<uint8_t>& data,
+    SlangReflectionBlobSection& outSection,
+    const T* records,
+    Index count)
+{
+    _alignData(data);
+
+    outSection.offset = uint32_t(data.getCount());
+    outSection.count = uint32_t(count);
+    outSection.stride = uint32_t(sizeof(T));
+
+    data.addRange((const uint8_t*)records, count * Index(sizeof(T)));
+}
+
+SlangResult ReflectionBinaryWriter::write(
+    slang::ShaderReflection* programReflection,
+    ComPtr<ISlangBlob>& outBlob)
+{
+    // Offset 0 is the empty string
+    m_strings.add(0);
+
+    SlangReflectionBlobHeader header = {};
+    header.magic = SLANG_REFLECTION_BLOB_MAGIC;
+    header.majorVersion = SLANG_REFLECTION_BLOB_MAJOR_VERSION;
+    header.minorVersion = SLANG_REFLECTION_BLOB_MINOR_VERSION;
+    header.sectionCount = SLANG_REFLECTION_BLOB_SECTION_COUNT_V1;
+
+    const unsigned parameterCount = programReflection->getParameterCount();
+    header.firstParameter = reserve(m_varLayouts, parameterCount);
+    header.parameterCount = parameterCount;
+    for (unsigned i = 0; i < parameterCount; ++i)
+    {
+        writeVarLayout(header.firstParameter + i, programReflection->getParameterByIndex(i));
+    }
+    header.globalParamsVarLayout = addVarLayout(programReflection->getGlobalParamsVarLayout());
+
+    const SlangUInt entryPointCount = programReflection->getEntryPointCount();
+    for (SlangUInt i = 0; i < entryPointCount; ++i)
+    {
+        auto entryPoint = programReflection->getEntryPointByIndex(i);
+
+        SlangReflectionBlobEntryPoint record = {};
+        record.name = addString(entryPoint->getName());
+        record.nameOverride = addString(entryPoint->getNameOverride());
+        record.stage = uint32_t(entryPoint->getStage());
+
+        if (entryPoint->getStage() == SLANG_STAGE_COMPUTE)
+        {
+            SlangUInt sizes[3] = {1, 1, 1};
+            entryPoint->getComputeThreadGroupSize(3, sizes);
+            for (Index j = 0; j < 3; ++j)
+                record.threadGroupSize[j] = uint32_t(sizes[j]);
+        }
+
+        const unsigned entryPointParamCount = entryPoint->getParameterCount();
+        record.firstParameter = reserve(m_varLayouts, entryPointParamCount);
+        record.parameterCount = entryPointParamCount;
+        for (unsigned j = 0; j < entryPointParamCount; ++j)
+        {
+            writeVarLayout(record.firstParameter + j, entryPoint->getParameterByIndex(j));
+        }
+
+        record.varLayout = addVarLayout(entryPoint->getVarLayout());
+        record.resultVarLayout = addVarLayout(entryPoint->getResultVarLayout());
+
+        m_entryPoints.add(record);
+    }
+
+    // Serialize. The header and section table are written last, once the offsets are known.
+    SlangReflectionBlobSection sections[SLANG_REFLECTION_BLOB_SECTION_COUNT_V1];
+
+    List<uint8_t> data;
+    data.growToCount(sizeof(header) + sizeof(sections));
+
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_STRINGS],
+        m_strings.getBuffer(),
+        m_strings.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_TYPE_LAYOUTS],
+        m_typeLayouts.getBuffer(),
+        m_typeLayouts.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_VAR_LAYOUTS],
+        m_varLayouts.getBuffer(),
+        m_varLayouts.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_SIZES],
+        m_sizes.getBuffer(),
+        m_sizes.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_OFFSETS],
+        m_offsets.getBuffer(),
+        m_offsets.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_BINDING_RANGES],
+        m_bindingRanges.getBuffer(),
+        m_bindingRanges.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_DESCRIPTOR_SETS],
+        m_descriptorSets.getBuffer(),
+        m_descriptorSets.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_DESCRIPTOR_RANGES],
+        m_descriptorRanges.getBuffer(),
+        m_descriptorRanges.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_SUB_OBJECT_RANGES],
+        m_subObjectRanges.getBuffer(),
+        m_subObjectRanges.getCount());
+    _writeSection(
+        data,
+        sections[SLANG_REFLECTION_BLOB_SECTION_ENTRY_POINTS],
+        m_entryPoints.getBuffer(),
+        m_entryPoints.getCount());
+
+    // Round up the total, so the blob can be concatenated and stay aligned
+    _alignData(data);
+
+    if (UInt(data.getCount()) > UInt(0xffffffff))
+    {
+        return SLANG_E_BUFFER_TOO_SMALL;
+    }
+    header.totalSize = uint32_t(data.getCount());
+
+    ::memcpy(data.getBuffer(), &header, sizeof(header));
+    ::memcpy(data.getBuffer() + sizeof(header), sections, sizeof(sections));
+
+    outBlob = ListBlob::moveCreate(data);
+    return SLANG_OK;
+}
+
+} // namespace
+
+SlangResult writeReflectionBinary(
+    slang::ShaderReflection* programReflection,
+    ComPtr<ISlangBlob>& outBlob)
+{
+    ReflectionBinaryWriter writer;
+    return writer.write(programReflection, outBlob);
+}
+
+} // namespace Slang
+
+extern "C"
+{
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob)
+    {
+        using namespace Slang;
+
+        if (!reflection || !outBlob)
+            return SLANG_E_INVALID_ARG;
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(writeReflectionBinary((slang::ShaderReflection*)reflection, blob));
+        *outBlob = blob.detach();
+        return SLANG_OK;
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef SLANG_REFLECTION_BINARY_H
+#define SLANG_REFLECTION_BINARY_H
+
+#include "../core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+/// Write the layout reflection of a program as a binary reflection blob.
+/// The format and accessors for reading it are defined in `slang-reflection-blob.h`.
+SlangResult writeReflectionBinary(
+    slang::ShaderReflection* programReflection,
+    ComPtr<ISlangBlob>& outBlob);
+
+} // namespace Slang
+
+#endif
@@ -192,6 +192,16 @@ namespace Slang
                 dstModule.dependentFiles.add(file->getPathInfo().getMostUniqueIdentity());
             }
         }
+        // Builtin modules don't have a file, and are never loaded from one
+        for (auto importedModule : module->getModuleDependencyList())
+        {
+            if (importedModule != module && importedModule->getName() &&
+                importedModule->getFilePath())
+            {
+                dstModule.importedModules.add(importedModule->getName());
+            }
+        }
+
         dstModule.digest = module->computeDigest();
         outData.modules.add(dstModule);
     }
@@ -289,6 +299,7 @@ namespace Slang
         container,
         RiffContainer::Chunk::Kind::List,
         SerialBinary::kContainerFourCc);
+    RiffContainer::Chunk* containerChunk = container->getCurrentChunk();
 
     // Write the header
     {
@@ -326,7 +337,8 @@ namespace Slang
 
             // First, we write a header that can be used to verify if the precompiled module is
             // up-to-date. The header has: 1) a digest of all compile options and dependent source
-            // files. 2) a list of source file paths.
+            // files. 2) a list of source file paths. 3) a list of the names of imported modules,
+            // so the modules it depends on can be found without reading the AST.
             //
             {
                 RiffContainer::ScopeChunk scopeHeader(
@@ -341,6 +353,12 @@ namespace Slang
                 uint32_t fileListLength = (uint32_t)filePathsSB.getLength();
                 headerMemStream.write(&fileListLength, sizeof(uint32_t));
                 headerMemStream.write(filePathsSB.getBuffer(), fileListLength);
+                StringBuilder importedModulesSB;
+                for (auto importedModule : module.importedModules)
+                    importedModulesSB << importedModule << "\n";
+                uint32_t importListLength = (uint32_t)importedModulesSB.getLength();
+                headerMemStream.write(&importListLength, sizeof(uint32_t));
+                headerMemStream.write(importedModulesSB.getBuffer(), importListLength);
                 container->write(
                     headerMemStream.getContents().getBuffer(),
                     headerMemStream.getContents().getCount());
@@ -349,15 +367,29 @@ namespace Slang
             // Write the IR information
             if ((options.optionFlags & SerialOptionFlag::IRModule) && module.irModule)
             {
-                IRSerialData serialData;
                 IRSerialWriter writer;
-                SLANG_RETURN_ON_FAIL(writer.write(
-                    module.irModule,
-                    sourceLocWriter,
-                    options.optionFlags,
-                    &serialData));
-                SLANG_RETURN_ON_FAIL(
-                    IRSerialWriter::writeContainer(serialData, options.compressionType, container));
+                if (options.useIRSerialData)
+                {
+                    IRSerialData serialData;
+                    SLANG_RETURN_ON_FAIL(writer.write(
+                        module.irModule,
+                        sourceLocWriter,
+                        options.optionFlags,
+                        &serialData));
+                    SLANG_RETURN_ON_FAIL(IRSerialWriter::writeContainer(
+                        serialData,
+                        options.compressionType,
+                        container));
+                }
+                else
+                {
+                    SLANG_RETURN_ON_FAIL(writer.writeModule(
+                        module.irModule,
+                        sourceLocWriter,
+                        options.optionFlags,
+                        options.compressionType,
+                        container));
+                }
             }
 
             // Write the AST information
@@ -468,6 +500,22 @@ namespace Slang
         container->write(encodedTable.getBuffer(), encodedTable.getCount());
     }
 
+    // Compress the chunks, each as an independent frame, so they can be decompressed in parallel
+    // (or not at all if they aren't needed) when read
+    if (options.frameCompressionType != CompressionSystemType::None)
+    {
+        ICompressionSystem* compressionSystem =
+            RiffContainer::getCompressionSystem(options.frameCompressionType);
+        if (!compressionSystem)
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        SLANG_RETURN_ON_FAIL(container->compressFrames(
+            containerChunk,
+            compressionSystem,
+            options.frameThreadCount));
+    }
+
     return SLANG_OK;
 }
 
@@ -485,6 +533,164 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
     return entry->candidateExtensions;
 }
 
+// Reads the header written for each module, with the digest, the dependent files and the imported
+// modules
+static SlangResult _readModuleHeader(
+    RiffContainer::DataChunk* headerChunk,
+    SerialContainerData::Module& outModule)
+{
+    RiffContainer::Data* headerData = headerChunk->getSingleData();
+    if (!headerData)
+        return SLANG_FAIL;
+
+    MemoryStreamBase memStream(FileAccess::Read, headerData->getPayload(), headerData->getSize());
+    size_t readSize = 0;
+    memStream.read(outModule.digest.data, sizeof(SHA1::Digest), readSize);
+    if (readSize != sizeof(SHA1::Digest))
+        return SLANG_FAIL;
+
+    auto readList = [&](List<String>& outList) -> SlangResult
+    {
+        uint32_t listLength = 0;
+        memStream.read(&listLength, sizeof(uint32_t), readSize);
+        if (readSize != sizeof(uint32_t))
+            return SLANG_FAIL;
+        List<uint8_t> listContent;
+        listContent.setCount(listLength);
+        memStream.read(listContent.getBuffer(), listContent.getCount(), readSize);
+        if (readSize != (size_t)listContent.getCount())
+            return SLANG_FAIL;
+        UnownedStringSlice listString((const char*)listContent.getBuffer(), listContent.getCount());
+        List<UnownedStringSlice> slices;
+        StringUtil::split(listString, '\n', slices);
+        for (auto slice : slices)
+        {
+            if (slice.getLength())
+            {
+                outList.add(slice);
+            }
+        }
+        return SLANG_OK;
+    };
+
+    SLANG_RETURN_ON_FAIL(readList(outModule.dependentFiles));
+
+    // The list of imported modules isn't present in older headers
+    if (memStream.getPosition() < int64_t(headerData->getSize()))
+    {
+        SLANG_RETURN_ON_FAIL(readList(outModule.importedModules));
+    }
+    return SLANG_OK;
+}
+
+// Find the list chunk holding the modules of a container
+static RiffContainer::ListChunk* _findModuleList(RiffContainer* container)
+{
+    RiffContainer::ListChunk* containerChunk =
+        container->getRoot() ? container->getRoot()->findListRec(SerialBinary::kContainerFourCc)
+                             : nullptr;
+    return containerChunk ? containerChunk->findContainedList(SerialBinary::kModuleListFourCc)
+                          : nullptr;
+}
+
+/* static */ SlangResult SerialContainerUtil::readModuleImports(
+    RiffContainer* container,
+    List<String>& outImportedModules)
+{
+    RiffContainer::ListChunk* moduleList = _findModuleList(container);
+    if (!moduleList)
+        return SLANG_FAIL;
+
+    List<RiffContainer::DataChunk*> headerChunks;
+    moduleList->findContained(SerialBinary::kModuleHeaderFourCc, headerChunks);
+    for (auto headerChunk : headerChunks)
+    {
+        SerialContainerData::Module module;
+        SLANG_RETURN_ON_FAIL(_readModuleHeader(headerChunk, module));
+        outImportedModules.addRange(module.importedModules);
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _readIRModule(
+    RiffContainer::ListChunk* irChunk,
+    SerialCompressionType containerCompressionType,
+    Session* session,
+    SerialSourceLocReader* sourceLocReader,
+    bool useIRSerialData,
+    IRSerialReader& reader,
+    RefPtr<IRModule>& outModule)
+{
+    if (useIRSerialData)
+    {
+        IRSerialData serialData;
+        SLANG_RETURN_ON_FAIL(
+            IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+
+        // Read IR back from serialData
+        return reader.read(serialData, session, sourceLocReader, outModule);
+    }
+    return reader.readModule(
+        irChunk,
+        containerCompressionType,
+        session,
+        sourceLocReader,
+        outModule);
+}
+
+/* static */ SlangResult SerialContainerUtil::readIRModules(
+    RiffContainer* container,
+    Session* session,
+    bool useIRSerialData,
+    List<PrereadIRModule>& outModules)
+{
+    outModules.clear();
+
+    RiffContainer::ListChunk* containerChunk =
+        container->getRoot() ? container->getRoot()->findListRec(SerialBinary::kContainerFourCc)
+                             : nullptr;
+    if (!containerChunk)
+        return SLANG_FAIL;
+
+    SerialBinary::ContainerHeader* containerHeader =
+        containerChunk->findContainedData<SerialBinary::ContainerHeader>(
+            SerialBinary::kContainerHeaderFourCc);
+    if (!containerHeader)
+        return SLANG_FAIL;
+
+    // Decompress on this thread, as the container may be one of many being read
+    SLANG_RETURN_ON_FAIL(RiffContainer::decompressFrames(containerChunk, 1));
+
+    RiffContainer::ListChunk* moduleList =
+        containerChunk->findContainedList(SerialBinary::kModuleListFourCc);
+    if (!moduleList)
+        return SLANG_OK;
+
+    for (auto chunk = moduleList->getFirstContainedChunk(); chunk; chunk = chunk->m_next)
+    {
+        auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc);
+        if (!irChunk)
+            continue;
+
+        PrereadIRModule module;
+        module.irChunk = irChunk;
+        if (SLANG_FAILED(_readIRModule(
+                irChunk,
+                SerialCompressionType(containerHeader->compressionType),
+                session,
+                nullptr,
+                useIRSerialData,
+                module.reader,
+                module.irModule)))
+        {
+            outModules.clear();
+            return SLANG_FAIL;
+        }
+        outModules.add(module);
+    }
+    return SLANG_OK;
+}
+
 /* static */ Result SerialContainerUtil::read(
     RiffContainer* container,
     const ReadOptions& options,
@@ -513,6 +719,14 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
     const SerialCompressionType containerCompressionType =
         SerialCompressionType(containerHeader->compressionType);
 
+    // If the chunks were compressed as frames, and all of the container is going to be read,
+    // decompress them all at once in parallel. Otherwise only the frames that are accessed are
+    // decompressed.
+    if (!options.readHeaderOnly)
+    {
+        SLANG_RETURN_ON_FAIL(RiffContainer::decompressFrames(containerChunk, 0));
+    }
+
     StringSlicePool containerStringPool(StringSlicePool::Style::Default);
 
     if (RiffContainer::Data* stringTableData =
@@ -540,21 +754,9 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
     }
 
     // Create a source loc representing the binary module.
-    SourceLoc binaryModuleLoc = SourceLoc();
-
-    if (options.modulePath.getLength())
-    {
-        auto srcManager = options.linkage->getSourceManager();
-        auto modulePathInfo = PathInfo::makePath(options.modulePath);
-        auto srcFile = srcManager->findSourceFileByPathRecursively(modulePathInfo.foundPath);
-        if (!srcFile)
-        {
-            srcFile = srcManager->createSourceFileWithString(modulePathInfo, String());
-            srcManager->addSourceFile(options.modulePath, srcFile);
-        }
-        auto srcView = srcManager->createSourceView(srcFile, &modulePathInfo, SourceLoc());
-        binaryModuleLoc = srcView->getRange().begin;
-    }
+    SourceLoc binaryModuleLoc = options.modulePath.getLength()
+                                    ? options.linkage->getBinaryModuleLoc(options.modulePath)
+                                    : SourceLoc();
 
     // Add modules
     if (RiffContainer::ListChunk* moduleList =
@@ -572,35 +774,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             if (auto headerChunk =
                     as<RiffContainer::DataChunk>(chunk, SerialBinary::kModuleHeaderFourCc))
             {
-                MemoryStreamBase memStream(
-                    FileAccess::Read,
-                    headerChunk->getSingleData()->getPayload(),
-                    headerChunk->getSingleData()->getSize());
-                size_t readSize = 0;
-                memStream.read(module.digest.data, sizeof(SHA1::Digest), readSize);
-                if (readSize != sizeof(SHA1::Digest))
-                    return SLANG_FAIL;
-                uint32_t fileListLength = 0;
-                memStream.read(&fileListLength, sizeof(uint32_t), readSize);
-                if (readSize != sizeof(uint32_t))
-                    return SLANG_FAIL;
-                List<uint8_t> fileListContent;
-                fileListContent.setCount(fileListLength);
-                memStream.read(fileListContent.getBuffer(), fileListContent.getCount(), readSize);
-                if (readSize != (size_t)fileListContent.getCount())
-                    return SLANG_FAIL;
-                UnownedStringSlice fileListString(
-                    (const char*)fileListContent.getBuffer(),
-                    fileListContent.getCount());
-                List<UnownedStringSlice> fileList;
-                StringUtil::split(fileListString, '\n', fileList);
-                for (auto file : fileList)
-                {
-                    if (file.getLength())
-                    {
-                        module.dependentFiles.add(file);
-                    }
-                }
+                SLANG_RETURN_ON_FAIL(_readModuleHeader(headerChunk, module));
                 // Onto next chunk
                 chunk = chunk->m_next;
             }
@@ -609,16 +783,33 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             {
                 if (!options.readHeaderOnly)
                 {
-                    IRSerialData serialData;
-                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(
-                        irChunk,
-                        containerCompressionType,
-                        &serialData));
+                    PrereadIRModule* prereadModule = nullptr;
+                    if (options.prereadIRModules)
+                    {
+                        for (auto& preread : *options.prereadIRModules)
+                        {
+                            if (preread.irChunk == irChunk)
+                                prereadModule = &preread;
+                        }
+                    }
 
-                    // Read IR back from serialData
-                    IRSerialReader reader;
-                    SLANG_RETURN_ON_FAIL(
-                        reader.read(serialData, options.session, sourceLocReader, irModule));
+                    if (prereadModule)
+                    {
+                        irModule = prereadModule->irModule;
+                        prereadModule->reader.applySourceLocs(sourceLocReader);
+                    }
+                    else
+                    {
+                        IRSerialReader reader;
+                        SLANG_RETURN_ON_FAIL(_readIRModule(
+                            irChunk,
+                            containerCompressionType,
+                            options.session,
+                            sourceLocReader,
+                            options.useIRSerialData,
+                            reader,
+                            irModule));
+                    }
                 }
 
                 // Onto next chunk
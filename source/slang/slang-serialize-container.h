@@ -5,6 +5,8 @@
 #include "../core/slang-riff.h"
 #include "slang-ir-insts.h"
 #include "slang-profile.h"
+#include "slang-serialize-ir-types.h"
+#include "slang-serialize-ir.h"
 #include "slang-serialize-types.h"
 
 namespace Slang
@@ -37,6 +39,7 @@ struct SerialContainerDataModule
     RefPtr<ASTBuilder> astBuilder;   ///< The astBuilder that owns the astRootNode
     NodeBase* astRootNode = nullptr; ///< The module decl
     List<String> dependentFiles;
+    List<String> importedModules; ///< Names of the modules this module depends on
     SHA1::Digest digest;
 };
 
@@ -91,6 +94,19 @@ struct SerialContainerUtil
             SerialOptionFlag::IRModule; ///< Flags controlling what is written
         SourceManager* sourceManager =
             nullptr; ///< The source manager used for the SourceLoc in the input
+        CompressionSystemType frameCompressionType =
+            CompressionSystemType::None; ///< If not None, each chunk is compressed as a frame
+        Index frameThreadCount = 0;      ///< Threads used to compress frames. 0 to use all
+        bool useIRSerialData = false; ///< Write IR through IRSerialData, rather than directly
+    };
+
+    /// The IR of a module in a container, read before the rest of the container is read
+    struct PrereadIRModule
+    {
+        RiffContainer::ListChunk* irChunk = nullptr;
+        RefPtr<IRModule> irModule;
+        /// Holds the debug source locations until the container is read
+        IRSerialReader reader;
     };
 
     struct ReadOptions
@@ -105,6 +121,11 @@ struct SerialContainerUtil
         DiagnosticSink* sink = nullptr;
         bool readHeaderOnly = false;
         String modulePath;
+        /// Read IR through IRSerialData, rather than directly from the container
+        bool useIRSerialData = false;
+        /// Optional. IR modules already read from the container by readIRModules, which are
+        /// used rather than reading their IR again
+        List<PrereadIRModule>* prereadIRModules = nullptr;
     };
 
     /// Add module to outData
@@ -138,6 +159,22 @@ struct SerialContainerUtil
         const LoadedModuleDictionary* additionalLoadedModules,
         SerialContainerData& outData);
 
+    /// Read the names of the modules imported by the modules in the container, from the module
+    /// headers
+    static SlangResult readModuleImports(
+        RiffContainer* container,
+        List<String>& outImportedModules);
+
+    /// Decompress the frames of the container and read the IR modules in it on the calling
+    /// thread. Only the session pointer is used, rather than any session or linkage state, so
+    /// containers can be read on different threads. The debug source locations of the IR use
+    /// the source manager, so are applied when the container is read with `read`.
+    static SlangResult readIRModules(
+        RiffContainer* container,
+        Session* session,
+        bool useIRSerialData,
+        List<PrereadIRModule>& outModules);
+
     /// Verify IR serialization
     static SlangResult verifyIRSerialize(
         IRModule* module,
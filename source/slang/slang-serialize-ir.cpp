@@ -27,7 +27,9 @@ void IRSerialWriter::_addInstruction(IRInst* inst)
     m_insts.add(inst);
 }
 
-Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
+Result IRSerialWriter::_calcDebugInfo(
+    SerialSourceLocWriter* sourceLocWriter,
+    List<Ser::SourceLocRun>& outSourceLocRuns)
 {
     // We need to find the unique source Locs
     // We are not going to store SourceLocs directly, because there may be multiple views mapping
@@ -96,7 +98,7 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
         sourceLocRun.m_sourceLoc =
             sourceLocWriter->addSourceLoc(SourceLoc::fromRaw(startSourceLoc));
 
-        m_serialData->m_debugSourceLocRuns.add(sourceLocRun);
+        outSourceLocRuns.add(sourceLocRun);
 
         // Next
         startInstLoc = curInstLoc;
@@ -105,18 +107,8 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
     return SLANG_OK;
 }
 
-Result IRSerialWriter::write(
-    IRModule* module,
-    SerialSourceLocWriter* sourceLocWriter,
-    SerialOptionFlags options,
-    IRSerialData* serialData)
+void IRSerialWriter::_addInstructions(IRModule* module, List<Ser::InstRun>& outChildRuns)
 {
-    typedef Ser::Inst::PayloadType PayloadType;
-
-    m_serialData = serialData;
-
-    serialData->clear();
-
     // We reserve 0 for null
     m_insts.clear();
     m_insts.add(nullptr);
@@ -166,7 +158,7 @@ Result IRSerialWriter::write(
             run.m_startInstIndex = startChildInstIndex;
             run.m_numChildren = Ser::SizeType(m_insts.getCount() - int(startChildInstIndex));
 
-            m_serialData->m_childRuns.add(run);
+            outChildRuns.add(run);
         }
     }
 
@@ -181,123 +173,143 @@ Result IRSerialWriter::write(
         }
     }
 #endif
+}
 
-    // Set to the right size
-    m_serialData->m_insts.setCount(m_insts.getCount());
-    // Clear all instructions
-    memset(m_serialData->m_insts.begin(), 0, sizeof(Ser::Inst) * m_serialData->m_insts.getCount());
-
-    // Need to set up the actual instructions
-    {
-        const Index numInsts = m_insts.getCount();
+Result IRSerialWriter::_calcInst(
+    IRInst* srcInst,
+    Ser::Inst& dstInst,
+    List<Ser::InstIndex>& ioExternalOperands)
+{
+    typedef Ser::Inst::PayloadType PayloadType;
 
-        for (Index i = 1; i < numInsts; ++i)
-        {
-            IRInst* srcInst = m_insts[i];
-            Ser::Inst& dstInst = m_serialData->m_insts[i];
+    // Clear, so unused parts of the payload are always zero
+    memset(&dstInst, 0, sizeof(dstInst));
 
-            dstInst.m_op = uint16_t(srcInst->getOp() & kIROpMask_OpMask);
-            dstInst.m_payloadType = PayloadType::Empty;
+    dstInst.m_op = uint16_t(srcInst->getOp() & kIROpMask_OpMask);
+    dstInst.m_payloadType = PayloadType::Empty;
 
-            dstInst.m_resultTypeIndex = getInstIndex(srcInst->getFullType());
+    dstInst.m_resultTypeIndex = getInstIndex(srcInst->getFullType());
 
-            IRConstant* irConst = as<IRConstant>(srcInst);
-            if (irConst)
+    IRConstant* irConst = as<IRConstant>(srcInst);
+    if (irConst)
+    {
+        switch (srcInst->getOp())
+        {
+        // Special handling for the ir const derived types
+        case kIROp_BlobLit:
             {
-                switch (srcInst->getOp())
-                {
-                // Special handling for the ir const derived types
-                case kIROp_BlobLit:
-                    {
-                        // Blobs are serialized into string table like strings
-                        auto stringLit = static_cast<IRBlobLit*>(srcInst);
-                        dstInst.m_payloadType = PayloadType::String_1;
-                        dstInst.m_payload.m_stringIndices[0] =
-                            getStringIndex(stringLit->getStringSlice());
-                        break;
-                    }
-                case kIROp_StringLit:
-                    {
-                        auto stringLit = static_cast<IRStringLit*>(srcInst);
-                        dstInst.m_payloadType = PayloadType::String_1;
-                        dstInst.m_payload.m_stringIndices[0] =
-                            getStringIndex(stringLit->getStringSlice());
-                        break;
-                    }
-                case kIROp_IntLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::Int64;
-                        dstInst.m_payload.m_int64 = irConst->value.intVal;
-                        break;
-                    }
-                case kIROp_PtrLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::Int64;
-                        dstInst.m_payload.m_int64 = (intptr_t)irConst->value.ptrVal;
-                        break;
-                    }
-                case kIROp_FloatLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::Float64;
-                        dstInst.m_payload.m_float64 = irConst->value.floatVal;
-                        break;
-                    }
-                case kIROp_BoolLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::UInt32;
-                        dstInst.m_payload.m_uint32 = irConst->value.intVal ? 1 : 0;
-                        break;
-                    }
-                case kIROp_VoidLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::Empty;
-                        break;
-                    }
-                default:
-                    {
-                        SLANG_RELEASE_ASSERT(!"Unhandled constant type");
-                        return SLANG_FAIL;
-                    }
-                }
-                continue;
+                // Blobs are serialized into string table like strings
+                auto stringLit = static_cast<IRBlobLit*>(srcInst);
+                dstInst.m_payloadType = PayloadType::String_1;
+                dstInst.m_payload.m_stringIndices[0] = getStringIndex(stringLit->getStringSlice());
+                break;
             }
-
-            // ModuleInst is different, in so far as it holds a pointer to IRModule, but we don't
-            // need to save that off in a special way, so can just use regular path
-
-            const int numOperands = int(srcInst->operandCount);
-            Ser::InstIndex* dstOperands = nullptr;
-
-            if (numOperands <= Ser::Inst::kMaxOperands)
+        case kIROp_StringLit:
+            {
+                auto stringLit = static_cast<IRStringLit*>(srcInst);
+                dstInst.m_payloadType = PayloadType::String_1;
+                dstInst.m_payload.m_stringIndices[0] = getStringIndex(stringLit->getStringSlice());
+                break;
+            }
+        case kIROp_IntLit:
             {
-                // Checks the compile below is valid
-                SLANG_COMPILE_TIME_ASSERT(
-                    PayloadType(0) == PayloadType::Empty &&
-                    PayloadType(1) == PayloadType::Operand_1 &&
-                    PayloadType(2) == PayloadType::Operand_2);
-
-                dstInst.m_payloadType = PayloadType(numOperands);
-                dstOperands = dstInst.m_payload.m_operands;
+                dstInst.m_payloadType = PayloadType::Int64;
+                dstInst.m_payload.m_int64 = irConst->value.intVal;
+                break;
             }
-            else
+        case kIROp_PtrLit:
+            {
+                dstInst.m_payloadType = PayloadType::Int64;
+                dstInst.m_payload.m_int64 = (intptr_t)irConst->value.ptrVal;
+                break;
+            }
+        case kIROp_FloatLit:
+            {
+                dstInst.m_payloadType = PayloadType::Float64;
+                dstInst.m_payload.m_float64 = irConst->value.floatVal;
+                break;
+            }
+        case kIROp_BoolLit:
+            {
+                dstInst.m_payloadType = PayloadType::UInt32;
+                dstInst.m_payload.m_uint32 = irConst->value.intVal ? 1 : 0;
+                break;
+            }
+        case kIROp_VoidLit:
+            {
+                dstInst.m_payloadType = PayloadType::Empty;
+                break;
+            }
+        default:
             {
-                dstInst.m_payloadType = PayloadType::OperandExternal;
+                SLANG_RELEASE_ASSERT(!"Unhandled constant type");
+                return SLANG_FAIL;
+            }
+        }
+        return SLANG_OK;
+    }
 
-                int operandArrayBaseIndex = int(m_serialData->m_externalOperands.getCount());
-                m_serialData->m_externalOperands.setCount(operandArrayBaseIndex + numOperands);
+    // ModuleInst is different, in so far as it holds a pointer to IRModule, but we don't
+    // need to save that off in a special way, so can just use regular path
 
-                dstOperands = m_serialData->m_externalOperands.begin() + operandArrayBaseIndex;
+    const int numOperands = int(srcInst->operandCount);
+    Ser::InstIndex* dstOperands = nullptr;
 
-                auto& externalOperands = dstInst.m_payload.m_externalOperand;
-                externalOperands.m_arrayIndex = Ser::ArrayIndex(operandArrayBaseIndex);
-                externalOperands.m_size = Ser::SizeType(numOperands);
-            }
+    if (numOperands <= Ser::Inst::kMaxOperands)
+    {
+        // Checks the compile below is valid
+        SLANG_COMPILE_TIME_ASSERT(
+            PayloadType(0) == PayloadType::Empty && PayloadType(1) == PayloadType::Operand_1 &&
+            PayloadType(2) == PayloadType::Operand_2);
 
-            for (int j = 0; j < numOperands; ++j)
-            {
-                const Ser::InstIndex dstInstIndex = getInstIndex(srcInst->getOperand(j));
-                dstOperands[j] = dstInstIndex;
-            }
+        dstInst.m_payloadType = PayloadType(numOperands);
+        dstOperands = dstInst.m_payload.m_operands;
+    }
+    else
+    {
+        dstInst.m_payloadType = PayloadType::OperandExternal;
+
+        int operandArrayBaseIndex = int(ioExternalOperands.getCount());
+        ioExternalOperands.setCount(operandArrayBaseIndex + numOperands);
+
+        dstOperands = ioExternalOperands.begin() + operandArrayBaseIndex;
+
+        auto& externalOperands = dstInst.m_payload.m_externalOperand;
+        externalOperands.m_arrayIndex = Ser::ArrayIndex(operandArrayBaseIndex);
+        externalOperands.m_size = Ser::SizeType(numOperands);
+    }
+
+    for (int j = 0; j < numOperands; ++j)
+    {
+        const Ser::InstIndex dstInstIndex = getInstIndex(srcInst->getOperand(j));
+        dstOperands[j] = dstInstIndex;
+    }
+    return SLANG_OK;
+}
+
+Result IRSerialWriter::write(
+    IRModule* module,
+    SerialSourceLocWriter* sourceLocWriter,
+    SerialOptionFlags options,
+    IRSerialData* serialData)
+{
+    serialData->clear();
+
+    _addInstructions(module, serialData->m_childRuns);
+
+    // Set to the right size
+    serialData->m_insts.setCount(m_insts.getCount());
+    // Clear all instructions
+    memset(serialData->m_insts.begin(), 0, sizeof(Ser::Inst) * serialData->m_insts.getCount());
+
+    // Need to set up the actual instructions
+    {
+        const Index numInsts = m_insts.getCount();
+
+        for (Index i = 1; i < numInsts; ++i)
+        {
+            SLANG_RETURN_ON_FAIL(
+                _calcInst(m_insts[i], serialData->m_insts[i], serialData->m_externalOperands));
         }
     }
 
@@ -324,20 +336,77 @@ Result IRSerialWriter::write(
 
     if ((options & SerialOptionFlag::SourceLocation) && sourceLocWriter)
     {
-        _calcDebugInfo(sourceLocWriter);
+        _calcDebugInfo(sourceLocWriter, serialData->m_debugSourceLocRuns);
     }
 
-    m_serialData = nullptr;
     return SLANG_OK;
 }
 
+// The most bytes an instruction can be encoded in by _encodeInst. The op and the result type are
+// each encoded as a UInt32, with a byte for the payload type between them.
+static const size_t kMaxEncodedInstSize =
+    2 * size_t(ByteEncodeUtil::kMaxLiteEncodeUInt32) + 1 +
+    Math::Max(sizeof(double), size_t(2 * ByteEncodeUtil::kMaxLiteEncodeUInt32));
+
+// Encode inst with the VariableByteLite encoding, returning the end of the encoding
+static uint8_t* _encodeInst(const IRSerialData::Inst& inst, uint8_t* encodeOut)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    encodeOut += ByteEncodeUtil::encodeLiteUInt32(inst.m_op, encodeOut);
+
+    *encodeOut++ = uint8_t(inst.m_payloadType);
+
+    encodeOut += ByteEncodeUtil::encodeLiteUInt32((uint32_t)inst.m_resultTypeIndex, encodeOut);
+
+    switch (inst.m_payloadType)
+    {
+    case PayloadType::Empty:
+        {
+            break;
+        }
+    case PayloadType::Operand_1:
+    case PayloadType::String_1:
+    case PayloadType::UInt32:
+        {
+            // 1 UInt32
+            encodeOut +=
+                ByteEncodeUtil::encodeLiteUInt32((uint32_t)inst.m_payload.m_operands[0], encodeOut);
+            break;
+        }
+    case PayloadType::Operand_2:
+    case PayloadType::OperandAndUInt32:
+    case PayloadType::OperandExternal:
+    case PayloadType::String_2:
+        {
+            // 2 UInt32
+            encodeOut +=
+                ByteEncodeUtil::encodeLiteUInt32((uint32_t)inst.m_payload.m_operands[0], encodeOut);
+            encodeOut +=
+                ByteEncodeUtil::encodeLiteUInt32((uint32_t)inst.m_payload.m_operands[1], encodeOut);
+            break;
+        }
+    case PayloadType::Float64:
+        {
+            memcpy(encodeOut, &inst.m_payload.m_float64, sizeof(inst.m_payload.m_float64));
+            encodeOut += sizeof(inst.m_payload.m_float64);
+            break;
+        }
+    case PayloadType::Int64:
+        {
+            memcpy(encodeOut, &inst.m_payload.m_int64, sizeof(inst.m_payload.m_int64));
+            encodeOut += sizeof(inst.m_payload.m_int64);
+            break;
+        }
+    }
+    return encodeOut;
+}
+
 Result _encodeInsts(
     SerialCompressionType compressionType,
     const List<IRSerialData::Inst>& instsIn,
     List<uint8_t>& encodeArrayOut)
 {
-    typedef IRSerialData::Inst::PayloadType PayloadType;
-
     if (compressionType != SerialCompressionType::VariableByteLite)
     {
         return SLANG_FAIL;
@@ -351,82 +420,23 @@ Result _encodeInsts(
     uint8_t* encodeOut = encodeArrayOut.begin();
     uint8_t* encodeEnd = encodeArrayOut.end();
 
-    // Calculate the maximum instruction size with worst case possible encoding
-    // 2 bytes hold the payload size, and the result type
-    // Note that if there were some free bits, we could encode some of this stuff into bits, but if
-    // we remove payloadType, then there are no free bits
-    const size_t maxInstSize = 1 + ByteEncodeUtil::kMaxLiteEncodeUInt16 +
-                               Math::Max(
-                                   sizeof(insts->m_payload.m_float64),
-                                   size_t(2 * ByteEncodeUtil::kMaxLiteEncodeUInt32));
-
     for (size_t i = 0; i < numInsts; ++i)
     {
-        const auto& inst = insts[i];
-
         // Make sure there is space for the largest possible instruction
-        if (encodeOut + maxInstSize >= encodeEnd)
+        if (encodeOut + kMaxEncodedInstSize >= encodeEnd)
         {
             const size_t offset = size_t(encodeOut - encodeArrayOut.begin());
 
             const UInt oldCapacity = encodeArrayOut.getCapacity();
 
-            encodeArrayOut.reserve(oldCapacity + (oldCapacity >> 1) + maxInstSize);
+            encodeArrayOut.reserve(oldCapacity + (oldCapacity >> 1) + kMaxEncodedInstSize);
             const UInt capacity = encodeArrayOut.getCapacity();
             encodeArrayOut.setCount(capacity);
 
             encodeOut = encodeArrayOut.begin() + offset;
             encodeEnd = encodeArrayOut.end();
         }
-        encodeOut += ByteEncodeUtil::encodeLiteUInt32(inst.m_op, encodeOut);
-
-        *encodeOut++ = uint8_t(inst.m_payloadType);
-
-        encodeOut += ByteEncodeUtil::encodeLiteUInt32((uint32_t)inst.m_resultTypeIndex, encodeOut);
-
-        switch (inst.m_payloadType)
-        {
-        case PayloadType::Empty:
-            {
-                break;
-            }
-        case PayloadType::Operand_1:
-        case PayloadType::String_1:
-        case PayloadType::UInt32:
-            {
-                // 1 UInt32
-                encodeOut += ByteEncodeUtil::encodeLiteUInt32(
-                    (uint32_t)inst.m_payload.m_operands[0],
-                    encodeOut);
-                break;
-            }
-        case PayloadType::Operand_2:
-        case PayloadType::OperandAndUInt32:
-        case PayloadType::OperandExternal:
-        case PayloadType::String_2:
-            {
-                // 2 UInt32
-                encodeOut += ByteEncodeUtil::encodeLiteUInt32(
-                    (uint32_t)inst.m_payload.m_operands[0],
-                    encodeOut);
-                encodeOut += ByteEncodeUtil::encodeLiteUInt32(
-                    (uint32_t)inst.m_payload.m_operands[1],
-                    encodeOut);
-                break;
-            }
-        case PayloadType::Float64:
-            {
-                memcpy(encodeOut, &inst.m_payload.m_float64, sizeof(inst.m_payload.m_float64));
-                encodeOut += sizeof(inst.m_payload.m_float64);
-                break;
-            }
-        case PayloadType::Int64:
-            {
-                memcpy(encodeOut, &inst.m_payload.m_int64, sizeof(inst.m_payload.m_int64));
-                encodeOut += sizeof(inst.m_payload.m_int64);
-                break;
-            }
-        }
+        encodeOut = _encodeInst(insts[i], encodeOut);
     }
 
     // Fix the size
@@ -522,6 +532,184 @@ Result _writeInstArrayChunk(
     return SLANG_OK;
 }
 
+namespace
+{ // anonymous
+
+// Collects small writes to a container chunk, and writes them to the container in larger blocks
+struct BufferedChunkWriter
+{
+    /// Get space for up to size bytes, and then call commit with how many were used
+    uint8_t* reserve(size_t size)
+    {
+        SLANG_ASSERT(size <= kBufferSize);
+        if (m_size + size > kBufferSize)
+        {
+            flush();
+        }
+        return m_buffer + m_size;
+    }
+    void commit(size_t size) { m_size += size; }
+    void write(const void* data, size_t size)
+    {
+        memcpy(reserve(size), data, size);
+        commit(size);
+    }
+    void flush()
+    {
+        if (m_size)
+        {
+            m_container->write(m_buffer, m_size);
+            m_size = 0;
+        }
+    }
+
+    BufferedChunkWriter(RiffContainer* container)
+        : m_container(container)
+    {
+    }
+    ~BufferedChunkWriter() { flush(); }
+
+    static const size_t kBufferSize = 16 * 1024;
+
+    RiffContainer* m_container;
+    size_t m_size = 0;
+    uint8_t m_buffer[kBufferSize];
+};
+
+} // namespace
+
+Result IRSerialWriter::writeModule(
+    IRModule* module,
+    SerialSourceLocWriter* sourceLocWriter,
+    SerialOptionFlags options,
+    SerialCompressionType compressionType,
+    RiffContainer* container)
+{
+    typedef RiffContainer::Chunk Chunk;
+    typedef RiffContainer::ScopeChunk ScopeChunk;
+
+    if (compressionType != SerialCompressionType::None &&
+        compressionType != SerialCompressionType::VariableByteLite)
+    {
+        return SLANG_FAIL;
+    }
+
+    List<Ser::InstRun> childRuns;
+    _addInstructions(module, childRuns);
+
+    const Index numInsts = m_insts.getCount();
+
+    ScopeChunk scopeModule(container, Chunk::Kind::List, Bin::kIRModuleFourCc);
+
+    List<Ser::InstIndex> externalOperands;
+    List<char> stringTable;
+    Index stringCount = 0;
+
+    // Encode each instruction into the container as it is visited. The chunk is the same as
+    // written by _writeInstArrayChunk.
+    {
+        const bool isCompressed = compressionType == SerialCompressionType::VariableByteLite;
+        ScopeChunk scope(
+            container,
+            Chunk::Kind::Data,
+            isCompressed ? SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kInstFourCc) : Bin::kInstFourCc);
+
+        if (isCompressed)
+        {
+            SerialBinary::CompressedArrayHeader header;
+            header.numEntries = uint32_t(numInsts);
+            header.numCompressedEntries = 0;
+            container->write(&header, sizeof(header));
+        }
+        else
+        {
+            SerialBinary::ArrayHeader header;
+            header.numEntries = uint32_t(numInsts);
+            container->write(&header, sizeof(header));
+        }
+
+        BufferedChunkWriter writer(container);
+        for (Index i = 0; i < numInsts; ++i)
+        {
+            // 0 is null, and is written as an empty instruction
+            Ser::Inst inst;
+            memset(&inst, 0, sizeof(inst));
+            if (i > 0)
+            {
+                SLANG_RETURN_ON_FAIL(_calcInst(m_insts[i], inst, externalOperands));
+            }
+
+            if (isCompressed)
+            {
+                uint8_t* encodeStart = writer.reserve(kMaxEncodedInstSize);
+                writer.commit(size_t(_encodeInst(inst, encodeStart) - encodeStart));
+            }
+            else
+            {
+                writer.write(&inst, sizeof(inst));
+            }
+
+            // Add any strings the instruction added to the pool to the string table
+            const auto addedStrings = m_stringSlicePool.getAdded();
+            for (; stringCount < addedStrings.getCount(); ++stringCount)
+            {
+                SerialStringTableUtil::appendEncodedString(addedStrings[stringCount], stringTable);
+            }
+        }
+    }
+
+    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
+        compressionType,
+        Bin::kChildRunFourCc,
+        childRuns,
+        container));
+    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
+        compressionType,
+        Bin::kExternalOperandsFourCc,
+        externalOperands,
+        container));
+    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
+        SerialCompressionType::None,
+        SerialBinary::kStringTableFourCc,
+        stringTable,
+        container));
+
+    // If the option to use RawSourceLocations is enabled, serialize out as is
+    if (options & SerialOptionFlag::RawSourceLocation)
+    {
+        ScopeChunk scope(container, Chunk::Kind::Data, Bin::kUInt32RawSourceLocFourCc);
+
+        SerialBinary::ArrayHeader header;
+        header.numEntries = uint32_t(numInsts);
+        container->write(&header, sizeof(header));
+
+        BufferedChunkWriter writer(container);
+        for (Index i = 0; i < numInsts; ++i)
+        {
+            // 0 is null, just mark as no location
+            const Ser::RawSourceLoc loc =
+                i ? Ser::RawSourceLoc(m_insts[i]->sourceLoc.getRaw()) : Ser::RawSourceLoc(0);
+            writer.write(&loc, sizeof(loc));
+        }
+    }
+
+    if ((options & SerialOptionFlag::SourceLocation) && sourceLocWriter)
+    {
+        List<Ser::SourceLocRun> sourceLocRuns;
+        SLANG_RETURN_ON_FAIL(_calcDebugInfo(sourceLocWriter, sourceLocRuns));
+        if (sourceLocRuns.getCount())
+        {
+            SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
+                compressionType,
+                Bin::kDebugSourceLocRunFourCc,
+                sourceLocRuns,
+                container));
+        }
+    }
+
+    return SLANG_OK;
+}
+
 /* static */ void IRSerialWriter::calcInstructionList(IRModule* module, List<IRInst*>& instsOut)
 {
     // We reserve 0 for null
@@ -555,85 +743,90 @@ Result _writeInstArrayChunk(
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialReader !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-static Result _decodeInsts(
-    SerialCompressionType compressionType,
-    const uint8_t* encodeCur,
-    size_t encodeInSize,
-    List<IRSerialData::Inst>& instsOut)
+// Decode an instruction encoded by _encodeInst, returning the end of the encoding
+static const uint8_t* _decodeInst(const uint8_t* encodeCur, IRSerialData::Inst& inst)
 {
-    const uint8_t* encodeEnd = encodeCur + encodeInSize;
-
     typedef IRSerialData::Inst::PayloadType PayloadType;
 
-    if (compressionType != SerialCompressionType::VariableByteLite)
-    {
-        return SLANG_FAIL;
-    }
+    uint32_t instOp = 0;
+    encodeCur += ByteEncodeUtil::decodeLiteUInt32(encodeCur, &instOp);
+    inst.m_op = (uint16_t)instOp;
 
-    const size_t numInsts = size_t(instsOut.getCount());
-    IRSerialData::Inst* insts = instsOut.begin();
+    const PayloadType payloadType = PayloadType(*encodeCur++);
+    inst.m_payloadType = payloadType;
 
-    for (size_t i = 0; i < numInsts; ++i)
+    // Read the result value
+    encodeCur += ByteEncodeUtil::decodeLiteUInt32(encodeCur, (uint32_t*)&inst.m_resultTypeIndex);
+
+    switch (inst.m_payloadType)
     {
-        if (encodeCur >= encodeEnd)
+    case PayloadType::Empty:
         {
-            SLANG_ASSERT(!"Invalid decode");
-            return SLANG_FAIL;
+            break;
         }
+    case PayloadType::Operand_1:
+    case PayloadType::String_1:
+    case PayloadType::UInt32:
+        {
+            // 1 UInt32
+            encodeCur += ByteEncodeUtil::decodeLiteUInt32(
+                encodeCur,
+                (uint32_t*)&inst.m_payload.m_operands[0]);
+            break;
+        }
+    case PayloadType::Operand_2:
+    case PayloadType::OperandAndUInt32:
+    case PayloadType::OperandExternal:
+    case PayloadType::String_2:
+        {
+            // 2 UInt32
+            encodeCur += ByteEncodeUtil::decodeLiteUInt32(
+                encodeCur,
+                2,
+                (uint32_t*)&inst.m_payload.m_operands[0]);
+            break;
+        }
+    case PayloadType::Float64:
+        {
+            memcpy(&inst.m_payload.m_float64, encodeCur, sizeof(inst.m_payload.m_float64));
+            encodeCur += sizeof(inst.m_payload.m_float64);
+            break;
+        }
+    case PayloadType::Int64:
+        {
+            memcpy(&inst.m_payload.m_int64, encodeCur, sizeof(inst.m_payload.m_int64));
+            encodeCur += sizeof(inst.m_payload.m_int64);
+            break;
+        }
+    }
+    return encodeCur;
+}
+
+static Result _decodeInsts(
+    SerialCompressionType compressionType,
+    const uint8_t* encodeCur,
+    size_t encodeInSize,
+    List<IRSerialData::Inst>& instsOut)
+{
+    const uint8_t* encodeEnd = encodeCur + encodeInSize;
+
+    if (compressionType != SerialCompressionType::VariableByteLite)
+    {
+        return SLANG_FAIL;
+    }
 
-        auto& inst = insts[i];
-        uint32_t instOp = 0;
-        encodeCur += ByteEncodeUtil::decodeLiteUInt32(encodeCur, &instOp);
-        inst.m_op = (uint16_t)instOp;
-
-        const PayloadType payloadType = PayloadType(*encodeCur++);
-        inst.m_payloadType = payloadType;
-
-        // Read the result value
-        encodeCur +=
-            ByteEncodeUtil::decodeLiteUInt32(encodeCur, (uint32_t*)&inst.m_resultTypeIndex);
-
-        switch (inst.m_payloadType)
+    const size_t numInsts = size_t(instsOut.getCount());
+    IRSerialData::Inst* insts = instsOut.begin();
+
+    for (size_t i = 0; i < numInsts; ++i)
+    {
+        if (encodeCur >= encodeEnd)
         {
-        case PayloadType::Empty:
-            {
-                break;
-            }
-        case PayloadType::Operand_1:
-        case PayloadType::String_1:
-        case PayloadType::UInt32:
-            {
-                // 1 UInt32
-                encodeCur += ByteEncodeUtil::decodeLiteUInt32(
-                    encodeCur,
-                    (uint32_t*)&inst.m_payload.m_operands[0]);
-                break;
-            }
-        case PayloadType::Operand_2:
-        case PayloadType::OperandAndUInt32:
-        case PayloadType::OperandExternal:
-        case PayloadType::String_2:
-            {
-                // 2 UInt32
-                encodeCur += ByteEncodeUtil::decodeLiteUInt32(
-                    encodeCur,
-                    2,
-                    (uint32_t*)&inst.m_payload.m_operands[0]);
-                break;
-            }
-        case PayloadType::Float64:
-            {
-                memcpy(&inst.m_payload.m_float64, encodeCur, sizeof(inst.m_payload.m_float64));
-                encodeCur += sizeof(inst.m_payload.m_float64);
-                break;
-            }
-        case PayloadType::Int64:
-            {
-                memcpy(&inst.m_payload.m_int64, encodeCur, sizeof(inst.m_payload.m_int64));
-                encodeCur += sizeof(inst.m_payload.m_int64);
-                break;
-            }
+            SLANG_ASSERT(!"Invalid decode");
+            return SLANG_FAIL;
         }
+
+        encodeCur = _decodeInst(encodeCur, insts[i]);
     }
 
     return SLANG_OK;
@@ -755,26 +948,269 @@ static Result _readInstArrayChunk(
     return SLANG_OK;
 }
 
+IRInst* IRSerialReader::_createInst(const Ser::Inst& srcInst)
+{
+    // Only used in debug builds
+    [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
+
+    IRModule* module = m_module;
+    const IROp op((IROp)srcInst.m_op);
+
+    if (!_isConstant(op))
+    {
+        return module->_allocateInst(op, srcInst.getNumOperands());
+    }
+
+    // Handling of constants
+
+    // Calculate the minimum object size (ie not including the payload of value)
+    const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+    // All IR constants have zero operands.
+    Int operandCount = 0;
+
+    IRConstant* irConst = nullptr;
+    switch (op)
+    {
+    case kIROp_BoolLit:
+        {
+            // TODO: Most of these cases could use the templated `_allocateInst<T>`
+            // *if* we had distinct `IRConstant` subtypes to represent these
+            // cases and their subtype-specific payloads.
+
+            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
+            irConst = static_cast<IRConstant*>(
+                module->_allocateInst(op, operandCount, prefixSize + sizeof(IRIntegerValue)));
+            irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
+            break;
+        }
+    case kIROp_IntLit:
+        {
+            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+            irConst = static_cast<IRConstant*>(
+                module->_allocateInst(op, operandCount, prefixSize + sizeof(IRIntegerValue)));
+            irConst->value.intVal = srcInst.m_payload.m_int64;
+            break;
+        }
+    case kIROp_PtrLit:
+        {
+            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+            irConst = static_cast<IRConstant*>(
+                module->_allocateInst(op, operandCount, prefixSize + sizeof(void*)));
+            irConst->value.ptrVal = (void*)(intptr_t)srcInst.m_payload.m_int64;
+            break;
+        }
+    case kIROp_FloatLit:
+        {
+            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
+            irConst = static_cast<IRConstant*>(module->_allocateInst(
+                op,
+                operandCount,
+                prefixSize + sizeof(IRFloatingPointValue)));
+            irConst->value.floatVal = srcInst.m_payload.m_float64;
+            break;
+        }
+    case kIROp_VoidLit:
+        {
+            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
+            irConst =
+                static_cast<IRConstant*>(module->_allocateInst(op, operandCount, prefixSize));
+            break;
+        }
+    case kIROp_BlobLit:
+    case kIROp_StringLit:
+        {
+            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+
+            const Index stringIndex = Index(srcInst.m_payload.m_stringIndices[0]);
+            if (stringIndex < 0 || stringIndex >= m_stringSlices.getCount())
+            {
+                return nullptr;
+            }
+            const UnownedStringSlice slice = m_stringSlices[stringIndex];
+
+            const size_t sliceSize = slice.getLength();
+            const size_t instSize =
+                prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+
+            irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, instSize));
+
+            IRConstant::StringValue& dstString = irConst->value.stringVal;
+
+            dstString.numChars = uint32_t(sliceSize);
+            // Turn into pointer to avoid warning of array overrun
+            char* dstChars = dstString.chars;
+            // Copy the chars
+            memcpy(dstChars, slice.begin(), sliceSize);
+            break;
+        }
+    default:
+        {
+            SLANG_ASSERT(!"Unknown constant type");
+            return nullptr;
+        }
+    }
+
+    return irConst;
+}
+
+Result IRSerialReader::_initInst(
+    IRInst* dstInst,
+    const Ser::Inst& srcInst,
+    ConstArrayView<Ser::InstIndex> externalOperands,
+    const List<IRInst*>& insts)
+{
+    const Index numInsts = insts.getCount();
+
+    // Set the result type
+    if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
+    {
+        const Index resultIndex = Index(srcInst.m_resultTypeIndex);
+        if (resultIndex >= numInsts)
+        {
+            return SLANG_FAIL;
+        }
+        IRInst* resultInst = insts[resultIndex];
+        // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example
+        // IRGlobalGenericParam is valid, but isn't IRType* derived
+
+        // SLANG_RELEASE_ASSERT(as<IRType>(resultInst));
+        dstInst->setFullType(static_cast<IRType*>(resultInst));
+    }
+
+    if (_isConstant(IROp(srcInst.m_op)))
+    {
+        return SLANG_OK;
+    }
+
+    const Ser::InstIndex* srcOperandIndices = srcInst.m_payload.m_operands;
+    Index numOperands = Index(Ser::s_payloadInfos[int(srcInst.m_payloadType)].m_numOperands);
+    if (srcInst.m_payloadType == Ser::Inst::PayloadType::OperandExternal)
+    {
+        const Index arrayIndex = Index(srcInst.m_payload.m_externalOperand.m_arrayIndex);
+        numOperands = Index(srcInst.m_payload.m_externalOperand.m_size);
+        if (arrayIndex + numOperands > externalOperands.getCount())
+        {
+            return SLANG_FAIL;
+        }
+        srcOperandIndices = externalOperands.getBuffer() + arrayIndex;
+    }
+
+    auto dstOperands = dstInst->getOperands();
+    for (Index j = 0; j < numOperands; j++)
+    {
+        const Index operandIndex = Index(srcOperandIndices[j]);
+        if (operandIndex >= numInsts)
+        {
+            return SLANG_FAIL;
+        }
+        dstOperands[j].init(dstInst, insts[operandIndex]);
+    }
+    return SLANG_OK;
+}
+
+static Result _addChildren(ConstArrayView<IRSerialData::InstRun> childRuns, List<IRInst*>& insts)
+{
+    for (const auto& run : childRuns)
+    {
+        const Index parentIndex = Index(run.m_parentIndex);
+        const Index startIndex = Index(run.m_startInstIndex);
+        if (parentIndex >= insts.getCount() ||
+            startIndex + Index(run.m_numChildren) > insts.getCount())
+        {
+            return SLANG_FAIL;
+        }
+
+        IRInst* inst = insts[parentIndex];
+        for (Index j = 0; j < Index(run.m_numChildren); ++j)
+        {
+            IRInst* child = insts[startIndex + j];
+            SLANG_ASSERT(child->parent == nullptr);
+            child->insertAtEnd(inst);
+        }
+    }
+    return SLANG_OK;
+}
+
+void IRSerialReader::_applySourceLocRuns(
+    ConstArrayView<Ser::SourceLocRun> sourceLocRuns,
+    SerialSourceLocReader* sourceLocReader,
+    const List<IRInst*>& insts)
+{
+    List<IRSerialData::SourceLocRun> sourceRuns;
+    sourceRuns.addRange(sourceLocRuns.getBuffer(), sourceLocRuns.getCount());
+    // They are now in source location order
+    sourceRuns.sort();
+
+    // Just guess initially 0 for the source file that contains the initial run
+    SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
+    int fix = 0;
+
+    const Index numRuns = sourceRuns.getCount();
+    for (Index i = 0; i < numRuns; ++i)
+    {
+        const auto& run = sourceRuns[i];
+
+        // Work out the fixed source location
+        SourceLoc sourceLoc;
+        if (run.m_sourceLoc)
+        {
+            if (!range.contains(run.m_sourceLoc))
+            {
+                fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+            }
+            sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
+        }
+
+        // Write to all the instructions
+        SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
+        IRInst* const* dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
+
+        const int runSize = int(run.m_numInst);
+        for (int j = 0; j < runSize; ++j)
+        {
+            dstInsts[j]->sourceLoc = sourceLoc;
+        }
+    }
+}
+
+void IRSerialReader::_keepSourceLocRuns(
+    ConstArrayView<Ser::SourceLocRun> sourceLocRuns,
+    List<IRInst*>& insts)
+{
+    m_pendingSourceLocRuns.clear();
+    m_pendingSourceLocRuns.addRange(sourceLocRuns.getBuffer(), sourceLocRuns.getCount());
+    m_pendingInsts.swapWith(insts);
+}
+
+void IRSerialReader::applySourceLocs(SerialSourceLocReader* sourceLocReader)
+{
+    if (sourceLocReader && m_pendingSourceLocRuns.getCount())
+    {
+        _applySourceLocRuns(
+            m_pendingSourceLocRuns.getArrayView(),
+            sourceLocReader,
+            m_pendingInsts);
+    }
+    m_pendingSourceLocRuns.clear();
+    m_pendingInsts.clear();
+}
+
 Result IRSerialReader::read(
     const IRSerialData& data,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
     RefPtr<IRModule>& outModule)
 {
-    // Only used in debug builds
-    [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
-
-    m_serialData = &data;
-
     auto module = IRModule::create(session);
     outModule = module;
     m_module = module;
 
-    // Convert m_stringTable into StringSlicePool.
+    // Convert m_stringTable into slices, indexed by StringIndex.
     SerialStringTableUtil::decodeStringTable(
         data.m_stringTable.getBuffer(),
         data.m_stringTable.getCount(),
-        m_stringTable);
+        m_stringSlices);
 
     // Each IR instruction has:
     //
@@ -814,239 +1250,311 @@ Result IRSerialReader::read(
 
     const Index numInsts = data.m_insts.getCount();
 
-    SLANG_ASSERT(numInsts > 0);
+    if (numInsts < 2 || data.m_insts[1].m_op != kIROp_Module)
+    {
+        return SLANG_FAIL;
+    }
 
     insts.setCount(numInsts);
     insts[0] = nullptr;
 
     // 0 holds null
-    // 1 holds the IRModuleInst
+    // 1 holds the IRModuleInst. The root IR instruction for the module will already have
+    // been created as part of creating `module` above.
+    insts[1] = module->getModuleInst();
+
+    for (Index i = 2; i < numInsts; ++i)
     {
-        // Check that insts[1] is the module inst
-        const Ser::Inst& srcInst = data.m_insts[1];
-        SLANG_RELEASE_ASSERT(srcInst.m_op == kIROp_Module);
-        SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
-
-        // The root IR instruction for the module will already have
-        // been created as part of creating `module` above.
-        //
-        auto moduleInst = module->getModuleInst();
-
-        // Set the IRModuleInst
-        insts[1] = moduleInst;
+        insts[i] = _createInst(data.m_insts[i]);
+        if (!insts[i])
+        {
+            return SLANG_FAIL;
+        }
     }
 
-    for (Index i = 2; i < numInsts; ++i)
+    // Patch up the operands
+    for (Index i = 1; i < numInsts; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
+        SLANG_RETURN_ON_FAIL(
+            _initInst(insts[i], data.m_insts[i], data.m_externalOperands.getArrayView(), insts));
+    }
 
-        const IROp op((IROp)srcInst.m_op);
+    // Patch up the children
+    SLANG_RETURN_ON_FAIL(_addChildren(data.m_childRuns.getArrayView(), insts));
 
-        if (_isConstant(op))
+    // Re-add source locations, if they are defined
+    if (data.m_rawSourceLocs.getCount() == numInsts)
+    {
+        const Ser::RawSourceLoc* srcLocs = data.m_rawSourceLocs.begin();
+        for (Index i = 1; i < numInsts; ++i)
         {
-            // Handling of constants
+            IRInst* dstInst = insts[i];
 
-            // Calculate the minimum object size (ie not including the payload of value)
-            const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+            dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+        }
+    }
 
-            // All IR constants have zero operands.
-            Int operandCount = 0;
+    // We now need to apply the runs
+    if (sourceLocReader && data.m_debugSourceLocRuns.getCount())
+    {
+        _applySourceLocRuns(data.m_debugSourceLocRuns.getArrayView(), sourceLocReader, insts);
+    }
+    else if (data.m_debugSourceLocRuns.getCount())
+    {
+        _keepSourceLocRuns(data.m_debugSourceLocRuns.getArrayView(), insts);
+    }
 
-            IRConstant* irConst = nullptr;
-            switch (op)
-            {
-            case kIROp_BoolLit:
-                {
-                    // TODO: Most of these cases could use the templated `_allocateInst<T>`
-                    // *if* we had distinct `IRConstant` subtypes to represent these
-                    // cases and their subtype-specific payloads.
-
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(
-                        op,
-                        operandCount,
-                        prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
-                    break;
-                }
-            case kIROp_IntLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(
-                        op,
-                        operandCount,
-                        prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_int64;
-                    break;
-                }
-            case kIROp_PtrLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(
-                        module->_allocateInst(op, operandCount, prefixSize + sizeof(void*)));
-                    irConst->value.ptrVal = (void*)(intptr_t)srcInst.m_payload.m_int64;
-                    break;
-                }
-            case kIROp_FloatLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(
-                        op,
-                        operandCount,
-                        prefixSize + sizeof(IRFloatingPointValue)));
-                    irConst->value.floatVal = srcInst.m_payload.m_float64;
-                    break;
-                }
-            case kIROp_VoidLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
-                    irConst = static_cast<IRConstant*>(
-                        module->_allocateInst(op, operandCount, prefixSize));
-                    break;
-                }
-            case kIROp_BlobLit:
-            case kIROp_StringLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+    return SLANG_OK;
+}
 
-                    const UnownedStringSlice slice = m_stringTable.getSlice(
-                        StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
+namespace
+{ // anonymous
 
-                    const size_t sliceSize = slice.getLength();
-                    const size_t instSize =
-                        prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+// Reads the instructions of an instruction chunk one at a time, in either of the ways the chunk
+// can be written
+struct InstChunkReader
+{
+    Result init(SerialCompressionType containerCompressionType, RiffContainer::DataChunk* chunk)
+    {
+        RiffReadHelper read = chunk->asReadHelper();
 
-                    irConst =
-                        static_cast<IRConstant*>(module->_allocateInst(op, operandCount, instSize));
+        m_isCompressed = chunk->m_fourCC == SLANG_MAKE_COMPRESSED_FOUR_CC(chunk->m_fourCC);
+        if (m_isCompressed)
+        {
+            if (containerCompressionType != SerialCompressionType::VariableByteLite)
+            {
+                return SLANG_FAIL;
+            }
+            SerialBinary::CompressedArrayHeader header;
+            SLANG_RETURN_ON_FAIL(read.read(header));
+            m_count = Index(header.numEntries);
+        }
+        else
+        {
+            SerialBinary::ArrayHeader header;
+            SLANG_RETURN_ON_FAIL(read.read(header));
+            m_count = Index(header.numEntries);
+            if (read.getRemainingSize() != m_count * sizeof(IRSerialData::Inst))
+            {
+                return SLANG_FAIL;
+            }
+        }
 
-                    IRConstant::StringValue& dstString = irConst->value.stringVal;
+        m_start = read.getData();
+        m_end = m_start + read.getRemainingSize();
+        m_cur = m_start;
+        return SLANG_OK;
+    }
 
-                    dstString.numChars = uint32_t(sliceSize);
-                    // Turn into pointer to avoid warning of array overrun
-                    char* dstChars = dstString.chars;
-                    // Copy the chars
-                    memcpy(dstChars, slice.begin(), sliceSize);
-                    break;
-                }
-            default:
-                {
-                    SLANG_ASSERT(!"Unknown constant type");
-                    return SLANG_FAIL;
-                }
-            }
+    /// Start reading from the first instruction again
+    void reset() { m_cur = m_start; }
 
-            insts[i] = irConst;
+    Result next(IRSerialData::Inst& outInst)
+    {
+        if (m_cur >= m_end)
+        {
+            return SLANG_FAIL;
+        }
+        memset(&outInst, 0, sizeof(outInst));
+        if (m_isCompressed)
+        {
+            m_cur = _decodeInst(m_cur, outInst);
         }
         else
         {
-            int numOperands = srcInst.getNumOperands();
-            insts[i] = module->_allocateInst(op, numOperands);
+            memcpy(&outInst, m_cur, sizeof(outInst));
+            m_cur += sizeof(outInst);
         }
+        return m_cur <= m_end &&
+                       outInst.m_payloadType < IRSerialData::Inst::PayloadType::CountOf
+                   ? SLANG_OK
+                   : SLANG_FAIL;
     }
 
-    // Patch up the operands
-    for (Index i = 1; i < numInsts; ++i)
-    {
-        const Ser::Inst& srcInst = data.m_insts[i];
-        const IROp op((IROp)srcInst.m_op);
-        SLANG_UNUSED(op);
+    bool m_isCompressed = false;
+    Index m_count = 0;
+    const uint8_t* m_start = nullptr;
+    const uint8_t* m_cur = nullptr;
+    const uint8_t* m_end = nullptr;
+};
 
-        IRInst* dstInst = insts[i];
+} // namespace
 
-        // Set the result type
-        if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
-        {
-            IRInst* resultInst = insts[int(srcInst.m_resultTypeIndex)];
-            // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example
-            // IRGlobalGenericParam is valid, but isn't IRType* derived
+Result IRSerialReader::readModule(
+    RiffContainer::ListChunk* moduleChunk,
+    SerialCompressionType containerCompressionType,
+    Session* session,
+    SerialSourceLocReader* sourceLocReader,
+    RefPtr<IRModule>& outModule)
+{
+    typedef IRSerialBinary Bin;
 
-            // SLANG_RELEASE_ASSERT(as<IRType>(resultInst));
-            dstInst->setFullType(static_cast<IRType*>(resultInst));
-        }
+    // Find the chunks. Only the small arrays are read into lists, the instructions and the
+    // strings are read from where they are in the container.
+    RiffContainer::DataChunk* instChunk = nullptr;
+    RiffContainer::DataChunk* rawSourceLocChunk = nullptr;
+    List<Ser::InstRun> childRuns;
+    List<Ser::InstIndex> externalOperands;
+    List<Ser::SourceLocRun> debugSourceLocRuns;
 
-        // if (!isParentDerived(op))
-        {
-            const Ser::InstIndex* srcOperandIndices;
-            const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
+    m_stringSlices.clear();
+    SerialStringTableUtil::decodeStringTable(nullptr, 0, m_stringSlices);
 
-            auto dstOperands = dstInst->getOperands();
+    for (RiffContainer::Chunk* chunk = moduleChunk->m_containedChunks; chunk;
+         chunk = chunk->m_next)
+    {
+        RiffContainer::DataChunk* dataChunk = as<RiffContainer::DataChunk>(chunk);
+        if (!dataChunk)
+        {
+            continue;
+        }
 
-            for (int j = 0; j < numOperands; j++)
+        switch (dataChunk->m_fourCC)
+        {
+        case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kInstFourCc):
+        case Bin::kInstFourCc:
             {
-                dstOperands[j].init(dstInst, insts[int(srcOperandIndices[j])]);
+                instChunk = dataChunk;
+                break;
+            }
+        case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kChildRunFourCc):
+        case Bin::kChildRunFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(
+                    containerCompressionType,
+                    dataChunk,
+                    childRuns));
+                break;
+            }
+        case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kExternalOperandsFourCc):
+        case Bin::kExternalOperandsFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(
+                    containerCompressionType,
+                    dataChunk,
+                    externalOperands));
+                break;
+            }
+        case SerialBinary::kStringTableFourCc:
+            {
+                RiffReadHelper read = dataChunk->asReadHelper();
+                SerialBinary::ArrayHeader header;
+                SLANG_RETURN_ON_FAIL(read.read(header));
+                if (read.getRemainingSize() < header.numEntries)
+                {
+                    return SLANG_FAIL;
+                }
+                SerialStringTableUtil::appendDecodedStringTable(
+                    (const char*)read.getData(),
+                    header.numEntries,
+                    m_stringSlices);
+                break;
+            }
+        case Bin::kUInt32RawSourceLocFourCc:
+            {
+                rawSourceLocChunk = dataChunk;
+                break;
+            }
+        case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugSourceLocRunFourCc):
+        case Bin::kDebugSourceLocRunFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(
+                    containerCompressionType,
+                    dataChunk,
+                    debugSourceLocRuns));
+                break;
+            }
+        default:
+            {
+                break;
             }
         }
     }
 
-    // Patch up the children
+    if (!instChunk)
     {
-        const Index numChildRuns = data.m_childRuns.getCount();
-        for (Index i = 0; i < numChildRuns; i++)
-        {
-            const auto& run = data.m_childRuns[i];
+        return SLANG_FAIL;
+    }
 
-            IRInst* inst = insts[int(run.m_parentIndex)];
+    InstChunkReader instReader;
+    SLANG_RETURN_ON_FAIL(instReader.init(containerCompressionType, instChunk));
 
-            for (int j = 0; j < int(run.m_numChildren); ++j)
-            {
-                IRInst* child = insts[j + int(run.m_startInstIndex)];
-                SLANG_ASSERT(child->parent == nullptr);
-                child->insertAtEnd(inst);
-            }
-        }
+    const Index numInsts = instReader.m_count;
+
+    // Skip the null instruction, and check the next is the module
+    Ser::Inst srcInst;
+    SLANG_RETURN_ON_FAIL(instReader.next(srcInst));
+    SLANG_RETURN_ON_FAIL(instReader.next(srcInst));
+    if (numInsts < 2 || srcInst.m_op != kIROp_Module)
+    {
+        return SLANG_FAIL;
     }
 
-    // Re-add source locations, if they are defined
-    if (m_serialData->m_rawSourceLocs.getCount() == numInsts)
+    auto module = IRModule::create(session);
+    outModule = module;
+    m_module = module;
+
+    // As in `read`, all the instructions are created first, and then their operands and
+    // children are set in later passes, so that instructions can refer to instructions later
+    // in the stream. Rather than keep the decoded instructions, they are decoded again for
+    // the second pass.
+    List<IRInst*> insts;
+    insts.setCount(numInsts);
+    insts[0] = nullptr;
+    insts[1] = module->getModuleInst();
+
+    for (Index i = 2; i < numInsts; ++i)
     {
-        const Ser::RawSourceLoc* srcLocs = m_serialData->m_rawSourceLocs.begin();
-        for (Index i = 1; i < numInsts; ++i)
+        SLANG_RETURN_ON_FAIL(instReader.next(srcInst));
+        insts[i] = _createInst(srcInst);
+        if (!insts[i])
         {
-            IRInst* dstInst = insts[i];
-
-            dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+            return SLANG_FAIL;
         }
     }
 
-    // We now need to apply the runs
-    if (sourceLocReader && m_serialData->m_debugSourceLocRuns.getCount())
+    // Patch up the operands
+    instReader.reset();
+    SLANG_RETURN_ON_FAIL(instReader.next(srcInst));
+    for (Index i = 1; i < numInsts; ++i)
     {
-        List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
-        // They are now in source location order
-        sourceRuns.sort();
+        SLANG_RETURN_ON_FAIL(instReader.next(srcInst));
+        SLANG_RETURN_ON_FAIL(
+            _initInst(insts[i], srcInst, externalOperands.getArrayView(), insts));
+    }
 
-        // Just guess initially 0 for the source file that contains the initial run
-        SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
-        int fix = 0;
+    // Patch up the children
+    SLANG_RETURN_ON_FAIL(_addChildren(childRuns.getArrayView(), insts));
 
-        const Index numRuns = sourceRuns.getCount();
-        for (Index i = 0; i < numRuns; ++i)
+    // Re-add source locations, if they are defined
+    if (rawSourceLocChunk)
+    {
+        RiffReadHelper read = rawSourceLocChunk->asReadHelper();
+        SerialBinary::ArrayHeader header;
+        SLANG_RETURN_ON_FAIL(read.read(header));
+        if (Index(header.numEntries) == numInsts &&
+            read.getRemainingSize() == numInsts * sizeof(Ser::RawSourceLoc))
         {
-            const auto& run = sourceRuns[i];
-
-            // Work out the fixed source location
-            SourceLoc sourceLoc;
-            if (run.m_sourceLoc)
-            {
-                if (!range.contains(run.m_sourceLoc))
-                {
-                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
-                }
-                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
-            }
-
-            // Write to all the instructions
-            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
-            IRInst** dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
-
-            const int runSize = int(run.m_numInst);
-            for (int j = 0; j < runSize; ++j)
+            const uint8_t* srcLocs = read.getData();
+            for (Index i = 1; i < numInsts; ++i)
             {
-                dstInsts[j]->sourceLoc = sourceLoc;
+                Ser::RawSourceLoc srcLoc;
+                memcpy(&srcLoc, srcLocs + i * sizeof(srcLoc), sizeof(srcLoc));
+                insts[i]->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLoc));
             }
         }
     }
 
+    // We now need to apply the runs
+    if (sourceLocReader && debugSourceLocRuns.getCount())
+    {
+        _applySourceLocRuns(debugSourceLocRuns.getArrayView(), sourceLocReader, insts);
+    }
+    else if (debugSourceLocRuns.getCount())
+    {
+        _keepSourceLocRuns(debugSourceLocRuns.getArrayView(), insts);
+    }
+
     return SLANG_OK;
 }
 
@@ -31,6 +31,17 @@ struct IRSerialWriter
         SerialCompressionType compressionType,
         RiffContainer* container);
 
+    /// Write a module to a container, in the same format as `write` followed by
+    /// `writeContainer`. The instructions are encoded into the container as they are visited,
+    /// and strings are added to the string table as they are found, so the module is never held
+    /// as IRSerialData.
+    Result writeModule(
+        IRModule* module,
+        SerialSourceLocWriter* sourceLocWriter,
+        SerialOptionFlags flags,
+        SerialCompressionType compressionType,
+        RiffContainer* container);
+
     /// Get an instruction index from an instruction
     Ser::InstIndex getInstIndex(IRInst* inst) const
     {
@@ -67,7 +78,7 @@ struct IRSerialWriter
     StringSlicePool& getStringPool() { return m_stringSlicePool; }
 
     IRSerialWriter()
-        : m_serialData(nullptr), m_stringSlicePool(StringSlicePool::Style::Default)
+        : m_stringSlicePool(StringSlicePool::Style::Default)
     {
     }
 
@@ -76,7 +87,16 @@ struct IRSerialWriter
 
 protected:
     void _addInstruction(IRInst* inst);
-    Result _calcDebugInfo(SerialSourceLocWriter* sourceLocWriter);
+    /// Add all of the instructions of the module in the order they are serialized
+    void _addInstructions(IRModule* module, List<Ser::InstRun>& outChildRuns);
+    /// Set outInst to the serialized form of srcInst
+    Result _calcInst(
+        IRInst* srcInst,
+        Ser::Inst& outInst,
+        List<Ser::InstIndex>& ioExternalOperands);
+    Result _calcDebugInfo(
+        SerialSourceLocWriter* sourceLocWriter,
+        List<Ser::SourceLocRun>& outSourceLocRuns);
 
     List<IRInst*> m_insts; ///< Instructions in same order as stored in the
 
@@ -88,7 +108,6 @@ protected:
     Dictionary<IRInst*, Ser::InstIndex> m_instMap; ///< Map an instruction to an instruction index
 
     StringSlicePool m_stringSlicePool;
-    IRSerialData* m_serialData; ///< Where the data is stored
 };
 
 struct IRSerialReader
@@ -108,15 +127,53 @@ struct IRSerialReader
         SerialSourceLocReader* sourceLocReader,
         RefPtr<IRModule>& outModule);
 
+    /// Read a module from a container, as written by `IRSerialWriter::writeContainer` or
+    /// `IRSerialWriter::writeModule`. The instructions are decoded straight from the container,
+    /// so the module is never held as IRSerialData.
+    Result readModule(
+        RiffContainer::ListChunk* module,
+        SerialCompressionType containerCompressionType,
+        Session* session,
+        SerialSourceLocReader* sourceLocReader,
+        RefPtr<IRModule>& outModule);
+
+    /// Apply the debug source locations of a module read without a sourceLocReader. Reading
+    /// the module only needs the session pointer, so can be done on another thread, whereas
+    /// the sourceLocReader uses the source manager.
+    void applySourceLocs(SerialSourceLocReader* sourceLocReader);
+
     IRSerialReader()
-        : m_serialData(nullptr), m_module(nullptr), m_stringTable(StringSlicePool::Style::Default)
+        : m_module(nullptr)
     {
     }
 
 protected:
-    StringSlicePool m_stringTable;
+    /// Create the instruction for srcInst. Constants are complete, other instructions have
+    /// their operands and type set by _initInst.
+    IRInst* _createInst(const Ser::Inst& srcInst);
+    Result _initInst(
+        IRInst* dstInst,
+        const Ser::Inst& srcInst,
+        ConstArrayView<Ser::InstIndex> externalOperands,
+        const List<IRInst*>& insts);
+    void _applySourceLocRuns(
+        ConstArrayView<Ser::SourceLocRun> sourceLocRuns,
+        SerialSourceLocReader* sourceLocReader,
+        const List<IRInst*>& insts);
+
+    /// Keep the debug source locations of a module read without a sourceLocReader, for
+    /// applySourceLocs
+    void _keepSourceLocRuns(
+        ConstArrayView<Ser::SourceLocRun> sourceLocRuns,
+        List<IRInst*>& insts);
+
+    /// The strings, indexed by Ser::StringIndex
+    List<UnownedStringSlice> m_stringSlices;
+
+    /// The debug source locations not yet applied, and the instructions they index
+    List<Ser::SourceLocRun> m_pendingSourceLocRuns;
+    List<IRInst*> m_pendingInsts;
 
-    const IRSerialData* m_serialData;
     IRModule* m_module;
 };
 
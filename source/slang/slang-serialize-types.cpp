@@ -45,26 +45,33 @@ struct ByteReader
     stringTable.clear();
     for (const auto& slice : slices)
     {
-        // TODO(JS):
-        // This is a bit of a hack. We need to store the string length, along with the string
-        // contents. We don't want to write the size as (say) uint32, because most strings are
-        // short. So we just save off the length as a utf8 encoding. As it stands this *does* have
-        // an arguable problem because encoding isn't of the full 32 bits.
-        const int len = int(slice.getLength());
+        appendEncodedString(slice, stringTable);
+    }
+}
+
+/* static */ void SerialStringTableUtil::appendEncodedString(
+    const UnownedStringSlice& slice,
+    List<char>& stringTable)
+{
+    // TODO(JS):
+    // This is a bit of a hack. We need to store the string length, along with the string
+    // contents. We don't want to write the size as (say) uint32, because most strings are
+    // short. So we just save off the length as a utf8 encoding. As it stands this *does* have
+    // an arguable problem because encoding isn't of the full 32 bits.
+    const int len = int(slice.getLength());
 
-        // We need to write into the the string array
-        char prefixBytes[6];
-        const int numPrefixBytes = encodeUnicodePointToUTF8(len, prefixBytes);
-        const Index baseIndex = stringTable.getCount();
+    // We need to write into the the string array
+    char prefixBytes[6];
+    const int numPrefixBytes = encodeUnicodePointToUTF8(len, prefixBytes);
+    const Index baseIndex = stringTable.getCount();
 
-        auto newCount = baseIndex + numPrefixBytes + len;
-        stringTable.growToCount(newCount);
+    auto newCount = baseIndex + numPrefixBytes + len;
+    stringTable.growToCount(newCount);
 
-        char* dst = stringTable.begin() + baseIndex;
+    char* dst = stringTable.begin() + baseIndex;
 
-        memcpy(dst, prefixBytes, numPrefixBytes);
-        memcpy(dst + numPrefixBytes, slice.begin(), len);
-    }
+    memcpy(dst, prefixBytes, numPrefixBytes);
+    memcpy(dst + numPrefixBytes, slice.begin(), len);
 }
 
 /* static */ void SerialStringTableUtil::appendDecodedStringTable(
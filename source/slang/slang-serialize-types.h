@@ -69,6 +69,8 @@ struct SerialStringTableUtil
     static void encodeStringTable(
         const ConstArrayView<UnownedStringSlice>& slices,
         List<char>& stringTable);
+    /// Append a single string to a string table, encoded the same as by encodeStringTable
+    static void appendEncodedString(const UnownedStringSlice& slice, List<char>& stringTable);
 
     /// Appends the decoded strings into slicesOut
     static void appendDecodedStringTable(
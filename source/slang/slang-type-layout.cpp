@@ -2322,6 +2322,8 @@ TypeLayoutContext getInitialLayoutContextForTarget(
         context.rules = rulesFamily->getConstantBufferRules(targetReq->getOptionSet(), nullptr);
     }
 
+    context.targetIdentity = TypeLayoutCache::getTargetIdentity(targetReq);
+
     return context;
 }
 
@@ -4582,6 +4584,263 @@ static TypeLayoutResult _updateLayout(
     return result;
 }
 
+//
+// TypeLayoutCache
+//
+
+static bool _isConstantIntVal(IntVal* val)
+{
+    return as<ConstantIntVal>(val) != nullptr;
+}
+
+bool TypeLayoutCache::isCacheable(ASTBuilder* astBuilder, Type* type)
+{
+    Index lowestInProgressDepth = 0;
+    return _isCacheable(astBuilder, type, lowestInProgressDepth);
+}
+
+bool TypeLayoutCache::_isCacheable(
+    ASTBuilder* astBuilder,
+    Type* type,
+    Index& ioLowestInProgressDepth)
+{
+    if (auto isCacheablePtr = m_isCacheable.tryGetValue(type))
+    {
+        return isCacheablePtr->isCacheable;
+    }
+
+    // An (invalid) recursive type reaches a type that is still being worked out. It is assumed
+    // not to be cacheable so that we terminate, but that is only provisional for the types in
+    // between, so they aren't memoized.
+    if (auto depthPtr = m_inProgressDepths.tryGetValue(type))
+    {
+        ioLowestInProgressDepth = Math::Min(ioLowestInProgressDepth, *depthPtr);
+        return false;
+    }
+
+    const Index depth = m_inProgressDepths.getCount();
+    m_inProgressDepths.add(type, depth);
+    Index lowestInProgressDepth = depth;
+
+    bool result = false;
+    if (as<BasicExpressionType>(type))
+    {
+        result = true;
+    }
+    else if (auto vectorType = as<VectorExpressionType>(type))
+    {
+        result = _isConstantIntVal(vectorType->getElementCount()) &&
+                 _isCacheable(astBuilder, vectorType->getElementType(), lowestInProgressDepth);
+    }
+    else if (auto matrixType = as<MatrixExpressionType>(type))
+    {
+        result = _isConstantIntVal(matrixType->getRowCount()) &&
+                 _isConstantIntVal(matrixType->getColumnCount()) &&
+                 _isConstantIntVal(matrixType->getLayout()) &&
+                 _isCacheable(astBuilder, matrixType->getElementType(), lowestInProgressDepth);
+    }
+    else if (auto arrayType = as<ArrayExpressionType>(type))
+    {
+        result = (arrayType->isUnsized() || _isConstantIntVal(arrayType->getElementCount())) &&
+                 _isCacheable(astBuilder, arrayType->getElementType(), lowestInProgressDepth);
+    }
+    else if (as<SamplerStateType>(type) || as<TextureType>(type))
+    {
+        // The layout of these only depends on the rules and the target
+        result = true;
+    }
+    else if (auto declRefType = as<DeclRefType>(type))
+    {
+        auto declRef = declRefType->getDeclRef();
+        if (auto structDeclRef = declRef.as<StructDecl>())
+        {
+            result = true;
+            for (auto inheritanceDeclRef :
+                 getMembersOfType<InheritanceDecl>(astBuilder, structDeclRef))
+            {
+                auto baseType = getSup(astBuilder, inheritanceDeclRef);
+                if (!isInterfaceType(baseType) &&
+                    !_isCacheable(astBuilder, baseType, lowestInProgressDepth))
+                {
+                    result = false;
+                    break;
+                }
+            }
+            if (result)
+            {
+                for (auto field : getFields(astBuilder, structDeclRef, MemberFilterStyle::Instance))
+                {
+                    if (!_isCacheable(
+                            astBuilder,
+                            getType(astBuilder, field),
+                            lowestInProgressDepth))
+                    {
+                        result = false;
+                        break;
+                    }
+                }
+            }
+        }
+        else if (auto enumDeclRef = declRef.as<EnumDecl>())
+        {
+            result = _isCacheable(
+                astBuilder,
+                enumDeclRef.getDecl()->tagType,
+                lowestInProgressDepth);
+        }
+    }
+
+    m_inProgressDepths.remove(type);
+
+    // The result is final once it doesn't depend on a provisional answer for a type that is
+    // still being worked out further up. A type that only reaches itself is never cacheable.
+    if (lowestInProgressDepth >= depth)
+    {
+        IsCacheableEntry entry;
+        entry.isCacheable = result;
+        entry.owner = astBuilder;
+        m_isCacheable[type] = entry;
+    }
+    else
+    {
+        ioLowestInProgressDepth = Math::Min(ioLowestInProgressDepth, lowestInProgressDepth);
+    }
+    return result;
+}
+
+TypeLayoutResult* TypeLayoutCache::tryGetLayout(const Key& key)
+{
+    auto entry = m_layouts.tryGetValue(key);
+    if (!entry)
+    {
+        return nullptr;
+    }
+    m_stats.hitCount++;
+    return &entry->result;
+}
+
+static void _markLayoutShared(VarLayout* varLayout);
+
+/// Mark `typeLayout` and the layouts it is made of as shared
+static void _markLayoutShared(TypeLayout* typeLayout)
+{
+    if (!typeLayout || typeLayout->isShared)
+    {
+        return;
+    }
+    typeLayout->isShared = true;
+    _markLayoutShared(typeLayout->pendingDataTypeLayout);
+
+    if (auto structTypeLayout = as<StructTypeLayout>(typeLayout))
+    {
+        for (auto field : structTypeLayout->fields)
+            _markLayoutShared(field);
+        for (const auto& [decl, fieldLayout] : structTypeLayout->mapVarToLayout)
+            _markLayoutShared(fieldLayout);
+    }
+    else if (auto sequenceTypeLayout = as<SequenceTypeLayout>(typeLayout))
+    {
+        _markLayoutShared(sequenceTypeLayout->elementTypeLayout);
+        if (auto arrayTypeLayout = as<ArrayTypeLayout>(typeLayout))
+            _markLayoutShared(arrayTypeLayout->originalElementTypeLayout);
+    }
+}
+
+static void _markLayoutShared(VarLayout* varLayout)
+{
+    if (!varLayout || varLayout->isShared)
+    {
+        return;
+    }
+    varLayout->isShared = true;
+    _markLayoutShared(varLayout->getTypeLayout());
+    _markLayoutShared(varLayout->pendingVarLayout);
+}
+
+void TypeLayoutCache::addLayout(const Key& key, const TypeLayoutResult& result, ASTBuilder* owner)
+{
+    m_stats.missCount++;
+    _markLayoutShared(result.layout);
+
+    LayoutEntry entry;
+    entry.result = result;
+    entry.owner = owner;
+    m_layouts.set(key, entry);
+}
+
+void TypeLayoutCache::removeEntriesOwnedBy(ASTBuilder* owner)
+{
+    List<Key> layoutKeys;
+    for (const auto& [key, entry] : m_layouts)
+    {
+        if (entry.owner == owner)
+            layoutKeys.add(key);
+    }
+    for (const auto& key : layoutKeys)
+        m_layouts.remove(key);
+
+    List<Type*> types;
+    for (const auto& [type, entry] : m_isCacheable)
+    {
+        if (entry.owner == owner)
+            types.add(type);
+    }
+    for (auto type : types)
+        m_isCacheable.remove(type);
+}
+
+/* static */ SHA1::Digest TypeLayoutCache::getTargetIdentity(TargetRequest* targetReq)
+{
+    DigestBuilder<SHA1> builder;
+    builder.append(int(targetReq->getTarget()));
+    targetReq->getOptionSet().buildHash(builder);
+    return builder.finalize();
+}
+
+TypeLayoutCache* Session::getTypeLayoutCache()
+{
+    if (!m_typeLayoutCache)
+    {
+        m_typeLayoutCache = new TypeLayoutCache;
+    }
+    return m_typeLayoutCache;
+}
+
+/// Returns true and sets `outKey` if the layout of `type` in `context` can be shared through the
+/// type layout cache of the global session.
+static TypeLayoutCache* _getTypeLayoutCache(TypeLayoutContext const& context)
+{
+    return context.targetReq->getLinkage()->getSessionImpl()->getTypeLayoutCache();
+}
+
+static bool _getTypeLayoutCacheKey(
+    TypeLayoutContext const& context,
+    Type* type,
+    TypeLayoutCache::Key& outKey)
+{
+    // Specialization arguments can only be consumed by existential types, which can't be cached,
+    // but we play it safe.
+    if (!context.targetReq || context.specializationArgCount != 0)
+    {
+        return false;
+    }
+    if (context.targetReq->getOptionSet().getBoolOption(CompilerOptionName::DisableTypeLayoutCache))
+    {
+        return false;
+    }
+    if (!_getTypeLayoutCache(context)->isCacheable(context.astBuilder, type))
+    {
+        return false;
+    }
+
+    outKey.type = type;
+    outKey.targetIdentity = context.targetIdentity;
+    outKey.rules = context.rules;
+    outKey.matrixLayoutMode = context.matrixLayoutMode;
+    outKey.hlslToVulkanKindFlags = context.objectLayoutOptions.hlslToVulkanKindFlags;
+    return true;
+}
+
 static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type)
 {
     if (auto layoutResultPtr = context.layoutMap.tryGetValue(type))
@@ -5017,6 +5276,19 @@ static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type
 
         if (auto structDeclRef = declRef.as<StructDecl>())
         {
+            // If the layout doesn't depend on the program, we can reuse the layout computed
+            // for another program.
+            TypeLayoutCache::Key cacheKey;
+            const bool useCache = _getTypeLayoutCacheKey(context, type, cacheKey);
+            if (useCache)
+            {
+                if (auto cachedResult = _getTypeLayoutCache(context)->tryGetLayout(cacheKey))
+                {
+                    _addLayout(context, type, *cachedResult);
+                    return *cachedResult;
+                }
+            }
+
             StructTypeLayoutBuilder typeLayoutBuilder;
             StructTypeLayoutBuilder pendingDataTypeLayoutBuilder;
 
@@ -5118,7 +5390,12 @@ static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type
                 typeLayout->pendingDataTypeLayout = pendingDataTypeLayout;
             }
 
-            return _updateLayout(context, type, typeLayoutBuilder.getTypeLayoutResult());
+            auto result = _updateLayout(context, type, typeLayoutBuilder.getTypeLayoutResult());
+            if (useCache)
+            {
+                _getTypeLayoutCache(context)->addLayout(cacheKey, result, context.astBuilder);
+            }
+            return result;
         }
         else if (auto globalGenericParamDecl = declRef.as<GlobalGenericParamDecl>())
         {
@@ -5648,6 +5925,7 @@ void TypeLayout::removeResourceUsage(LayoutResourceKind kind)
     {
         if (resourceInfos[ii].kind == kind)
         {
+            SLANG_ASSERT(!isShared);
             resourceInfos.removeAt(ii);
             return;
         }
@@ -5661,6 +5939,7 @@ void VarLayout::removeResourceUsage(LayoutResourceKind kind)
     {
         if (resourceInfos[ii].kind == kind)
         {
+            SLANG_ASSERT(!isShared);
             resourceInfos.removeAt(ii);
             return;
         }
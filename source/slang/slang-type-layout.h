@@ -385,6 +385,10 @@ class VarLayout;
 // Base class for things that store layout info
 class Layout : public RefObject
 {
+public:
+    /// Set once the layout is shared through the `TypeLayoutCache`, after which it must not be
+    /// changed, as other programs (and sessions) hold on to the same object.
+    bool isShared = false;
 };
 
 // A reified representation of a particular laid-out type
@@ -445,6 +449,7 @@ public:
         if (existing)
             return existing;
 
+        SLANG_ASSERT(!isShared);
         ResourceInfo info;
         info.kind = kind;
         info.count = 0;
@@ -591,6 +596,7 @@ public:
 
     ResourceInfo* AddResourceInfo(LayoutResourceKind kind)
     {
+        SLANG_ASSERT(!isShared);
         ResourceInfo info;
         info.kind = kind;
         info.space = 0;
@@ -1183,6 +1189,9 @@ struct TypeLayoutContext
     // Options passed to object layout
     ObjectLayoutRulesImpl::Options objectLayoutOptions;
 
+    // Identifies the target in the keys of the `TypeLayoutCache`
+    SHA1::Digest targetIdentity;
+
     LayoutRulesImpl* getRules() { return rules; }
     LayoutRulesFamilyImpl* getRulesFamily() const { return rules->getLayoutRulesFamily(); }
 
@@ -1226,6 +1235,98 @@ struct TypeLayoutContext
     }
 };
 
+/// A cache of type layouts that is shared by all of the sessions of a global session.
+///
+/// Most programs linked against the same modules use the same `struct` types for their
+/// parameters (for example a large uniform struct in a common `ParameterBlock`), and without
+/// a cache the layout for those types is recomputed for every program and every specialization.
+///
+/// Only layouts that are fully determined by the type, the layout rules and the target can be
+/// cached. Any type that (recursively) involves generic or existential parameters has a layout
+/// that depends on the program, and is never cached.
+///
+/// Layouts are keyed on the type, so they are shared by every program and session that lays
+/// out the same type for a target with the same identity. Entries refer to the AST of the
+/// linkage that created them, and are removed by `removeEntriesOwnedBy` when it is destroyed.
+///
+/// Cached layouts are marked `isShared`, and must not be changed by their users.
+///
+class TypeLayoutCache : public RefObject
+{
+public:
+    struct Key
+    {
+        Type* type;
+        /// Identifies the target format and the options of the target
+        SHA1::Digest targetIdentity;
+        LayoutRulesImpl* rules;
+        MatrixLayoutMode matrixLayoutMode;
+        HLSLToVulkanLayoutOptions::KindFlags hlslToVulkanKindFlags;
+
+        HashCode getHashCode() const
+        {
+            Hasher hasher;
+            hasher.hashValue(type);
+            hasher.hashValue(targetIdentity.getHashCode());
+            hasher.hashValue(rules);
+            hasher.hashValue(matrixLayoutMode);
+            hasher.hashValue(hlslToVulkanKindFlags);
+            return hasher.getResult();
+        }
+        bool operator==(const Key& other) const
+        {
+            return type == other.type && targetIdentity == other.targetIdentity &&
+                   rules == other.rules && matrixLayoutMode == other.matrixLayoutMode &&
+                   hlslToVulkanKindFlags == other.hlslToVulkanKindFlags;
+        }
+    };
+
+    struct Stats
+    {
+        Count hitCount = 0;  ///< Layouts found in the cache
+        Count missCount = 0; ///< Cacheable layouts that had to be computed
+    };
+
+    /// Returns true if the layout of `type` only depends on the values in a `Key`
+    bool isCacheable(ASTBuilder* astBuilder, Type* type);
+
+    /// Returns the cached result for `key`, or nullptr if there isn't one
+    TypeLayoutResult* tryGetLayout(const Key& key);
+    /// Add the result for `key`, which was computed with the AST of `owner`. The layouts in
+    /// `result` are marked as shared.
+    void addLayout(const Key& key, const TypeLayoutResult& result, ASTBuilder* owner);
+
+    /// Remove every entry that refers to the AST of `owner`, before it is destroyed
+    void removeEntriesOwnedBy(ASTBuilder* owner);
+
+    const Stats& getStats() const { return m_stats; }
+
+    /// Get the identity of `targetReq` to use in a `Key`
+    static SHA1::Digest getTargetIdentity(TargetRequest* targetReq);
+
+protected:
+    struct LayoutEntry
+    {
+        TypeLayoutResult result;
+        ASTBuilder* owner = nullptr;
+    };
+    struct IsCacheableEntry
+    {
+        bool isCacheable = false;
+        ASTBuilder* owner = nullptr;
+    };
+
+    /// Implements `isCacheable`. `ioLowestInProgressDepth` is lowered to the depth of the
+    /// shallowest type still being worked out that the result assumed not to be cacheable.
+    bool _isCacheable(ASTBuilder* astBuilder, Type* type, Index& ioLowestInProgressDepth);
+
+    Dictionary<Key, LayoutEntry> m_layouts;
+    Dictionary<Type*, IsCacheableEntry> m_isCacheable;
+    /// The types whose cacheability is being worked out, and the depth of each in the query
+    Dictionary<Type*, Index> m_inProgressDepths;
+    Stats m_stats;
+};
+
 //
 
 
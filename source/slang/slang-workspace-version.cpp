@@ -197,6 +197,42 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
 void Workspace::invalidate()
 {
     currentVersion = nullptr;
+    changeCount++;
+}
+
+RefPtr<Workspace> Workspace::createSnapshot(slang::IGlobalSession* globalSession)
+{
+    // Strings share their buffers with non-atomic reference counts, so everything is deep copied
+    // to keep the snapshot independent of the thread that owns this workspace.
+    auto copyString = [](const String& str) { return String(str.getUnownedSlice()); };
+
+    RefPtr<Workspace> snapshot = new Workspace();
+    for (auto& path : rootDirectories)
+        snapshot->rootDirectories.add(copyString(path));
+    for (auto& path : additionalSearchPaths)
+        snapshot->additionalSearchPaths.add(copyString(path));
+    for (auto& path : workspaceSearchPaths)
+        snapshot->workspaceSearchPaths.add(copyString(path));
+    for (auto& macro : predefinedMacros)
+    {
+        OwnedPreprocessorMacroDefinition macroCopy;
+        macroCopy.name = copyString(macro.name);
+        macroCopy.value = copyString(macro.value);
+        snapshot->predefinedMacros.add(macroCopy);
+    }
+    snapshot->searchInWorkspace = searchInWorkspace;
+    snapshot->slangGlobalSession = globalSession;
+    snapshot->changeCount = changeCount;
+
+    // Documents are edited in place, so the snapshot needs its own copy of each of them.
+    for (const auto& [path, doc] : openedDocuments)
+    {
+        RefPtr<DocumentVersion> docCopy = new DocumentVersion();
+        docCopy->setText(copyString(doc->getText()));
+        docCopy->setPath(copyString(path));
+        snapshot->openedDocuments[docCopy->getPath()] = docCopy;
+    }
+    return snapshot;
 }
 
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
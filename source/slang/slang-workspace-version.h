@@ -165,6 +165,7 @@ private:
     RefPtr<WorkspaceVersion> currentVersion;
     RefPtr<WorkspaceVersion> currentCompletionVersion;
     RefPtr<WorkspaceVersion> createWorkspaceVersion();
+    uint32_t changeCount = 0;
 
 public:
     List<String> rootDirectories;
@@ -189,10 +190,16 @@ public:
 
     void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
     void invalidate();
+    // Incremented every time the workspace is invalidated.
+    uint32_t getChangeCount() const { return changeCount; }
     WorkspaceVersion* getCurrentVersion();
     WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
     WorkspaceVersion* createVersionForCompletion();
 
+    // Creates a copy of the workspace that shares no state with it, so it can be checked on
+    // another thread using `globalSession` while this workspace keeps changing.
+    RefPtr<Workspace> createSnapshot(slang::IGlobalSession* globalSession);
+
 public:
     // Inherited via ISlangFileSystem
     SLANG_COM_OBJECT_IUNKNOWN_ALL
@@ -3,6 +3,7 @@
 #include "../core/slang-archive-file-system.h"
 #include "../core/slang-castable.h"
 #include "../core/slang-io.h"
+#include "../core/slang-parallel-util.h"
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-string-util.h"
@@ -32,6 +33,7 @@
 #include "slang-parameter-binding.h"
 #include "slang-parser.h"
 #include "slang-preprocessor.h"
+#include "slang-reflection-binary.h"
 #include "slang-reflection-json.h"
 #include "slang-repro.h"
 #include "slang-serialize-ast.h"
@@ -179,6 +181,10 @@ void Session::init()
 
     m_sharedLibraryLoader = DefaultSharedLibraryLoader::getSingleton();
 
+    // The shared file cache is created up front, rather than on first use, because sessions can
+    // be created concurrently. It holds nothing until a session reads through it.
+    m_sharedFileCache = new SharedFileCache();
+
     // Set up the command line options
     initCommandOptions(m_commandOptions);
 
@@ -822,6 +828,13 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
     {
         linkage->setFileSystem(desc.fileSystem);
     }
+    else if (desc.flags & slang::kSessionFlags_UseSharedFileCache)
+    {
+        // The session still gets its own `CacheFileSystem`, so paths and unique identities are
+        // resolved once per session, but the file contents come from the shared cache.
+        ComPtr<ISlangFileSystem> cacheFileSystem(new CacheFileSystem(getSharedFileCache()));
+        linkage->setFileSystem(cacheFileSystem);
+    }
 
     if (desc.structureSize >= offsetof(slang::SessionDesc, enableEffectAnnotations))
     {
@@ -856,6 +869,11 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
     return SLANG_OK;
 }
 
+SharedFileCache* Session::getSharedFileCache()
+{
+    return m_sharedFileCache;
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Session::createCompileRequest(slang::ICompileRequest** outCompileRequest)
 {
@@ -1298,6 +1316,11 @@ ISlangUnknown* Linkage::getInterface(const Guid& guid)
 Linkage::~Linkage()
 {
     destroyTypeCheckingCache();
+
+    // The shared type layouts created by this linkage refer to its AST. A linkage that doesn't
+    // retain its session is owned by it, and is only destroyed along with the cache.
+    if (m_retainedSession)
+        m_retainedSession->getTypeLayoutCache()->removeEntriesOwnedBy(m_astBuilder);
 }
 
 SearchDirectoryList& Linkage::getSearchDirectories()
@@ -1570,6 +1593,290 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompositeComponentType(
     return SLANG_OK;
 }
 
+namespace
+{ // anonymous
+
+// Identifies a step of a batch compile, that can be shared between requests.
+//
+// The key holds a reference to the object the step starts from, so that the object
+// can't be freed, and its address reused by another, while the batch is running.
+struct BatchCompileStepKey
+{
+    ComPtr<ISlangUnknown> object;
+    String name;
+    SlangInt index;
+
+    bool operator==(BatchCompileStepKey const& other) const
+    {
+        return object == other.object && name == other.name && index == other.index;
+    }
+    HashCode getHashCode() const
+    {
+        return combineHash(
+            Slang::getHashCode(object.get()),
+            combineHash(name.getHashCode(), Slang::getHashCode(index)));
+    }
+};
+
+// The outcome of a step of a batch compile
+struct BatchCompileStep
+{
+    SlangResult result = SLANG_OK;
+    ComPtr<slang::IComponentType> componentType;
+    ComPtr<ISlangBlob> code;
+    ComPtr<ISlangBlob> diagnostics;
+
+    // For a code step, the target program the code is for, and the downstream compile
+    // that is still to be run, if any.
+    TargetProgram* targetProgram = nullptr;
+    RefPtr<DownstreamCompileJob> job;
+};
+
+// A request of a batch compile that is waiting for its code to be generated
+struct BatchCompilePendingRequest
+{
+    SlangInt index;
+    StringBuilder diagnostics;
+    BatchCompileStepKey codeKey;
+};
+
+} // namespace
+
+static void _appendDiagnostics(ISlangBlob* blob, StringBuilder& ioDiagnostics)
+{
+    if (blob)
+        ioDiagnostics.append(StringUtil::getSlice(blob));
+}
+
+// Set up `sink` the way `ComponentType::getEntryPointCode` does for `program`.
+static void _applyEntryPointCodeSinkSettings(DiagnosticSink* sink, ComponentType* program)
+{
+    applySettingsToDiagnosticSink(sink, sink, program->getLinkage()->m_optionSet);
+    applySettingsToDiagnosticSink(sink, sink, program->getOptionSet());
+}
+
+static SlangResult _loadEntryPointCode(IArtifact* artifact, ComPtr<ISlangBlob>& outCode)
+{
+    if (!artifact)
+        return SLANG_FAIL;
+    return artifact->loadBlob(ArtifactKeep::Yes, outCode.writeRef());
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::compileBatch(
+    slang::BatchCompileRequest const* requests,
+    SlangInt requestCount,
+    slang::BatchCompileResult* outResults)
+{
+    if (requestCount < 0 || (requestCount && (!requests || !outResults)))
+        return SLANG_E_INVALID_ARG;
+
+    SLANG_AST_BUILDER_RAII(getASTBuilder());
+
+    // Each step is done once for all of the requests that need it. Requests for the
+    // same entry point share the program composed from the module and the checked
+    // entry point. Specializing a program with the same arguments gives the same
+    // component type (see `ComponentType::specialize`), so requests that specialize it
+    // the same way share the linked program, and those for the same target share the
+    // code generated for it.
+    //
+    Dictionary<BatchCompileStepKey, BatchCompileStep> programs;
+    Dictionary<BatchCompileStepKey, BatchCompileStep> linkedPrograms;
+    Dictionary<BatchCompileStepKey, BatchCompileStep> codes;
+
+    List<BatchCompilePendingRequest> pendingRequests;
+
+    SlangResult batchResult = SLANG_OK;
+    auto finishRequest = [&](SlangInt index, StringBuilder& diagnostics, SlangResult result)
+    {
+        auto& outResult = outResults[index];
+        outResult.result = result;
+        if (diagnostics.getLength())
+        {
+            outResult.diagnostics = StringBlob::moveCreate(diagnostics).detach();
+        }
+        if (SLANG_FAILED(result))
+            batchResult = SLANG_FAIL;
+    };
+
+    for (SlangInt i = 0; i < requestCount; ++i)
+    {
+        auto& request = requests[i];
+        outResults[i] = slang::BatchCompileResult();
+
+        StringBuilder diagnostics;
+
+        if (!request.module || !request.entryPointName || request.targetIndex < 0 ||
+            request.targetIndex >= targets.getCount())
+        {
+            finishRequest(i, diagnostics, SLANG_E_INVALID_ARG);
+            continue;
+        }
+
+        // Compose the module with the checked entry point.
+        //
+        BatchCompileStepKey programKey = {
+            ComPtr<ISlangUnknown>(request.module),
+            String(request.entryPointName),
+            SlangInt(request.stage)};
+        auto program = programs.tryGetValue(programKey);
+        if (!program)
+        {
+            BatchCompileStep step;
+            ComPtr<slang::IEntryPoint> entryPoint;
+            if (request.stage == SLANG_STAGE_NONE)
+            {
+                step.result = request.module->findEntryPointByName(
+                    request.entryPointName,
+                    entryPoint.writeRef());
+            }
+            else
+            {
+                step.result = request.module->findAndCheckEntryPoint(
+                    request.entryPointName,
+                    request.stage,
+                    entryPoint.writeRef(),
+                    step.diagnostics.writeRef());
+            }
+            if (SLANG_SUCCEEDED(step.result) && !entryPoint)
+                step.result = SLANG_FAIL;
+
+            if (SLANG_SUCCEEDED(step.result))
+            {
+                ComPtr<ISlangBlob> compositeDiagnostics;
+                slang::IComponentType* components[] = {request.module, entryPoint.get()};
+                step.result = createCompositeComponentType(
+                    components,
+                    2,
+                    step.componentType.writeRef(),
+                    compositeDiagnostics.writeRef());
+                if (compositeDiagnostics)
+                    step.diagnostics = compositeDiagnostics;
+            }
+            programs[programKey] = step;
+            program = programs.tryGetValue(programKey);
+        }
+        _appendDiagnostics(program->diagnostics, diagnostics);
+        if (SLANG_FAILED(program->result))
+        {
+            finishRequest(i, diagnostics, program->result);
+            continue;
+        }
+
+        // Specialize and link the program.
+        //
+        ComPtr<slang::IComponentType> specialized;
+        {
+            ComPtr<ISlangBlob> specializeDiagnostics;
+            SlangResult result = program->componentType->specialize(
+                request.specializationArgs,
+                request.specializationArgCount,
+                specialized.writeRef(),
+                specializeDiagnostics.writeRef());
+            _appendDiagnostics(specializeDiagnostics, diagnostics);
+            if (SLANG_FAILED(result) || !specialized)
+            {
+                finishRequest(i, diagnostics, SLANG_FAILED(result) ? result : SLANG_FAIL);
+                continue;
+            }
+        }
+
+        BatchCompileStepKey linkKey = {ComPtr<ISlangUnknown>(specialized), String(), 0};
+        auto linked = linkedPrograms.tryGetValue(linkKey);
+        if (!linked)
+        {
+            BatchCompileStep step;
+            step.result =
+                specialized->link(step.componentType.writeRef(), step.diagnostics.writeRef());
+            linkedPrograms[linkKey] = step;
+            linked = linkedPrograms.tryGetValue(linkKey);
+        }
+        _appendDiagnostics(linked->diagnostics, diagnostics);
+        if (SLANG_FAILED(linked->result))
+        {
+            finishRequest(i, diagnostics, linked->result);
+            continue;
+        }
+
+        // Generate the code for the target, up to any compile by a downstream compiler,
+        // which is run below once every request has got this far.
+        //
+        BatchCompileStepKey codeKey = {
+            ComPtr<ISlangUnknown>(linked->componentType),
+            String(),
+            request.targetIndex};
+        if (!codes.containsKey(codeKey))
+        {
+            BatchCompileStep step;
+            step.componentType = linked->componentType;
+
+            auto linkedProgram = asInternal(linked->componentType.get());
+            step.targetProgram = linkedProgram->getTargetProgram(targets[request.targetIndex]);
+
+            DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
+            _applyEntryPointCodeSinkSettings(&sink, linkedProgram);
+
+            IArtifact* artifact = step.targetProgram->beginEntryPointResult(0, &sink, step.job);
+            sink.getBlobIfNeeded(step.diagnostics.writeRef());
+            if (!step.job)
+                step.result = _loadEntryPointCode(artifact, step.code);
+            codes[codeKey] = step;
+        }
+        pendingRequests.add({i, diagnostics, codeKey});
+    }
+
+    // Run the downstream compiles. A compile doesn't use the session, so the compiles that
+    // share nothing else with each other (see `DownstreamCompileJob::canRunConcurrently`)
+    // are run at the same time.
+    //
+    List<DownstreamCompileJob*> concurrentJobs;
+    for (auto& [codeKey, step] : codes)
+    {
+        if (!step.job)
+            continue;
+        if (step.job->canRunConcurrently)
+            concurrentJobs.add(step.job);
+        else
+            step.job->run();
+    }
+    ParallelUtil::forEach(concurrentJobs.getCount(), 0, [&](Index i) { concurrentJobs[i]->run(); });
+
+    // Report the outcome of each compile, in the order the compiles were started.
+    //
+    for (auto& [codeKey, step] : codes)
+    {
+        if (!step.job)
+            continue;
+
+        auto linkedProgram = asInternal(step.componentType.get());
+        DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
+        _applyEntryPointCodeSinkSettings(&sink, linkedProgram);
+
+        IArtifact* artifact = step.targetProgram->endEntryPointResult(0, step.job, &sink);
+        step.result = _loadEntryPointCode(artifact, step.code);
+        step.job = nullptr;
+
+        ComPtr<ISlangBlob> finishDiagnostics;
+        sink.getBlobIfNeeded(finishDiagnostics.writeRef());
+        if (finishDiagnostics)
+        {
+            StringBuilder stepDiagnostics;
+            _appendDiagnostics(step.diagnostics, stepDiagnostics);
+            _appendDiagnostics(finishDiagnostics, stepDiagnostics);
+            step.diagnostics = StringBlob::moveCreate(stepDiagnostics);
+        }
+    }
+
+    for (auto& pendingRequest : pendingRequests)
+    {
+        auto code = codes.tryGetValue(pendingRequest.codeKey);
+        _appendDiagnostics(code->diagnostics, pendingRequest.diagnostics);
+        if (SLANG_SUCCEEDED(code->result))
+            outResults[pendingRequest.index].code = ComPtr<ISlangBlob>(code->code).detach();
+        finishRequest(pendingRequest.index, pendingRequest.diagnostics, code->result);
+    }
+    return batchResult;
+}
+
 SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::specializeType(
     slang::TypeReflection* inUnspecializedType,
     slang::SpecializationArg const* specializationArgs,
@@ -4020,13 +4327,233 @@ RefPtr<Module> Linkage::loadDeserializedModule(
     return resultModule;
 }
 
+String getFileNameFromModuleName(Name* name, bool translateUnderScore);
+
+/// A precompiled module found while resolving the imports of another precompiled module, which
+/// has been read but not yet added to the linkage.
+struct PrefetchedBinaryModule : public RefObject
+{
+    Name* name = nullptr;
+    PathInfo filePathInfo;
+    ComPtr<ISlangBlob> blob;
+    RiffContainer container;
+
+    /// The names of the modules imported by this module, from its header
+    List<String> importedModules;
+    /// The imported modules that were prefetched too
+    List<PrefetchedBinaryModule*> imports;
+    /// The IR of the module, read before the module is added to the linkage
+    List<SerialContainerUtil::PrereadIRModule> irModules;
+
+    bool isVisited = false;
+};
+
+SourceLoc Linkage::getBinaryModuleLoc(String const& modulePath)
+{
+    if (modulePath.getLength() == 0)
+        return SourceLoc();
+
+    auto srcManager = getSourceManager();
+    auto modulePathInfo = PathInfo::makePath(modulePath);
+    auto srcFile = srcManager->findSourceFileByPathRecursively(modulePathInfo.foundPath);
+    if (!srcFile)
+    {
+        srcFile = srcManager->createSourceFileWithString(modulePathInfo, String());
+        srcManager->addSourceFile(modulePath, srcFile);
+    }
+    auto srcView = srcManager->createSourceView(srcFile, &modulePathInfo, SourceLoc());
+    return srcView->getRange().begin;
+}
+
+SlangResult Linkage::_findModuleFile(
+    IncludeSystem& includeSystem,
+    Name* name,
+    SourceLoc const& loc,
+    bool isBinaryModule,
+    bool translateUnderScore,
+    PathInfo& outFilePathInfo)
+{
+    String fileName = getFileNameFromModuleName(name, translateUnderScore);
+    if (isBinaryModule)
+        fileName = Path::replaceExt(fileName, "slang-module");
+
+    PathInfo pathIncludedFromInfo = getSourceManager()->getPathInfo(loc, SourceLocType::Actual);
+    return includeSystem.findFile(fileName, pathIncludedFromInfo.foundPath, outFilePathInfo);
+}
+
+void Linkage::_loadBinaryModuleImports(
+    RiffContainer* container,
+    Name* moduleName,
+    const PathInfo& filePathInfo,
+    SourceLoc const& loc,
+    const LoadedModuleDictionary* additionalLoadedModules)
+{
+    // The language server prefers source modules, so leave finding modules to
+    // `findOrImportModule`.
+    if (isInLanguageServer())
+        return;
+
+    List<String> rootImports;
+    if (SLANG_FAILED(SerialContainerUtil::readModuleImports(container, rootImports)) ||
+        rootImports.getCount() == 0)
+    {
+        return;
+    }
+
+    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
+    const bool checkUpToDate =
+        m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule);
+
+    // Find the precompiled modules of the import graph. This uses the file system and the
+    // linkage, so happens on this thread.
+    List<RefPtr<PrefetchedBinaryModule>> modules;
+    Dictionary<Name*, PrefetchedBinaryModule*> mapNameToModule;
+
+    auto shouldPrefetch = [&](Name* importName) -> bool
+    {
+        Module* additionalModule = nullptr;
+        return importName != moduleName && importName != getSessionImpl()->glslModuleName &&
+               !mapNameToLoadedModules.containsKey(importName) &&
+               !mapNameToModule.containsKey(importName) &&
+               !(additionalLoadedModules &&
+                 additionalLoadedModules->tryGetValue(importName, additionalModule));
+    };
+
+    // The imports of a precompiled module are looked for in the same way as
+    // `findOrImportModule` does when they are imported while reading the module, as if
+    // imported at the location that represents the module.
+    auto prefetch = [&](Name* importName, const PathInfo& fromPathInfo) -> PrefetchedBinaryModule*
+    {
+        const SourceLoc importLoc = getBinaryModuleLoc(fromPathInfo.foundPath);
+        for (int translateUnderScore = 0; translateUnderScore <= 1; translateUnderScore++)
+        {
+            RefPtr<PrefetchedBinaryModule> module = new PrefetchedBinaryModule;
+            module->name = importName;
+            if (SLANG_FAILED(_findModuleFile(
+                    includeSystem,
+                    importName,
+                    importLoc,
+                    true,
+                    translateUnderScore == 1,
+                    module->filePathInfo)))
+            {
+                continue;
+            }
+
+            // Already loaded under another name, or already prefetched
+            if (mapPathToLoadedModule.containsKey(module->filePathInfo.getMostUniqueIdentity()))
+                return nullptr;
+
+            if (SLANG_FAILED(includeSystem.loadFile(module->filePathInfo, module->blob)))
+                continue;
+
+            MemoryStreamBase readStream(
+                FileAccess::Read,
+                module->blob->getBufferPointer(),
+                module->blob->getBufferSize());
+            if (SLANG_FAILED(RiffUtil::read(&readStream, module->container)))
+                continue;
+
+            if (checkUpToDate &&
+                !isBinaryModuleUpToDate(module->filePathInfo.foundPath, &module->container))
+            {
+                continue;
+            }
+
+            SerialContainerUtil::readModuleImports(&module->container, module->importedModules);
+            modules.add(module);
+            mapNameToModule.add(importName, module);
+            return module;
+        }
+        return nullptr;
+    };
+
+    for (auto& importName : rootImports)
+    {
+        Name* name = getNamePool()->getName(importName);
+        if (shouldPrefetch(name))
+            prefetch(name, filePathInfo);
+    }
+    // `modules` grows as the imports of the prefetched modules are found
+    for (Index i = 0; i < modules.getCount(); ++i)
+    {
+        PrefetchedBinaryModule* module = modules[i];
+        for (auto& importName : module->importedModules)
+        {
+            Name* name = getNamePool()->getName(importName);
+            if (shouldPrefetch(name))
+                prefetch(name, module->filePathInfo);
+
+            PrefetchedBinaryModule* importedModule = nullptr;
+            if (mapNameToModule.tryGetValue(name, importedModule))
+                module->imports.add(importedModule);
+        }
+    }
+
+    if (modules.getCount() == 0)
+        return;
+
+    // Decompressing a module and reading its IR into its own IRModule is independent of the
+    // other modules and of the linkage, so the modules are read concurrently. The AST can only
+    // be read once the modules it imports are loaded, so is read when the module is added to
+    // the linkage below. If reading the IR fails, it is read again when the module is loaded,
+    // which reports the failure.
+    Session* session = getSessionImpl();
+    const bool useIRSerialData = m_optionSet.getBoolOption(CompilerOptionName::SerialIRViaData);
+    ParallelUtil::forEach(
+        modules.getCount(),
+        m_optionSet.getIntOption(CompilerOptionName::ModuleLoadThreadCount),
+        [&](Index i)
+        {
+            PrefetchedBinaryModule* module = modules[i];
+            SerialContainerUtil::readIRModules(
+                &module->container,
+                session,
+                useIRSerialData,
+                module->irModules);
+        });
+
+    // Add the modules to the linkage such that a module's imports are added before it, so
+    // deserializing its AST finds them already loaded.
+    List<PrefetchedBinaryModule*> orderedModules;
+    auto visit = [&](auto& self, PrefetchedBinaryModule* module) -> void
+    {
+        if (module->isVisited)
+            return;
+        module->isVisited = true;
+        for (auto importedModule : module->imports)
+            self(self, importedModule);
+        orderedModules.add(module);
+    };
+    for (auto& module : modules)
+        visit(visit, module);
+
+    // If loading a module fails, `findOrImportModule` will try again when the module is
+    // imported, and diagnose the failure then.
+    DiagnosticSink prefetchSink(getSourceManager(), Lexer::sourceLocationLexer);
+    for (auto module : orderedModules)
+    {
+        if (mapNameToLoadedModules.containsKey(module->name))
+            continue;
+        loadModuleFromIRBlobImpl(
+            module->name,
+            module->filePathInfo,
+            module->blob,
+            loc,
+            &prefetchSink,
+            additionalLoadedModules,
+            module);
+    }
+}
+
 RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     Name* name,
     const PathInfo& filePathInfo,
     ISlangBlob* fileContentsBlob,
     SourceLoc const& loc,
     DiagnosticSink* sink,
-    const LoadedModuleDictionary* additionalLoadedModules)
+    const LoadedModuleDictionary* additionalLoadedModules,
+    PrefetchedBinaryModule* prefetchedModule)
 {
     SLANG_AST_BUILDER_RAII(m_astBuilder);
 
@@ -4037,17 +4564,28 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     String mostUniqueIdentity = filePathInfo.getMostUniqueIdentity();
     SLANG_ASSERT(mostUniqueIdentity.getLength() > 0);
 
-    RiffContainer container;
-    MemoryStreamBase readStream(
-        FileAccess::Read,
-        fileContentsBlob->getBufferPointer(),
-        fileContentsBlob->getBufferSize());
-    SLANG_RETURN_NULL_ON_FAIL(RiffUtil::read(&readStream, container));
-
-    if (m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule))
+    RiffContainer readContainer;
+    RiffContainer* container = &readContainer;
+    if (prefetchedModule)
     {
-        if (!isBinaryModuleUpToDate(filePathInfo.foundPath, &container))
-            return nullptr;
+        // Already read, checked to be up to date, and its imports loaded
+        container = &prefetchedModule->container;
+    }
+    else
+    {
+        MemoryStreamBase readStream(
+            FileAccess::Read,
+            fileContentsBlob->getBufferPointer(),
+            fileContentsBlob->getBufferSize());
+        SLANG_RETURN_NULL_ON_FAIL(RiffUtil::read(&readStream, readContainer));
+
+        if (m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule))
+        {
+            if (!isBinaryModuleUpToDate(filePathInfo.foundPath, container))
+                return nullptr;
+        }
+
+        _loadBinaryModuleImports(container, name, filePathInfo, loc, additionalLoadedModules);
     }
 
     mapPathToLoadedModule.add(mostUniqueIdentity, resultModule);
@@ -4062,9 +4600,12 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     readOptions.sourceManager = getSourceManager();
     readOptions.namePool = getNamePool();
     readOptions.modulePath = filePathInfo.foundPath;
+    readOptions.useIRSerialData = m_optionSet.getBoolOption(CompilerOptionName::SerialIRViaData);
+    if (prefetchedModule)
+        readOptions.prereadIRModules = &prefetchedModule->irModules;
     SerialContainerData containerData;
     if (SLANG_FAILED(SerialContainerUtil::read(
-            &container,
+            container,
             readOptions,
             additionalLoadedModules,
             containerData)) ||
@@ -4315,8 +4856,6 @@ RefPtr<Module> Linkage::findOrImportModule(
 
     IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
 
-    // Get the original path info
-    PathInfo pathIncludedFromInfo = getSourceManager()->getPathInfo(loc, SourceLocType::Actual);
     PathInfo filePathInfo;
 
 
@@ -4332,18 +4871,16 @@ RefPtr<Module> Linkage::findOrImportModule(
         // Try without translating `_` to `-` first, if that fails, try translating.
         for (int translateUnderScore = 0; translateUnderScore <= 1; translateUnderScore++)
         {
-            auto moduleSourceFileName = getFileNameFromModuleName(name, translateUnderScore == 1);
-            String fileName;
-            if (checkBinaryModule == 1)
-                fileName = Path::replaceExt(moduleSourceFileName, "slang-module");
-            else
-                fileName = moduleSourceFileName;
-
             ComPtr<ISlangBlob> fileContents;
 
             // We have to load via the found path - as that is how file was originally loaded
-            if (SLANG_FAILED(
-                    includeSystem.findFile(fileName, pathIncludedFromInfo.foundPath, filePathInfo)))
+            if (SLANG_FAILED(_findModuleFile(
+                    includeSystem,
+                    name,
+                    loc,
+                    checkBinaryModule,
+                    translateUnderScore == 1,
+                    filePathInfo)))
             {
                 continue;
             }
@@ -5067,6 +5604,10 @@ SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
 
     buildHash(builder);
 
+    // Options given when linking, such as the values of specialization constants, change
+    // the generated code.
+    m_optionSet.buildHash(builder);
+
     // Add the name and name override for the specified entry point to the hash.
     auto entryPointName = getEntryPoint(entryPointIndex)->getName()->text;
     builder.append(entryPointName);
@@ -5136,6 +5677,69 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointMetadata(
     return SLANG_OK;
 }
 
+/// Appends what identifies the structure of `componentType` to `builder`, so that a
+/// component type that is rebuilt from the same parts has the same identity.
+///
+/// The parts are identified by their address, which is only valid for as long as they
+/// are kept alive, as they are by any component type cached under the identity.
+static void _buildStructuralIdentity(ComponentType* componentType, DigestBuilder<SHA1>& builder)
+{
+    auto appendAddress = [&](const void* ptr) { builder.append(uint64_t(uintptr_t(ptr))); };
+
+    if (auto module = as<Module>(componentType))
+    {
+        builder.append(UnownedStringSlice("module"));
+        appendAddress(module);
+    }
+    else if (auto entryPoint = as<EntryPoint>(componentType))
+    {
+        builder.append(UnownedStringSlice("entryPoint"));
+        appendAddress(entryPoint->getFuncDeclRef().declRefBase);
+        appendAddress(entryPoint->getName());
+        builder.append(int(entryPoint->getStage()));
+    }
+    else if (auto renamed = as<RenamedEntryPointComponentType>(componentType))
+    {
+        builder.append(UnownedStringSlice("renamed"));
+        builder.append(renamed->getEntryPointNameOverride(0));
+        _buildStructuralIdentity(renamed->getBase(), builder);
+    }
+    else if (auto composite = as<CompositeComponentType>(componentType))
+    {
+        auto childCount = composite->getChildComponentCount();
+        builder.append(UnownedStringSlice("composite"));
+        builder.append(childCount);
+        for (Index i = 0; i < childCount; ++i)
+            _buildStructuralIdentity(composite->getChildComponent(i), builder);
+    }
+    else if (auto specialized = as<SpecializedComponentType>(componentType))
+    {
+        auto argCount = specialized->getSpecializationArgCount();
+        builder.append(UnownedStringSlice("specialized"));
+        builder.append(argCount);
+        for (Index i = 0; i < argCount; ++i)
+        {
+            auto val = specialized->getSpecializationArg(i).val;
+            appendAddress(val ? val->resolve() : nullptr);
+        }
+        _buildStructuralIdentity(specialized->getBaseComponentType(), builder);
+    }
+    else if (auto conformance = as<TypeConformance>(componentType))
+    {
+        builder.append(UnownedStringSlice("conformance"));
+        appendAddress(conformance->getSubtypeWitness()->resolve());
+        builder.append(conformance->getConformanceIdOverride());
+    }
+    else
+    {
+        // Anything else is only identified by itself.
+        builder.append(UnownedStringSlice("other"));
+        appendAddress(componentType);
+    }
+
+    componentType->getOptionSet().buildHash(builder);
+}
+
 RefPtr<ComponentType> ComponentType::specialize(
     SpecializationArg const* inSpecializationArgs,
     SlangInt specializationArgCount,
@@ -5146,6 +5750,27 @@ RefPtr<ComponentType> ComponentType::specialize(
         return this;
     }
 
+    // Specializing with the same arguments gives the same component type, so if
+    // we have done this before we can reuse the earlier result, which avoids
+    // validating, linking and generating code for it again.
+    //
+    SpecializedComponentTypeKey key;
+    DigestBuilder<SHA1> identityBuilder;
+    _buildStructuralIdentity(this, identityBuilder);
+    key.base = identityBuilder.finalize();
+    for (SlangInt i = 0; i < specializationArgCount; ++i)
+    {
+        auto val = inSpecializationArgs[i].val;
+        key.args.add(val ? val->resolve() : nullptr);
+    }
+
+    RefPtr<ComponentType> specializedComponentType =
+        m_linkage->m_specializedComponentTypes.tryGet(key);
+    if (specializedComponentType)
+        return specializedComponentType;
+
+    const auto errorCount = sink->getErrorCount();
+
     List<SpecializationArg> specializationArgs;
     specializationArgs.addRange(inSpecializationArgs, specializationArgCount);
 
@@ -5157,7 +5782,16 @@ RefPtr<ComponentType> ComponentType::specialize(
     RefPtr<SpecializationInfo> specializationInfo =
         _validateSpecializationArgs(specializationArgs.getBuffer(), specializationArgCount, sink);
 
-    return new SpecializedComponentType(this, specializationInfo, specializationArgs, sink);
+    specializedComponentType =
+        new SpecializedComponentType(this, specializationInfo, specializationArgs, sink);
+
+    // A result with errors isn't reused, so that specializing with
+    // the same arguments again reports the errors again.
+    //
+    if (sink->getErrorCount() == errorCount)
+        m_linkage->m_specializedComponentTypes.add(key, specializedComponentType);
+
+    return specializedComponentType;
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
@@ -5270,11 +5904,80 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::linkWithOptions(
 
     auto linked = *outLinkedComponentType;
 
-    if (linked)
+    if (!linked)
+        return SLANG_OK;
+
+    bool hasConstantValues = false;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (entries[i].name == CompilerOptionName::SpecializeConstant)
+            hasConstantValues = true;
+    }
+    if (!hasConstantValues)
     {
         static_cast<ComponentType*>(linked)->getOptionSet().load(count, entries);
+        return SLANG_OK;
+    }
+
+    // Values for specialization and link-time constants make a separate variant of the
+    // program, with its own generated code. The variant is held in a composite of its own,
+    // so that it doesn't change the options of `this`, and is cached so that asking for
+    // the same values again reuses the code already generated for them.
+    //
+    // A later value for a constant replaces an earlier one, so only the last value of each
+    // is part of the key, and they are sorted by name so that the order they are given in
+    // doesn't make another variant.
+    //
+    Dictionary<String, String> mapConstantNameToValue;
+    CompilerOptionSet otherOptions;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (entries[i].name == CompilerOptionName::SpecializeConstant)
+        {
+            mapConstantNameToValue[String(entries[i].value.stringValue0)] =
+                String(entries[i].value.stringValue1);
+        }
+        else
+        {
+            otherOptions.load(1, &entries[i]);
+        }
     }
+    List<String> constantNames;
+    for (const auto& [name, value] : mapConstantNameToValue)
+        constantNames.add(name);
+    constantNames.sort();
 
+    DigestBuilder<SHA1> optionsBuilder;
+    otherOptions.buildHash(optionsBuilder);
+    for (const auto& name : constantNames)
+    {
+        optionsBuilder.append(name);
+        optionsBuilder.append(mapConstantNameToValue.getValue(name));
+    }
+
+    // The variant holds on to `this` through the linked component type, so the addresses
+    // in its identity stay valid for as long as it is cached.
+    DigestBuilder<SHA1> identityBuilder;
+    _buildStructuralIdentity(this, identityBuilder);
+
+    LinkedComponentTypeKey key;
+    key.base = identityBuilder.finalize();
+    key.optionsHash = optionsBuilder.finalize();
+
+    RefPtr<ComponentType> variant = m_linkage->m_constantSpecializedComponentTypes.tryGet(key);
+    if (!variant)
+    {
+        auto linkedComponentType = static_cast<ComponentType*>(linked);
+        List<RefPtr<ComponentType>> childComponents;
+        childComponents.add(linkedComponentType);
+        variant = new CompositeComponentType(m_linkage, childComponents);
+        variant->getOptionSet().overrideWith(linkedComponentType->getOptionSet());
+        variant->getOptionSet().load(count, entries);
+        m_linkage->m_constantSpecializedComponentTypes.add(key, variant);
+    }
+
+    linked->release();
+    *outLinkedComponentType = ComPtr<slang::IComponentType>(variant).detach();
     return SLANG_OK;
 }
 
@@ -7118,6 +7821,22 @@ SlangResult EndToEndCompileRequest::compile()
         }
     }
 
+    auto reflectionBinaryPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitReflectionBinary);
+    if (reflectionBinaryPath.getLength() != 0)
+    {
+        auto programReflection = (slang::ShaderReflection*)this->getReflection();
+        ComPtr<ISlangBlob> blob;
+        if (!programReflection || SLANG_FAILED(writeReflectionBinary(programReflection, blob)) ||
+            SLANG_FAILED(File::writeAllBytes(
+                reflectionBinaryPath,
+                blob->getBufferPointer(),
+                blob->getBufferSize())))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, reflectionBinaryPath);
+        }
+    }
+
     return res;
 }
 
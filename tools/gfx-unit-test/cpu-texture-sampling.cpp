@@ -0,0 +1,175 @@
+#include "core/slang-basic.h"
+#include "gfx-test-util.h"
+#include "gfx-util/shader-cursor.h"
+#include "slang-gfx.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+static ComPtr<ISamplerState> createSampler(
+    IDevice* device,
+    TextureFilteringMode filter,
+    TextureAddressingMode addressMode)
+{
+    ISamplerState::Desc desc = {};
+    desc.minFilter = filter;
+    desc.magFilter = filter;
+    desc.mipFilter = filter;
+    desc.addressU = addressMode;
+    desc.addressV = addressMode;
+    desc.addressW = addressMode;
+
+    ComPtr<ISamplerState> sampler;
+    GFX_CHECK_CALL_ABORT(device->createSamplerState(desc, sampler.writeRef()));
+    return sampler;
+}
+
+static void runTextureSamplingTest(IDevice* device, uint32_t textureFlags)
+{
+    Slang::ComPtr<ITransientResourceHeap> transientHeap;
+    ITransientResourceHeap::Desc transientHeapDesc = {};
+    transientHeapDesc.constantBufferSize = 4096;
+    GFX_CHECK_CALL_ABORT(
+        device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    GFX_CHECK_CALL_ABORT(loadComputeProgram(
+        device,
+        shaderProgram,
+        "cpu-texture-sampling",
+        "computeMain",
+        slangReflection));
+
+    ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<gfx::IPipelineState> pipelineState;
+    GFX_CHECK_CALL_ABORT(
+        device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+    const int kResultCount = 5;
+    ComPtr<IBufferResource> buffer;
+    {
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = kResultCount * sizeof(float);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        float initialData[kResultCount] = {};
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferResource(bufferDesc, initialData, buffer.writeRef()));
+    }
+
+    ComPtr<IResourceView> uav;
+    {
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(device->createBufferView(buffer, nullptr, viewDesc, uav.writeRef()));
+    }
+
+    // A 2x2 texture whose red channel is 0.0, 1.0 in the first row and 0.2, 0.4 in the second,
+    // with a white 1x1 mip level.
+    ComPtr<ITextureResource> texture;
+    {
+        ITextureResource::Desc textureDesc = {};
+        textureDesc.type = IResource::Type::Texture2D;
+        textureDesc.format = Format::R8G8B8A8_UNORM;
+        textureDesc.size.width = 2;
+        textureDesc.size.height = 2;
+        textureDesc.size.depth = 1;
+        textureDesc.numMipLevels = 2;
+        textureDesc.flags = textureFlags;
+        textureDesc.memoryType = MemoryType::DeviceLocal;
+        textureDesc.defaultState = ResourceState::ShaderResource;
+        textureDesc.allowedStates.add(ResourceState::CopyDestination);
+        uint32_t level0[] = {0xFF000000, 0xFF0000FF, 0xFF000033, 0xFF000066};
+        uint32_t level1[] = {0xFFFFFFFF};
+        ITextureResource::SubresourceData subResourceData[2] = {{level0, 8, 16}, {level1, 4, 4}};
+        GFX_CHECK_CALL_ABORT(
+            device->createTextureResource(textureDesc, subResourceData, texture.writeRef()));
+    }
+
+    ComPtr<IResourceView> srv;
+    {
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::ShaderResource;
+        viewDesc.format = Format::R8G8B8A8_UNORM;
+        viewDesc.subresourceRange.layerCount = 1;
+        viewDesc.subresourceRange.mipLevelCount = 2;
+        GFX_CHECK_CALL_ABORT(device->createTextureView(texture, viewDesc, srv.writeRef()));
+    }
+
+    auto linearWrap =
+        createSampler(device, TextureFilteringMode::Linear, TextureAddressingMode::Wrap);
+    auto linearClamp =
+        createSampler(device, TextureFilteringMode::Linear, TextureAddressingMode::ClampToEdge);
+    auto pointWrap =
+        createSampler(device, TextureFilteringMode::Point, TextureAddressingMode::Wrap);
+
+    ComPtr<IShaderObject> rootObject;
+    device->createMutableRootShaderObject(shaderProgram, rootObject.writeRef());
+    {
+        auto cursor = ShaderCursor(rootObject);
+        cursor["tex"].setResource(srv);
+        cursor["linearWrap"].setSampler(linearWrap);
+        cursor["linearClamp"].setSampler(linearClamp);
+        cursor["pointWrap"].setSampler(pointWrap);
+        cursor["buffer"].setResource(uav);
+    }
+
+    {
+        ICommandQueue::Desc queueDesc = {ICommandQueue::QueueType::Graphics};
+        auto queue = device->createCommandQueue(queueDesc);
+
+        auto commandBuffer = transientHeap->createCommandBuffer();
+        {
+            auto encoder = commandBuffer->encodeComputeCommands();
+            encoder->bindPipelineWithRootObject(pipelineState, rootObject);
+            encoder->dispatchCompute(1, 1, 1);
+            encoder->endEncoding();
+        }
+
+        commandBuffer->close();
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+    }
+
+    compareComputeResult(device, buffer, Slang::makeArray<float>(0.4f, 0.5f, 0.0f, 0.4f, 0.7f));
+}
+
+void cpuTextureSamplingTestImpl(IDevice* device, UnitTestContext* context)
+{
+    runTextureSamplingTest(device, TextureResourceFlags::None);
+}
+
+// Tiling only changes where the texels are stored, so the results must be the same.
+void cpuTextureSamplingTiledTestImpl(IDevice* device, UnitTestContext* context)
+{
+    runTextureSamplingTest(device, TextureResourceFlags::Tiled);
+}
+
+SLANG_UNIT_TEST(cpuTextureSamplingCPU)
+{
+    runTestImpl(cpuTextureSamplingTestImpl, unitTestContext, Slang::RenderApiFlag::CPU);
+}
+
+SLANG_UNIT_TEST(cpuTextureSamplingTiledCPU)
+{
+    runTestImpl(cpuTextureSamplingTiledTestImpl, unitTestContext, Slang::RenderApiFlag::CPU);
+}
+
+SLANG_UNIT_TEST(cpuTextureSamplingVulkan)
+{
+    runTestImpl(cpuTextureSamplingTestImpl, unitTestContext, Slang::RenderApiFlag::Vulkan);
+}
+} // namespace gfx_test
@@ -24,6 +24,7 @@ class TextureResourceImpl;
 class ResourceViewImpl;
 class BufferResourceViewImpl;
 class TextureResourceViewImpl;
+class SamplerStateImpl;
 class ShaderObjectLayoutImpl;
 class EntryPointLayoutImpl;
 class RootShaderObjectLayoutImpl;
@@ -5,6 +5,7 @@
 #include "cpu-pipeline-state.h"
 #include "cpu-query.h"
 #include "cpu-resource-views.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object.h"
 #include "cpu-shader-program.h"
 #include "cpu-texture.h"
@@ -216,8 +217,8 @@ SLANG_NO_THROW const DeviceInfo& SLANG_MCALL DeviceImpl::getDeviceInfo() const
 SLANG_NO_THROW Result SLANG_MCALL
 DeviceImpl::createSamplerState(ISamplerState::Desc const& desc, ISamplerState** outSampler)
 {
-    SLANG_UNUSED(desc);
-    *outSampler = nullptr;
+    RefPtr<SamplerStateImpl> sampler = new SamplerStateImpl(desc);
+    returnComPtr(outSampler, sampler);
     return SLANG_OK;
 }
 
@@ -69,59 +69,85 @@ void TextureResourceViewImpl::SampleLevel(
     float level,
     void* outData,
     size_t dataSize)
+{
+    _sampleLevels(
+        samplerState,
+        coords,
+        _getSampleCoordCount(),
+        &level,
+        1,
+        outData,
+        dataSize);
+}
+
+void TextureResourceViewImpl::_sampleLevels(
+    slang_prelude::SamplerState samplerState,
+    const float* locs,
+    int locSize,
+    const float* levels,
+    int count,
+    void* outData,
+    size_t dataSize)
 {
     TextureResourceImpl* texture = m_texture;
+    if (samplerState.state)
+    {
+        // The prelude's sampler state is the `SamplerStateImpl` bound to the shader object
+        auto sampler = reinterpret_cast<SamplerStateImpl*>(samplerState.state);
+        sampleTextureLevels(texture, sampler, locs, locSize, levels, count, outData, dataSize);
+        return;
+    }
+
+    // Without a sampler, keep the nearest texel mapping used before sampler states were
+    // supported.
     auto baseShape = texture->m_baseShape;
     auto& desc = texture->_getDesc();
     int32_t rank = baseShape->rank;
     int32_t baseCoordCount = baseShape->baseCoordCount;
-
-    int32_t integerMipLevel = int32_t(level + 0.5f);
-    if (integerMipLevel >= desc.numMipLevels)
-        integerMipLevel = desc.numMipLevels - 1;
-    if (integerMipLevel < 0)
-        integerMipLevel = 0;
-
-    auto& mipLevelInfo = texture->m_mipLevels[integerMipLevel];
-
-    bool isArray = (desc.arraySize != 0) || (desc.type == ITextureResource::Type::TextureCube);
     int32_t effectiveArrayElementCount = texture->m_effectiveArrayElementCount;
-    int32_t coordIndex = baseCoordCount;
-    int32_t elementIndex = 0;
-    if (isArray)
-    {
-        elementIndex = int32_t(coords[coordIndex++] + 0.5f);
-    }
-    if (elementIndex >= effectiveArrayElementCount)
-        elementIndex = effectiveArrayElementCount - 1;
-    if (elementIndex < 0)
-        elementIndex = 0;
 
-    // Note: for now we are just going to do nearest-neighbor sampling
-    //
-    int64_t texelOffset = mipLevelInfo.offset;
-    texelOffset += elementIndex * mipLevelInfo.strides[3];
-    for (int32_t axis = 0; axis < rank; ++axis)
+    for (int i = 0; i < count; ++i)
     {
-        int32_t extent = mipLevelInfo.extents[axis];
+        const float* coords = locs + i * locSize;
 
-        float coord = coords[axis];
+        int32_t integerMipLevel = int32_t(levels[i] + 0.5f);
+        if (integerMipLevel >= desc.numMipLevels)
+            integerMipLevel = desc.numMipLevels - 1;
+        if (integerMipLevel < 0)
+            integerMipLevel = 0;
 
-        // TODO: deal with wrap/clamp/repeat if `coord < 0` or `coord > 1`
+        auto& mipLevelInfo = texture->m_mipLevels[integerMipLevel];
 
-        int32_t integerCoord = int32_t(coord * (extent - 1) + 0.5f);
+        int32_t elementIndex = 0;
+        if (locSize > baseCoordCount)
+        {
+            elementIndex = int32_t(coords[baseCoordCount] + 0.5f);
+        }
+        if (elementIndex >= effectiveArrayElementCount)
+            elementIndex = effectiveArrayElementCount - 1;
+        if (elementIndex < 0)
+            elementIndex = 0;
 
-        if (integerCoord >= extent)
-            integerCoord = extent - 1;
-        if (integerCoord < 0)
-            integerCoord = 0;
+        int32_t texelCoords[3] = {0, 0, 0};
+        for (int32_t axis = 0; axis < rank; ++axis)
+        {
+            int32_t extent = mipLevelInfo.extents[axis];
 
-        texelOffset += integerCoord * mipLevelInfo.strides[axis];
-    }
+            int32_t integerCoord = int32_t(coords[axis] * (extent - 1) + 0.5f);
 
-    auto texelPtr = (char const*)texture->m_data + texelOffset;
+            if (integerCoord >= extent)
+                integerCoord = extent - 1;
+            if (integerCoord < 0)
+                integerCoord = 0;
 
-    m_texture->m_formatInfo->unpackFunc(texelPtr, outData, dataSize);
+            texelCoords[axis] = integerCoord;
+        }
+
+        int64_t texelOffset = texture->getTexelOffset(mipLevelInfo, elementIndex, texelCoords);
+        auto texelPtr = (char const*)texture->m_data + texelOffset;
+
+        m_texture->m_formatInfo->unpackFunc(texelPtr, (char*)outData + i * dataSize, dataSize);
+    }
 }
 
 void* TextureResourceViewImpl::refAt(const uint32_t* texelCoords)
@@ -168,8 +194,7 @@ void* TextureResourceViewImpl::_getTexelPtr(int32_t const* texelCoords)
 
     auto& mipLevelInfo = texture->m_mipLevels[mipLevel];
 
-    int64_t texelOffset = mipLevelInfo.offset;
-    texelOffset += elementIndex * mipLevelInfo.strides[3];
+    int32_t coords[3] = {0, 0, 0};
     for (int32_t axis = 0; axis < rank; ++axis)
     {
         int32_t coord = texelCoords[axis];
@@ -178,11 +203,21 @@ void* TextureResourceViewImpl::_getTexelPtr(int32_t const* texelCoords)
         if (coord < 0)
             coord = 0;
 
-        texelOffset += texelCoords[axis] * mipLevelInfo.strides[axis];
+        coords[axis] = coord;
     }
 
+    int64_t texelOffset = texture->getTexelOffset(mipLevelInfo, elementIndex, coords);
     return (char*)texture->m_data + texelOffset;
 }
 
+int32_t TextureResourceViewImpl::_getSampleCoordCount()
+{
+    // Array textures have the element index after the coordinates of the location. A texture
+    // with a single element is always sampled from that element, so the index isn't read.
+    auto& desc = m_texture->_getDesc();
+    bool isArray = desc.arraySize > 1;
+    return m_texture->m_baseShape->baseCoordCount + (isArray ? 1 : 0);
+}
+
 } // namespace cpu
 } // namespace gfx
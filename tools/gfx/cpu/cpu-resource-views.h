@@ -2,6 +2,7 @@
 #pragma once
 #include "cpu-base.h"
 #include "cpu-buffer.h"
+#include "cpu-sampler.h"
 #include "cpu-texture.h"
 
 namespace gfx
@@ -84,6 +85,18 @@ private:
     RefPtr<TextureResourceImpl> m_texture;
 
     void* _getTexelPtr(int32_t const* texelCoords);
+    int32_t _getSampleCoordCount();
+
+    /// Sample `count` locations, `locSize` floats apart in `locs`, writing the results
+    /// `dataSize` bytes apart in `outData`.
+    void _sampleLevels(
+        slang_prelude::SamplerState samplerState,
+        const float* locs,
+        int locSize,
+        const float* levels,
+        int count,
+        void* outData,
+        size_t dataSize);
 };
 
 } // namespace cpu
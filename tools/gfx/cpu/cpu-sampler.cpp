@@ -0,0 +1,366 @@
+// cpu-sampler.cpp
+#include "cpu-sampler.h"
+
+#include <math.h>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+namespace
+{ // anonymous
+
+// The texels along one axis that are filtered for a location, and their weights
+struct AxisFilter
+{
+    int32_t coords[2]; ///< -1 for a texel outside of the image, that has the border color
+    float weights[2];
+    int32_t count;
+};
+
+} // namespace
+
+static int32_t _applyAddressMode(int32_t coord, int32_t extent, TextureAddressingMode mode)
+{
+    if (coord >= 0 && coord < extent)
+        return coord;
+
+    switch (mode)
+    {
+    case TextureAddressingMode::Wrap:
+        {
+            const int32_t wrapped = coord % extent;
+            return wrapped < 0 ? wrapped + extent : wrapped;
+        }
+    case TextureAddressingMode::MirrorRepeat:
+        {
+            const int32_t period = extent * 2;
+            int32_t mirrored = coord % period;
+            if (mirrored < 0)
+                mirrored += period;
+            return mirrored < extent ? mirrored : period - 1 - mirrored;
+        }
+    case TextureAddressingMode::MirrorOnce:
+        {
+            const int32_t mirrored = coord < 0 ? -1 - coord : coord;
+            return mirrored < extent ? mirrored : extent - 1;
+        }
+    case TextureAddressingMode::ClampToBorder:
+        return -1;
+    case TextureAddressingMode::ClampToEdge:
+    default:
+        return coord < 0 ? 0 : extent - 1;
+    }
+}
+
+static void _calcAxisFilter(
+    float coord,
+    int32_t extent,
+    TextureFilteringMode filter,
+    TextureAddressingMode mode,
+    AxisFilter& outFilter)
+{
+    // Keep the texel coordinate in a range that can be converted to an integer, where it is
+    // far enough outside the image for the addressing mode to give the same result.
+    float texelCoord = coord * float(extent);
+    const float limit = 16777216.0f;
+    if (!(texelCoord > -limit && texelCoord < limit))
+        texelCoord = texelCoord > 0.0f ? limit : -limit;
+
+    if (filter == TextureFilteringMode::Point)
+    {
+        outFilter.count = 1;
+        outFilter.coords[0] = _applyAddressMode(int32_t(floorf(texelCoord)), extent, mode);
+        outFilter.weights[0] = 1.0f;
+        return;
+    }
+
+    // The texels either side of the location, weighted by how close the location is to their
+    // centers.
+    const float sampleCoord = texelCoord - 0.5f;
+    const float firstCoord = floorf(sampleCoord);
+    const float fraction = sampleCoord - firstCoord;
+    const int32_t first = int32_t(firstCoord);
+
+    outFilter.count = 2;
+    outFilter.coords[0] = _applyAddressMode(first, extent, mode);
+    outFilter.coords[1] = _applyAddressMode(first + 1, extent, mode);
+    outFilter.weights[0] = 1.0f - fraction;
+    outFilter.weights[1] = fraction;
+}
+
+// Returns the face of the cube that `direction` points at, and the location on the face
+static int32_t _calcCubeFace(const float* direction, float outUV[2])
+{
+    const float x = direction[0];
+    const float y = direction[1];
+    const float z = direction[2];
+    const float absX = fabsf(x);
+    const float absY = fabsf(y);
+    const float absZ = fabsf(z);
+
+    int32_t face;
+    float s, t, major;
+    if (absX >= absY && absX >= absZ)
+    {
+        face = x >= 0.0f ? 0 : 1;
+        s = x >= 0.0f ? -z : z;
+        t = -y;
+        major = absX;
+    }
+    else if (absY >= absZ)
+    {
+        face = y >= 0.0f ? 2 : 3;
+        s = x;
+        t = y >= 0.0f ? z : -z;
+        major = absY;
+    }
+    else
+    {
+        face = z >= 0.0f ? 4 : 5;
+        s = z >= 0.0f ? x : -x;
+        t = -y;
+        major = absZ;
+    }
+
+    if (major == 0.0f)
+        major = 1.0f;
+    outUV[0] = 0.5f * (s / major + 1.0f);
+    outUV[1] = 0.5f * (t / major + 1.0f);
+    return face;
+}
+
+static void _calcAxisFilters(
+    TextureResourceImpl* texture,
+    ISamplerState::Desc const& desc,
+    TextureFilteringMode filter,
+    bool isCube,
+    int32_t mipLevel,
+    const float* uvw,
+    AxisFilter outAxes[3])
+{
+    auto& level = texture->m_mipLevels[mipLevel];
+    const int32_t rank = texture->getRank();
+    const TextureAddressingMode modes[3] = {desc.addressU, desc.addressV, desc.addressW};
+
+    for (int32_t axis = 0; axis < 3; ++axis)
+    {
+        if (axis < rank)
+        {
+            // Faces of a cube are clamped, as they don't wrap onto each other
+            _calcAxisFilter(
+                uvw[axis],
+                level.extents[axis],
+                filter,
+                isCube ? TextureAddressingMode::ClampToEdge : modes[axis],
+                outAxes[axis]);
+        }
+        else
+        {
+            outAxes[axis].count = 1;
+            outAxes[axis].coords[0] = 0;
+            outAxes[axis].weights[0] = 1.0f;
+        }
+    }
+}
+
+// Filters the texels of a mip level around a location
+static void _filterLevel(
+    TextureResourceImpl* texture,
+    ISamplerState::Desc const& desc,
+    TextureFilteringMode filter,
+    bool isCube,
+    int32_t mipLevel,
+    int32_t elementIndex,
+    const float* uvw,
+    float outValue[4])
+{
+    AxisFilter axes[3];
+    _calcAxisFilters(texture, desc, filter, isCube, mipLevel, uvw, axes);
+
+    for (int32_t i = 0; i < 4; ++i)
+        outValue[i] = 0.0f;
+
+    // The texels are unpacked and accumulated 4 at a time, which is all of the texels for
+    // bilinear filtering of a 2D texture.
+    auto& level = texture->m_mipLevels[mipLevel];
+    auto unpackQuad = texture->m_formatInfo->unpackQuadFunc;
+    const char* data = (const char*)texture->m_data;
+
+    const void* texels[4];
+    float weights[4];
+    int32_t texelCount = 0;
+
+    auto accumulate = [&]()
+    {
+        for (int32_t i = texelCount; i < 4; ++i)
+        {
+            texels[i] = texels[0];
+            weights[i] = 0.0f;
+        }
+
+        float values[16];
+        unpackQuad(texels, values);
+        for (int32_t i = 0; i < 4; ++i)
+        {
+            for (int32_t channel = 0; channel < 4; ++channel)
+                outValue[channel] += values[i * 4 + channel] * weights[i];
+        }
+        texelCount = 0;
+    };
+
+    for (int32_t z = 0; z < axes[2].count; ++z)
+    {
+        for (int32_t y = 0; y < axes[1].count; ++y)
+        {
+            for (int32_t x = 0; x < axes[0].count; ++x)
+            {
+                const float weight =
+                    axes[0].weights[x] * axes[1].weights[y] * axes[2].weights[z];
+                const int32_t coords[3] = {
+                    axes[0].coords[x],
+                    axes[1].coords[y],
+                    axes[2].coords[z]};
+
+                if (coords[0] < 0 || coords[1] < 0 || coords[2] < 0)
+                {
+                    for (int32_t channel = 0; channel < 4; ++channel)
+                        outValue[channel] += desc.borderColor[channel] * weight;
+                    continue;
+                }
+
+                texels[texelCount] = data + texture->getTexelOffset(level, elementIndex, coords);
+                weights[texelCount] = weight;
+                if (++texelCount == 4)
+                    accumulate();
+            }
+        }
+    }
+
+    if (texelCount > 0)
+        accumulate();
+}
+
+void sampleTextureLevels(
+    TextureResourceImpl* texture,
+    SamplerStateImpl* sampler,
+    const float* coords,
+    int32_t coordCount,
+    const float* levels,
+    int32_t count,
+    void* outData,
+    size_t dataSize)
+{
+    auto& textureDesc = texture->_getDesc();
+    auto& desc = sampler->m_desc;
+    auto formatInfo = texture->m_formatInfo;
+
+    const int32_t rank = texture->getRank();
+    const int32_t baseCoordCount = texture->m_baseShape->baseCoordCount;
+    const bool isCube = textureDesc.type == ITextureResource::Type::TextureCube;
+    const int32_t arrayElementCount =
+        texture->m_effectiveArrayElementCount / texture->m_baseShape->implicitArrayElementCount;
+    const int32_t levelCount = textureDesc.numMipLevels;
+
+    for (int32_t i = 0; i < count; ++i)
+    {
+        const float* sampleCoords = coords + i * coordCount;
+        void* sampleOutData = (char*)outData + i * dataSize;
+
+        // The array element comes after the coordinates of the location
+        int32_t arrayIndex = 0;
+        if (coordCount > baseCoordCount)
+        {
+            const float arrayCoord = floorf(sampleCoords[baseCoordCount] + 0.5f);
+            if (arrayCoord >= float(arrayElementCount))
+                arrayIndex = arrayElementCount - 1;
+            else if (arrayCoord > 0.0f)
+                arrayIndex = int32_t(arrayCoord);
+        }
+
+        float uvw[3] = {0.0f, 0.0f, 0.0f};
+        int32_t elementIndex = arrayIndex;
+        if (isCube)
+        {
+            elementIndex = arrayIndex * 6 + _calcCubeFace(sampleCoords, uvw);
+        }
+        else
+        {
+            for (int32_t axis = 0; axis < rank; ++axis)
+                uvw[axis] = sampleCoords[axis];
+        }
+
+        float lod = levels[i] + desc.mipLODBias;
+        lod = Math::Clamp(lod, desc.minLOD, desc.maxLOD);
+        if (lod > float(levelCount - 1))
+            lod = float(levelCount - 1);
+        if (!(lod > 0.0f))
+            lod = 0.0f;
+
+        const TextureFilteringMode filter = lod > 0.0f ? desc.minFilter : desc.magFilter;
+        const int32_t firstLevel = int32_t(lod);
+        const float levelFraction = lod - float(firstLevel);
+
+        if (!formatInfo->unpackQuadFunc)
+        {
+            // Formats that aren't read as floats aren't filtered, so just read the nearest texel
+            AxisFilter axes[3];
+            const int32_t mipLevel = int32_t(lod + 0.5f);
+            _calcAxisFilters(
+                texture,
+                desc,
+                TextureFilteringMode::Point,
+                isCube,
+                mipLevel,
+                uvw,
+                axes);
+            const int32_t texelCoords[3] = {
+                axes[0].coords[0],
+                axes[1].coords[0],
+                axes[2].coords[0]};
+            if (texelCoords[0] < 0 || texelCoords[1] < 0 || texelCoords[2] < 0)
+            {
+                memset(sampleOutData, 0, dataSize);
+                continue;
+            }
+            const int64_t offset =
+                texture->getTexelOffset(texture->m_mipLevels[mipLevel], elementIndex, texelCoords);
+            formatInfo->unpackFunc((const char*)texture->m_data + offset, sampleOutData, dataSize);
+            continue;
+        }
+
+        float value[4];
+        if (desc.mipFilter == TextureFilteringMode::Linear && levelFraction > 0.0f &&
+            firstLevel + 1 < levelCount)
+        {
+            // Trilinear filtering blends the two nearest mip levels
+            float secondValue[4];
+            _filterLevel(texture, desc, filter, isCube, firstLevel, elementIndex, uvw, value);
+            _filterLevel(
+                texture,
+                desc,
+                filter,
+                isCube,
+                firstLevel + 1,
+                elementIndex,
+                uvw,
+                secondValue);
+            for (int32_t channel = 0; channel < 4; ++channel)
+                value[channel] += (secondValue[channel] - value[channel]) * levelFraction;
+        }
+        else
+        {
+            const int32_t mipLevel =
+                desc.mipFilter == TextureFilteringMode::Linear ? firstLevel : int32_t(lod + 0.5f);
+            _filterLevel(texture, desc, filter, isCube, mipLevel, elementIndex, uvw, value);
+        }
+
+        memcpy(sampleOutData, value, Math::Min(dataSize, sizeof(value)));
+    }
+}
+
+} // namespace cpu
+} // namespace gfx
@@ -0,0 +1,40 @@
+// cpu-sampler.h
+#pragma once
+#include "cpu-base.h"
+#include "cpu-texture.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+class SamplerStateImpl : public SamplerStateBase
+{
+public:
+    SamplerStateImpl(ISamplerState::Desc const& desc)
+        : m_desc(desc)
+    {
+    }
+
+    ISamplerState::Desc m_desc;
+};
+
+/// Samples `count` locations of `texture` with the filtering and addressing modes of `sampler`.
+///
+/// `coords` holds `coordCount` coordinates for each location, as passed to `SampleLevel`, and
+/// `levels` the mip level for each. The texel for each location is written to `outData`,
+/// `dataSize` bytes apart.
+void sampleTextureLevels(
+    TextureResourceImpl* texture,
+    SamplerStateImpl* sampler,
+    const float* coords,
+    int32_t coordCount,
+    const float* levels,
+    int32_t count,
+    void* outData,
+    size_t dataSize);
+
+} // namespace cpu
+} // namespace gfx
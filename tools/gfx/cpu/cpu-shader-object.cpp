@@ -3,6 +3,7 @@
 
 #include "cpu-buffer.h"
 #include "cpu-resource-views.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object-layout.h"
 
 namespace gfx
@@ -84,6 +85,7 @@ Result ShaderObjectImpl::init(IDevice* device, ShaderObjectLayoutImpl* typeLayou
     // and not just the number of resource/sub-object ranges.
     //
     m_resources.setCount(typeLayout->getResourceCount());
+    m_samplers.setCount(typeLayout->getResourceCount());
     m_objects.setCount(typeLayout->getSubObjectCount());
 
     for (auto subObjectRange : getLayout()->subObjectRanges)
@@ -232,8 +234,23 @@ ShaderObjectImpl::setObject(ShaderOffset const& offset, IShaderObject* object)
 SLANG_NO_THROW Result SLANG_MCALL
 ShaderObjectImpl::setSampler(ShaderOffset const& offset, ISamplerState* sampler)
 {
-    SLANG_UNUSED(sampler);
-    SLANG_UNUSED(offset);
+    auto layout = getLayout();
+
+    auto bindingRangeIndex = offset.bindingRangeIndex;
+    SLANG_ASSERT(bindingRangeIndex >= 0);
+    SLANG_ASSERT(bindingRangeIndex < layout->m_bindingRanges.getCount());
+
+    // Samplers take slots in the same way as resources
+    auto& bindingRange = layout->m_bindingRanges[bindingRangeIndex];
+    auto samplerIndex = bindingRange.baseIndex + offset.bindingArrayIndex;
+
+    auto samplerImpl = static_cast<SamplerStateImpl*>(sampler);
+    m_samplers[samplerIndex] = samplerImpl;
+
+    // The generated code passes the sampler back to the texture that samples with it, so the
+    // pointer is only used as an opaque handle.
+    auto samplerObj = reinterpret_cast<slang_prelude::ISamplerState*>(samplerImpl);
+    SLANG_RETURN_ON_FAIL(setData(offset, &samplerObj, sizeof(samplerObj)));
     return SLANG_OK;
 }
 
@@ -40,6 +40,7 @@ class ShaderObjectImpl
 
 public:
     List<RefPtr<ResourceViewImpl>> m_resources;
+    List<RefPtr<SamplerStateImpl>> m_samplers;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL
     init(IDevice* device, ShaderObjectLayoutImpl* typeLayout);
@@ -1,6 +1,13 @@
 // cpu-texture.cpp
 #include "cpu-texture.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GFX_CPU_TEXTURE_SSE2 1
+#else
+#define GFX_CPU_TEXTURE_SSE2 0
+#endif
+
 namespace gfx
 {
 using namespace Slang;
@@ -91,6 +98,75 @@ void _unpackUInt32Texel(void const* texelData, void* outData, size_t outSize)
     memcpy(outData, temp, outSize);
 }
 
+template<int N>
+void _unpackFloatQuad(void const* const* texels, float* outValues)
+{
+    for (int i = 0; i < 4; ++i)
+        _unpackFloatTexel<N>(texels[i], outValues + i * 4, sizeof(float) * 4);
+}
+
+template<int N>
+void _unpackFloat16Quad(void const* const* texels, float* outValues)
+{
+    for (int i = 0; i < 4; ++i)
+        _unpackFloat16Texel<N>(texels[i], outValues + i * 4, sizeof(float) * 4);
+}
+
+#if GFX_CPU_TEXTURE_SSE2
+// Unpacks 4 texels of 4 8 bit unorm channels, to a vector per texel
+static SLANG_FORCE_INLINE void _unpackUnorm8x4Quad(void const* const* texels, __m128 outValues[4])
+{
+    uint32_t packed[4];
+    for (int i = 0; i < 4; ++i)
+        memcpy(&packed[i], texels[i], sizeof(uint32_t));
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_loadu_si128((const __m128i*)packed);
+    const __m128i lowHalves = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i highHalves = _mm_unpackhi_epi8(bytes, zero);
+    const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+    outValues[0] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lowHalves, zero)), scale);
+    outValues[1] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lowHalves, zero)), scale);
+    outValues[2] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(highHalves, zero)), scale);
+    outValues[3] = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(highHalves, zero)), scale);
+}
+#endif
+
+template<int N>
+void _unpackUnorm8Quad(void const* const* texels, float* outValues)
+{
+#if GFX_CPU_TEXTURE_SSE2
+    if (N == 4)
+    {
+        __m128 values[4];
+        _unpackUnorm8x4Quad(texels, values);
+        for (int i = 0; i < 4; ++i)
+            _mm_storeu_ps(outValues + i * 4, values[i]);
+        return;
+    }
+#endif
+    for (int i = 0; i < 4; ++i)
+        _unpackUnorm8Texel<N>(texels[i], outValues + i * 4, sizeof(float) * 4);
+}
+
+void _unpackUnormBGRA8Quad(void const* const* texels, float* outValues)
+{
+#if GFX_CPU_TEXTURE_SSE2
+    __m128 values[4];
+    _unpackUnorm8x4Quad(texels, values);
+    for (int i = 0; i < 4; ++i)
+    {
+        // Swap the red and blue channels
+        const __m128 rgba = _mm_shuffle_ps(values[i], values[i], _MM_SHUFFLE(3, 0, 1, 2));
+        _mm_storeu_ps(outValues + i * 4, rgba);
+    }
+#else
+    for (int i = 0; i < 4; ++i)
+        _unpackUnormBGRA8Texel(texels[i], outValues + i * 4, sizeof(float) * 4);
+#endif
+}
+
 TextureResourceImpl::~TextureResourceImpl()
 {
     free(m_data);
@@ -144,6 +220,11 @@ Result TextureResourceImpl::init(ITextureResource::SubresourceData const* initDa
 
     int32_t levelCount = desc.numMipLevels;
 
+    // 2D images are tiled if asked for, which doesn't change how they are accessed, only where
+    // texels are stored.
+    const bool isMultisample = desc.sampleDesc.numSamples > 1;
+    m_isTiled = (desc.flags & TextureResourceFlags::Tiled) && rank == 2 && !isMultisample;
+
     m_mipLevels.setCount(levelCount);
 
     int64_t totalDataSize = 0;
@@ -165,10 +246,16 @@ Result TextureResourceImpl::init(ITextureResource::SubresourceData const* initDa
             level.strides[axis] = level.strides[axis - 1] * level.extents[axis - 1];
         }
 
-        int64_t levelDataSize = texelSize;
-        levelDataSize *= effectiveArrayElementCount;
-        for (int32_t axis = 0; axis < rank; ++axis)
-            levelDataSize *= int64_t(level.extents[axis]);
+        level.tileCountX = 0;
+        if (m_isTiled)
+        {
+            // The image is padded to a whole number of tiles
+            level.tileCountX = (level.extents[0] + kTileMask) >> kTileShift;
+            const int64_t tileCountY = (level.extents[1] + kTileMask) >> kTileShift;
+            level.strides[3] = level.tileCountX * tileCountY * kTileTexelCount * texelSize;
+        }
+
+        int64_t levelDataSize = level.strides[3] * effectiveArrayElementCount;
 
         level.offset = totalDataSize;
         totalDataSize += levelDataSize;
@@ -213,7 +300,25 @@ Result TextureResourceImpl::init(ITextureResource::SubresourceData const* initDa
 
                     for (int32_t row = 0; row < rowCount; ++row)
                     {
-                        memcpy(dstRow, srcRow, textureRowSize);
+                        if (m_isTiled)
+                        {
+                            for (int32_t x = 0; x < m_mipLevels[mipLevel].extents[0]; ++x)
+                            {
+                                const int32_t coords[2] = {x, row};
+                                const int64_t dstOffset = getTexelOffset(
+                                    m_mipLevels[mipLevel],
+                                    arrayElementIndex,
+                                    coords);
+                                memcpy(
+                                    (char*)textureData + dstOffset,
+                                    srcRow + x * texelSize,
+                                    texelSize);
+                            }
+                        }
+                        else
+                        {
+                            memcpy(dstRow, srcRow, textureRowSize);
+                        }
 
                         srcRow += srcRowStride;
                         dstRow += dstRowStride;
@@ -30,9 +30,14 @@ static CPUTextureBaseShapeInfo const* _getBaseShapeInfo(ITextureResource::Type b
 
 typedef void (*CPUTextureUnpackFunc)(void const* texelData, void* outData, size_t outSize);
 
+/// Unpacks 4 texels to 4 floats each (16 in total). Used for filtering, so only set for formats
+/// that are read as floats.
+typedef void (*CPUTextureUnpackQuadFunc)(void const* const* texels, float* outValues);
+
 struct CPUTextureFormatInfo
 {
     CPUTextureUnpackFunc unpackFunc;
+    CPUTextureUnpackQuadFunc unpackQuadFunc;
 };
 
 template<int N>
@@ -54,33 +59,48 @@ void _unpackUInt16Texel(void const* texelData, void* outData, size_t outSize);
 template<int N>
 void _unpackUInt32Texel(void const* texelData, void* outData, size_t outSize);
 
+template<int N>
+void _unpackFloatQuad(void const* const* texels, float* outValues);
+
+template<int N>
+void _unpackFloat16Quad(void const* const* texels, float* outValues);
+
+template<int N>
+void _unpackUnorm8Quad(void const* const* texels, float* outValues);
+
+void _unpackUnormBGRA8Quad(void const* const* texels, float* outValues);
+
 struct CPUFormatInfoMap
 {
     CPUFormatInfoMap()
     {
         memset(m_infos, 0, sizeof(m_infos));
 
-        set(Format::R32G32B32A32_FLOAT, &_unpackFloatTexel<4>);
-        set(Format::R32G32B32_FLOAT, &_unpackFloatTexel<3>);
+        set(Format::R32G32B32A32_FLOAT, &_unpackFloatTexel<4>, &_unpackFloatQuad<4>);
+        set(Format::R32G32B32_FLOAT, &_unpackFloatTexel<3>, &_unpackFloatQuad<3>);
 
-        set(Format::R32G32_FLOAT, &_unpackFloatTexel<2>);
-        set(Format::R32_FLOAT, &_unpackFloatTexel<1>);
+        set(Format::R32G32_FLOAT, &_unpackFloatTexel<2>, &_unpackFloatQuad<2>);
+        set(Format::R32_FLOAT, &_unpackFloatTexel<1>, &_unpackFloatQuad<1>);
 
-        set(Format::R16G16B16A16_FLOAT, &_unpackFloat16Texel<4>);
-        set(Format::R16G16_FLOAT, &_unpackFloat16Texel<2>);
-        set(Format::R16_FLOAT, &_unpackFloat16Texel<1>);
+        set(Format::R16G16B16A16_FLOAT, &_unpackFloat16Texel<4>, &_unpackFloat16Quad<4>);
+        set(Format::R16G16_FLOAT, &_unpackFloat16Texel<2>, &_unpackFloat16Quad<2>);
+        set(Format::R16_FLOAT, &_unpackFloat16Texel<1>, &_unpackFloat16Quad<1>);
 
-        set(Format::R8G8B8A8_UNORM, &_unpackUnorm8Texel<4>);
-        set(Format::B8G8R8A8_UNORM, &_unpackUnormBGRA8Texel);
+        set(Format::R8G8B8A8_UNORM, &_unpackUnorm8Texel<4>, &_unpackUnorm8Quad<4>);
+        set(Format::B8G8R8A8_UNORM, &_unpackUnormBGRA8Texel, &_unpackUnormBGRA8Quad);
         set(Format::R16_UINT, &_unpackUInt16Texel<1>);
         set(Format::R32_UINT, &_unpackUInt32Texel<1>);
-        set(Format::D32_FLOAT, &_unpackFloatTexel<1>);
+        set(Format::D32_FLOAT, &_unpackFloatTexel<1>, &_unpackFloatQuad<1>);
     }
 
-    void set(Format format, CPUTextureUnpackFunc func)
+    void set(
+        Format format,
+        CPUTextureUnpackFunc func,
+        CPUTextureUnpackQuadFunc quadFunc = nullptr)
     {
         auto& info = m_infos[Index(format)];
         info.unpackFunc = func;
+        info.unpackQuadFunc = quadFunc;
     }
     SLANG_FORCE_INLINE const CPUTextureFormatInfo& get(Format format) const
     {
@@ -102,7 +122,12 @@ class TextureResourceImpl : public TextureResource
 {
     enum
     {
-        kMaxRank = 3
+        kMaxRank = 3,
+
+        // Tiled textures are stored in tiles of 8x8 texels
+        kTileShift = 3,
+        kTileMask = (1 << kTileShift) - 1,
+        kTileTexelCount = 1 << (2 * kTileShift),
     };
 
 public:
@@ -123,14 +148,50 @@ public:
     int32_t m_effectiveArrayElementCount = 0;
     uint32_t m_texelSize = 0;
 
+    /// If set, from `TextureResourceFlags::Tiled`, the texels of each 2D image are stored in
+    /// tiles, with the texels of a tile in Morton (Z) order. Texels that are close to each other
+    /// in both axes, such as those that are filtered together, are then mostly in the same cache
+    /// lines.
+    bool m_isTiled = false;
+
     struct MipLevel
     {
         int32_t extents[kMaxRank];
         int64_t strides[kMaxRank + 1];
         int64_t offset;
+        int32_t tileCountX; ///< The number of tiles in a row of tiles, if tiled
     };
     List<MipLevel> m_mipLevels;
     void* m_data = nullptr;
+
+    /// Get the offset in bytes of a texel in `m_data`. The coordinates must be in range.
+    SLANG_FORCE_INLINE int64_t
+    getTexelOffset(MipLevel const& level, int32_t elementIndex, int32_t const* coords) const
+    {
+        int64_t offset = level.offset + elementIndex * level.strides[3];
+        if (m_isTiled)
+        {
+            const int32_t x = coords[0];
+            const int32_t y = coords[1];
+            const int32_t tileIndex = (y >> kTileShift) * level.tileCountX + (x >> kTileShift);
+            const int32_t texelIndex = _getMortonIndex(x & kTileMask, y & kTileMask);
+            return offset + (int64_t(tileIndex) * kTileTexelCount + texelIndex) * m_texelSize;
+        }
+        for (int32_t axis = 0; axis < m_baseShape->rank; ++axis)
+        {
+            offset += coords[axis] * level.strides[axis];
+        }
+        return offset;
+    }
+
+private:
+    /// Interleaves the bits of the texel coordinates within a tile
+    static SLANG_FORCE_INLINE int32_t _getMortonIndex(int32_t x, int32_t y)
+    {
+        const int32_t spreadX = (x & 1) | ((x & 2) << 1) | ((x & 4) << 2);
+        const int32_t spreadY = (y & 1) | ((y & 2) << 1) | ((y & 4) << 2);
+        return spreadX | (spreadY << 1);
+    }
 };
 
 } // namespace cpu
@@ -1,31 +1,833 @@
 // slang-profile-main.cpp
 
+#include "../../source/compiler-core/slang-json-rpc-connection.h"
+#include "../../source/core/slang-compression-system.h"
 #include "../../source/core/slang-io.h"
 #include "../../source/core/slang-process-util.h"
 #include "../../source/core/slang-std-writers.h"
 #include "../../source/core/slang-string-util.h"
 #include "slang-com-helper.h"
 
+#define SLANG_PRELUDE_NAMESPACE CPPPrelude
+#include "../../prelude/slang-cpp-types.h"
+
 using namespace Slang;
 
-SlangResult innerMain(int argc, char** argv)
+static double _getSeconds(uint64_t startTick, uint64_t endTick)
 {
-    auto stdWriters = StdWriters::initDefaultSingleton();
+    return double(endTick - startTick) / Process::getClockFrequency();
+}
+
+// Time the creation of the session
+static SlangResult _profileSessionCreation()
+{
+    const auto startTick = Process::getClockTick();
+
+    for (Int i = 0; i < 32; ++i)
+    {
+        ComPtr<slang::IGlobalSession> slangSession;
+        slangSession.attach(spCreateSession(nullptr));
+    }
+
+    const auto endTick = Process::getClockTick();
+
+    printf("Ticks %f\n", _getSeconds(startTick, endTick));
+    return SLANG_OK;
+}
+
+/* Time getLayout() for many programs that share a large parameter block.
+
+Each program is a module with its own entry point and parameters, that imports a common module.
+The programs are all laid out in one session, once with the type layout cache (so the layout of
+the shared types is reused) and once without it (so everything is laid out from scratch). */
+static SlangResult _profileTypeLayout()
+{
+    const Index programCount = 300;
+
+    StringBuilder commonSource;
+    commonSource << "struct Light { float4 position; float4 color; float4x4 shadowMatrix; };\n";
+    commonSource << "struct View { float4x4 view; float4x4 projection; float4 frustum[6]; };\n";
+    commonSource << "struct Common\n{\n";
+    for (Index i = 0; i < 64; ++i)
+    {
+        commonSource << "    View view" << i << ";\n";
+        commonSource << "    Light lights" << i << "[4];\n";
+    }
+    commonSource << "    Texture2D shadowMaps[16];\n";
+    commonSource << "    SamplerState samplers[4];\n";
+    commonSource << "};\n";
+    commonSource << "public ParameterBlock<Common> gCommon;\n";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    auto createProgram =
+        [&](slang::ISession* session, Index index, ComPtr<slang::IComponentType>& outProgram)
+    {
+        ComPtr<slang::IBlob> diagnostics;
+        if (!session->loadModuleFromSourceString(
+                "common",
+                "common.slang",
+                commonSource.getBuffer(),
+                diagnostics.writeRef()))
+        {
+            return SLANG_FAIL;
+        }
+
+        StringBuilder source;
+        source << "import common;\n";
+        source << "struct Params { float4 values[" << (index % 8) + 1 << "]; };\n";
+        source << "ConstantBuffer<Params> gParams;\n";
+        source << "RWStructuredBuffer<float4> gOutput;\n";
+        source << "[shader(\"compute\")][numthreads(8, 1, 1)]\n";
+        source << "void main(uint3 tid : SV_DispatchThreadID)\n{\n";
+        source << "    gOutput[tid.x] = gCommon.lights" << (index % 64)
+               << "[tid.x & 3].color * gParams.values[0];\n";
+        source << "}\n";
+
+        StringBuilder moduleName;
+        moduleName << "program" << index;
+
+        auto module = session->loadModuleFromSourceString(
+            moduleName.getBuffer(),
+            (moduleName + ".slang").getBuffer(),
+            source.getBuffer(),
+            diagnostics.writeRef());
+        if (!module)
+        {
+            return SLANG_FAIL;
+        }
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->findEntryPointByName("main", entryPoint.writeRef()));
+
+        slang::IComponentType* components[] = {module, entryPoint};
+        return session->createCompositeComponentType(
+            components,
+            SLANG_COUNT_OF(components),
+            outProgram.writeRef(),
+            diagnostics.writeRef());
+    };
+
+    auto layoutProgram = [&](slang::IComponentType* program, uint64_t& ioTicks)
+    {
+        const auto startTick = Process::getClockTick();
+        auto layout = program->getLayout(0);
+        ioTicks += Process::getClockTick() - startTick;
+        return layout ? SLANG_OK : SLANG_FAIL;
+    };
+
+    // All programs are in one session, with and without the type layout cache, so the difference
+    // is only down to the cache. Only getLayout() is timed, not loading the modules.
+    for (const bool disableCache : {false, true})
+    {
+        slang::CompilerOptionEntry option = {};
+        option.name = slang::CompilerOptionName::DisableTypeLayoutCache;
+        option.value.kind = slang::CompilerOptionValueKind::Int;
+        option.value.intValue0 = 1;
+
+        slang::SessionDesc cacheSessionDesc = sessionDesc;
+        if (disableCache)
+        {
+            cacheSessionDesc.compilerOptionEntries = &option;
+            cacheSessionDesc.compilerOptionEntryCount = 1;
+        }
+
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(globalSession->createSession(cacheSessionDesc, session.writeRef()));
+
+        uint64_t ticks = 0;
+        for (Index i = 0; i < programCount; ++i)
+        {
+            ComPtr<slang::IComponentType> program;
+            SLANG_RETURN_ON_FAIL(createProgram(session, i, program));
+            SLANG_RETURN_ON_FAIL(layoutProgram(program, ticks));
+        }
+        printf(
+            "type-layout: %d programs, cache %s: %f s\n",
+            int(programCount),
+            disableCache ? "off" : "on",
+            _getSeconds(0, ticks));
+    }
+
+    return SLANG_OK;
+}
+
+/* Time reading language server style messages through a JSONRPCConnection.
+
+Most of the messages are `textDocument/didChange` notifications holding a whole document, the rest
+are small requests. For comparison the same messages are also parsed with
+JSONRPCUtil::parseJSON, which copies and decodes the text of each message. */
+static SlangResult _profileJSONRPC()
+{
+    const Index messageCount = 2000;
+
+    StringBuilder documentText;
+    for (Index i = 0; i < 200; ++i)
+    {
+        documentText << "    float4 value" << i << " = gInput[tid.x + " << i
+                     << "] * 0.5f;\\n    // \\\"comment\\\" " << i << "\\n";
+    }
+
+    List<String> contents;
+    size_t totalContentSize = 0;
+    for (Index i = 0; i < messageCount; ++i)
+    {
+        StringBuilder content;
+        if (i % 4 == 0)
+        {
+            content << "{\"jsonrpc\":\"2.0\",\"id\":" << i
+                    << ",\"method\":\"textDocument/hover\",\"params\":{\"textDocument\":{\"uri\":"
+                       "\"file:///shader.slang\"},\"position\":{\"line\":"
+                    << (i % 100) << ",\"character\":12}}}";
+        }
+        else
+        {
+            content << "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{"
+                       "\"textDocument\":{\"uri\":\"file:///shader.slang\",\"version\":"
+                    << i << "},\"contentChanges\":[{\"text\":\"" << documentText << "\"}]}}";
+        }
+        totalContentSize += content.getLength();
+        contents.add(content.produceString());
+    }
+
+    List<Byte> packets;
+    for (const auto& content : contents)
+    {
+        StringBuilder header;
+        HTTPHeader httpHeader;
+        httpHeader.m_contentLength = content.getLength();
+        httpHeader.append(header);
+        packets.addRange((const Byte*)header.getBuffer(), header.getLength());
+        packets.addRange((const Byte*)content.getBuffer(), content.getLength());
+    }
+
+    auto report = [&](const char* name, uint64_t startTick, uint64_t endTick)
+    {
+        const double seconds = _getSeconds(startTick, endTick);
+        printf(
+            "json-rpc: %s: %d messages, %f s (%.0f messages/s, %.1f MB/s)\n",
+            name,
+            int(messageCount),
+            seconds,
+            messageCount / seconds,
+            totalContentSize / (seconds * 1024 * 1024));
+    };
 
-    // Time the creation of the session
+    // Reading through the connection, including the text of each document change
     {
+        RefPtr<OwnedMemoryStream> readStream = new OwnedMemoryStream(FileAccess::Read);
+        readStream->setContent(packets.getBuffer(), packets.getCount());
+        RefPtr<OwnedMemoryStream> writeStream = new OwnedMemoryStream(FileAccess::Write);
+
+        RefPtr<JSONRPCConnection> connection = new JSONRPCConnection;
+        SLANG_RETURN_ON_FAIL(connection->init(
+            new HTTPPacketConnection(new BufferedReadStream(readStream), writeStream)));
+
+        auto container = connection->getContainer();
+
         const auto startTick = Process::getClockTick();
+        for (Index i = 0; i < messageCount; ++i)
+        {
+            SLANG_RETURN_ON_FAIL(connection->waitForResult());
+            if (!connection->hasMessage())
+            {
+                return SLANG_FAIL;
+            }
+
+            JSONRPCCall call;
+            SLANG_RETURN_ON_FAIL(connection->getRPC(&call));
+
+            // Keys are only valid for the current message
+            const JSONKey changesKey = container->getKey(toSlice("contentChanges"));
+            auto changes = container->findObjectValue(call.params, changesKey);
+            if (changes.getKind() == JSONValue::Kind::Array)
+            {
+                auto change = container->getArray(changes)[0];
+                auto text = container->findObjectValue(change, container->getKey(toSlice("text")));
+                if (container->getTransientString(text).getLength() == 0)
+                {
+                    return SLANG_FAIL;
+                }
+            }
+        }
+        report("connection", startTick, Process::getClockTick());
+    }
 
-        for (Int i = 0; i < 32; ++i)
+    // Parsing each message with JSONRPCUtil::parseJSON
+    {
+        SourceManager sourceManager;
+        sourceManager.initialize(nullptr, nullptr);
+        DiagnosticSink sink(&sourceManager, &JSONLexer::calcLexemeLocation);
+        JSONContainer container(&sourceManager);
+
+        const auto startTick = Process::getClockTick();
+        for (const auto& content : contents)
         {
-            ComPtr<slang::IGlobalSession> slangSession;
-            slangSession.attach(spCreateSession(nullptr));
+            sourceManager.reset();
+            container.reset();
+
+            JSONValue root;
+            SLANG_RETURN_ON_FAIL(
+                JSONRPCUtil::parseJSON(content.getUnownedSlice(), &container, &sink, root));
         }
+        report("parseJSON", startTick, Process::getClockTick());
+    }
+
+    return SLANG_OK;
+}
+
+// Generate the source of a module with many small types and functions
+static String _generateMaterialSource(Index materialCount)
+{
+    StringBuilder source;
+    for (Index i = 0; i < materialCount; ++i)
+    {
+        source << "public struct Material" << i << "\n{\n";
+        source << "    public float4 color;\n    public float roughness;\n";
+        source << "    public float4 shade(float3 normal, float3 light)\n    {\n";
+        source << "        float d = max(dot(normal, light), 0.0) * roughness + " << i << ".0;\n";
+        source << "        return color * d;\n    }\n};\n";
+        source << "public float4 shadeMaterial" << i << "(Material" << i
+               << " m, float3 n, float3 l)\n{\n";
+        source << "    return m.shade(n, l) + float4(" << i << ");\n}\n";
+    }
+    return source.produceString();
+}
+
+/* Time loading a precompiled module, when the chunks of the module are stored uncompressed, or
+each compressed as an independent frame with deflate or LZ4.
+
+The module is serialized once for each compression, and then loaded into new sessions. Checking
+whether the module is up to date only reads the header, so compressed frames for the IR and AST
+are never decompressed. */
+static SlangResult _profileModuleLoad()
+{
+    const Index loadCount = 20;
+
+    String source = _generateMaterialSource(400);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    auto createSession = [&](CompressionSystemType compressionType,
+                             ComPtr<slang::ISession>& outSession) -> SlangResult
+    {
+        slang::CompilerOptionEntry entry;
+        entry.name = slang::CompilerOptionName::ModuleCompression;
+        entry.value.intValue0 = int32_t(compressionType);
+
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.compilerOptionEntries = &entry;
+        sessionDesc.compilerOptionEntryCount = 1;
+        return globalSession->createSession(sessionDesc, outSession.writeRef());
+    };
+
+    struct Compression
+    {
+        const char* name;
+        CompressionSystemType type;
+    };
+    const Compression compressions[] = {
+        {"none", CompressionSystemType::None},
+        {"deflate", CompressionSystemType::Deflate},
+        {"lz4", CompressionSystemType::LZ4},
+    };
+
+    for (const auto& compression : compressions)
+    {
+        ComPtr<slang::IBlob> moduleBlob;
+        {
+            ComPtr<slang::ISession> session;
+            SLANG_RETURN_ON_FAIL(createSession(compression.type, session));
+
+            ComPtr<slang::IBlob> diagnostics;
+            auto module = session->loadModuleFromSourceString(
+                "moduleLoad",
+                "moduleLoad.slang",
+                source.getBuffer(),
+                diagnostics.writeRef());
+            if (!module)
+            {
+                return SLANG_FAIL;
+            }
+            SLANG_RETURN_ON_FAIL(module->serialize(moduleBlob.writeRef()));
+        }
+
+        uint64_t loadTicks = 0;
+        uint64_t checkTicks = 0;
+        for (Index i = 0; i < loadCount; ++i)
+        {
+            ComPtr<slang::ISession> session;
+            SLANG_RETURN_ON_FAIL(createSession(compression.type, session));
+
+            auto startTick = Process::getClockTick();
+            session->isBinaryModuleUpToDate("moduleLoad.slang", moduleBlob);
+            checkTicks += Process::getClockTick() - startTick;
+
+            ComPtr<slang::IBlob> diagnostics;
+            startTick = Process::getClockTick();
+            auto module = session->loadModuleFromIRBlob(
+                "moduleLoad",
+                "moduleLoad.slang-module",
+                moduleBlob,
+                diagnostics.writeRef());
+            loadTicks += Process::getClockTick() - startTick;
+            if (!module)
+            {
+                return SLANG_FAIL;
+            }
+        }
+
+        printf(
+            "module-load: %s: %d bytes, load %f s, up to date check %f s\n",
+            compression.name,
+            int(moduleBlob->getBufferSize()),
+            _getSeconds(0, loadTicks) / loadCount,
+            _getSeconds(0, checkTicks) / loadCount);
+    }
+
+    return SLANG_OK;
+}
+
+static SlangResult _profileIRSerialize()
+{
+    const Index repeatCount = 20;
+
+    String source = _generateMaterialSource(1000);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
 
+    auto createSession = [&](bool viaData, ComPtr<slang::ISession>& outSession) -> SlangResult
+    {
+        slang::CompilerOptionEntry entry;
+        entry.name = slang::CompilerOptionName::SerialIRViaData;
+        entry.value.intValue0 = viaData ? 1 : 0;
+
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.compilerOptionEntries = &entry;
+        sessionDesc.compilerOptionEntryCount = 1;
+        return globalSession->createSession(sessionDesc, outSession.writeRef());
+    };
+
+    // Compare writing and reading IR directly, with going through the IRSerialData arrays.
+    // Both produce the same blob, so each is read back with the same path it was written with.
+    for (bool viaData : {true, false})
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(createSession(viaData, session));
+
+        ComPtr<slang::IBlob> diagnostics;
+        auto module = session->loadModuleFromSourceString(
+            "irSerialize",
+            "irSerialize.slang",
+            source.getBuffer(),
+            diagnostics.writeRef());
+        if (!module)
+        {
+            return SLANG_FAIL;
+        }
+
+        ComPtr<slang::IBlob> moduleBlob;
+        uint64_t writeTicks = 0;
+        for (Index i = 0; i < repeatCount; ++i)
+        {
+            moduleBlob.setNull();
+            auto startTick = Process::getClockTick();
+            SLANG_RETURN_ON_FAIL(module->serialize(moduleBlob.writeRef()));
+            writeTicks += Process::getClockTick() - startTick;
+        }
+
+        uint64_t readTicks = 0;
+        for (Index i = 0; i < repeatCount; ++i)
+        {
+            ComPtr<slang::ISession> readSession;
+            SLANG_RETURN_ON_FAIL(createSession(viaData, readSession));
+
+            auto startTick = Process::getClockTick();
+            auto readModule = readSession->loadModuleFromIRBlob(
+                "irSerialize",
+                "irSerialize.slang-module",
+                moduleBlob,
+                diagnostics.writeRef());
+            readTicks += Process::getClockTick() - startTick;
+            if (!readModule)
+            {
+                return SLANG_FAIL;
+            }
+        }
+
+        printf(
+            "ir-serialize: %s: %d bytes, write %f s, read %f s\n",
+            viaData ? "via IRSerialData" : "direct",
+            int(moduleBlob->getBufferSize()),
+            _getSeconds(0, writeTicks) / repeatCount,
+            _getSeconds(0, readTicks) / repeatCount);
+    }
+
+    return SLANG_OK;
+}
+
+static int _writeEnvironmentVariable(const char* key, const char* val)
+{
+#ifdef _WIN32
+    String var = String(key) + "=" + val;
+    return _putenv(var.getBuffer());
+#else
+    return setenv(key, val, 1);
+#endif
+}
+
+/* Time the overhead of the record layer on API calls, with recording off, and with each way of
+writing the records.
+
+A global session is created for each mode, as the record layer is set up when the global session
+is created. Many cheap calls show the cost per call, and compiling small programs shows the cost
+in a more typical use. The records are written to the 'slang-record' directory. */
+static SlangResult _profileRecordOverhead()
+{
+    const Index callCount = 20000;
+    const Index compileCount = 20;
+
+    const char* source = R"(
+        RWStructuredBuffer<float> gOutput;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            gOutput[tid.x] = gOutput[tid.x] * 2.0 + 1.0;
+        }
+        )";
+
+    struct Mode
+    {
+        const char* name;
+        const char* recordLayer;
+        const char* writeMode;
+    };
+    const Mode modes[] = {
+        {"off", "0", "sync"},
+        {"sync", "1", "sync"},
+        {"async", "1", "async"},
+        {"async-lz4", "1", "async-lz4"},
+    };
+
+    for (const auto& mode : modes)
+    {
+        _writeEnvironmentVariable("SLANG_RECORD_LAYER", mode.recordLayer);
+        _writeEnvironmentVariable("SLANG_RECORD_WRITE_MODE", mode.writeMode);
+
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_RETURN_ON_FAIL(
+            slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+
+        auto startTick = Process::getClockTick();
+        for (Index i = 0; i < callCount; ++i)
+        {
+            globalSession->findProfile("sm_5_0");
+        }
+        const auto callTicks = Process::getClockTick() - startTick;
+
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HLSL;
+        targetDesc.profile = globalSession->findProfile("sm_5_0");
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+
+        startTick = Process::getClockTick();
+        for (Index i = 0; i < compileCount; ++i)
+        {
+            ComPtr<slang::ISession> session;
+            SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+            ComPtr<slang::IBlob> diagnostics;
+            auto module = session->loadModuleFromSourceString(
+                "recordOverhead",
+                "recordOverhead.slang",
+                source,
+                diagnostics.writeRef());
+            if (!module)
+            {
+                return SLANG_FAIL;
+            }
+
+            ComPtr<slang::IEntryPoint> entryPoint;
+            SLANG_RETURN_ON_FAIL(
+                module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+            slang::IComponentType* components[] = {module, entryPoint.get()};
+            ComPtr<slang::IComponentType> program;
+            SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+                components,
+                2,
+                program.writeRef(),
+                diagnostics.writeRef()));
+
+            ComPtr<slang::IComponentType> linkedProgram;
+            SLANG_RETURN_ON_FAIL(program->link(linkedProgram.writeRef(), diagnostics.writeRef()));
+
+            ComPtr<slang::IBlob> code;
+            SLANG_RETURN_ON_FAIL(
+                linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()));
+        }
+        const auto compileTicks = Process::getClockTick() - startTick;
+
+        printf(
+            "record-overhead: %s: call %f us, compile %f s\n",
+            mode.name,
+            _getSeconds(0, callTicks) * 1000000.0 / callCount,
+            _getSeconds(0, compileTicks) / compileCount);
+    }
+
+    _writeEnvironmentVariable("SLANG_RECORD_LAYER", "0");
+    _writeEnvironmentVariable("SLANG_RECORD_WRITE_MODE", "sync");
+    return SLANG_OK;
+}
+
+/* Time the packing and unpacking of interface-typed values in host callable CPU code, with the
+natural AnyValue layout and with -tight-any-value-packing.
+
+Each thread makes a value of one of two types with narrow fields through a function that returns
+it as an interface, which packs it, and then calls a method on it, which unpacks it. The sum of
+the outputs is printed so that the results of the two layouts can be compared. */
+static SlangResult _profileAnyValuePacking()
+{
+    const Index threadCount = 4096;
+    const Index dispatchCount = 100;
+
+    const char* source = R"(
+        interface IMaterial
+        {
+            float shade(float x);
+        }
+
+        struct Plastic : IMaterial
+        {
+            uint8_t layer;
+            float roughness;
+            bool emissive;
+            int16_t id;
+            uint8_t flags;
+            int16_t group;
+
+            float shade(float x)
+            {
+                return x * roughness + layer + (emissive ? 1.0 : 0.0) + id + flags + group;
+            }
+        };
+
+        struct Metal : IMaterial
+        {
+            bool polished;
+            float tint;
+            uint8_t layer;
+            int16_t id;
+
+            float shade(float x) { return (polished ? x : -x) * tint + layer + id; }
+        };
+
+        [noinline]
+        IMaterial makeMaterial(uint kind, uint seed)
+        {
+            if (kind == 0)
+            {
+                Plastic plastic = {
+                    uint8_t(seed),
+                    float(seed & 15) * 0.5,
+                    (seed & 1) != 0,
+                    int16_t(seed & 255),
+                    uint8_t(seed >> 2),
+                    int16_t(-int(seed & 127)) };
+                return plastic;
+            }
+            Metal metal = {
+                (seed & 2) != 0,
+                float(seed & 7) * 0.25,
+                uint8_t(seed),
+                int16_t(seed & 63) };
+            return metal;
+        }
+
+        RWStructuredBuffer<float> gOutput;
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            float sum = 0.0;
+            for (uint i = 0; i < 64; i++)
+            {
+                IMaterial material = makeMaterial((tid.x + i) & 1, tid.x * 31 + i);
+                sum += material.shade(float(i));
+            }
+            gOutput[tid.x] = sum;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+
+    struct UniformState
+    {
+        CPPPrelude::RWStructuredBuffer<float> output;
+    };
+    List<float> output;
+    output.setCount(threadCount);
+
+    for (auto tightPacking : {false, true})
+    {
+        slang::CompilerOptionEntry entry;
+        entry.name = slang::CompilerOptionName::TightAnyValuePacking;
+        entry.value.intValue0 = tightPacking ? 1 : 0;
+
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_SHADER_HOST_CALLABLE;
+        targetDesc.compilerOptionEntries = &entry;
+        targetDesc.compilerOptionEntryCount = 1;
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+        ComPtr<slang::IBlob> diagnostics;
+        auto module = session->loadModuleFromSourceString(
+            "anyValuePacking",
+            "anyValuePacking.slang",
+            source,
+            diagnostics.writeRef());
+        if (!module)
+        {
+            return SLANG_FAIL;
+        }
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+        slang::IComponentType* components[] = {module, entryPoint.get()};
+        ComPtr<slang::IComponentType> program;
+        SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+            components,
+            2,
+            program.writeRef(),
+            diagnostics.writeRef()));
+
+        ComPtr<ISlangSharedLibrary> sharedLibrary;
+        SLANG_RETURN_ON_FAIL(program->getEntryPointHostCallable(
+            0,
+            0,
+            sharedLibrary.writeRef(),
+            diagnostics.writeRef()));
+        auto func = (CPPPrelude::ComputeFunc)sharedLibrary->findFuncByName("computeMain");
+        if (!func)
+        {
+            return SLANG_FAIL;
+        }
+
+        UniformState uniformState;
+        uniformState.output.data = output.getBuffer();
+        uniformState.output.count = size_t(threadCount);
+
+        CPPPrelude::ComputeVaryingInput varyingInput = {};
+        varyingInput.endGroupID = {uint32_t(threadCount / 64), 1, 1};
+
+        const auto startTick = Process::getClockTick();
+        for (Index i = 0; i < dispatchCount; ++i)
+        {
+            func(&varyingInput, nullptr, &uniformState);
+        }
         const auto endTick = Process::getClockTick();
 
-        printf("Ticks %f\n", double(endTick - startTick) / Process::getClockFrequency());
-        return SLANG_OK;
+        double sum = 0.0;
+        for (auto value : output)
+        {
+            sum += value;
+        }
+
+        // Each thread packs and unpacks 64 values.
+        const Index valueCount = threadCount * 64 * dispatchCount;
+        printf(
+            "any-value-packing: %s: %f ns per value (output sum %f)\n",
+            tightPacking ? "tight" : "natural",
+            _getSeconds(startTick, endTick) * 1000000000.0 / double(valueCount),
+            sum);
+    }
+
+    return SLANG_OK;
+}
+
+struct ProfileInfo
+{
+    const char* name;
+    SlangResult (*func)();
+};
+
+static const ProfileInfo kProfiles[] = {
+    {"session-creation", &_profileSessionCreation},
+    {"type-layout", &_profileTypeLayout},
+    {"json-rpc", &_profileJSONRPC},
+    {"module-load", &_profileModuleLoad},
+    {"ir-serialize", &_profileIRSerialize},
+    {"record-overhead", &_profileRecordOverhead},
+    {"any-value-packing", &_profileAnyValuePacking},
+};
+
+SlangResult innerMain(int argc, char** argv)
+{
+    auto stdWriters = StdWriters::initDefaultSingleton();
+
+    // With no arguments, just profile session creation
+    if (argc <= 1)
+    {
+        return _profileSessionCreation();
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice name(argv[i]);
+
+        const ProfileInfo* found = nullptr;
+        for (const auto& profile : kProfiles)
+        {
+            if (name == profile.name || name == "all")
+            {
+                found = &profile;
+                SLANG_RETURN_ON_FAIL(profile.func());
+            }
+        }
+
+        if (!found)
+        {
+            printf("Unknown profile '%s'. Available profiles:\n", argv[i]);
+            for (const auto& profile : kProfiles)
+            {
+                printf("  %s\n", profile.name);
+            }
+            return SLANG_FAIL;
+        }
     }
 
     return SLANG_OK;
@@ -1981,6 +1981,26 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
             }
             return SLANG_OK;
     };
+    auto waitForDiagnostics = [&]() -> SlangResult
+    {
+        while (!diagnosticsReceived)
+        {
+            SLANG_RETURN_ON_FAIL(connection->waitForResult(-1));
+            if (connection->getMessageType() == JSONRPCMessageType::Call)
+            {
+                JSONRPCCall call;
+                connection->getRPC(&call);
+                if (call.method == "textDocument/publishDiagnostics")
+                {
+                    diagnosticsReceived = true;
+                    LanguageServerProtocol::PublishDiagnosticsParams arg;
+                    SLANG_RETURN_ON_FAIL(connection->getMessage(&arg));
+                    diagnostics.add(arg);
+                }
+            }
+        }
+        return SLANG_OK;
+    };
 
     List<UnownedStringSlice> lines;
     StringUtil::calcLines(testFileContent.getUnownedSlice(), lines);
@@ -2109,12 +2129,51 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 actualOutputSB << "\ncontent:\n" << hover.contents.value << "\n";
             }
         }
-        else if (line.startsWith("//DIAGNOSTICS"))
+        else if (line.startsWith("//CANCEL_HOVER:"))
         {
-            if (!diagnosticsReceived)
+            auto arg = line.tail(UnownedStringSlice("//CANCEL_HOVER:").getLength());
+            Int linePos, colPos;
+            parseLocation(arg, 0, linePos, colPos);
+
+            // The cancellation is sent before the request, so the result doesn't depend on
+            // whether the server reads both messages at once.
+            LanguageServerProtocol::CancelParams cancelParams;
+            cancelParams.id = callId;
+            if (SLANG_FAILED(
+                    connection->sendCall(UnownedStringSlice("$/cancelRequest"), &cancelParams)))
+            {
+                return TestResult::Fail;
+            }
+
+            LanguageServerProtocol::HoverParams params;
+            params.position.line = int(linePos - 1);
+            params.position.character = int(colPos - 1);
+            params.textDocument.uri = openDocParams.textDocument.uri;
+            if (SLANG_FAILED(connection->sendCall(
+                    LanguageServerProtocol::HoverParams::methodName,
+                    &params,
+                    JSONValue::makeInt(callId++))))
+            {
+                return TestResult::Fail;
+            }
+            if (SLANG_FAILED(waitForNonDiagnosticResponse()))
+                return TestResult::Fail;
+            actualOutputSB << "--------\n";
+            JSONRPCErrorResponse errorResponse;
+            if (connection->getMessageType() == JSONRPCMessageType::Error &&
+                SLANG_SUCCEEDED(connection->getRPC(&errorResponse)))
+            {
+                actualOutputSB << "error: " << errorResponse.error.code << "\n";
+            }
+            else
             {
-                waitForNonDiagnosticResponse();
+                actualOutputSB << "not canceled\n";
             }
+        }
+        else if (line.startsWith("//DIAGNOSTICS"))
+        {
+            if (SLANG_FAILED(waitForDiagnostics()))
+                return TestResult::Fail;
             actualOutputSB << "--------\n";
             for (auto item : diagnostics)
             {
@@ -4727,6 +4786,11 @@ SlangResult innerMain(int argc, char** argv)
     auto ptr32Category = categorySet.add("32-bit", fullTestCategory);
 #endif
 
+#if SLANG_PROCESSOR_X86_64
+    // Tests that rely on the x86-64 only fiber support of the CPU prelude.
+    categorySet.add("x86-64", fullTestCategory);
+#endif
+
     // An un-categorized test will always belong to the `full` category
     categorySet.defaultCategory = fullTestCategory;
 
@@ -0,0 +1,215 @@
+// unit-test-batch-compile.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test compiling several entry points, specializations and targets with
+// `ISession::compileBatch`.
+
+static const char* kBatchCompileSource = R"(
+    interface IMaterial
+    {
+        float4 eval();
+    }
+
+    struct Red : IMaterial
+    {
+        float4 eval() { return float4(1, 0, 0, 1); }
+    }
+
+    struct Blue : IMaterial
+    {
+        float4 eval() { return float4(0, 0, 1, 1); }
+    }
+
+    RWStructuredBuffer<float4> gOutput;
+
+    [numthreads(1, 1, 1)]
+    void shadeMain<M : IMaterial>(uniform M material)
+    {
+        gOutput[0] = material.eval();
+    }
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void clearMain()
+    {
+        gOutput[0] = float4(0);
+    }
+    )";
+
+static bool _contains(slang::IBlob* blob, const char* text)
+{
+    if (!blob)
+        return false;
+    UnownedStringSlice slice((const char*)blob->getBufferPointer(), blob->getBufferSize());
+    return slice.indexOf(UnownedStringSlice(text)) >= 0;
+}
+
+SLANG_UNIT_TEST(batchCompile)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDescs[2] = {};
+    targetDescs[0].format = SLANG_HLSL;
+    targetDescs[0].profile = globalSession->findProfile("sm_5_0");
+    targetDescs[1].format = SLANG_GLSL;
+    targetDescs[1].profile = globalSession->findProfile("glsl_450");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 2;
+    sessionDesc.targets = targetDescs;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "batchCompile",
+        "batchCompile.slang",
+        kBatchCompileSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    auto layout = module->getLayout();
+    slang::SpecializationArg red =
+        slang::SpecializationArg::fromType(layout->findTypeByName("Red"));
+    slang::SpecializationArg blue =
+        slang::SpecializationArg::fromType(layout->findTypeByName("Blue"));
+    SLANG_CHECK_ABORT(red.type && blue.type);
+
+    const Index kRequestCount = 6;
+    slang::BatchCompileRequest requests[kRequestCount];
+    for (auto& request : requests)
+    {
+        request.module = module;
+        request.entryPointName = "shadeMain";
+        request.stage = SLANG_STAGE_COMPUTE;
+    }
+    requests[0].specializationArgs = &red;
+    requests[0].specializationArgCount = 1;
+    requests[1].specializationArgs = &blue;
+    requests[1].specializationArgCount = 1;
+    // The same as the first request
+    requests[2] = requests[0];
+    // The same program for another target
+    requests[3] = requests[0];
+    requests[3].targetIndex = 1;
+    // An entry point found by its attribute
+    requests[4].entryPointName = "clearMain";
+    requests[4].stage = SLANG_STAGE_NONE;
+    // An entry point that doesn't exist
+    requests[5].entryPointName = "missingMain";
+
+    slang::BatchCompileResult results[kRequestCount];
+    SLANG_CHECK(session->compileBatch(requests, kRequestCount, results) == SLANG_FAIL);
+
+    for (Index i = 0; i < 5; ++i)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(results[i].result));
+        SLANG_CHECK(results[i].code != nullptr);
+    }
+
+    // Each request gets the code for its own specialization and target
+    SLANG_CHECK(_contains(results[0].code, "Red"));
+    SLANG_CHECK(_contains(results[1].code, "Blue"));
+    SLANG_CHECK(results[0].code != results[1].code);
+    SLANG_CHECK(_contains(results[3].code, "#version"));
+    SLANG_CHECK(!_contains(results[0].code, "#version"));
+
+    // Requests that are the same share their code
+    SLANG_CHECK(results[2].code == results[0].code);
+
+    // A request that fails doesn't stop the others, and reports why it failed
+    SLANG_CHECK(SLANG_FAILED(results[5].result));
+    SLANG_CHECK(results[5].code == nullptr);
+    SLANG_CHECK(_contains(results[5].diagnostics, "missingMain"));
+
+    for (auto& result : results)
+    {
+        if (result.code)
+            result.code->release();
+        if (result.diagnostics)
+            result.diagnostics->release();
+    }
+}
+
+// Test a batch whose code is compiled by a downstream compiler, where the compiles of the
+// different requests run at the same time.
+SLANG_UNIT_TEST(batchCompileDownstream)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    const SlangPassThrough compiler = globalSession->getDownstreamCompilerForTransition(
+        SLANG_CPP_SOURCE,
+        SLANG_SHADER_SHARED_LIBRARY);
+    if (compiler == SLANG_PASS_THROUGH_NONE ||
+        SLANG_FAILED(globalSession->checkPassThroughSupport(compiler)))
+    {
+        SLANG_IGNORE_TEST;
+    }
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SHADER_SHARED_LIBRARY;
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "batchCompileDownstream",
+        "batchCompileDownstream.slang",
+        kBatchCompileSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    auto layout = module->getLayout();
+    slang::SpecializationArg red =
+        slang::SpecializationArg::fromType(layout->findTypeByName("Red"));
+    slang::SpecializationArg blue =
+        slang::SpecializationArg::fromType(layout->findTypeByName("Blue"));
+    SLANG_CHECK_ABORT(red.type && blue.type);
+
+    const Index kRequestCount = 4;
+    slang::BatchCompileRequest requests[kRequestCount];
+    for (auto& request : requests)
+    {
+        request.module = module;
+        request.entryPointName = "shadeMain";
+        request.stage = SLANG_STAGE_COMPUTE;
+    }
+    requests[0].specializationArgs = &red;
+    requests[0].specializationArgCount = 1;
+    requests[1].specializationArgs = &blue;
+    requests[1].specializationArgCount = 1;
+    // The same as the first request
+    requests[2] = requests[0];
+    requests[3].entryPointName = "clearMain";
+    requests[3].stage = SLANG_STAGE_NONE;
+
+    slang::BatchCompileResult results[kRequestCount];
+    SLANG_CHECK(session->compileBatch(requests, kRequestCount, results) == SLANG_OK);
+
+    for (auto& result : results)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(result.result));
+        SLANG_CHECK(result.code != nullptr && result.code->getBufferSize() != 0);
+    }
+    SLANG_CHECK(results[0].code != results[1].code);
+    SLANG_CHECK(results[2].code == results[0].code);
+
+    for (auto& result : results)
+    {
+        if (result.code)
+            result.code->release();
+        if (result.diagnostics)
+            result.diagnostics->release();
+    }
+}
@@ -0,0 +1,240 @@
+// unit-test-cpu-group-barriers.cpp
+
+#include "../../source/core/slang-common.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Returns the definition of the function `name` in the C++ `code`.
+static UnownedStringSlice _findFuncDefinition(UnownedStringSlice code, const char* name)
+{
+    const Index start = code.indexOf(UnownedStringSlice(name));
+    if (start == -1)
+        return UnownedStringSlice();
+    const auto rest = code.tail(start);
+    const Index end = rest.indexOf(toSlice("\n}\n"));
+    return end == -1 ? rest : rest.head(end);
+}
+
+// Shader shared by the tests: `withBarrier` reverses the group thread indices through group
+// shared memory, `withoutBarrier` never synchronizes.
+static const char* kGroupBarriersSource = R"(
+        RWStructuredBuffer<int> outputBuffer;
+        groupshared int gValues[4];
+
+        [noinline]
+        void syncGroup()
+        {
+            GroupMemoryBarrierWithGroupSync();
+        }
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void withBarrier(uint groupIndex : SV_GroupIndex)
+        {
+            gValues[groupIndex] = int(groupIndex);
+            syncGroup();
+            outputBuffer[groupIndex] = gValues[3 - groupIndex];
+        }
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void withoutBarrier(uint groupIndex : SV_GroupIndex)
+        {
+            outputBuffer[groupIndex] = int(groupIndex);
+        }
+        )";
+
+// Test that when a CPU program has several entry points, only the ones that synchronize the
+// threads of a group, including through the functions they call, run the threads on fibers.
+//
+SLANG_UNIT_TEST(cpuGroupBarriers)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_CPP_SOURCE;
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        kGroupBarriersSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK(module != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    module->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK(linkedProgram != nullptr);
+
+    ComPtr<slang::IBlob> code;
+    linkedProgram->getTargetCode(0, code.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK(code != nullptr);
+
+    UnownedStringSlice resultStr = UnownedStringSlice((char*)code->getBufferPointer());
+
+    auto withBarrier = _findFuncDefinition(resultStr, "withBarrier_Group(");
+    auto withoutBarrier = _findFuncDefinition(resultStr, "withoutBarrier_Group(");
+    SLANG_CHECK(withBarrier.getLength() != 0);
+    SLANG_CHECK(withoutBarrier.getLength() != 0);
+    SLANG_CHECK(withBarrier.indexOf(toSlice("_slang_runGroupFibers")) != -1);
+    SLANG_CHECK(withoutBarrier.indexOf(toSlice("_slang_runGroupFibers")) == -1);
+}
+
+namespace
+{ // anonymous
+
+// Mirrors the prelude's `ComputeVaryingInput`.
+struct GroupRange
+{
+    uint32_t startGroupID[3];
+    uint32_t endGroupID[3];
+};
+
+// Mirrors the global parameters of `kGroupBarriersSource`.
+struct GroupBarriersGlobals
+{
+    int32_t* data;
+    size_t count;
+};
+
+typedef void (*ComputeFunc)(GroupRange*, void*, void*);
+
+// Compiles `withBarrier` to host callable code with whatever downstream compiler is currently
+// selected, runs a single group and checks the threads saw each other's writes.
+static void _runWithBarrier(slang::IGlobalSession* globalSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SHADER_HOST_CALLABLE;
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        kGroupBarriersSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("withBarrier", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> composedProgram;
+    session->createCompositeComponentType(
+        components,
+        SLANG_COUNT_OF(components),
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(composedProgram != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(linkedProgram != nullptr);
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    linkedProgram->getEntryPointHostCallable(
+        0,
+        0,
+        sharedLibrary.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(sharedLibrary != nullptr);
+
+    auto func = (ComputeFunc)sharedLibrary->findFuncByName("withBarrier");
+    SLANG_CHECK_ABORT(func != nullptr);
+
+    int32_t data[4] = {-1, -1, -1, -1};
+    GroupBarriersGlobals globals = {data, SLANG_COUNT_OF(data)};
+    GroupRange range = {{0, 0, 0}, {1, 1, 1}};
+    func(&range, nullptr, &globals);
+
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        SLANG_CHECK(data[i] == 3 - i);
+    }
+}
+
+} // namespace
+
+// Test that a kernel with a group barrier runs correctly on the CPU, both when the generated C++
+// is built by a regular C++ compiler and when it is JIT compiled by slang-llvm.
+//
+SLANG_UNIT_TEST(cpuGroupBarriersRun)
+{
+    // Fibers are only implemented for x86-64, elsewhere the kernel is expected to fail to build.
+    if (!SLANG_PROCESSOR_X86_64)
+    {
+        SLANG_IGNORE_TEST;
+    }
+
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    const SlangPassThrough previousDefaultCompiler =
+        globalSession->getDefaultDownstreamCompiler(SLANG_SOURCE_LANGUAGE_CPP);
+    const SlangPassThrough previousHostCallableCompiler =
+        globalSession->getDownstreamCompilerForTransition(
+            SLANG_CPP_SOURCE,
+            SLANG_SHADER_HOST_CALLABLE);
+    SLANG_DEFER_LAMBDA(
+        [&]()
+        {
+            globalSession->setDefaultDownstreamCompiler(
+                SLANG_SOURCE_LANGUAGE_CPP,
+                previousDefaultCompiler);
+            globalSession->setDownstreamCompilerForTransition(
+                SLANG_CPP_SOURCE,
+                SLANG_SHADER_HOST_CALLABLE,
+                previousHostCallableCompiler);
+        });
+
+    const SlangPassThrough compilers[] = {
+        SLANG_PASS_THROUGH_VISUAL_STUDIO,
+        SLANG_PASS_THROUGH_GCC,
+        SLANG_PASS_THROUGH_CLANG,
+        SLANG_PASS_THROUGH_LLVM,
+    };
+
+    bool ranAny = false;
+    bool ranCpp = false;
+    for (const auto compiler : compilers)
+    {
+        // One regular C++ compiler is enough, but slang-llvm is always tried when present.
+        const bool isLlvm = compiler == SLANG_PASS_THROUGH_LLVM;
+        if ((!isLlvm && ranCpp) || SLANG_FAILED(globalSession->checkPassThroughSupport(compiler)))
+            continue;
+
+        if (!isLlvm)
+        {
+            globalSession->setDefaultDownstreamCompiler(SLANG_SOURCE_LANGUAGE_CPP, compiler);
+        }
+        globalSession->setDownstreamCompilerForTransition(
+            SLANG_CPP_SOURCE,
+            SLANG_SHADER_HOST_CALLABLE,
+            compiler);
+
+        _runWithBarrier(globalSession);
+
+        ranAny = true;
+        ranCpp = ranCpp || !isLlvm;
+    }
+
+    if (!ranAny)
+    {
+        SLANG_IGNORE_TEST;
+    }
+}
@@ -0,0 +1,102 @@
+// unit-test-json-rpc-connection.cpp
+
+#include "../../source/compiler-core/slang-json-rpc-connection.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test reading a sequence of messages through a JSONRPCConnection, where the parsed values
+// reference the text of the message.
+
+static void _appendPacket(const char* content, List<Byte>& ioBytes)
+{
+    const size_t contentSize = ::strlen(content);
+
+    StringBuilder buf;
+    HTTPHeader header;
+    header.m_contentLength = contentSize;
+    header.append(buf);
+    buf.append(content);
+
+    ioBytes.addRange((const Byte*)buf.getBuffer(), buf.getLength());
+}
+
+SLANG_UNIT_TEST(jsonRPCConnection)
+{
+    List<Byte> bytes;
+    _appendPacket(
+        R"({"jsonrpc":"2.0","id":1,"method":"textDocument/didChange",)"
+        R"("params":{"text":"a \"quoted\"\nline","key":"plain"}})",
+        bytes);
+    // Byte order mark at the start
+    _appendPacket(
+        "\xef\xbb\xbf"
+        R"({"jsonrpc":"2.0","id":2,"method":"textDocument/hover","params":{"line":3}})",
+        bytes);
+    _appendPacket(R"({"jsonrpc":"2.0","id":3,"method":"broken",)", bytes);
+    _appendPacket(R"({"jsonrpc":"2.0","id":4,"method":"shutdown"})", bytes);
+
+    RefPtr<OwnedMemoryStream> readStream = new OwnedMemoryStream(FileAccess::Read);
+    readStream->swapContents(bytes);
+    RefPtr<OwnedMemoryStream> writeStream = new OwnedMemoryStream(FileAccess::Write);
+
+    RefPtr<HTTPPacketConnection> packetConnection =
+        new HTTPPacketConnection(new BufferedReadStream(readStream), writeStream);
+
+    RefPtr<JSONRPCConnection> connection = new JSONRPCConnection;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->init(packetConnection)));
+
+    auto container = connection->getContainer();
+
+    // Strings are unescaped when they are read, and keys are found with or without escapes
+    String text;
+    {
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->waitForResult(1000)));
+        SLANG_CHECK_ABORT(connection->hasMessage());
+        SLANG_CHECK(connection->getMessageType() == JSONRPCMessageType::Call);
+
+        JSONRPCCall call;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->getRPC(&call)));
+        SLANG_CHECK(call.method == "textDocument/didChange");
+        SLANG_CHECK(container->asInteger(call.id) == 1);
+
+        auto textValue =
+            container->findObjectValue(call.params, container->getKey(toSlice("text")));
+        text = container->getTransientString(textValue);
+        SLANG_CHECK(text == "a \"quoted\"\nline");
+
+        auto keyValue =
+            container->findObjectValue(call.params, container->getKey(toSlice("key")));
+        SLANG_CHECK(container->getTransientString(keyValue) == "plain");
+    }
+
+    {
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->waitForResult(1000)));
+        SLANG_CHECK_ABORT(connection->hasMessage());
+
+        JSONRPCCall call;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->getRPC(&call)));
+        SLANG_CHECK(call.method == "textDocument/hover");
+        SLANG_CHECK(container->asInteger(call.id) == 2);
+
+        auto lineValue =
+            container->findObjectValue(call.params, container->getKey(toSlice("line")));
+        SLANG_CHECK(container->asInteger(lineValue) == 3);
+    }
+
+    // Invalid JSON isn't a message, but doesn't stop the following messages being read
+    connection->waitForResult(1000);
+    SLANG_CHECK(!connection->hasMessage());
+
+    {
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->waitForResult(1000)));
+        SLANG_CHECK_ABORT(connection->hasMessage());
+
+        JSONRPCCall call;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->getRPC(&call)));
+        SLANG_CHECK(call.method == "shutdown");
+    }
+
+    // What was copied out of the first message is unaffected by reading the others
+    SLANG_CHECK(text == "a \"quoted\"\nline");
+}
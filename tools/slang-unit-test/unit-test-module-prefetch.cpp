@@ -0,0 +1,166 @@
+// unit-test-module-prefetch.cpp
+
+#include "core/slang-memory-file-system.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test loading a precompiled module that imports other precompiled modules. The imported
+// modules are found from the module headers, read ahead of the module that imports them, and
+// loaded in dependency order.
+
+// A file system that records the order in which files are loaded
+class LoadRecordingFileSystem : public MemoryFileSystem
+{
+public:
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(char const* path, ISlangBlob** outBlob)
+        SLANG_OVERRIDE
+    {
+        loadedPaths.add(path);
+        return MemoryFileSystem::loadFile(path, outBlob);
+    }
+
+    /// Get the index of the first load of a file with the name `fileName`, or -1
+    Index indexOfLoad(const char* fileName)
+    {
+        for (Index i = 0; i < loadedPaths.getCount(); ++i)
+        {
+            if (loadedPaths[i].endsWith(UnownedStringSlice(fileName)))
+                return i;
+        }
+        return -1;
+    }
+
+    List<String> loadedPaths;
+};
+
+static const char* kPrefetchBaseSource = R"(
+    module prefetch_base;
+
+    public int baseValue(int x) { return x * 2; }
+    )";
+
+static const char* kPrefetchMiddleSource = R"(
+    module prefetch_middle;
+    import prefetch_base;
+
+    public int middleValue(int x) { return baseValue(x) + 1; }
+    )";
+
+static const char* kPrefetchTopSource = R"(
+    module prefetch_top;
+    import prefetch_middle;
+
+    RWStructuredBuffer<int> gOutput;
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void computeMain()
+    {
+        gOutput[0] = middleValue(gOutput[0]);
+    }
+    )";
+
+SLANG_UNIT_TEST(modulePrefetch)
+{
+    ComPtr<LoadRecordingFileSystem> memoryFileSystem(new LoadRecordingFileSystem());
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.fileSystem = memoryFileSystem;
+
+    // Precompile the modules to files
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        struct ModuleSource
+        {
+            const char* name;
+            const char* source;
+        };
+        const ModuleSource moduleSources[] = {
+            {"prefetch_base", kPrefetchBaseSource},
+            {"prefetch_middle", kPrefetchMiddleSource},
+            {"prefetch_top", kPrefetchTopSource},
+        };
+        for (auto& moduleSource : moduleSources)
+        {
+            ComPtr<slang::IBlob> diagnosticBlob;
+            auto module = session->loadModuleFromSourceString(
+                moduleSource.name,
+                (String(moduleSource.name) + ".slang").getBuffer(),
+                moduleSource.source,
+                diagnosticBlob.writeRef());
+            SLANG_CHECK_ABORT(module != nullptr);
+
+            ComPtr<slang::IBlob> moduleBlob;
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(moduleBlob.writeRef())));
+            memoryFileSystem->saveFile(
+                (String(moduleSource.name) + ".slang-module").getBuffer(),
+                moduleBlob->getBufferPointer(),
+                moduleBlob->getBufferSize());
+        }
+    }
+
+    // Load the top module in a new session, which loads the modules it imports with it. This is
+    // done with the modules read on as many threads as there are hardware threads, and on one.
+    for (int threadCount = 0; threadCount <= 1; ++threadCount)
+    {
+        slang::CompilerOptionEntry threadCountEntry;
+        threadCountEntry.name = slang::CompilerOptionName::ModuleLoadThreadCount;
+        threadCountEntry.value.intValue0 = threadCount;
+        slang::SessionDesc loadSessionDesc = sessionDesc;
+        loadSessionDesc.compilerOptionEntries = &threadCountEntry;
+        loadSessionDesc.compilerOptionEntryCount = 1;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(loadSessionDesc, session.writeRef()) == SLANG_OK);
+
+        memoryFileSystem->loadedPaths.clear();
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModule("prefetch_top", diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+        SLANG_CHECK(session->getLoadedModuleCount() == 3);
+
+        // The top module only refers to `prefetch_middle`, so without reading ahead
+        // `prefetch_base` would only be found while reading `prefetch_middle`. Reading ahead
+        // finds all of the imports from the header of the top module, which lists them in
+        // dependency order.
+        const Index baseIndex = memoryFileSystem->indexOfLoad("prefetch_base.slang-module");
+        const Index middleIndex = memoryFileSystem->indexOfLoad("prefetch_middle.slang-module");
+        SLANG_CHECK(baseIndex >= 0 && middleIndex >= 0);
+        SLANG_CHECK(baseIndex < middleIndex);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        module->findEntryPointByName("computeMain", entryPoint.writeRef());
+        SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+        ComPtr<slang::IComponentType> program;
+        slang::IComponentType* components[] = {module, entryPoint.get()};
+        session->createCompositeComponentType(
+            components,
+            2,
+            program.writeRef(),
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(program != nullptr);
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        program->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(linkedProgram != nullptr);
+
+        ComPtr<slang::IBlob> code;
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef());
+        SLANG_CHECK(code != nullptr && code->getBufferSize() > 0);
+    }
+}
@@ -450,4 +450,12 @@ SLANG_UNIT_TEST(RecordReplay)
     SLANG_CHECK(SLANG_SUCCEEDED(runTests(unitTestContext)));
 }
 
+SLANG_UNIT_TEST(RecordReplayAsync)
+{
+    // Record with the records written by a background thread as LZ4 frames
+    SLANG_CHECK(writeEnvironmentVariable("SLANG_RECORD_WRITE_MODE", "async-lz4") == 0);
+    SLANG_CHECK(SLANG_SUCCEEDED(runTest(unitTestContext, "cpu-hello-world")));
+    writeEnvironmentVariable("SLANG_RECORD_WRITE_MODE", "sync");
+}
+
 #endif
@@ -0,0 +1,215 @@
+// unit-test-reflection-binary.cpp
+
+#include "slang-com-ptr.h"
+#include "slang-reflection-blob.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that the binary reflection blob can be read with the accessors in slang-reflection-blob.h,
+// and agrees with the reflection API.
+
+SLANG_UNIT_TEST(reflectionBinary)
+{
+    const char* userSourceBody = R"(
+        struct Material
+        {
+            float4 color;
+            float roughness;
+            Texture2D albedo;
+        };
+
+        ConstantBuffer<Material> gMaterial;
+        RWStructuredBuffer<float4> gOutput;
+        SamplerState gSamplers[4];
+
+        [numthreads(4, 2, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            gOutput[tid.x] = gMaterial.color * gMaterial.roughness
+                + gMaterial.albedo.SampleLevel(gSamplers[tid.y], float2(0, 0), 0);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findAndCheckEntryPoint(
+        "computeMain",
+        SLANG_STAGE_COMPUTE,
+        entryPoint.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(compositeProgram != nullptr);
+
+    auto layout = compositeProgram->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toBinary(blob.writeRef())));
+
+    // Everything below only uses the blob.
+    auto header = slangReflectionBlob_getHeader(blob->getBufferPointer(), blob->getBufferSize());
+    SLANG_CHECK_ABORT(header != nullptr);
+    SLANG_CHECK(header->parameterCount == layout->getParameterCount());
+
+    // A truncated blob is rejected
+    SLANG_CHECK(
+        slangReflectionBlob_getHeader(blob->getBufferPointer(), blob->getBufferSize() - 4) ==
+        nullptr);
+
+    // The constant buffer, and the layout of its contents
+    {
+        auto param = slangReflectionBlob_findParameter(header, "gMaterial");
+        SLANG_CHECK_ABORT(param != nullptr);
+
+        // Parameters are in the same order as the reflection API
+        const uint32_t index = uint32_t(param - slangReflectionBlob_getParameter(header, 0));
+        auto reflected = layout->getParameterByIndex(index);
+        SLANG_CHECK_ABORT(reflected != nullptr);
+        SLANG_CHECK(strcmp(reflected->getName(), "gMaterial") == 0);
+
+        uint32_t space = ~0u;
+        const uint32_t binding = slangReflectionBlob_getVarLayoutOffset(
+            header,
+            param,
+            SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER,
+            &space);
+        SLANG_CHECK(binding == reflected->getOffset(SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER));
+        SLANG_CHECK(space == reflected->getBindingSpace(SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER));
+
+        auto typeLayout = slangReflectionBlob_getTypeLayout(header, param->typeLayout);
+        SLANG_CHECK_ABORT(typeLayout != nullptr);
+        SLANG_CHECK(typeLayout->kind == SLANG_TYPE_KIND_CONSTANT_BUFFER);
+
+        auto elementTypeLayout =
+            slangReflectionBlob_getTypeLayout(header, typeLayout->elementTypeLayout);
+        SLANG_CHECK_ABORT(elementTypeLayout != nullptr);
+        SLANG_CHECK(elementTypeLayout->kind == SLANG_TYPE_KIND_STRUCT);
+        SLANG_CHECK(
+            strcmp(slangReflectionBlob_getString(header, elementTypeLayout->name), "Material") ==
+            0);
+        SLANG_CHECK(elementTypeLayout->fieldCount == 3);
+
+        auto reflectedElement = reflected->getTypeLayout()->getElementTypeLayout();
+        SLANG_CHECK(
+            slangReflectionBlob_getTypeLayoutSize(
+                header,
+                elementTypeLayout,
+                SLANG_PARAMETER_CATEGORY_UNIFORM) ==
+            reflectedElement->getSize(SLANG_PARAMETER_CATEGORY_UNIFORM));
+
+        auto roughness = slangReflectionBlob_getField(header, elementTypeLayout, 1);
+        SLANG_CHECK_ABORT(roughness != nullptr);
+        SLANG_CHECK(
+            strcmp(slangReflectionBlob_getString(header, roughness->name), "roughness") == 0);
+        SLANG_CHECK(
+            slangReflectionBlob_getVarLayoutOffset(
+                header,
+                roughness,
+                SLANG_PARAMETER_CATEGORY_UNIFORM,
+                nullptr) ==
+            reflectedElement->getFieldByIndex(1)->getOffset(SLANG_PARAMETER_CATEGORY_UNIFORM));
+
+        SLANG_CHECK(slangReflectionBlob_getField(header, elementTypeLayout, 3) == nullptr);
+    }
+
+    // The descriptor layout of the global scope matches
+    {
+        auto globals = slangReflectionBlob_getVarLayout(header, header->globalParamsVarLayout);
+        SLANG_CHECK_ABORT(globals != nullptr);
+        auto globalsTypeLayout = slangReflectionBlob_getTypeLayout(header, globals->typeLayout);
+        SLANG_CHECK_ABORT(globalsTypeLayout != nullptr);
+
+        auto reflected = layout->getGlobalParamsTypeLayout();
+        SLANG_CHECK_ABORT(
+            globalsTypeLayout->bindingRangeCount == uint32_t(reflected->getBindingRangeCount()));
+        for (uint32_t i = 0; i < globalsTypeLayout->bindingRangeCount; ++i)
+        {
+            auto range = slangReflectionBlob_getBindingRange(header, globalsTypeLayout, i);
+            SLANG_CHECK_ABORT(range != nullptr);
+            SLANG_CHECK(range->bindingType == uint32_t(reflected->getBindingRangeType(i)));
+            SLANG_CHECK(
+                range->bindingCount == uint32_t(reflected->getBindingRangeBindingCount(i)));
+        }
+
+        SLANG_CHECK_ABORT(
+            globalsTypeLayout->descriptorSetCount == uint32_t(reflected->getDescriptorSetCount()));
+        for (uint32_t i = 0; i < globalsTypeLayout->descriptorSetCount; ++i)
+        {
+            auto set = slangReflectionBlob_getDescriptorSet(header, globalsTypeLayout, i);
+            SLANG_CHECK_ABORT(set != nullptr);
+            SLANG_CHECK(
+                set->descriptorRangeCount ==
+                uint32_t(reflected->getDescriptorSetDescriptorRangeCount(i)));
+            for (uint32_t j = 0; j < set->descriptorRangeCount; ++j)
+            {
+                auto range = slangReflectionBlob_getDescriptorRange(header, set, j);
+                SLANG_CHECK_ABORT(range != nullptr);
+                SLANG_CHECK(
+                    range->indexOffset ==
+                    uint32_t(reflected->getDescriptorSetDescriptorRangeIndexOffset(i, j)));
+                SLANG_CHECK(
+                    range->bindingType ==
+                    uint32_t(reflected->getDescriptorSetDescriptorRangeType(i, j)));
+            }
+        }
+    }
+
+    // The entry point
+    {
+        const uint32_t entryPointCount =
+            slangReflectionBlob_getRecordCount(header, SLANG_REFLECTION_BLOB_SECTION_ENTRY_POINTS);
+        SLANG_CHECK(entryPointCount == 1);
+        auto entryPointRecord = slangReflectionBlob_getEntryPoint(header, 0);
+        SLANG_CHECK_ABORT(entryPointRecord != nullptr);
+        SLANG_CHECK(
+            strcmp(slangReflectionBlob_getString(header, entryPointRecord->name), "computeMain") ==
+            0);
+        SLANG_CHECK(entryPointRecord->stage == SLANG_STAGE_COMPUTE);
+        SLANG_CHECK(entryPointRecord->threadGroupSize[0] == 4);
+        SLANG_CHECK(entryPointRecord->threadGroupSize[1] == 2);
+        SLANG_CHECK(entryPointRecord->threadGroupSize[2] == 1);
+        SLANG_CHECK(entryPointRecord->parameterCount == 1);
+    }
+
+    // The blob is the same every time it is produced
+    {
+        ComPtr<ISlangBlob> otherBlob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toBinary(otherBlob.writeRef())));
+        SLANG_CHECK(
+            otherBlob->getBufferSize() == blob->getBufferSize() &&
+            memcmp(
+                otherBlob->getBufferPointer(),
+                blob->getBufferPointer(),
+                blob->getBufferSize()) == 0);
+    }
+}
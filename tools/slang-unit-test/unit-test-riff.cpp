@@ -40,6 +40,8 @@ SLANG_UNIT_TEST(riff)
 {
     typedef RiffContainer::ScopeChunk ScopeChunk;
     typedef RiffContainer::Chunk::Kind Kind;
+    typedef RiffContainer::ListChunk ListChunk;
+    typedef RiffContainer::DataChunk DataChunk;
 
     const FourCC markThings = SLANG_FOUR_CC('T', 'H', 'I', 'N');
     const FourCC markData = SLANG_FOUR_CC('D', 'A', 'T', 'A');
@@ -169,6 +171,125 @@ SLANG_UNIT_TEST(riff)
         }
     }
 
+    // Test compressing data chunks as frames, and that they are only decompressed when accessed
+    for (auto compressionType : {CompressionSystemType::Deflate, CompressionSystemType::LZ4})
+    {
+        const FourCC markSmall = SLANG_FOUR_CC('S', 'M', 'A', 'L');
+        const FourCC markRandom = SLANG_FOUR_CC('R', 'A', 'N', 'D');
+
+        // Compressible data, in a chunk of its own and in a nested list
+        List<uint8_t> data;
+        for (Index i = 0; i < 4096; ++i)
+        {
+            data.add(uint8_t(i % 13));
+        }
+        const char small[] = "Small";
+
+        RefPtr<RandomGenerator> rand = RandomGenerator::create(0x1234);
+        List<uint8_t> randomData;
+        randomData.setCount(1024);
+        rand->nextData(randomData.getBuffer(), randomData.getCount());
+
+        RiffContainer container;
+        {
+            ScopeChunk scopeContainer(&container, Kind::List, markThings);
+            container.addDataChunk(markData, data.getBuffer(), data.getCount());
+            container.addDataChunk(markSmall, small, sizeof(small));
+            container.addDataChunk(markRandom, randomData.getBuffer(), randomData.getCount());
+            {
+                ScopeChunk innerScopeContainer(&container, Kind::List, markThings);
+                container.addDataChunk(markData, data.getBuffer(), data.getCount() / 2);
+            }
+        }
+
+        SLANG_CHECK(SLANG_SUCCEEDED(container.compressFrames(
+            container.getRoot(),
+            RiffContainer::getCompressionSystem(compressionType),
+            2)));
+
+        ListChunk* root = container.getRoot();
+        // Small chunks, and chunks that don't compress, aren't written as frames
+        SLANG_CHECK(as<DataChunk>(root->findContained(markData))->m_frame != nullptr);
+        SLANG_CHECK(as<DataChunk>(root->findContained(markSmall))->m_frame == nullptr);
+        SLANG_CHECK(as<DataChunk>(root->findContained(markRandom))->m_frame == nullptr);
+
+        OwnedMemoryStream stream(FileAccess::ReadWrite);
+        SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::write(root, true, &stream)));
+        SLANG_CHECK(stream.getContents().getCount() < data.getCount());
+        stream.seek(SeekOrigin::Start, 0);
+
+        RiffContainer readContainer;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(RiffUtil::read(&stream, readContainer)));
+        ListChunk* readRoot = readContainer.getRoot();
+        SLANG_CHECK(RiffContainer::isChunkOk(readRoot));
+
+        // Frames are read as chunks of their original type, that haven't been decompressed
+        DataChunk* dataChunk = as<DataChunk>(readRoot->findContained(markData));
+        DataChunk* innerDataChunk =
+            as<DataChunk>(readRoot->findContainedList(markThings)->findContained(markData));
+        SLANG_CHECK_ABORT(dataChunk && innerDataChunk);
+        SLANG_CHECK(dataChunk->hasPendingFrame() && innerDataChunk->hasPendingFrame());
+        SLANG_CHECK(dataChunk->m_payloadSize == size_t(data.getCount()));
+
+        // Accessing the payload decompresses only that chunk
+        SLANG_CHECK(dataChunk->isEqual(data.getBuffer(), data.getCount()));
+        SLANG_CHECK(!dataChunk->hasPendingFrame() && innerDataChunk->hasPendingFrame());
+
+        SLANG_CHECK(SLANG_SUCCEEDED(RiffContainer::decompressFrames(readRoot, 4)));
+        SLANG_CHECK(!innerDataChunk->hasPendingFrame());
+        SLANG_CHECK(innerDataChunk->isEqual(data.getBuffer(), data.getCount() / 2));
+        SLANG_CHECK(
+            as<DataChunk>(readRoot->findContained(markSmall))->isEqual(small, sizeof(small)));
+        SLANG_CHECK(as<DataChunk>(readRoot->findContained(markRandom))
+                        ->isEqual(randomData.getBuffer(), randomData.getCount()));
+
+        // Writing the read container again gives the same stream, as the frames are kept
+        OwnedMemoryStream rewriteStream(FileAccess::ReadWrite);
+        SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::write(readRoot, true, &rewriteStream)));
+        SLANG_CHECK(rewriteStream.getContents() == stream.getContents());
+
+        // A frame that can't be decompressed is an error wherever its payload is used
+        List<uint8_t> corrupted;
+        corrupted.addRange(stream.getContents().getBuffer(), stream.getContents().getCount());
+        Index framePos = -1;
+        for (Index i = 0; i + Index(sizeof(FourCC)) <= corrupted.getCount(); ++i)
+        {
+            FourCC fourCC;
+            ::memcpy(&fourCC, corrupted.getBuffer() + i, sizeof(fourCC));
+            if (fourCC == RiffFourCC::kFrame)
+            {
+                framePos = i;
+                break;
+            }
+        }
+        SLANG_CHECK_ABORT(framePos >= 0);
+        uint32_t frameSize = 0;
+        ::memcpy(&frameSize, corrupted.getBuffer() + framePos + sizeof(FourCC), sizeof(frameSize));
+        const Index compressedPos =
+            framePos + Index(sizeof(RiffHeader) + sizeof(RiffFrameHeader));
+        ::memset(
+            corrupted.getBuffer() + compressedPos,
+            0,
+            frameSize - sizeof(RiffFrameHeader));
+
+        OwnedMemoryStream corruptedStream(FileAccess::ReadWrite);
+        corruptedStream.setContent(corrupted.getBuffer(), corrupted.getCount());
+        RiffContainer corruptedContainer;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(RiffUtil::read(&corruptedStream, corruptedContainer)));
+        ListChunk* corruptedRoot = corruptedContainer.getRoot();
+        DataChunk* corruptedChunk = as<DataChunk>(corruptedRoot->findContained(markData));
+        SLANG_CHECK_ABORT(corruptedChunk && corruptedChunk->hasPendingFrame());
+
+        List<uint8_t> payload;
+        payload.setCount(Index(corruptedChunk->m_payloadSize));
+        RiffHashCode hash;
+        SLANG_CHECK(SLANG_FAILED(corruptedChunk->getPayload(payload.getBuffer())));
+        SLANG_CHECK(SLANG_FAILED(corruptedChunk->calcHash(hash)));
+        SLANG_CHECK(!corruptedChunk->isEqual(data.getBuffer(), data.getCount()));
+        SLANG_CHECK(corruptedChunk->getSingleData() == nullptr);
+        SLANG_CHECK(SLANG_FAILED(RiffContainer::decompressFrames(corruptedRoot, 4)));
+    }
+
 #if 0
     {
         RiffContainer container;
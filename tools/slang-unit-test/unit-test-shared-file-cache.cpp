@@ -0,0 +1,156 @@
+// unit-test-shared-file-cache.cpp
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-shared-file-cache.h"
+#include "../../source/core/slang-string-util.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static bool _isContents(ISlangBlob* blob, const UnownedStringSlice& contents)
+{
+    return blob && blob->getBufferSize() == size_t(contents.getLength()) &&
+           ::memcmp(blob->getBufferPointer(), contents.begin(), contents.getLength()) == 0;
+}
+
+SLANG_UNIT_TEST(sharedFileCache)
+{
+    const String path = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/shared-file-cache-test" +
+        String(Process::getId()) + ".txt");
+
+    ComPtr<SharedFileCache> cache(new SharedFileCache);
+
+    // A file that doesn't exist isn't found, and isn't cached.
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(cache->loadFile(path.getBuffer(), blob.writeRef()) == SLANG_E_NOT_FOUND);
+        SLANG_CHECK(cache->getEntryCount() == 0);
+    }
+
+    const UnownedStringSlice first = toSlice("float4 main() { return 0; }");
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(path, first.begin(), first.getLength())));
+
+    ComPtr<ISlangBlob> firstBlob;
+    SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(path.getBuffer(), firstBlob.writeRef())));
+    SLANG_CHECK(_isContents(firstBlob, first));
+    SLANG_CHECK(cache->getStats().missCount == 1);
+
+    // An unchanged file is served from the cache, as the same blob.
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(path.getBuffer(), blob.writeRef())));
+        SLANG_CHECK(blob == firstBlob);
+        SLANG_CHECK(cache->getStats().hitCount == 1);
+    }
+
+    // Sessions each have their own CacheFileSystem, that share the same contents.
+    {
+        ComPtr<ISlangFileSystemExt> sessionA(new CacheFileSystem(cache));
+        ComPtr<ISlangFileSystemExt> sessionB(new CacheFileSystem(cache));
+
+        ComPtr<ISlangBlob> blobA, blobB;
+        SLANG_CHECK(SLANG_SUCCEEDED(sessionA->loadFile(path.getBuffer(), blobA.writeRef())));
+        SLANG_CHECK(SLANG_SUCCEEDED(sessionB->loadFile(path.getBuffer(), blobB.writeRef())));
+        SLANG_CHECK(blobA == firstBlob && blobB == firstBlob);
+    }
+
+    // Changing the file invalidates the entry. The old blob is still valid for anyone holding it.
+    const UnownedStringSlice second = toSlice("float4 main() { return float4(1, 2, 3, 4); }");
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(path, second.begin(), second.getLength())));
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(path.getBuffer(), blob.writeRef())));
+        SLANG_CHECK(_isContents(blob, second));
+        SLANG_CHECK(_isContents(firstBlob, first));
+        SLANG_CHECK(cache->getStats().invalidationCount == 1);
+    }
+
+    // Editing the file in place, keeping its size, doesn't change a blob that was handed out.
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(path.getBuffer(), blob.writeRef())));
+        SLANG_CHECK(_isContents(blob, second));
+
+        String edited(second);
+        edited = StringUtil::calcCharReplaced(edited, '1', '9');
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(File::writeAllBytes(path, edited.getBuffer(), edited.getLength())));
+        SLANG_CHECK(_isContents(blob, second));
+
+        // Truncating it doesn't either.
+        SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(path, nullptr, 0)));
+        SLANG_CHECK(_isContents(blob, second));
+    }
+
+    // Large files are read whole, and are still zero terminated.
+    {
+        String large;
+        for (Index i = 0; large.getLength() <= 128 * 1024; ++i)
+        {
+            large.append("// line ");
+            large.append(i);
+            large.append("\n");
+        }
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(File::writeAllBytes(path, large.getBuffer(), large.getLength())));
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(path.getBuffer(), blob.writeRef())));
+        SLANG_CHECK(_isContents(blob, large.getUnownedSlice()));
+        SLANG_CHECK(((const char*)blob->getBufferPointer())[blob->getBufferSize()] == 0);
+    }
+
+    // The cache keeps within its byte budget by evicting the least recently used entries, and
+    // doesn't cache a file larger than the whole budget.
+    {
+        const String otherPath = path + ".other";
+        const UnownedStringSlice other = toSlice("int other() { return 1; }");
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(File::writeAllBytes(otherPath, other.begin(), other.getLength())));
+
+        cache->setMaxByteCount(size_t(other.getLength()));
+        SLANG_CHECK(cache->getEntryCount() == 0);
+        SLANG_CHECK(cache->getByteCount() == 0);
+
+        ComPtr<ISlangBlob> otherBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(otherPath.getBuffer(), otherBlob.writeRef())));
+        SLANG_CHECK(_isContents(otherBlob, other));
+        SLANG_CHECK(cache->getEntryCount() == 1);
+        SLANG_CHECK(cache->getByteCount() == size_t(other.getLength()));
+
+        // The large file is read, but not cached.
+        ComPtr<ISlangBlob> largeBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(path.getBuffer(), largeBlob.writeRef())));
+        SLANG_CHECK(cache->getEntryCount() == 1);
+
+        // A budget with room for one entry evicts the older one when another is added.
+        const String thirdPath = path + ".third";
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(File::writeAllBytes(thirdPath, other.begin(), other.getLength())));
+        const auto evictionCount = cache->getStats().evictionCount;
+        ComPtr<ISlangBlob> thirdBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->loadFile(thirdPath.getBuffer(), thirdBlob.writeRef())));
+        SLANG_CHECK(cache->getEntryCount() == 1);
+        SLANG_CHECK(cache->getStats().evictionCount == evictionCount + 1);
+        SLANG_CHECK(cache->getByteCount() == size_t(other.getLength()));
+
+        // The evicted blob is still valid for anyone holding it.
+        SLANG_CHECK(_isContents(otherBlob, other));
+
+        cache->setMaxByteCount(SharedFileCache::kDefaultMaxByteCount);
+        File::remove(otherPath);
+        File::remove(thirdPath);
+        cache->clearCache();
+    }
+
+    File::remove(path);
+
+    // Once the file has gone, so has the entry.
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(cache->loadFile(path.getBuffer(), blob.writeRef()) == SLANG_E_NOT_FOUND);
+        SLANG_CHECK(cache->getEntryCount() == 0);
+    }
+}
@@ -0,0 +1,148 @@
+// unit-test-specialization-cache.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that specializing a component type with the same arguments again gives the same
+// component type, and that different arguments give a different one. The cache also
+// covers programs that are rebuilt from the same parts, and only keeps recent results.
+
+static const char* kSpecializationCacheSource = R"(
+    interface IMaterial
+    {
+        float4 eval();
+    }
+
+    struct Red : IMaterial
+    {
+        float4 eval() { return float4(1, 0, 0, 1); }
+    }
+
+    struct Blue : IMaterial
+    {
+        float4 eval() { return float4(0, 0, 1, 1); }
+    }
+
+    typealias Crimson = Red;
+
+    struct Sized<let N : int> : IMaterial
+    {
+        float4 eval() { return float4(N, 0, 0, 1); }
+    }
+
+    RWStructuredBuffer<float4> gOutput;
+
+    [numthreads(1, 1, 1)]
+    void computeMain<M : IMaterial>(uniform M material)
+    {
+        gOutput[0] = material.eval();
+    }
+    )";
+
+static ComPtr<slang::IComponentType> _specialize(
+    slang::IComponentType* program,
+    slang::IModule* module,
+    const char* typeName)
+{
+    auto type = module->getLayout()->findTypeByName(typeName);
+    if (!type)
+        return nullptr;
+
+    slang::SpecializationArg arg = slang::SpecializationArg::fromType(type);
+    ComPtr<slang::IBlob> diagnosticBlob;
+    ComPtr<slang::IComponentType> specialized;
+    program->specialize(&arg, 1, specialized.writeRef(), diagnosticBlob.writeRef());
+    return specialized;
+}
+
+SLANG_UNIT_TEST(specializationCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "specializationCache",
+        "specializationCache.slang",
+        kSpecializationCacheSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findAndCheckEntryPoint(
+        "computeMain",
+        SLANG_STAGE_COMPUTE,
+        entryPoint.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(entryPoint);
+
+    ComPtr<slang::IComponentType> program;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        program.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(program);
+    SLANG_CHECK_ABORT(program->getSpecializationParamCount() == 1);
+
+    auto red = _specialize(program, module, "Red");
+    SLANG_CHECK_ABORT(red);
+
+    ComPtr<slang::IBlob> redCode;
+    SLANG_CHECK(
+        SLANG_SUCCEEDED(red->getEntryPointCode(0, 0, redCode.writeRef(), nullptr)) && redCode);
+
+    // The same arguments give the same component type, including when the type
+    // is named through an alias
+    SLANG_CHECK(_specialize(program, module, "Red").get() == red.get());
+    SLANG_CHECK(_specialize(program, module, "Crimson").get() == red.get());
+
+    // Different arguments give a different component type
+    auto blue = _specialize(program, module, "Blue");
+    SLANG_CHECK_ABORT(blue);
+    SLANG_CHECK(blue.get() != red.get());
+
+    // Earlier results are still reused after other specializations
+    SLANG_CHECK(_specialize(program, module, "Red").get() == red.get());
+
+    // A program rebuilt from the same parts finds the same result
+    ComPtr<slang::IComponentType> rebuiltProgram;
+    session->createCompositeComponentType(
+        components,
+        2,
+        rebuiltProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(rebuiltProgram);
+    SLANG_CHECK(rebuiltProgram.get() != program.get());
+    SLANG_CHECK(_specialize(rebuiltProgram, module, "Red").get() == red.get());
+
+    // Only the most recently used results are kept, so after many other
+    // specializations the result for `Red` is created again
+    for (int i = 0; i < 100; ++i)
+    {
+        StringBuilder typeName;
+        typeName << "Sized<" << i << ">";
+        SLANG_CHECK(_specialize(program, module, typeName.getBuffer()));
+    }
+    auto redAgain = _specialize(program, module, "Red");
+    SLANG_CHECK_ABORT(redAgain);
+    SLANG_CHECK(redAgain.get() != red.get());
+
+    // The wrong number of arguments is still an error
+    ComPtr<slang::IComponentType> specialized;
+    SLANG_CHECK(SLANG_FAILED(
+        program->specialize(nullptr, 0, specialized.writeRef(), diagnosticBlob.writeRef())));
+}
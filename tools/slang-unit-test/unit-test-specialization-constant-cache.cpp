@@ -0,0 +1,152 @@
+// unit-test-specialization-constant-cache.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that linking with values for specialization constants folds them into the generated
+// code, and that linking with the same values again gives the same component type.
+
+static const char* kSpecializationConstantCacheSource = R"(
+    [vk::constant_id(0)]
+    const bool useFastPath = true;
+
+    RWStructuredBuffer<int> gOutput;
+
+    [numthreads(1, 1, 1)]
+    void computeMain()
+    {
+        gOutput[0] = useFastPath ? 12345 : 67890;
+    }
+    )";
+
+static slang::CompilerOptionEntry _makeConstantValueEntry(const char* name, const char* value)
+{
+    slang::CompilerOptionEntry entry;
+    entry.name = slang::CompilerOptionName::SpecializeConstant;
+    entry.value.kind = slang::CompilerOptionValueKind::String;
+    entry.value.stringValue0 = name;
+    entry.value.stringValue1 = value;
+    return entry;
+}
+
+static ComPtr<slang::IComponentType> _linkWithConstantValues(
+    slang::IComponentType* program,
+    uint32_t count,
+    slang::CompilerOptionEntry* entries)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    ComPtr<slang::IComponentType> linked;
+    program->linkWithOptions(linked.writeRef(), count, entries, diagnosticBlob.writeRef());
+    return linked;
+}
+
+static ComPtr<slang::IComponentType> _linkWithConstantValue(
+    slang::IComponentType* program,
+    const char* name,
+    const char* value)
+{
+    auto entry = _makeConstantValueEntry(name, value);
+    return _linkWithConstantValues(program, 1, &entry);
+}
+
+static bool _containsText(slang::IBlob* blob, const char* text)
+{
+    UnownedStringSlice code((const char*)blob->getBufferPointer(), blob->getBufferSize());
+    return code.indexOf(UnownedStringSlice(text)) >= 0;
+}
+
+SLANG_UNIT_TEST(specializationConstantCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_GLSL;
+    targetDesc.profile = globalSession->findProfile("glsl_450");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "specializationConstantCache",
+        "specializationConstantCache.slang",
+        kSpecializationConstantCacheSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findAndCheckEntryPoint(
+        "computeMain",
+        SLANG_STAGE_COMPUTE,
+        entryPoint.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(entryPoint);
+
+    ComPtr<slang::IComponentType> program;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        program.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(program);
+
+    auto slowPath = _linkWithConstantValue(program, "useFastPath", "false");
+    SLANG_CHECK_ABORT(slowPath);
+
+    // The constant is folded, so only the value on the path that is taken is left
+    ComPtr<slang::IBlob> slowCode;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(slowPath->getEntryPointCode(0, 0, slowCode.writeRef(), nullptr)) &&
+        slowCode);
+    SLANG_CHECK(_containsText(slowCode, "67890"));
+    SLANG_CHECK(!_containsText(slowCode, "12345"));
+    SLANG_CHECK(!_containsText(slowCode, "constant_id"));
+
+    // The same value gives the same component type
+    SLANG_CHECK(_linkWithConstantValue(program, "useFastPath", "false").get() == slowPath.get());
+
+    // Only the last value given for a constant counts
+    slang::CompilerOptionEntry repeatedEntries[] = {
+        _makeConstantValueEntry("useFastPath", "true"),
+        _makeConstantValueEntry("useFastPath", "false")};
+    SLANG_CHECK(_linkWithConstantValues(program, 2, repeatedEntries).get() == slowPath.get());
+
+    // The order that the values are given in doesn't matter
+    slang::CompilerOptionEntry orderedEntries[] = {
+        _makeConstantValueEntry("useFastPath", "false"),
+        _makeConstantValueEntry("unusedConstant", "3")};
+    slang::CompilerOptionEntry reorderedEntries[] = {
+        _makeConstantValueEntry("unusedConstant", "3"),
+        _makeConstantValueEntry("useFastPath", "false")};
+    auto ordered = _linkWithConstantValues(program, 2, orderedEntries);
+    SLANG_CHECK_ABORT(ordered);
+    SLANG_CHECK(_linkWithConstantValues(program, 2, reorderedEntries).get() == ordered.get());
+
+    // A different value gives a different component type, with its own code. The constant can
+    // also be named by its constant_id
+    auto fastPath = _linkWithConstantValue(program, "0", "true");
+    SLANG_CHECK_ABORT(fastPath);
+    SLANG_CHECK(fastPath.get() != slowPath.get());
+
+    ComPtr<slang::IBlob> fastCode;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(fastPath->getEntryPointCode(0, 0, fastCode.writeRef(), nullptr)) &&
+        fastCode);
+    SLANG_CHECK(_containsText(fastCode, "12345"));
+    SLANG_CHECK(!_containsText(fastCode, "67890"));
+
+    // Linking without values still leaves the specialization constant in the code
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->link(linked.writeRef(), diagnosticBlob.writeRef())));
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(linked->getEntryPointCode(0, 0, code.writeRef(), nullptr)) && code);
+    SLANG_CHECK(_containsText(code, "constant_id"));
+}
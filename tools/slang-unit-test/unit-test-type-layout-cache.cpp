@@ -0,0 +1,223 @@
+// unit-test-type-layout-cache.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that programs linked in the same session share the layouts of `struct` types
+// that don't depend on the program, that the layouts are the same as if
+// they were computed from scratch, and that they aren't shared with the cache disabled.
+
+static const char* kTypeLayoutCacheSource = R"(
+    struct Light
+    {
+        float3 position;
+        float intensity;
+        float4x4 shadowMatrix;
+    };
+
+    struct CommonParams
+    {
+        float4x4 viewProjection;
+        Light lights[8];
+        uint lightCount;
+        Texture2D shadowMap;
+        SamplerState shadowSampler;
+    };
+
+    interface IMaterial
+    {
+        float4 eval();
+    };
+
+    struct PerProgram
+    {
+        float4 tint;
+        IMaterial material;
+    };
+
+    ParameterBlock<CommonParams> gCommon;
+    ConstantBuffer<PerProgram> gPerProgram;
+    RWStructuredBuffer<float4> gOutput;
+
+    [numthreads(8, 1, 1)]
+    void computeA(uint3 tid : SV_DispatchThreadID)
+    {
+        gOutput[tid.x] = gCommon.lights[tid.x].intensity * gPerProgram.tint;
+    }
+
+    [numthreads(8, 1, 1)]
+    void computeB(uint3 tid : SV_DispatchThreadID)
+    {
+        gOutput[tid.x] = mul(gCommon.viewProjection, float4(gCommon.lights[0].position, 1));
+    }
+    )";
+
+static slang::VariableLayoutReflection* _findParam(slang::ProgramLayout* layout, const char* name)
+{
+    const unsigned count = layout->getParameterCount();
+    for (unsigned i = 0; i < count; ++i)
+    {
+        auto param = layout->getParameterByIndex(i);
+        if (strcmp(param->getName(), name) == 0)
+            return param;
+    }
+    return nullptr;
+}
+
+static slang::TypeLayoutReflection* _getElementTypeLayout(
+    slang::ProgramLayout* layout,
+    const char* paramName)
+{
+    auto param = _findParam(layout, paramName);
+    if (!param)
+        return nullptr;
+    auto elementVarLayout = param->getTypeLayout()->getElementVarLayout();
+    return elementVarLayout ? elementVarLayout->getTypeLayout() : nullptr;
+}
+
+static slang::IModule* _loadModule(slang::ISession* session)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    return session->loadModuleFromSourceString(
+        "typeLayoutCache",
+        "typeLayoutCache.slang",
+        kTypeLayoutCacheSource,
+        diagnosticBlob.writeRef());
+}
+
+static ComPtr<slang::IComponentType> _createProgram(
+    slang::ISession* session,
+    slang::IModule* module,
+    const char* entryPointName)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findAndCheckEntryPoint(
+        entryPointName,
+        SLANG_STAGE_COMPUTE,
+        entryPoint.writeRef(),
+        diagnosticBlob.writeRef());
+    if (!entryPoint)
+        return nullptr;
+
+    ComPtr<slang::IComponentType> program;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        program.writeRef(),
+        diagnosticBlob.writeRef());
+    return program;
+}
+
+SLANG_UNIT_TEST(typeLayoutCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    auto module = _loadModule(session);
+    SLANG_CHECK_ABORT(module);
+
+    auto programA = _createProgram(session, module, "computeA");
+    auto programB = _createProgram(session, module, "computeB");
+    SLANG_CHECK_ABORT(programA && programB);
+
+    auto layoutA = programA->getLayout(0);
+    auto layoutB = programB->getLayout(0);
+    SLANG_CHECK_ABORT(layoutA && layoutB);
+
+    // The struct only depends on the target, so the layout is shared
+    auto commonA = _getElementTypeLayout(layoutA, "gCommon");
+    auto commonB = _getElementTypeLayout(layoutB, "gCommon");
+    SLANG_CHECK_ABORT(commonA && commonB);
+    SLANG_CHECK(commonA == commonB);
+
+    // A struct with an existential field depends on the program, and isn't shared
+    auto perProgramA = _getElementTypeLayout(layoutA, "gPerProgram");
+    auto perProgramB = _getElementTypeLayout(layoutB, "gPerProgram");
+    SLANG_CHECK_ABORT(perProgramA && perProgramB);
+    SLANG_CHECK(perProgramA != perProgramB);
+
+    // The shared layout is the same as one computed in a new session
+    ComPtr<slang::ISession> otherSession;
+    SLANG_CHECK_ABORT(
+        globalSession->createSession(sessionDesc, otherSession.writeRef()) == SLANG_OK);
+    auto otherModule = _loadModule(otherSession);
+    SLANG_CHECK_ABORT(otherModule);
+    auto otherProgram = _createProgram(otherSession, otherModule, "computeB");
+    SLANG_CHECK_ABORT(otherProgram);
+    auto otherCommon = _getElementTypeLayout(otherProgram->getLayout(0), "gCommon");
+    SLANG_CHECK_ABORT(otherCommon);
+
+    SLANG_CHECK(otherCommon->getSize() == commonB->getSize());
+    SLANG_CHECK(otherCommon->getFieldCount() == commonB->getFieldCount());
+    for (unsigned i = 0; i < commonB->getFieldCount(); ++i)
+    {
+        auto field = commonB->getFieldByIndex(i);
+        auto otherField = otherCommon->getFieldByIndex(i);
+        SLANG_CHECK(strcmp(field->getName(), otherField->getName()) == 0);
+        SLANG_CHECK(field->getOffset() == otherField->getOffset());
+        SLANG_CHECK(
+            field->getOffset(slang::ParameterCategory::DescriptorTableSlot) ==
+            otherField->getOffset(slang::ParameterCategory::DescriptorTableSlot));
+    }
+    SLANG_CHECK(otherCommon->getBindingRangeCount() == commonB->getBindingRangeCount());
+
+    // The layouts of a session that is destroyed are removed from the cache of the global
+    // session, and a later session that lays out the same types gets correct layouts.
+    const auto otherSize = otherCommon->getSize();
+    otherProgram = nullptr;
+    otherSession = nullptr;
+    {
+        ComPtr<slang::ISession> laterSession;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, laterSession.writeRef()) == SLANG_OK);
+        auto laterModule = _loadModule(laterSession);
+        SLANG_CHECK_ABORT(laterModule);
+        auto laterProgram = _createProgram(laterSession, laterModule, "computeA");
+        SLANG_CHECK_ABORT(laterProgram);
+        auto laterCommon = _getElementTypeLayout(laterProgram->getLayout(0), "gCommon");
+        SLANG_CHECK_ABORT(laterCommon);
+        SLANG_CHECK(laterCommon->getSize() == otherSize);
+        SLANG_CHECK(laterCommon->getFieldCount() == commonB->getFieldCount());
+    }
+    SLANG_CHECK(commonA->getSize() == otherSize);
+
+    // With the cache disabled, programs in the same session each get their own layout
+    slang::CompilerOptionEntry option = {};
+    option.name = slang::CompilerOptionName::DisableTypeLayoutCache;
+    option.value.kind = slang::CompilerOptionValueKind::Int;
+    option.value.intValue0 = 1;
+    slang::SessionDesc uncachedSessionDesc = sessionDesc;
+    uncachedSessionDesc.compilerOptionEntries = &option;
+    uncachedSessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> uncachedSession;
+    SLANG_CHECK_ABORT(
+        globalSession->createSession(uncachedSessionDesc, uncachedSession.writeRef()) ==
+        SLANG_OK);
+    auto uncachedModule = _loadModule(uncachedSession);
+    SLANG_CHECK_ABORT(uncachedModule);
+    auto uncachedA = _createProgram(uncachedSession, uncachedModule, "computeA");
+    auto uncachedB = _createProgram(uncachedSession, uncachedModule, "computeB");
+    SLANG_CHECK_ABORT(uncachedA && uncachedB);
+    auto uncachedCommonA = _getElementTypeLayout(uncachedA->getLayout(0), "gCommon");
+    auto uncachedCommonB = _getElementTypeLayout(uncachedB->getLayout(0), "gCommon");
+    SLANG_CHECK_ABORT(uncachedCommonA && uncachedCommonB);
+    SLANG_CHECK(uncachedCommonA != uncachedCommonB);
+    SLANG_CHECK(uncachedCommonA->getSize() == commonA->getSize());
+}